@@ -0,0 +1,77 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "unit/benchmark_unit.hpp"
+
+#include <cstdlib>
+#include <new>
+
+/*
+ * The global allocation functions are replaced to
+ * count the allocations of each benchmark. They
+ * live in their own translation unit, so the
+ * compiler never sees a malloc paired with a
+ * delete. On platforms where the library doesn't
+ * share the allocation functions of the executable
+ * (e.g. a windows dll) only the allocations of the
+ * benchmark code itself are counted.
+ */
+void* operator new(std::size_t size)
+{
+  oos::benchmark_unit::count_allocation(size);
+  void *p = std::malloc(size > 0 ? size : 1);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+  oos::benchmark_unit::count_allocation(size);
+  return std::malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t &tag) noexcept
+{
+  return operator new(size, tag);
+}
+
+void operator delete(void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept
+{
+  std::free(p);
+}
@@ -0,0 +1,50 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "unit/test_suite.hpp"
+
+#include "object/ObjectStoreBenchmark.hpp"
+#include "object/ObjectViewBenchmark.hpp"
+#include "object/ContainerBenchmark.hpp"
+
+#include "tools/ToolsBenchmark.hpp"
+
+#include "json/JsonBenchmark.hpp"
+
+#include "database/DatabaseBenchmark.hpp"
+
+int main(int argc, char *argv[])
+{
+  oos::test_suite suite;
+
+  suite.init(argc, argv);
+
+  suite.register_unit(new ToolsBenchmark());
+
+  suite.register_unit(new ObjectStoreBenchmark());
+  suite.register_unit(new ObjectViewBenchmark());
+  suite.register_unit(new ContainerBenchmark());
+
+  suite.register_unit(new JsonBenchmark());
+
+#ifdef OOS_SQLITE3
+  suite.register_unit(new DatabaseBenchmark("sqlite_database", "sqlite database benchmark unit", "sqlite://bench.sqlite"));
+#endif
+
+  bool result = suite.run();
+  return result ? 0 : 1;
+}
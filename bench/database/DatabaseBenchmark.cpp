@@ -0,0 +1,335 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DatabaseBenchmark.hpp"
+
+#include "Item.hpp"
+
+#include "object/object_view.hpp"
+
+#include "database/session.hpp"
+#include "database/transaction.hpp"
+#include "database/query.hpp"
+
+#include <sstream>
+#include <tuple>
+
+using namespace oos;
+
+namespace {
+
+const std::size_t item_count = 10000;
+const std::size_t blob_size = 16 * 1024 * 1024;
+const std::size_t blob_chunk_size = 64 * 1024;
+const std::size_t track_count = 1000;
+const std::size_t element_count = 10000;
+
+}
+
+DatabaseBenchmark::DatabaseBenchmark(const std::string &name, const std::string &msg, const std::string &db)
+  : benchmark_unit(name, msg)
+  , db_(db)
+  , session_(nullptr)
+  , filled_(false)
+  , blob_filled_(false)
+  , vectors_filled_(false)
+  , sink_(0)
+{
+  add_benchmark("insert", std::bind(&DatabaseBenchmark::create_items, this), std::bind(&DatabaseBenchmark::insert, this), "insert items in one transaction", item_count);
+  add_benchmark("load", std::bind(&DatabaseBenchmark::unload, this), std::bind(&DatabaseBenchmark::load, this), "load all items of a session", item_count);
+  add_benchmark("mass_delete", std::bind(&DatabaseBenchmark::fill, this), std::bind(&DatabaseBenchmark::mass_delete, this), "delete all items in one transaction", item_count);
+  add_benchmark("update_columns", std::bind(&DatabaseBenchmark::fill, this), std::bind(&DatabaseBenchmark::update_columns, this), "update one column of a wide row", item_count);
+  add_benchmark("select_iterate", std::bind(&DatabaseBenchmark::fill_once, this), std::bind(&DatabaseBenchmark::select_iterate, this), "select and iterate all items", item_count);
+  add_benchmark("select_reuse", std::bind(&DatabaseBenchmark::fill_once, this), std::bind(&DatabaseBenchmark::select_reuse, this), "select all items reusing one row object", item_count);
+  add_benchmark("insert_metrics", std::bind(&DatabaseBenchmark::create_items_measured, this), std::bind(&DatabaseBenchmark::insert, this), "insert items in one transaction with sql metrics", item_count);
+  add_benchmark("select_reuse_metrics", std::bind(&DatabaseBenchmark::fill_once_measured, this), std::bind(&DatabaseBenchmark::select_reuse, this), "select all items reusing one row object with sql metrics", item_count);
+  add_benchmark("select_tuple", std::bind(&DatabaseBenchmark::fill_once, this), std::bind(&DatabaseBenchmark::select_tuple, this), "select one column into a tuple and sum it on the client", item_count);
+  add_benchmark("aggregate_sum", std::bind(&DatabaseBenchmark::fill_once, this), std::bind(&DatabaseBenchmark::aggregate_sum, this), "sum a column in the database", item_count);
+  add_benchmark("blob_write", std::bind(&DatabaseBenchmark::reset, this), std::bind(&DatabaseBenchmark::blob_write, this), "write a 16MB blob", blob_size);
+  add_benchmark("blob_read", std::bind(&DatabaseBenchmark::fill_blob_once, this), std::bind(&DatabaseBenchmark::blob_read, this), "load and read a 16MB blob in 64KB chunks", blob_size);
+  add_benchmark("vector_front_insert", std::bind(&DatabaseBenchmark::create_chart, this), std::bind(&DatabaseBenchmark::vector_front_insert, this), "insert each track at the front of a gapped vector in one transaction", track_count);
+  add_benchmark("value_vector_insert", std::bind(&DatabaseBenchmark::reset, this), std::bind(&DatabaseBenchmark::value_vector_insert, this), "insert a value_vector of ints into its join table", element_count);
+  add_benchmark("item_vector_insert", std::bind(&DatabaseBenchmark::reset, this), std::bind(&DatabaseBenchmark::item_vector_insert, this), "insert an object_vector of ints with one item per element", element_count);
+  add_benchmark("vector_load", std::bind(&DatabaseBenchmark::fill_vectors_once, this), std::bind(&DatabaseBenchmark::load, this), "load a value_vector and an object_vector of ints", 2 * element_count);
+}
+
+DatabaseBenchmark::~DatabaseBenchmark()
+{}
+
+void DatabaseBenchmark::initialize()
+{
+  ostore_.insert_prototype<Item>("item");
+  ostore_.insert_prototype<picture>("picture");
+  ostore_.insert_prototype<album>("album");
+  ostore_.insert_prototype<track>("track");
+  ostore_.insert_prototype<chart>("chart");
+  ostore_.insert_prototype<sensor>("sensor");
+  ostore_.insert_prototype(new vector_object_producer<IntVector>("int_vector"), "item_int_vector");
+
+  std::vector<char> data(blob_size);
+  for (std::size_t i = 0; i < blob_size; ++i) {
+    data[i] = (char)(i % 251);
+  }
+  blob_.assign(&data.front(), data.size());
+
+  filled_ = false;
+  blob_filled_ = false;
+  vectors_filled_ = false;
+
+  session_ = new session(ostore_, db_);
+  session_->open();
+  session_->create();
+}
+
+void DatabaseBenchmark::finalize()
+{
+  session_->drop();
+  session_->close();
+
+  delete session_;
+  session_ = nullptr;
+
+  for (std::vector<Item*>::iterator i = items_.begin(); i != items_.end(); ++i) {
+    if ((*i)->id() == 0) {
+      delete *i;
+    }
+  }
+  items_.clear();
+  blob_.clear();
+  ostore_.clear(true);
+}
+
+void DatabaseBenchmark::reset()
+{
+  ostore_.clear();
+  session_->drop();
+  session_->create();
+  filled_ = false;
+  blob_filled_ = false;
+  vectors_filled_ = false;
+}
+
+void DatabaseBenchmark::create_items()
+{
+  session_->db().metrics().enable(false);
+  reset();
+  items_.clear();
+  for (std::size_t i = 0; i < item_count; ++i) {
+    items_.push_back(new Item("item", (int)i));
+  }
+}
+
+void DatabaseBenchmark::fill()
+{
+  create_items();
+  insert();
+  items_.clear();
+  filled_ = true;
+}
+
+void DatabaseBenchmark::fill_once()
+{
+  if (!filled_) {
+    fill();
+  }
+  session_->db().metrics().enable(false);
+}
+
+void DatabaseBenchmark::create_items_measured()
+{
+  create_items();
+  session_->db().metrics().enable(true);
+}
+
+void DatabaseBenchmark::fill_once_measured()
+{
+  fill_once();
+  session_->db().metrics().enable(true);
+}
+
+void DatabaseBenchmark::unload()
+{
+  fill_once();
+  ostore_.clear();
+}
+
+void DatabaseBenchmark::fill_blob_once()
+{
+  if (!blob_filled_) {
+    reset();
+    blob_write();
+    blob_filled_ = true;
+  }
+  ostore_.clear();
+}
+
+void DatabaseBenchmark::create_chart()
+{
+  reset();
+  transaction tr(*session_);
+  tr.begin();
+  ostore_.insert(new chart("chart"));
+  tr.commit();
+}
+
+void DatabaseBenchmark::fill_vectors_once()
+{
+  if (!vectors_filled_) {
+    reset();
+    value_vector_insert();
+    item_vector_insert();
+    vectors_filled_ = true;
+  }
+  ostore_.clear();
+}
+
+void DatabaseBenchmark::insert()
+{
+  transaction tr(*session_);
+  tr.begin();
+  for (std::vector<Item*>::iterator i = items_.begin(); i != items_.end(); ++i) {
+    ostore_.insert(*i);
+  }
+  tr.commit();
+}
+
+void DatabaseBenchmark::load()
+{
+  session_->load();
+}
+
+void DatabaseBenchmark::mass_delete()
+{
+  object_view<Item> view(ostore_);
+  transaction tr(*session_);
+  tr.begin();
+  ostore_.remove(view.begin(), view.end());
+  tr.commit();
+}
+
+void DatabaseBenchmark::update_columns()
+{
+  object_view<Item> view(ostore_);
+  transaction tr(*session_);
+  tr.begin();
+  for (object_view<Item>::iterator i = view.begin(); i != view.end(); ++i) {
+    (*i)->set_int((*i)->get_int() + 1);
+  }
+  tr.commit();
+}
+
+void DatabaseBenchmark::select_iterate()
+{
+  query<Item> q(session_->db());
+  result<Item> res(q.select().from("item").execute());
+  long long sum = 0;
+  for (result<Item>::iterator i = res.begin(); i != res.end(); ++i) {
+    sum += i->get_int();
+  }
+  sink_ = sum;
+}
+
+void DatabaseBenchmark::select_reuse()
+{
+  query<Item> q(session_->db());
+  result<Item> res(q.select().from("item").execute());
+  long long sum = 0;
+  res.for_each_row([&](const Item &item) {
+    sum += item.get_int();
+  });
+  sink_ = sum;
+}
+
+void DatabaseBenchmark::select_tuple()
+{
+  typedef std::tuple<int> row_t;
+  query<row_t> q(session_->db());
+  q.select({"val_int"}).from("item");
+  result<row_t> res(q.execute());
+  long long sum = 0;
+  for (result<row_t>::iterator i = res.begin(); i != res.end(); ++i) {
+    sum += std::get<0>(*i);
+  }
+  sink_ = sum;
+}
+
+void DatabaseBenchmark::aggregate_sum()
+{
+  query<Item> q(session_->db());
+  sink_ = q.aggregate<long>(oos::aggregate_sum, "val_int", "item").value();
+}
+
+void DatabaseBenchmark::blob_write()
+{
+  transaction tr(*session_);
+  tr.begin();
+  ostore_.insert(new picture("picture", blob_));
+  tr.commit();
+}
+
+void DatabaseBenchmark::blob_read()
+{
+  session_->load();
+  object_view<picture> view(ostore_);
+  const blob &data = view.front()->data();
+  std::vector<char> buf(blob_chunk_size);
+  blob::size_type offset = 0;
+  blob::size_type n = 0;
+  long long total = 0;
+  while ((n = data.read(offset, &buf.front(), buf.size())) > 0) {
+    offset += n;
+    total += (unsigned char)buf[n - 1];
+  }
+  sink_ = total + (long long)offset;
+}
+
+void DatabaseBenchmark::vector_front_insert()
+{
+  object_view<chart> view(ostore_);
+  object_ptr<chart> c = view.front();
+  transaction tr(*session_);
+  tr.begin();
+  for (std::size_t i = 0; i < track_count; ++i) {
+    std::stringstream title;
+    title << "track " << i;
+    c->insert(c->begin(), ostore_.insert(new track(title.str())));
+  }
+  tr.commit();
+}
+
+void DatabaseBenchmark::value_vector_insert()
+{
+  transaction tr(*session_);
+  tr.begin();
+  object_ptr<sensor> s = ostore_.insert(new sensor("sensor"));
+  sensor::sample_vector_t &samples = s->samples();
+  for (std::size_t i = 0; i < element_count; ++i) {
+    samples.push_back((int)i);
+  }
+  tr.commit();
+}
+
+void DatabaseBenchmark::item_vector_insert()
+{
+  transaction tr(*session_);
+  tr.begin();
+  object_ptr<IntVector> v = ostore_.insert(new IntVector("int_vector"));
+  for (std::size_t i = 0; i < element_count; ++i) {
+    v->push_back((int)i);
+  }
+  tr.commit();
+}
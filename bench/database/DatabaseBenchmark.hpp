@@ -0,0 +1,82 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATABASE_BENCHMARK_HPP
+#define DATABASE_BENCHMARK_HPP
+
+#include "unit/benchmark_unit.hpp"
+
+#include "object/object_store.hpp"
+
+#include "tools/blob.hpp"
+
+#include <string>
+#include <vector>
+
+namespace oos {
+class session;
+}
+
+class Item;
+
+class DatabaseBenchmark : public oos::benchmark_unit
+{
+public:
+  DatabaseBenchmark(const std::string &name, const std::string &msg, const std::string &db);
+  virtual ~DatabaseBenchmark();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void reset();
+  void create_items();
+  void fill();
+  void fill_once();
+  void unload();
+  void fill_blob_once();
+  void create_items_measured();
+  void fill_once_measured();
+  void create_chart();
+  void fill_vectors_once();
+
+  void insert();
+  void load();
+  void mass_delete();
+  void update_columns();
+  void select_iterate();
+  void select_reuse();
+  void select_tuple();
+  void aggregate_sum();
+  void blob_write();
+  void blob_read();
+  void vector_front_insert();
+  void value_vector_insert();
+  void item_vector_insert();
+
+private:
+  oos::object_store ostore_;
+  std::string db_;
+  oos::session *session_;
+  std::vector<Item*> items_;
+  bool filled_;
+  bool blob_filled_;
+  bool vectors_filled_;
+  oos::blob blob_;
+  long long sink_;
+};
+
+#endif /* DATABASE_BENCHMARK_HPP */
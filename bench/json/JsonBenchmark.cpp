@@ -0,0 +1,77 @@
+#include "JsonBenchmark.hpp"
+
+#include "Item.hpp"
+
+#include "object/object_view.hpp"
+
+#include "json/json_parser.hpp"
+#include "json/json_serializer.hpp"
+#include "json/json_deserializer.hpp"
+
+#include <sstream>
+
+using namespace oos;
+
+namespace {
+
+const std::size_t item_count = 10000;
+
+}
+
+JsonBenchmark::JsonBenchmark()
+  : benchmark_unit("json", "json benchmark unit")
+  , sink_(0)
+{
+  add_benchmark("parse", std::bind(&JsonBenchmark::parse, this), "parse a json array of items", item_count);
+  add_benchmark("serialize", std::bind(&JsonBenchmark::serialize, this), "serialize a view of items", item_count);
+  add_benchmark("deserialize", std::bind(&JsonBenchmark::clear_target, this), std::bind(&JsonBenchmark::deserialize, this), "deserialize items into an object store", item_count);
+}
+
+JsonBenchmark::~JsonBenchmark()
+{}
+
+void JsonBenchmark::initialize()
+{
+  ostore_.insert_prototype<Item>("item");
+  target_.insert_prototype<Item>("item");
+  for (std::size_t i = 0; i < item_count; ++i) {
+    Item *item = new Item("item", (int)i);
+    item->set_double(i * 0.5);
+    item->set_bool(i % 2 == 0);
+    ostore_.insert(item);
+  }
+  json_serializer serializer;
+  json_ = serializer.serialize(object_view<Item>(ostore_));
+  metric("document_bytes", (double)json_.size());
+}
+
+void JsonBenchmark::finalize()
+{
+  json_.clear();
+  target_.clear(true);
+  ostore_.clear(true);
+}
+
+void JsonBenchmark::clear_target()
+{
+  target_.clear();
+}
+
+void JsonBenchmark::parse()
+{
+  json_parser parser;
+  sink_ = parser.parse(json_.c_str()).size();
+}
+
+void JsonBenchmark::serialize()
+{
+  json_serializer serializer;
+  sink_ = serializer.serialize(object_view<Item>(ostore_)).size();
+}
+
+void JsonBenchmark::deserialize()
+{
+  std::istringstream in(json_);
+  json_deserializer deserializer;
+  sink_ = deserializer.deserialize<Item>(target_, in);
+}
@@ -0,0 +1,32 @@
+#ifndef JSONBENCHMARK_HPP
+#define JSONBENCHMARK_HPP
+
+#include "unit/benchmark_unit.hpp"
+
+#include "object/object_store.hpp"
+
+#include <string>
+
+class JsonBenchmark : public oos::benchmark_unit
+{
+public:
+  JsonBenchmark();
+  virtual ~JsonBenchmark();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void clear_target();
+
+  void parse();
+  void serialize();
+  void deserialize();
+
+private:
+  oos::object_store ostore_;
+  oos::object_store target_;
+  std::string json_;
+  std::size_t sink_;
+};
+
+#endif /* JSONBENCHMARK_HPP */
@@ -0,0 +1,119 @@
+#include "ContainerBenchmark.hpp"
+
+#include "Item.hpp"
+
+#include <sstream>
+
+using namespace oos;
+
+namespace {
+
+const std::size_t track_count = 2000;
+const std::size_t element_count = 10000;
+
+}
+
+ContainerBenchmark::ContainerBenchmark()
+  : benchmark_unit("container", "container benchmark unit")
+  , filled_(false)
+  , sink_(0)
+{
+  add_benchmark("front_insert", std::bind(&ContainerBenchmark::create_chart, this), std::bind(&ContainerBenchmark::front_insert, this), "insert each item at the front of a gapped vector", track_count);
+  // the allocated bytes of the inserts compare the memory per element
+  add_benchmark("value_vector_insert", std::bind(&ContainerBenchmark::create_containers, this), std::bind(&ContainerBenchmark::value_vector_insert, this), "append ints to a value_vector", element_count);
+  add_benchmark("item_vector_insert", std::bind(&ContainerBenchmark::create_containers, this), std::bind(&ContainerBenchmark::item_vector_insert, this), "append ints to an object_vector with one item per element", element_count);
+  add_benchmark("value_vector_iterate", std::bind(&ContainerBenchmark::fill_containers_once, this), std::bind(&ContainerBenchmark::value_vector_iterate, this), "sum the ints of a value_vector", element_count);
+  add_benchmark("item_vector_iterate", std::bind(&ContainerBenchmark::fill_containers_once, this), std::bind(&ContainerBenchmark::item_vector_iterate, this), "sum the ints of an object_vector with one item per element", element_count);
+}
+
+ContainerBenchmark::~ContainerBenchmark()
+{}
+
+void ContainerBenchmark::initialize()
+{
+  ostore_.insert_prototype<album>("album");
+  ostore_.insert_prototype<track>("track");
+  ostore_.insert_prototype<chart>("chart");
+  ostore_.insert_prototype<sensor>("sensor");
+  ostore_.insert_prototype(new vector_object_producer<int_vector>("int_vector"), "item_int_vector");
+  filled_ = false;
+}
+
+void ContainerBenchmark::finalize()
+{
+  chart_.reset();
+  sensor_.reset();
+  int_vector_.reset();
+  ostore_.clear(true);
+}
+
+void ContainerBenchmark::create_chart()
+{
+  chart_.reset();
+  ostore_.clear();
+  filled_ = false;
+  chart_ = ostore_.insert(new chart("chart"));
+}
+
+void ContainerBenchmark::create_containers()
+{
+  sensor_.reset();
+  int_vector_.reset();
+  ostore_.clear();
+  filled_ = false;
+  sensor_ = ostore_.insert(new sensor("sensor"));
+  int_vector_ = ostore_.insert(new int_vector("int_vector"));
+}
+
+void ContainerBenchmark::fill_containers_once()
+{
+  if (!filled_) {
+    create_containers();
+    value_vector_insert();
+    item_vector_insert();
+    filled_ = true;
+  }
+}
+
+void ContainerBenchmark::front_insert()
+{
+  for (std::size_t i = 0; i < track_count; ++i) {
+    std::stringstream title;
+    title << "track " << i;
+    chart_->insert(chart_->begin(), ostore_.insert(new track(title.str())));
+  }
+}
+
+void ContainerBenchmark::value_vector_insert()
+{
+  sensor::sample_vector_t &samples = sensor_->samples();
+  for (std::size_t i = 0; i < element_count; ++i) {
+    samples.push_back((int)i);
+  }
+}
+
+void ContainerBenchmark::item_vector_insert()
+{
+  for (std::size_t i = 0; i < element_count; ++i) {
+    int_vector_->push_back((int)i);
+  }
+}
+
+void ContainerBenchmark::value_vector_iterate()
+{
+  const sensor::sample_vector_t &samples = sensor_->samples();
+  long long sum = 0;
+  for (sensor::sample_vector_t::const_iterator i = samples.begin(); i != samples.end(); ++i) {
+    sum += *i;
+  }
+  sink_ = sum;
+}
+
+void ContainerBenchmark::item_vector_iterate()
+{
+  long long sum = 0;
+  for (int_vector::iterator i = int_vector_->begin(); i != int_vector_->end(); ++i) {
+    sum += (*i)->value();
+  }
+  sink_ = sum;
+}
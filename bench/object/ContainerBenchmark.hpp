@@ -0,0 +1,47 @@
+#ifndef CONTAINERBENCHMARK_HPP
+#define CONTAINERBENCHMARK_HPP
+
+#include "unit/benchmark_unit.hpp"
+
+#include "object/object_store.hpp"
+#include "object/object_ptr.hpp"
+
+class chart;
+class sensor;
+
+template < class T > class Vector;
+
+class ContainerBenchmark : public oos::benchmark_unit
+{
+public:
+  typedef Vector<int> int_vector;
+  typedef oos::object_ptr<chart> chart_ptr;
+  typedef oos::object_ptr<sensor> sensor_ptr;
+  typedef oos::object_ptr<int_vector> int_vector_ptr;
+
+  ContainerBenchmark();
+  virtual ~ContainerBenchmark();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void create_chart();
+  void create_containers();
+  void fill_containers_once();
+
+  void front_insert();
+  void value_vector_insert();
+  void item_vector_insert();
+  void value_vector_iterate();
+  void item_vector_iterate();
+
+private:
+  oos::object_store ostore_;
+  chart_ptr chart_;
+  sensor_ptr sensor_;
+  int_vector_ptr int_vector_;
+  bool filled_;
+  long long sink_;
+};
+
+#endif /* CONTAINERBENCHMARK_HPP */
@@ -0,0 +1,154 @@
+#include "ObjectStoreBenchmark.hpp"
+
+#include "Item.hpp"
+
+#include "object/change_feed.hpp"
+
+#include "database/session.hpp"
+#include "database/transaction.hpp"
+
+using namespace oos;
+
+namespace {
+
+const std::size_t item_count = 10000;
+// large enough to keep all records of one run
+const std::size_t feed_capacity = 16 * 1024 * 1024;
+
+}
+
+ObjectStoreBenchmark::ObjectStoreBenchmark()
+  : benchmark_unit("object_store", "object store benchmark unit")
+  , sink_(0)
+{
+  add_benchmark("insert", std::bind(&ObjectStoreBenchmark::create_items, this), std::bind(&ObjectStoreBenchmark::insert, this), "insert items one by one", item_count);
+  add_benchmark("bulk_insert", std::bind(&ObjectStoreBenchmark::create_items, this), std::bind(&ObjectStoreBenchmark::bulk_insert, this), "insert items as one batch", item_count);
+  add_benchmark("remove", std::bind(&ObjectStoreBenchmark::insert_items, this), std::bind(&ObjectStoreBenchmark::remove, this), "remove items one by one", item_count);
+  add_benchmark("remove_range", std::bind(&ObjectStoreBenchmark::insert_items, this), std::bind(&ObjectStoreBenchmark::remove_range, this), "remove items as one batch", item_count);
+  add_benchmark("commit", std::bind(&ObjectStoreBenchmark::create_items, this), std::bind(&ObjectStoreBenchmark::commit, this), "insert items in a committed memory transaction", item_count);
+  add_benchmark("rollback", std::bind(&ObjectStoreBenchmark::create_items, this), std::bind(&ObjectStoreBenchmark::rollback, this), "insert items in a rolled back memory transaction", item_count);
+  add_benchmark("change_feed", std::bind(&ObjectStoreBenchmark::create_items_with_feed, this), std::bind(&ObjectStoreBenchmark::feed, this), "publish and poll a change feed record per inserted item", item_count);
+  add_benchmark("change_feed_image", std::bind(&ObjectStoreBenchmark::create_items_with_image_feed, this), std::bind(&ObjectStoreBenchmark::feed, this), "publish and poll a change feed record with object image per inserted item", item_count);
+}
+
+ObjectStoreBenchmark::~ObjectStoreBenchmark()
+{}
+
+void ObjectStoreBenchmark::initialize()
+{
+  ostore_.insert_prototype<Item>("item");
+}
+
+void ObjectStoreBenchmark::finalize()
+{
+  clear_items();
+  ostore_.clear(true);
+}
+
+void ObjectStoreBenchmark::create_items()
+{
+  clear_items();
+  for (std::size_t i = 0; i < item_count; ++i) {
+    items_.push_back(new Item("item", (int)i));
+  }
+}
+
+void ObjectStoreBenchmark::insert_items()
+{
+  clear_items();
+  for (std::size_t i = 0; i < item_count; ++i) {
+    item_ptrs_.push_back(ostore_.insert(new Item("item", (int)i)));
+  }
+}
+
+void ObjectStoreBenchmark::clear_items()
+{
+  feed_.reset();
+  item_ptrs_.clear();
+  // items not taken by the store
+  for (std::vector<Item*>::iterator i = items_.begin(); i != items_.end(); ++i) {
+    if ((*i)->id() == 0) {
+      delete *i;
+    }
+  }
+  items_.clear();
+  ostore_.clear();
+}
+
+void ObjectStoreBenchmark::create_items_with_feed()
+{
+  create_items();
+  feed_.reset(new change_feed(ostore_, feed_capacity));
+}
+
+void ObjectStoreBenchmark::create_items_with_image_feed()
+{
+  create_items();
+  feed_.reset(new change_feed(ostore_, feed_capacity, true));
+}
+
+void ObjectStoreBenchmark::insert()
+{
+  for (std::vector<Item*>::iterator i = items_.begin(); i != items_.end(); ++i) {
+    ostore_.insert(*i);
+  }
+}
+
+void ObjectStoreBenchmark::bulk_insert()
+{
+  ostore_.insert(items_.begin(), items_.end());
+}
+
+void ObjectStoreBenchmark::remove()
+{
+  for (std::vector<item_ptr>::iterator i = item_ptrs_.begin(); i != item_ptrs_.end(); ++i) {
+    ostore_.remove(*i);
+  }
+}
+
+void ObjectStoreBenchmark::remove_range()
+{
+  ostore_.remove(item_ptrs_.begin(), item_ptrs_.end());
+}
+
+void ObjectStoreBenchmark::commit()
+{
+  session s(ostore_);
+  s.open();
+  transaction tr(s);
+  tr.begin();
+  for (std::vector<Item*>::iterator i = items_.begin(); i != items_.end(); ++i) {
+    ostore_.insert(*i);
+  }
+  tr.commit();
+  s.close();
+}
+
+void ObjectStoreBenchmark::rollback()
+{
+  session s(ostore_);
+  s.open();
+  transaction tr(s);
+  tr.begin();
+  for (std::vector<Item*>::iterator i = items_.begin(); i != items_.end(); ++i) {
+    ostore_.insert(*i);
+  }
+  tr.rollback();
+  s.close();
+  // the rollback deleted the items
+  items_.clear();
+}
+
+void ObjectStoreBenchmark::feed()
+{
+  change_feed::cursor c = feed_->current();
+  for (std::vector<Item*>::iterator i = items_.begin(); i != items_.end(); ++i) {
+    ostore_.insert(*i);
+  }
+  change_feed::record r;
+  long long records = 0;
+  while (feed_->poll(c, r) == change_feed::POLL_RECORD) {
+    ++records;
+  }
+  sink_ = records;
+}
@@ -0,0 +1,51 @@
+#ifndef OBJECTSTOREBENCHMARK_HPP
+#define OBJECTSTOREBENCHMARK_HPP
+
+#include "unit/benchmark_unit.hpp"
+
+#include "object/object_store.hpp"
+#include "object/object_ptr.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace oos {
+class change_feed;
+}
+
+class Item;
+
+class ObjectStoreBenchmark : public oos::benchmark_unit
+{
+public:
+  typedef oos::object_ptr<Item> item_ptr;
+
+  ObjectStoreBenchmark();
+  virtual ~ObjectStoreBenchmark();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void create_items();
+  void insert_items();
+  void clear_items();
+  void create_items_with_feed();
+  void create_items_with_image_feed();
+
+  void insert();
+  void bulk_insert();
+  void remove();
+  void remove_range();
+  void commit();
+  void rollback();
+  void feed();
+
+private:
+  oos::object_store ostore_;
+  std::vector<Item*> items_;
+  std::vector<item_ptr> item_ptrs_;
+  std::unique_ptr<oos::change_feed> feed_;
+  long long sink_;
+};
+
+#endif /* OBJECTSTOREBENCHMARK_HPP */
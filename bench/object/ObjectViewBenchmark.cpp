@@ -0,0 +1,160 @@
+#include "ObjectViewBenchmark.hpp"
+
+#include "Item.hpp"
+
+#include "object/object_view.hpp"
+#include "object/object_expression.hpp"
+#include "object/static_expression.hpp"
+#include "object/parallel_algorithm.hpp"
+#include "object/generic_access.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <sstream>
+
+using namespace oos;
+
+namespace {
+
+const std::size_t item_count = 100000;
+// total threads of the scaling pools, the caller included
+const std::size_t pool_threads[] = { 1, 2, 4, 8 };
+const std::size_t pool_count = sizeof(pool_threads) / sizeof(pool_threads[0]);
+
+}
+
+ObjectViewBenchmark::ObjectViewBenchmark()
+  : benchmark_unit("object_view", "object view benchmark unit")
+  , sink_(0)
+{
+  add_benchmark("iterate", std::bind(&ObjectViewBenchmark::iterate, this), "iterate a view", item_count);
+  add_benchmark("count_if", std::bind(&ObjectViewBenchmark::count_if, this), "count with an object expression", item_count);
+  add_benchmark("static_count_if", std::bind(&ObjectViewBenchmark::static_count_if, this), "count with a static expression", item_count);
+  add_benchmark("parallel_count_if", std::bind(&ObjectViewBenchmark::parallel_count_if, this), "count with a static expression in parallel", item_count);
+  add_benchmark("parallel_for_each", std::bind(&ObjectViewBenchmark::parallel_for_each, this), "sum a view in parallel", item_count);
+  add_benchmark("pk_lookup", std::bind(&ObjectViewBenchmark::pk_lookup, this), "find proxies by integral primary key", item_count);
+  add_benchmark("field_access", std::bind(&ObjectViewBenchmark::field_access, this), "get a value through the field table", item_count);
+  add_benchmark("field_access_by_name", std::bind(&ObjectViewBenchmark::field_access_by_name, this), "get a value by name", item_count);
+  for (std::size_t i = 0; i < pool_count; ++i) {
+    std::stringstream threads;
+    threads << pool_threads[i];
+    add_benchmark("count_if_threads_" + threads.str(), std::bind(&ObjectViewBenchmark::scaled_count_if, this, i), "count in parallel with " + threads.str() + " threads", item_count);
+    add_benchmark("transform_reduce_threads_" + threads.str(), std::bind(&ObjectViewBenchmark::scaled_transform_reduce, this, i), "sum a view in parallel with " + threads.str() + " threads", item_count);
+  }
+}
+
+ObjectViewBenchmark::~ObjectViewBenchmark()
+{}
+
+void ObjectViewBenchmark::initialize()
+{
+  ostore_.insert_prototype<Item>("item");
+  ids_.clear();
+  for (std::size_t i = 0; i < item_count; ++i) {
+    ids_.push_back((long long)ostore_.insert(new Item("item", (int)i))->id());
+  }
+  // look the keys up in random order
+  std::random_shuffle(ids_.begin(), ids_.end());
+  pools_.clear();
+  for (std::size_t i = 0; i < pool_count; ++i) {
+    pools_.emplace_back(new thread_pool(pool_threads[i] - 1));
+  }
+}
+
+void ObjectViewBenchmark::finalize()
+{
+  pools_.clear();
+  ostore_.clear(true);
+}
+
+void ObjectViewBenchmark::iterate()
+{
+  object_view<Item> view(ostore_);
+  long long sum = 0;
+  for (object_view<Item>::const_iterator i = view.begin(); i != view.end(); ++i) {
+    sum += (*i)->get_int();
+  }
+  sink_ = sum;
+}
+
+void ObjectViewBenchmark::count_if()
+{
+  object_view<Item> view(ostore_);
+  variable<int> x(make_var(&Item::get_int));
+  sink_ = (long long)std::count_if(view.begin(), view.end(), x >= 25000 && x < 75000);
+}
+
+void ObjectViewBenchmark::static_count_if()
+{
+  object_view<Item> view(ostore_);
+  auto x = make_static_var(&Item::get_int);
+  sink_ = (long long)std::count_if(view.begin(), view.end(), x >= 25000 && x < 75000);
+}
+
+void ObjectViewBenchmark::parallel_count_if()
+{
+  object_view<Item> view(ostore_);
+  auto x = make_static_var(&Item::get_int);
+  sink_ = (long long)oos::parallel_count_if(view, x >= 25000 && x < 75000);
+}
+
+void ObjectViewBenchmark::parallel_for_each()
+{
+  object_view<Item> view(ostore_);
+  std::atomic<long long> sum(0);
+  oos::parallel_for_each(view, [&](const Item &item) {
+    sum.fetch_add(item.get_int(), std::memory_order_relaxed);
+  });
+  sink_ = sum.load();
+}
+
+void ObjectViewBenchmark::scaled_count_if(std::size_t pool)
+{
+  object_view<Item> view(ostore_);
+  auto x = make_static_var(&Item::get_int);
+  sink_ = (long long)oos::parallel_count_if(view, x >= 25000 && x < 75000, *pools_[pool]);
+}
+
+void ObjectViewBenchmark::scaled_transform_reduce(std::size_t pool)
+{
+  object_view<Item> view(ostore_);
+  sink_ = oos::parallel_transform_reduce(view, 0LL, std::plus<long long>(), [](const Item &item) {
+    return (long long)item.get_int();
+  }, *pools_[pool]);
+}
+
+void ObjectViewBenchmark::pk_lookup()
+{
+  prototype_iterator node = ostore_.find_prototype<Item>();
+  long long found = 0;
+  for (std::vector<long long>::const_iterator i = ids_.begin(); i != ids_.end(); ++i) {
+    found += node->find_proxy(*i) != nullptr;
+  }
+  sink_ = found;
+}
+
+void ObjectViewBenchmark::field_access()
+{
+  object_view<Item> view(ostore_);
+  const field_descriptor *field = ostore_.find_prototype<Item>()->fields.find("val_int");
+  long long sum = 0;
+  int val = 0;
+  for (object_view<Item>::const_iterator i = view.begin(); i != view.end(); ++i) {
+    oos::get(*i, *field, val);
+    sum += val;
+  }
+  sink_ = sum;
+}
+
+void ObjectViewBenchmark::field_access_by_name()
+{
+  object_view<Item> view(ostore_);
+  long long sum = 0;
+  int val = 0;
+  for (object_view<Item>::const_iterator i = view.begin(); i != view.end(); ++i) {
+    oos::get(*i, "val_int", val);
+    sum += val;
+  }
+  sink_ = sum;
+}
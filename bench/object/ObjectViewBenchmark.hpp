@@ -0,0 +1,42 @@
+#ifndef OBJECTVIEWBENCHMARK_HPP
+#define OBJECTVIEWBENCHMARK_HPP
+
+#include "unit/benchmark_unit.hpp"
+
+#include "object/object_store.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace oos {
+class thread_pool;
+}
+
+class ObjectViewBenchmark : public oos::benchmark_unit
+{
+public:
+  ObjectViewBenchmark();
+  virtual ~ObjectViewBenchmark();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void iterate();
+  void count_if();
+  void static_count_if();
+  void parallel_count_if();
+  void parallel_for_each();
+  void scaled_count_if(std::size_t pool);
+  void scaled_transform_reduce(std::size_t pool);
+  void pk_lookup();
+  void field_access();
+  void field_access_by_name();
+
+private:
+  oos::object_store ostore_;
+  std::vector<long long> ids_;
+  std::vector<std::unique_ptr<oos::thread_pool> > pools_;
+  long long sink_;
+};
+
+#endif /* OBJECTVIEWBENCHMARK_HPP */
@@ -0,0 +1,165 @@
+#include "ToolsBenchmark.hpp"
+
+#include "tools/iso8601.hpp"
+#include "tools/string.hpp"
+
+#include <algorithm>
+
+using namespace oos;
+
+namespace {
+
+const std::size_t item_count = 100000;
+const std::size_t blob_size = 16 * 1024 * 1024;
+const std::size_t blob_chunk_size = 64 * 1024;
+const char *generic_format = "%d.%m.%Y %H:%M:%S";
+
+}
+
+ToolsBenchmark::ToolsBenchmark()
+  : benchmark_unit("tools", "tools benchmark unit")
+  , sink_(0)
+{
+  add_benchmark("time_sort", std::bind(&ToolsBenchmark::copy_times, this), std::bind(&ToolsBenchmark::time_sort, this), "sort time values", item_count);
+  add_benchmark("utc_time_sort", std::bind(&ToolsBenchmark::copy_utc_times, this), std::bind(&ToolsBenchmark::utc_time_sort, this), "sort utc_time values", item_count);
+  add_benchmark("format_iso8601", std::bind(&ToolsBenchmark::format_iso8601, this), "format times with the ISO8601 path", item_count);
+  add_benchmark("format_generic", std::bind(&ToolsBenchmark::format_generic, this), "format times with a strftime format", item_count);
+  add_benchmark("parse_iso8601", std::bind(&ToolsBenchmark::parse_iso8601, this), "parse times with the ISO8601 path", item_count);
+  add_benchmark("parse_generic", std::bind(&ToolsBenchmark::parse_generic, this), "parse times with a strptime format", item_count);
+  add_benchmark("varchar_copy", std::bind(&ToolsBenchmark::varchar_copy, this), "copy a vector of varchar<255>", item_count);
+  add_benchmark("string_copy", std::bind(&ToolsBenchmark::string_copy, this), "copy a vector of std::string", item_count);
+  add_benchmark("blob_read", std::bind(&ToolsBenchmark::blob_read, this), "read a 16MB blob in 64KB chunks", blob_size);
+}
+
+ToolsBenchmark::~ToolsBenchmark()
+{}
+
+void ToolsBenchmark::initialize()
+{
+  utc_time start(2015, 1, 1);
+  for (std::size_t i = 0; i < item_count; ++i) {
+    // daytime values only, a local time inside
+    // a daylight saving gap isn't valid
+    utc_time t(start);
+    t.add_days((int)(i / 12));
+    t += (((8 + (long long)(i % 12)) * 60 + (long long)(i * 7 % 60)) * 60 + (long long)(i * 13 % 60)) * 1000000LL;
+    oos::time ot(t.year(), t.month(), t.day(), t.hour(), t.minute(), t.second());
+    times_.push_back(ot);
+    utc_times_.push_back(t);
+    iso_strings_.push_back(to_string(ot));
+    generic_strings_.push_back(to_string(ot, generic_format));
+    strings_.push_back(std::string("item name number ") + std::to_string(i));
+    varchars_.push_back(varchar<255>(strings_.back()));
+  }
+  std::random_shuffle(times_.begin(), times_.end());
+  std::random_shuffle(utc_times_.begin(), utc_times_.end());
+
+  std::vector<char> data(blob_size);
+  for (std::size_t i = 0; i < blob_size; ++i) {
+    data[i] = (char)(i % 251);
+  }
+  blob_.assign(&data.front(), data.size());
+
+  metric("sizeof_time", (double)sizeof(oos::time));
+  metric("sizeof_utc_time", (double)sizeof(utc_time));
+  metric("sizeof_varchar_255", (double)sizeof(varchar<255>));
+  metric("sizeof_string", (double)sizeof(std::string));
+}
+
+void ToolsBenchmark::finalize()
+{
+  times_.clear();
+  utc_times_.clear();
+  time_work_.clear();
+  utc_time_work_.clear();
+  iso_strings_.clear();
+  generic_strings_.clear();
+  varchars_.clear();
+  strings_.clear();
+  blob_.clear();
+}
+
+void ToolsBenchmark::copy_times()
+{
+  time_work_ = times_;
+}
+
+void ToolsBenchmark::copy_utc_times()
+{
+  utc_time_work_ = utc_times_;
+}
+
+void ToolsBenchmark::time_sort()
+{
+  std::sort(time_work_.begin(), time_work_.end());
+  sink_ = time_work_.size();
+}
+
+void ToolsBenchmark::utc_time_sort()
+{
+  std::sort(utc_time_work_.begin(), utc_time_work_.end());
+  sink_ = utc_time_work_.size();
+}
+
+void ToolsBenchmark::format_iso8601()
+{
+  char buf[iso8601_time_size];
+  std::size_t len = 0;
+  for (std::vector<oos::time>::const_iterator i = times_.begin(); i != times_.end(); ++i) {
+    len += oos::format_iso8601(*i, buf, sizeof(buf));
+  }
+  sink_ = len;
+}
+
+void ToolsBenchmark::format_generic()
+{
+  std::size_t len = 0;
+  for (std::vector<oos::time>::const_iterator i = times_.begin(); i != times_.end(); ++i) {
+    len += to_string(*i, generic_format).size();
+  }
+  sink_ = len;
+}
+
+void ToolsBenchmark::parse_iso8601()
+{
+  oos::time t;
+  std::size_t parsed = 0;
+  for (std::vector<std::string>::const_iterator i = iso_strings_.begin(); i != iso_strings_.end(); ++i) {
+    parsed += oos::parse_iso8601(i->c_str(), i->size(), t);
+  }
+  sink_ = parsed;
+}
+
+void ToolsBenchmark::parse_generic()
+{
+  std::size_t parsed = 0;
+  for (std::vector<std::string>::const_iterator i = generic_strings_.begin(); i != generic_strings_.end(); ++i) {
+    parsed += oos::time::parse(*i, generic_format).year() > 0;
+  }
+  sink_ = parsed;
+}
+
+void ToolsBenchmark::varchar_copy()
+{
+  std::vector<varchar<255> > copy(varchars_);
+  sink_ = copy.size();
+}
+
+void ToolsBenchmark::string_copy()
+{
+  std::vector<std::string> copy(strings_);
+  sink_ = copy.size();
+}
+
+void ToolsBenchmark::blob_read()
+{
+  std::vector<char> buf(blob_chunk_size);
+  std::size_t total = 0;
+  blob::size_type offset = 0;
+  blob::size_type n = 0;
+  while ((n = blob_.read(offset, &buf.front(), buf.size())) > 0) {
+    offset += n;
+    total += (unsigned char)buf[n - 1];
+  }
+  sink_ = total + offset;
+}
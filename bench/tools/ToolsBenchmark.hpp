@@ -0,0 +1,49 @@
+#ifndef TOOLSBENCHMARK_HPP
+#define TOOLSBENCHMARK_HPP
+
+#include "unit/benchmark_unit.hpp"
+
+#include "tools/time.hpp"
+#include "tools/utc_time.hpp"
+#include "tools/varchar.hpp"
+#include "tools/blob.hpp"
+
+#include <string>
+#include <vector>
+
+class ToolsBenchmark : public oos::benchmark_unit
+{
+public:
+  ToolsBenchmark();
+  virtual ~ToolsBenchmark();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void copy_times();
+  void copy_utc_times();
+
+  void time_sort();
+  void utc_time_sort();
+  void format_iso8601();
+  void format_generic();
+  void parse_iso8601();
+  void parse_generic();
+  void varchar_copy();
+  void string_copy();
+  void blob_read();
+
+private:
+  std::vector<oos::time> times_;
+  std::vector<oos::utc_time> utc_times_;
+  std::vector<oos::time> time_work_;
+  std::vector<oos::utc_time> utc_time_work_;
+  std::vector<std::string> iso_strings_;
+  std::vector<std::string> generic_strings_;
+  std::vector<oos::varchar<255> > varchars_;
+  std::vector<std::string> strings_;
+  oos::blob blob_;
+  std::size_t sink_;
+};
+
+#endif /* TOOLSBENCHMARK_HPP */
@@ -77,6 +77,7 @@ protected:
   virtual void read(const char *id, std::string &x);
   virtual void read(const char *id, oos::date &x);
   virtual void read(const char *id, oos::time &x);
+  virtual void read(const char *id, oos::blob &x);
   virtual void read(const char *id, object_base_ptr &x);
   virtual void read(const char *id, object_container &x);
   virtual void read(const char *id, basic_identifier &x);
@@ -98,6 +99,7 @@ protected:
   void read_column(const char *, varchar_base &val);
   void read_column(const char *, oos::date &val);
   void read_column(const char *, oos::time &val);
+  void read_column(const char *, oos::blob &val);
 
 private:
   size_type affected_rows_;
@@ -80,6 +80,7 @@ protected:
   virtual void write(const char *id, const std::string &x);
   virtual void write(const char *id, const oos::date &x);
   virtual void write(const char *id, const oos::time &x);
+  virtual void write(const char *id, const oos::blob &x);
 	virtual void write(const char *id, const object_base_ptr &x);
   virtual void write(const char *id, const object_container &x);
   virtual void write(const char *id, const basic_identifier &x);
@@ -99,6 +100,7 @@ protected:
   }
   void bind_value(const oos::date &d, int index);
   void bind_value(const oos::time &t, int index);
+  void bind_value(const oos::blob &b, int index);
   void bind_value(unsigned long val, int index);
   void bind_value(const char *val, size_t size, int index);
 
@@ -218,6 +218,8 @@ const char* mssql_database::type_string(data_type_t type) const
       return "VARCHAR";
     case type_text:
       return "TEXT";
+    case type_blob:
+      return "VARBINARY(MAX)";
     case type_date:
       return "DATE";
     case type_time:
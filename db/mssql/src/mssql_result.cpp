@@ -20,6 +20,7 @@
 #include "tools/varchar.hpp"
 #include "tools/date.hpp"
 #include "tools/time.hpp"
+#include "tools/blob.hpp"
 
 #include <cstring>
 
@@ -184,6 +185,11 @@ void mssql_result::read(const char *id, oos::time &x)
   read_column(id, x);
 }
 
+void mssql_result::read(const char *id, oos::blob &x)
+{
+  read_column(id, x);
+}
+
 void mssql_result::read(const char *id, object_base_ptr &x)
 {
   read_foreign_object(id, x);
@@ -225,6 +231,29 @@ void mssql_result::read_column(const char *, std::string &val)
   }
 }
 
+void mssql_result::read_column(const char *, oos::blob &val)
+{
+  val.clear();
+  // fetch the column chunk by chunk until there is no more data
+  char chunk[64 * 1024];
+  SQLUSMALLINT index = static_cast<SQLUSMALLINT>(result_index++);
+  while (true) {
+    SQLLEN info = 0;
+    SQLRETURN ret = SQLGetData(stmt_, index, SQL_C_BINARY, chunk, sizeof(chunk), &info);
+    if (ret == SQL_NO_DATA || info == SQL_NULL_DATA) {
+      break;
+    } else if (ret == SQL_SUCCESS_WITH_INFO) {
+      // the chunk is full, info holds the remaining size or SQL_NO_TOTAL
+      val.append(chunk, sizeof(chunk));
+    } else if (ret == SQL_SUCCESS) {
+      val.append(chunk, static_cast<size_t>(info));
+      break;
+    } else {
+      throw_error(ret, SQL_HANDLE_STMT, stmt_, "mssql", "error on retrieving field value");
+    }
+  }
+}
+
 void mssql_result::read_column(const char *, varchar_base &val)
 {
   char *buf = new char[val.capacity()];
@@ -24,6 +24,7 @@
 #include "tools/varchar.hpp"
 #include "tools/date.hpp"
 #include "tools/time.hpp"
+#include "tools/blob.hpp"
 
 #include <cstring>
 #include <sstream>
@@ -70,6 +71,26 @@ detail::result_impl* mssql_statement::execute()
 {
   SQLRETURN ret = SQLExecute(stmt_);
 
+  // send the blobs bound at execution chunk by chunk
+  while (ret == SQL_NEED_DATA) {
+    SQLPOINTER token = 0;
+    ret = SQLParamData(stmt_, &token);
+    if (ret == SQL_NEED_DATA) {
+      const oos::blob *x = static_cast<const oos::blob*>(token);
+      char chunk[64 * 1024];
+      oos::blob::size_type offset = 0, len = 0;
+      while ((len = x->read(offset, chunk, sizeof(chunk))) > 0) {
+        SQLRETURN pret = SQLPutData(stmt_, chunk, (SQLLEN)len);
+        throw_error(pret, SQL_HANDLE_STMT, stmt_, str(), "error on sending blob data");
+        offset += len;
+      }
+      if (offset == 0) {
+        SQLRETURN pret = SQLPutData(stmt_, chunk, 0);
+        throw_error(pret, SQL_HANDLE_STMT, stmt_, str(), "error on sending blob data");
+      }
+    }
+  }
+
   // check result
   throw_error(ret, SQL_HANDLE_STMT, stmt_, str(), "error on query execute");
 
@@ -151,6 +172,11 @@ void mssql_statement::write(const char *, const oos::time &x)
   bind_value(x, ++host_index);
 }
 
+void mssql_statement::write(const char *, const oos::blob &x)
+{
+  bind_value(x, ++host_index);
+}
+
 void mssql_statement::write(const char *, const varchar_base &x)
 {
   bind_value(x.c_str(), x.size() + 1, ++host_index);
@@ -208,6 +234,18 @@ void mssql_statement::bind_value(const oos::time &t, int index)
   host_data_.push_back(v.release());
 }
 
+void mssql_statement::bind_value(const oos::blob &b, int index)
+{
+  // the data is sent on execution, the
+  // blob itself is the parameter token
+  value_t *v = new value_t(false, SQL_LEN_DATA_AT_EXEC((SQLLEN)b.size()));
+
+  host_data_.push_back(v);
+
+  SQLRETURN ret = SQLBindParameter(stmt_, (SQLUSMALLINT)index, SQL_PARAM_INPUT, SQL_C_BINARY, SQL_LONGVARBINARY, b.size(), 0, (SQLPOINTER)&b, 0, &v->len);
+  throw_error(ret, SQL_HANDLE_STMT, stmt_, "mssql", "couldn't bind parameter");
+}
+
 void mssql_statement::bind_value(unsigned long val, int index)
 {
   value_t *v = new value_t(true, SQL_NTS);
@@ -284,6 +322,8 @@ int mssql_statement::type2int(data_type_t type)
       return SQL_C_DATE;
     case type_time:
       return SQL_C_TIMESTAMP;
+    case type_blob:
+      return SQL_C_BINARY;
     default:
       {
         throw std::logic_error("mssql statement: unknown type");
@@ -326,6 +366,8 @@ int mssql_statement::type2sql(data_type_t type)
       return SQL_DATE;
     case type_time:
       return SQL_DATETIME;
+    case type_blob:
+      return SQL_LONGVARBINARY;
     default:
       {
         throw std::logic_error("mssql statement: unknown type");
@@ -46,6 +46,7 @@ public:
 
   size_type affected_rows() const;
   size_type result_rows() const;
+  virtual bool result_rows_known() const;
   size_type fields() const;
 
   virtual int transform_index(int index) const;
@@ -64,6 +65,7 @@ public:
   virtual void read(const char *id, char *x, size_t s);
   virtual void read(const char *id, oos::date &x);
   virtual void read(const char *id, oos::time &x);
+  virtual void read(const char *id, oos::blob &x);
   virtual void read(const char *id, std::string &x);
   virtual void read(const char *id, varchar_base &x);
   virtual void read(const char *id, object_base_ptr &x);
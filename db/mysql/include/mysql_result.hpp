@@ -56,6 +56,7 @@ public:
 
   size_type affected_rows() const;
   size_type result_rows() const;
+  virtual bool result_rows_known() const;
   size_type fields() const;
 
   virtual int transform_index(int index) const;
@@ -77,6 +78,7 @@ protected:
   virtual void read(const char *id, std::string &x);
   virtual void read(const char *id, oos::date &x);
   virtual void read(const char *id, oos::time &x);
+  virtual void read(const char *id, oos::blob &x);
   virtual void read(const char *id, object_base_ptr &x);
   virtual void read(const char *id, object_container &x);
   virtual void read(const char *id, basic_identifier &x);
@@ -30,6 +30,7 @@
 #endif
 
 #include <string>
+#include <utility>
 #include <vector>
 #include <type_traits>
 
@@ -68,6 +69,7 @@ protected:
   virtual void write(const char *id, const std::string &x);
   virtual void write(const char *id, const oos::date &x);
   virtual void write(const char *id, const oos::time &x);
+  virtual void write(const char *id, const oos::blob &x);
   virtual void write(const char *id, const object_base_ptr &x);
   virtual void write(const char *id, const object_container &x);
   virtual void write(const char *id, const basic_identifier &x);
@@ -97,6 +99,8 @@ private:
   int result_size;
   int host_size;
   std::vector<unsigned long> length_vector;
+  // the blobs sent as long data on execution
+  std::vector<std::pair<unsigned int, const oos::blob*> > long_data_;
   MYSQL_STMT *stmt_ = nullptr;
   MYSQL_BIND *host_array = nullptr;
 
@@ -23,6 +23,7 @@
 namespace oos {
 
 class varchar_base;
+class blob;
 class object_base_ptr;
 
 namespace mysql {
@@ -44,6 +45,7 @@ template <> struct type_traits<double> { inline static const char* type_string()
 template <> struct type_traits<varchar_base> { inline static const char* type_string() { return "VARCHAR"; } };
 template <> struct type_traits<const char*> { inline static const char* type_string() { return "VARCHAR"; } };
 template <> struct type_traits<std::string> { inline static const char* type_string() { return "TEXT"; } };
+template <> struct type_traits<oos::blob> { inline static const char* type_string() { return "LONGBLOB"; } };
 template <> struct type_traits<object_base_ptr> { inline static const char* type_string() { return "INTEGER"; } };
 
 class mysql_types
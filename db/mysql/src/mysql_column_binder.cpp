@@ -3,6 +3,7 @@
 #include "tools/date.hpp"
 #include "tools/time.hpp"
 #include "tools/varchar.hpp"
+#include "tools/blob.hpp"
 
 #include "object/object_ptr.hpp"
 
@@ -115,6 +116,11 @@ void mysql_column_binder::read(const char *, oos::time &x)
 #endif
 }
 
+void mysql_column_binder::read(const char *, oos::blob &x)
+{
+  prepare_bind_column(column_index_++, MYSQL_TYPE_BLOB, x);
+}
+
 void mysql_column_binder::read(const char *, varchar_base &x)
 {
   prepare_bind_column(column_index_++, MYSQL_TYPE_VAR_STRING, x);
@@ -180,6 +186,17 @@ void mysql_column_binder::prepare_bind_column(int index, enum_field_types type,
   bind_[index].error = &info_[index].error;
 }
 
+void mysql_column_binder::prepare_bind_column(int index, enum_field_types type, oos::blob & /*value*/)
+{
+  // the data is fetched in chunks while reading
+  bind_[index].buffer_type = type;
+  bind_[index].buffer = 0;
+  bind_[index].buffer_length = 0;
+  bind_[index].is_null = &info_[index].is_null;
+  bind_[index].length = &info_[index].length;
+  bind_[index].error = &info_[index].error;
+}
+
 void mysql_column_binder::prepare_bind_column(int index, enum_field_types type, char *x, size_t s)
 {
   bind_[index].buffer_type = type;
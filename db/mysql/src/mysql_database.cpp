@@ -179,6 +179,8 @@ const char* mysql_database::type_string(data_type_t type) const
       return "VARCHAR";
     case type_text:
       return "TEXT";
+    case type_blob:
+      return "LONGBLOB";
     default:
       {
         std::stringstream msg;
@@ -7,6 +7,7 @@
 #include "tools/date.hpp"
 #include "tools/time.hpp"
 #include "tools/varchar.hpp"
+#include "tools/blob.hpp"
 
 #include "object/serializable.hpp"
 #include "object/object_ptr.hpp"
@@ -89,7 +90,7 @@ bool mysql_prepared_result::fetch()
 
       return Row(&*row);
   */
-  return rows-- > 0;
+  return ret == 0 || ret == MYSQL_DATA_TRUNCATED;
 }
 
 bool mysql_prepared_result::fetch(serializable *o)
@@ -130,6 +131,12 @@ mysql_prepared_result::size_type mysql_prepared_result::result_rows() const
   return rows;
 }
 
+bool mysql_prepared_result::result_rows_known() const
+{
+  // the statement stores the result on execution
+  return true;
+}
+
 mysql_prepared_result::size_type mysql_prepared_result::fields() const
 {
   return fields_;
@@ -242,6 +249,39 @@ void mysql_prepared_result::read(const char */*id*/, std::string &x)
     }
     delete [] (char*)bind_[result_index].buffer;
     bind_[result_index].buffer = 0;
+  } else {
+    x.clear();
+  }
+  ++result_index;
+}
+
+void mysql_prepared_result::read(const char */*id*/, oos::blob &x)
+{
+  x.clear();
+  unsigned long size = info_[result_index].length;
+  if (size > 0) {
+    // fetch the column chunk by chunk
+    char chunk[64 * 1024];
+    unsigned long offset = 0;
+    unsigned long len = 0;
+    bind_[result_index].buffer = chunk;
+    bind_[result_index].buffer_length = sizeof(chunk);
+    bind_[result_index].length = &len;
+    while (offset < size) {
+      int ret = mysql_stmt_fetch_column(stmt, &bind_[result_index], result_index, offset);
+      if (ret != 0) {
+        bind_[result_index].buffer = 0;
+        bind_[result_index].buffer_length = 0;
+        bind_[result_index].length = &info_[result_index].length;
+        throw_stmt_error(ret, stmt, "mysql", "");
+      }
+      unsigned long n = size - offset < sizeof(chunk) ? size - offset : (unsigned long)sizeof(chunk);
+      x.append(chunk, n);
+      offset += n;
+    }
+    bind_[result_index].buffer = 0;
+    bind_[result_index].buffer_length = 0;
+    bind_[result_index].length = &info_[result_index].length;
   }
   ++result_index;
 }
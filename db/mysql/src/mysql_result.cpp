@@ -18,6 +18,7 @@
 #include "tools/varchar.hpp"
 #include "tools/date.hpp"
 #include "tools/time.hpp"
+#include "tools/blob.hpp"
 
 #include "object/identifier.hpp"
 #include "object/serializable.hpp"
@@ -64,12 +65,11 @@ const char* mysql_result::column(size_type c) const
 
 bool mysql_result::fetch()
 {
-  row_ = mysql_fetch_row(res_);
-  if (!row_) {
-    rows_ = 0;
+  if (!res_) {
     return false;
-  }    
-  return rows_-- > 0;
+  }
+  row_ = mysql_fetch_row(res_);
+  return row_ != 0;
 }
 
 bool mysql_result::fetch(serializable *obj)
@@ -95,6 +95,12 @@ mysql_result::size_type mysql_result::result_rows() const
   return rows_;
 }
 
+bool mysql_result::result_rows_known() const
+{
+  // the result is stored on execution
+  return true;
+}
+
 mysql_result::size_type mysql_result::fields() const
 {
   return fields_;
@@ -241,6 +247,14 @@ void mysql_result::read(const char */*id*/, varchar_base &x)
   x.assign(val);
 }
 
+void mysql_result::read(const char */*id*/, oos::blob &x)
+{
+  unsigned long *lengths = mysql_fetch_lengths(res_);
+  unsigned long len = lengths ? lengths[result_index] : 0;
+  char *val = row_[result_index++];
+  x.assign(val, val ? len : 0);
+}
+
 void mysql_result::read(const char */*id*/, std::string &x)
 {
   char *val = row_[result_index++];
@@ -26,6 +26,7 @@
 #include "tools/string.hpp"
 #include "tools/date.hpp"
 #include "tools/time.hpp"
+#include "tools/blob.hpp"
 
 #include <cstring>
 
@@ -65,6 +66,7 @@ mysql_statement::~mysql_statement()
 void mysql_statement::reset()
 {
   mysql_stmt_reset(stmt_);
+  long_data_.clear();
 }
 
 void mysql_statement::clear()
@@ -79,6 +81,7 @@ void mysql_statement::clear()
 
   result_size = 0;
   host_size = 0;
+  long_data_.clear();
   mysql_stmt_free_result(stmt_);
 }
 
@@ -90,6 +93,19 @@ detail::result_impl* mysql_statement::execute()
       throw_stmt_error(res, stmt_, "mysql", str());
     }
   }
+  // send the blobs chunk by chunk
+  char chunk[64 * 1024];
+  for (std::size_t i = 0; i < long_data_.size(); ++i) {
+    const oos::blob *x = long_data_[i].second;
+    oos::blob::size_type offset = 0, len = 0;
+    while ((len = x->read(offset, chunk, sizeof(chunk))) > 0) {
+      if (mysql_stmt_send_long_data(stmt_, long_data_[i].first, chunk, (unsigned long)len) != 0) {
+        throw_stmt_error(1, stmt_, "mysql", str());
+      }
+      offset += len;
+    }
+  }
+  long_data_.clear();
 //  std::cout << str() << '\n';
 
   int res = mysql_stmt_execute(stmt_);
@@ -201,6 +217,14 @@ void mysql_statement::write(const char *, const oos::time &x)
   ++host_index;
 }
 
+void mysql_statement::write(const char *, const oos::blob &x)
+{
+  // the data is sent as long data on execution
+  bind_value(host_array[host_index], MYSQL_TYPE_LONG_BLOB, host_index);
+  long_data_.push_back(std::make_pair((unsigned int)host_index, &x));
+  ++host_index;
+}
+
 void mysql_statement::write(const char *, const varchar_base &x)
 {
   bind_value(host_array[host_index], MYSQL_TYPE_VAR_STRING, x.c_str(), x.size(), host_index);
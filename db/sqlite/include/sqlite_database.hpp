@@ -33,6 +33,8 @@
 #include "database/result_impl.hpp"
 #include "database/database.hpp"
 
+#include <memory>
+
 struct sqlite3;
 
 namespace oos {
@@ -74,6 +76,15 @@ public:
    */
   sqlite3* operator()();
 
+  /**
+   * Returns a weak reference to the open
+   * connection. It expires when the database
+   * is closed.
+   *
+   * @return The weak reference to the connection.
+   */
+  std::weak_ptr<sqlite3> connection() const;
+
   virtual const char* type_string(data_type_t type) const override;
 
 protected:
@@ -90,6 +101,8 @@ private:
 
 private:
   sqlite3 *sqlite_db_;
+  // shares the connection with lazy blobs, reset on close
+  std::shared_ptr<sqlite3> connection_;
 };
 
 }
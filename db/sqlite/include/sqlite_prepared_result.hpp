@@ -5,14 +5,36 @@
 
 #include "object/serializable.hpp"
 
+#include <memory>
+#include <string>
 #include <vector>
 
+struct sqlite3;
 struct sqlite3_stmt;
 
 namespace oos {
 
 namespace sqlite {
 
+/*
+ * The result columns of a prepared statement
+ * whose large blobs are read lazy. They are
+ * resolved once per statement on the first
+ * large blob.
+ */
+struct lazy_blob_columns
+{
+  void resolve(sqlite3_stmt *stmt);
+
+  bool resolved = false;
+  // the result column holding the rowid, -1 if there is none
+  int rowid_column = -1;
+  std::string rowid_table;
+  // the origin column of each result column of the
+  // rowid table, empty for all other columns
+  std::vector<std::string> columns;
+};
+
 class sqlite_prepared_result : public oos::detail::result_impl
 {
 private:
@@ -23,7 +45,7 @@ public:
   typedef oos::detail::result_impl::size_type size_type;
 
 public:
-  sqlite_prepared_result(sqlite3_stmt *stmt, int rs, std::shared_ptr<oos::object_base_producer> producer);
+  sqlite_prepared_result(sqlite3_stmt *stmt, int rs, const std::weak_ptr<sqlite3> &db, lazy_blob_columns *blob_columns, std::shared_ptr<oos::object_base_producer> producer);
   ~sqlite_prepared_result();
 
   virtual const char *column(size_type c) const override;
@@ -31,6 +53,7 @@ public:
   virtual bool fetch(serializable *) override;
   size_type affected_rows() const override;
   size_type result_rows() const override;
+  virtual bool empty() const override;
   size_type fields() const override;
 
   virtual int transform_index(int index) const override;
@@ -52,17 +75,24 @@ protected:
   virtual void read(const char *id, std::string &x) override;
   virtual void read(const char *id, oos::date &x) override;
   virtual void read(const char *id, oos::time &x) override;
+  virtual void read(const char *id, oos::blob &x) override;
   virtual void read(const char *id, object_base_ptr &x);
   virtual void read(const char *id, object_container &x);
   virtual void read(const char *id, basic_identifier &x);
 
 private:
+  // blobs of this size or larger are loaded lazy
+  static const int lazy_blob_size = 64 * 1024;
+
   int ret_;
   bool first_;
+  bool empty_;
   size_type affected_rows_;
   size_type rows;
   size_type fields_;
   sqlite3_stmt *stmt_;
+  std::weak_ptr<sqlite3> db_;
+  lazy_blob_columns *blob_columns_;
 };
 
 }
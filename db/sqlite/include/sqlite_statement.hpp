@@ -20,6 +20,8 @@
 
 #include "database/statement_impl.hpp"
 
+#include "sqlite_prepared_result.hpp"
+
 #include <string>
 #include <vector>
 #include <memory>
@@ -62,6 +64,7 @@ protected:
   virtual void write(const char *id, const std::string &x);
   virtual void write(const char *id, const oos::date &x);
   virtual void write(const char *id, const oos::time &x);
+  virtual void write(const char *id, const oos::blob &x);
   virtual void write(const char *id, const object_base_ptr &x);
   virtual void write(const char *id, const object_container &x);
   virtual void write(const char *id, const basic_identifier &x);
@@ -70,7 +73,9 @@ private:
   sqlite_database &db_;
   sqlite3_stmt *stmt_;
 
-  std::vector<std::shared_ptr<std::string> > host_strings_;
+  // resolved on the first large blob of a result
+  lazy_blob_columns blob_columns_;
+
   std::shared_ptr<oos::object_base_producer> producer_;
 };
 
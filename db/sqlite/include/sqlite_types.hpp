@@ -46,6 +46,7 @@ template <> struct type_traits<const char*> { inline static const char* type_str
 template <> struct type_traits<std::string> { inline static const char* type_string() { return "TEXT"; } };
 template <> struct type_traits<oos::date> { inline static const char* type_string() { return "INTEGER"; } };
 template <> struct type_traits<oos::time> { inline static const char* type_string() { return "TEXT"; } };
+template <> struct type_traits<oos::blob> { inline static const char* type_string() { return "BLOB"; } };
 template <> struct type_traits<object_base_ptr> { inline static const char* type_string() { return "INTEGER"; } };
 
 class sqlite_types
@@ -63,6 +63,8 @@ void sqlite_database::on_open(const std::string &db)
   if (ret != SQLITE_OK) {
     throw sqlite_exception("couldn't open database: " + db);
   }
+  // the connection is owned and closed by the database
+  connection_.reset(sqlite_db_, [](sqlite3*) {});
 }
 
 bool sqlite_database::is_open() const
@@ -76,6 +78,7 @@ void sqlite_database::on_close()
   
   throw_error(ret, sqlite_db_, "sqlite_close");
 
+  connection_.reset();
   sqlite_db_ = 0;
 }
 
@@ -84,6 +87,11 @@ sqlite3* sqlite_database::operator()()
   return sqlite_db_;
 }
 
+std::weak_ptr<sqlite3> sqlite_database::connection() const
+{
+  return connection_;
+}
+
 void sqlite_database::on_begin()
 {
   execute<serializable>("BEGIN TRANSACTION;", (std::shared_ptr<object_base_producer>()));
@@ -170,6 +178,8 @@ const char* sqlite_database::type_string(data_type_t type) const
       return "REAL";
     case type_time:
       return "TEXT";
+    case type_blob:
+      return "BLOB";
     default:
       {
         std::stringstream msg;
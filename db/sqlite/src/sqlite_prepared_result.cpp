@@ -2,10 +2,15 @@
 
 #include "tools/date.hpp"
 #include "tools/time.hpp"
+#include "tools/iso8601.hpp"
 #include "tools/varchar.hpp"
+#include "tools/blob.hpp"
 
 #include "object/object_ptr.hpp"
 
+#include "sqlite_exception.hpp"
+
+#include <algorithm>
 #include <cstring>
 
 #include <sqlite3.h>
@@ -14,14 +19,143 @@ namespace oos {
 
 namespace sqlite {
 
-sqlite_prepared_result::sqlite_prepared_result(sqlite3_stmt *stmt, int ret, std::shared_ptr<oos::object_base_producer> producer)
+#ifdef OOS_SQLITE3_COLUMN_METADATA
+namespace {
+
+/*
+ * reads the chunks of a blob with the
+ * incremental blob io of sqlite, the
+ * blob is identified by table, column
+ * and rowid. The source only holds a
+ * weak reference to the connection, once
+ * the database is closed reading throws.
+ */
+class sqlite_blob_source : public blob_source
+{
+public:
+  sqlite_blob_source(const std::weak_ptr<sqlite3> &db, const std::string &table, const std::string &column, sqlite3_int64 rowid, size_type size)
+    : db_(db), table_(table), column_(column), rowid_(rowid), size_(size)
+  {}
+
+  virtual size_type size() const override
+  {
+    return size_;
+  }
+
+  virtual size_type read(size_type offset, char *buf, size_type len) const override
+  {
+    if (offset >= size_) {
+      return 0;
+    }
+    std::shared_ptr<sqlite3> db = db_.lock();
+    if (!db) {
+      throw sqlite_exception("couldn't read blob: database is closed");
+    }
+    len = std::min(len, size_ - offset);
+    sqlite3_blob *handle = nullptr;
+    // the handle is closed after each chunk, so the
+    // database isn't blocked by an open blob handle
+    int ret = sqlite3_blob_open(db.get(), "main", table_.c_str(), column_.c_str(), rowid_, 0, &handle);
+    if (ret == SQLITE_OK) {
+      ret = sqlite3_blob_read(handle, buf, (int)len, (int)offset);
+    }
+    sqlite3_blob_close(handle);
+    if (ret != SQLITE_OK) {
+      throw sqlite_exception(sqlite3_errmsg(db.get()));
+    }
+    return len;
+  }
+
+private:
+  std::weak_ptr<sqlite3> db_;
+  std::string table_;
+  std::string column_;
+  sqlite3_int64 rowid_;
+  size_type size_;
+};
+
+/*
+ * returns the number of primary key
+ * columns of the given table
+ */
+int primary_key_columns(sqlite3 *db, const char *table)
+{
+  std::string sql("PRAGMA table_info(\"");
+  for (const char *c = table; *c; ++c) {
+    if (*c == '"') {
+      sql += '"';
+    }
+    sql += *c;
+  }
+  sql += "\")";
+  sqlite3_stmt *stmt = nullptr;
+  int count = 0;
+  if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+      // the sixth column is the index of the column in the primary key
+      if (sqlite3_column_int(stmt, 5) > 0) {
+        ++count;
+      }
+    }
+  }
+  sqlite3_finalize(stmt);
+  return count;
+}
+
+}
+#endif
+
+void lazy_blob_columns::resolve(sqlite3_stmt *stmt)
+{
+  resolved = true;
+#ifdef OOS_SQLITE3_COLUMN_METADATA
+  /*
+   * only a single primary key column declared
+   * as INTEGER is an alias of the rowid
+   */
+  sqlite3 *db = sqlite3_db_handle(stmt);
+  int count = sqlite3_column_count(stmt);
+  for (int i = 0; i < count && rowid_column < 0; ++i) {
+    const char *table = sqlite3_column_table_name(stmt, i);
+    const char *column = sqlite3_column_origin_name(stmt, i);
+    const char *type = nullptr;
+    int primary_key = 0;
+    if (table && column &&
+        sqlite3_table_column_metadata(db, nullptr, table, column, &type, nullptr, nullptr, &primary_key, nullptr) == SQLITE_OK &&
+        primary_key && type && sqlite3_stricmp(type, "INTEGER") == 0 &&
+        primary_key_columns(db, table) == 1) {
+      rowid_column = i;
+      rowid_table = table;
+    }
+  }
+  if (rowid_column < 0) {
+    return;
+  }
+  // the blob columns of the rowid table may be read lazy
+  columns.resize(count);
+  for (int i = 0; i < count; ++i) {
+    const char *table = sqlite3_column_table_name(stmt, i);
+    const char *column = sqlite3_column_origin_name(stmt, i);
+    if (table && column && rowid_table == table) {
+      columns[i] = column;
+    }
+  }
+#else
+  (void)stmt;
+#endif
+}
+
+sqlite_prepared_result::sqlite_prepared_result(sqlite3_stmt *stmt, int ret, const std::weak_ptr<sqlite3> &db, lazy_blob_columns *blob_columns, std::shared_ptr<oos::object_base_producer> producer)
   : result_impl(producer)
   , ret_(ret)
   , first_(true)
+  , empty_(ret != SQLITE_ROW)
   , affected_rows_(0)
   , rows(0)
   , fields_(0)
   , stmt_(stmt)
+  , db_(db)
+  , blob_columns_(blob_columns)
 {
 }
 
@@ -73,6 +207,13 @@ sqlite_prepared_result::size_type sqlite_prepared_result::result_rows() const
   return rows;
 }
 
+bool sqlite_prepared_result::empty() const
+{
+  // the rows are stepped while fetching, but
+  // the first step is done on execution
+  return empty_;
+}
+
 sqlite_prepared_result::size_type sqlite_prepared_result::fields() const
 {
   return fields_;
@@ -150,6 +291,7 @@ void sqlite_prepared_result::read(const char *, varchar_base &x)
   int s = sqlite3_column_bytes(stmt_, result_index);
   const char *text = (const char*)sqlite3_column_text(stmt_, result_index++);
   if (s == 0) {
+    x.assign("", 0);
   } else {
     x.assign(text, s);
   }
@@ -182,11 +324,14 @@ void sqlite_prepared_result::read(const char *id, oos::date &x)
   x.set(static_cast<int>(val));
 }
 
-void sqlite_prepared_result::read(const char *id, oos::time &x)
+void sqlite_prepared_result::read(const char *, oos::time &x)
 {
-  std::string val;
-  read(id, val);
-  x = oos::time::parse(val, "%F %T.%f");
+  int s = sqlite3_column_bytes(stmt_, result_index);
+  const char *text = (const char*)sqlite3_column_text(stmt_, result_index++);
+  if (text && oos::parse_iso8601(text, s, x)) {
+    return;
+  }
+  x = oos::time::parse(std::string(text ? text : "", s), "%F %T.%f");
 }
 
 void sqlite_prepared_result::read(const char *id, object_base_ptr &x)
@@ -196,6 +341,36 @@ void sqlite_prepared_result::read(const char *id, object_base_ptr &x)
 
 void sqlite_prepared_result::read(const char *, object_container &) { }
 
+void sqlite_prepared_result::read(const char *, oos::blob &x)
+{
+  int index = result_index++;
+  if (sqlite3_column_type(stmt_, index) == SQLITE_NULL) {
+    x.clear();
+    return;
+  }
+  const char *data = nullptr;
+  int size = sqlite3_column_bytes(stmt_, index);
+#ifdef OOS_SQLITE3_COLUMN_METADATA
+  /*
+   * a large blob of the table whose rowid is
+   * selected isn't copied, its chunks are read
+   * from the database on request
+   */
+  if (size >= lazy_blob_size) {
+    if (!blob_columns_->resolved) {
+      blob_columns_->resolve(stmt_);
+    }
+    if (blob_columns_->rowid_column >= 0 && !blob_columns_->columns[index].empty()) {
+      sqlite3_int64 rowid = sqlite3_column_int64(stmt_, blob_columns_->rowid_column);
+      x.source(std::make_shared<sqlite_blob_source>(db_, blob_columns_->rowid_table, blob_columns_->columns[index], rowid, size));
+      return;
+    }
+  }
+#endif
+  data = (const char*)sqlite3_column_blob(stmt_, index);
+  x.assign(data, size);
+}
+
 void sqlite_prepared_result::read(const char *id, basic_identifier &x)
 {
   x.deserialize(id, *this);
@@ -18,6 +18,8 @@
 #include "tools/varchar.hpp"
 #include "tools/date.hpp"
 #include "tools/time.hpp"
+#include "tools/iso8601.hpp"
+#include "tools/blob.hpp"
 
 #include "object/identifier.hpp"
 #include "object/serializable.hpp"
@@ -79,6 +81,12 @@ sqlite_result::size_type sqlite_result::result_rows() const
   return result_.size();
 }
 
+bool sqlite_result::result_rows_known() const
+{
+  // all rows are read on execution
+  return true;
+}
+
 sqlite_result::size_type sqlite_result::fields() const
 {
   return 0;
@@ -122,6 +130,8 @@ void sqlite_result::read(const char */*id*/, short &x)
 {
   t_row::value_type &val = result_[pos_][column_++];
   if (strlen(val) == 0) {
+    // null, like a prepared result
+    x = 0;
     return;
   }
   char *end;
@@ -133,6 +143,8 @@ void sqlite_result::read(const char */*id*/, int &x)
 {
   t_row::value_type &val = result_[pos_][column_++];
   if (strlen(val) == 0) {
+    // null, like a prepared result
+    x = 0;
     return;
   }
   char *end;
@@ -144,6 +156,8 @@ void sqlite_result::read(const char */*id*/, long &x)
 {
   t_row::value_type &val = result_[pos_][column_++];
   if (strlen(val) == 0) {
+    // null, like a prepared result
+    x = 0;
     return;
   }
   char *end;
@@ -155,6 +169,8 @@ void sqlite_result::read(const char */*id*/, unsigned char &x)
 {
   t_row::value_type &val = result_[pos_][column_++];
   if (strlen(val) == 0) {
+    // null, like a prepared result
+    x = 0;
     return;
   }
   char *end;
@@ -166,6 +182,8 @@ void sqlite_result::read(const char */*id*/, unsigned short &x)
 {
   t_row::value_type &val = result_[pos_][column_++];
   if (strlen(val) == 0) {
+    // null, like a prepared result
+    x = 0;
     return;
   }
   char *end;
@@ -177,6 +195,8 @@ void sqlite_result::read(const char */*id*/, unsigned int &x)
 {
   t_row::value_type &val = result_[pos_][column_++];
   if (strlen(val) == 0) {
+    // null, like a prepared result
+    x = 0;
     return;
   }
   char *end;
@@ -188,6 +208,8 @@ void sqlite_result::read(const char */*id*/, unsigned long &x)
 {
   char *val = result_[pos_][column_++];
   if (strlen(val) == 0) {
+    // null, like a prepared result
+    x = 0;
     return;
   }
   char *end = nullptr;
@@ -199,6 +221,8 @@ void sqlite_result::read(const char */*id*/, bool &x)
 {
   t_row::value_type &val = result_[pos_][column_++];
   if (strlen(val) == 0) {
+    // null, like a prepared result
+    x = 0;
     return;
   }
   char *end;
@@ -210,6 +234,8 @@ void sqlite_result::read(const char */*id*/, float &x)
 {
   t_row::value_type &val = result_[pos_][column_++];
   if (strlen(val) == 0) {
+    // null, like a prepared result
+    x = 0;
     return;
   }
   char *end;
@@ -221,6 +247,8 @@ void sqlite_result::read(const char */*id*/, double &x)
 {
   t_row::value_type &val = result_[pos_][column_++];
   if (strlen(val) == 0) {
+    // null, like a prepared result
+    x = 0;
     return;
   }
   char *end;
@@ -259,11 +287,24 @@ void sqlite_result::read(const char *id, oos::date &x)
   x.set(static_cast<int>(val));
 }
 
+void sqlite_result::read(const char */*id*/, oos::blob &x)
+{
+  // the rows of a direct query are text, a
+  // blob ends at its first zero byte
+  t_row::value_type val = result_[pos_][column_++];
+  x.assign(val, strlen(val));
+}
+
 void sqlite_result::read(const char *id, oos::time &x)
 {
-std::string val;
-read(id, val);
-x = oos::time::parse(val, "%F %T.%f");
+  t_row::value_type val = result_[pos_][column_];
+  if (val && oos::parse_iso8601(val, strlen(val), x)) {
+    ++column_;
+    return;
+  }
+  std::string str;
+  read(id, str);
+  x = oos::time::parse(str, "%F %T.%f");
 }
 
 void sqlite_result::read(const char *id, object_base_ptr &x)
@@ -27,6 +27,8 @@
 #include "tools/string.hpp"
 #include "tools/varchar.hpp"
 #include "tools/date.hpp"
+#include "tools/iso8601.hpp"
+#include "tools/blob.hpp"
 
 #include <cstring>
 
@@ -71,7 +73,7 @@ detail::result_impl* sqlite_statement::execute()
   // get next row
   int ret = sqlite3_step(stmt_);
 
-  return new sqlite_prepared_result(stmt_, ret, producer_);
+  return new sqlite_prepared_result(stmt_, ret, db_.connection(), &blob_columns_, producer_);
 }
 
 void sqlite_statement::reset()
@@ -182,12 +184,31 @@ void sqlite_statement::write(const char *, const oos::date &x)
   int ret = sqlite3_bind_int(stmt_, ++host_index, x.julian_date());
   throw_error(ret, db_(), "sqlite3_bind_int");}
 
-void sqlite_statement::write(const char *id, const oos::time &x)
+void sqlite_statement::write(const char *, const oos::time &x)
 {
-  // format time to ISO8601
-  auto time_string = std::make_shared<std::string>(oos::to_string(x, "%F %T.%f"));
-  write(id, *time_string);
-  host_strings_.push_back(time_string);
+  // format time to ISO8601, sqlite copies the text
+  char buffer[oos::iso8601_time_size];
+  std::size_t len = oos::format_iso8601(x, buffer, sizeof(buffer));
+  if (len == 0) {
+    std::string time_string(oos::to_string(x, "%F %T.%f"));
+    int ret = sqlite3_bind_text(stmt_, ++host_index, time_string.c_str(), time_string.size(), SQLITE_TRANSIENT);
+    throw_error(ret, db_(), "sqlite3_bind_text");
+    return;
+  }
+  int ret = sqlite3_bind_text(stmt_, ++host_index, buffer, len, SQLITE_TRANSIENT);
+  throw_error(ret, db_(), "sqlite3_bind_text");
+}
+
+void sqlite_statement::write(const char *, const oos::blob &x)
+{
+  int ret;
+  if (x.empty()) {
+    ret = sqlite3_bind_zeroblob(stmt_, ++host_index, 0);
+  } else {
+    // the data of the blob isn't copied
+    ret = sqlite3_bind_blob(stmt_, ++host_index, x.data(), (int)x.size(), SQLITE_STATIC);
+  }
+  throw_error(ret, db_(), "sqlite3_bind_blob");
 }
 
 void sqlite_statement::write(const char *, const object_base_ptr &x)
@@ -31,6 +31,8 @@
   #define OOS_API
 #endif
 
+#include "database/column_image.hpp"
+
 #include <string>
 #include <list>
 #include <memory>
@@ -255,8 +257,15 @@ public:
    */
   const object_proxy* proxy() const;
 
+  /**
+   * The column values of the serializable
+   * before it was updated.
+   */
+  column_image& image();
+
 private:
   object_proxy *proxy_;
+  column_image image_;
 };
 
 /**
@@ -0,0 +1,52 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AGGREGATE_HPP
+#define AGGREGATE_HPP
+
+#include <string>
+
+namespace oos {
+  /**
+   * Enumeration of sql aggregate functions
+   */
+  enum aggregate_t {
+    aggregate_count = 0, /*!< Number of rows or values */
+    aggregate_sum,       /*!< Sum of the values */
+    aggregate_min,       /*!< Smallest value */
+    aggregate_max,       /*!< Largest value */
+    aggregate_avg        /*!< Average of the values */
+  };
+
+  /**
+   * Returns the sql expression applying the
+   * aggregate function to the given column,
+   * e.g. COUNT(*) or SUM(val_int). The expression
+   * can be used as a column of a tuple select.
+   *
+   * @param func The aggregate function.
+   * @param column The name of the column.
+   * @return The sql expression.
+   */
+  inline std::string aggregate_column(aggregate_t func, const std::string &column = "*")
+  {
+    static const char *names[] = { "COUNT(", "SUM(", "MIN(", "MAX(", "AVG(" };
+    return names[func] + column + ")";
+  }
+}
+
+#endif /* AGGREGATE_HPP */
@@ -0,0 +1,143 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLUMN_IMAGE_HPP
+#define COLUMN_IMAGE_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include "object/serializer.hpp"
+
+#include <string>
+#include <vector>
+
+namespace oos {
+
+class serializable;
+class varchar_base;
+class object_base_ptr;
+class object_container;
+class basic_identifier;
+class date;
+class time;
+class blob;
+class basic_value_vector;
+
+/// @cond OOS_DEV
+
+/**
+ * A column mask holds one flag per column
+ * of a table in the order the columns are
+ * written by a serializable. Object containers
+ * aren't columns, primary keys and object
+ * pointers are one column each.
+ */
+typedef std::vector<bool> column_mask;
+
+/**
+ * @class column_image
+ * @brief The column values of a serializable
+ *
+ * A column_image holds the raw value of each
+ * column of a serializable. The image is taken
+ * when an object is backed up for an update
+ * and compared with the object on commit to
+ * find the modified columns.
+ */
+class OOS_API column_image : public generic_serializer<column_image>
+{
+public:
+  column_image();
+  virtual ~column_image();
+
+  /**
+   * Takes the image of the given serializable.
+   *
+   * @param o The serializable to take the image from.
+   */
+  void take(const serializable *o);
+
+  /**
+   * Compares the image with the given serializable
+   * and sets a flag for each column and each
+   * value_vector with a different value.
+   *
+   * @param o The serializable to compare with.
+   * @param mask The mask receiving the modified columns.
+   * @param vectors The mask receiving the modified value_vectors.
+   * @return True if at least one column or value_vector was modified.
+   */
+  bool compare(const serializable *o, column_mask &mask, column_mask &vectors);
+
+  /**
+   * Returns true if no image was taken.
+   *
+   * @return True if no image was taken.
+   */
+  bool empty() const;
+
+  using generic_serializer<column_image>::write;
+
+  // a value_vector isn't a column, its image is the encoded elements
+  virtual void write(const char *id, const basic_value_vector &x);
+
+  template < class T >
+  void write_value(const char*, const T &x)
+  {
+    column(&x, sizeof(T));
+  }
+
+  void write_value(const char*, const char *x, std::size_t s);
+  void write_value(const char*, const std::string &x);
+  void write_value(const char*, const varchar_base &x);
+  void write_value(const char*, const date &x);
+  void write_value(const char*, const time &x);
+  void write_value(const char*, const blob &x);
+  void write_value(const char*, const object_base_ptr &x);
+  void write_value(const char*, const object_container &) {}
+  void write_value(const char *id, const basic_identifier &x);
+
+private:
+  void column(const void *data, std::size_t size);
+
+private:
+  std::vector<std::string> values_;
+  std::size_t index_;
+  column_mask *mask_;
+  bool modified_;
+
+  std::vector<std::string> vectors_;
+  std::size_t vector_index_;
+  column_mask *vector_mask_;
+};
+
+/// @endcond
+
+}
+
+#endif /* COLUMN_IMAGE_HPP */
@@ -37,6 +37,7 @@
 #include "database/sql.hpp"
 #include "database/result.hpp"
 #include "database/statement.hpp"
+#include "database/sql_metrics.hpp"
 
 #include "tools/sequencer.hpp"
 
@@ -44,6 +45,7 @@
 #include <unordered_map>
 #include <map>
 #include <list>
+#include <vector>
 
 namespace oos {
 
@@ -171,7 +173,7 @@ public:
   template < class T >
   result<T> execute(std::string sql, std::shared_ptr<object_base_producer> ptr)
   {
-    return result<T>(on_execute(sql, ptr), this);
+    return result<T>(execute_direct(sql, ptr), this);
   }
 
 
@@ -185,9 +187,27 @@ public:
   template < class T >
   statement<T> prepare(const oos::sql &sql, std::shared_ptr<object_base_producer> ptr)
   {
-    return statement<T>(on_prepare(sql, ptr), this);
+    detail::statement_impl *impl = on_prepare(sql, ptr);
+    impl->metrics(&metrics_);
+    return statement<T>(impl, this);
   }
 
+  /**
+   * Returns the execution metrics of
+   * the sql statements of this database.
+   *
+   * @return The sql metrics.
+   */
+  sql_metrics& metrics();
+
+  /**
+   * Returns the execution metrics of
+   * the sql statements of this database.
+   *
+   * @return The sql metrics.
+   */
+  const sql_metrics& metrics() const;
+
   /**
    * The interface for the create table action.
    */
@@ -204,7 +224,11 @@ public:
   virtual void visit(update_action*);
 
   /**
-   * The interface for the delete action.
+   * The interface for the delete action. The
+   * primary key is queued at its table; the
+   * queued keys are deleted with a few batched
+   * statements before the next insert or update
+   * and on commit.
    */
   virtual void visit(delete_action*);
 
@@ -282,6 +306,11 @@ protected:
   virtual void on_commit() = 0;
   virtual void on_rollback() = 0;
 
+private:
+  oos::detail::result_impl* execute_direct(const std::string &sql, std::shared_ptr<object_base_producer> ptr);
+
+  void execute_removes();
+  void clear_removes();
 
 private:
   friend class database_factory;
@@ -293,9 +322,12 @@ private:
   bool commiting_;
 
   table_map_t table_map_;
+  std::vector<table_ptr> removing_tables_;
 
   database_sequencer_ptr sequencer_;
   sequencer_impl_ptr sequencer_backup_;
+
+  sql_metrics metrics_;
 };
 
 /// @endcond
@@ -19,6 +19,7 @@
 #define QUERY_HPP
 
 #include "database/sql.hpp"
+#include "database/aggregate.hpp"
 #include "database/result.hpp"
 #include "database/statement.hpp"
 #include "database/session.hpp"
@@ -31,6 +32,10 @@
 
 #include <memory>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
 
 namespace oos {
 
@@ -65,6 +70,20 @@ class object_base_ptr;
  * to itself. So you can concatenate your query
  * parts by calling the methods in a chain
  * (concatenated by dots).
+ *
+ * Aggregates are computed by the database. A single
+ * aggregate is selected with aggregate() and read with
+ * value(), grouped aggregates are selected as columns
+ * of a tuple (see aggregate_column()):
+ *
+ * @code
+ * long n = q.aggregate<long>(aggregate_count, "*", "item")
+ *           .where("val_int > 5").value();
+ *
+ * typedef std::tuple<std::string, long> row_t;
+ * result<row_t> res = q.select<row_t>({"val_string", aggregate_column(aggregate_count)})
+ *                      .from("item").group_by("val_string").execute();
+ * @endcode
  */
 template < class T >
 class query
@@ -118,6 +137,14 @@ public:
     , db_(db)
   {}
 
+  /**
+   * Moves the statement and the state
+   * of the given query into a new query.
+   *
+   * @param x The query to move.
+   */
+  query(query &&x) = default;
+
   ~query() {}
 
   /**
@@ -208,6 +235,93 @@ public:
     return *this;
   }
 
+  /**
+   * Creates a select statement for the given
+   * columns. The type of the query must be a
+   * std::tuple with one element per column. The
+   * result of the query reads the columns directly
+   * into a tuple, no serializable is created.
+   *
+   * @param columns The names of the columns to select.
+   * @return A reference to the query.
+   */
+  query& select(const std::vector<std::string> &columns)
+  {
+    reset();
+    producer_.reset();
+
+    throw_invalid(QUERY_SELECT, state);
+    if (columns.size() != detail::tuple_row<T>::size()) {
+      throw std::logic_error("number of columns doesn't match the tuple size");
+    }
+    sql_.append("SELECT ");
+
+    detail::tuple_row<T> row(columns);
+    query_select s(sql_);
+    row.serialize(s);
+
+    state = QUERY_SELECT;
+    return *this;
+  }
+
+  /**
+   * Creates a new query selecting the given
+   * columns into a tuple (see select(columns)).
+   * This query isn't changed.
+   *
+   * @tparam Tuple The std::tuple type of a row.
+   * @param columns The names of the columns to select.
+   * @return The new query.
+   */
+  template < class Tuple >
+  query<Tuple> select(const std::vector<std::string> &columns)
+  {
+    query<Tuple> q(db_);
+    q.select(columns);
+    return q;
+  }
+
+  /**
+   * Creates a new query selecting the given
+   * aggregate function of a column of a table.
+   * The row of the query is a tuple with the
+   * aggregated value; conditions may be added
+   * with where(). This query isn't changed.
+   *
+   * @tparam R The type of the aggregated value.
+   * @param func The aggregate function.
+   * @param column The name of the column.
+   * @param table The name of the table.
+   * @return The new query.
+   */
+  template < class R >
+  query<std::tuple<R> > aggregate(aggregate_t func, const std::string &column, const std::string &table)
+  {
+    query<std::tuple<R> > q(db_);
+    q.select(std::vector<std::string>(1, aggregate_column(func, column)));
+    q.from(table);
+    return q;
+  }
+
+  /**
+   * Executes the query and returns the first
+   * column of the first row. The type of the
+   * query must be a std::tuple; if the result
+   * has no rows a default value is returned.
+   *
+   * @return The value of the first column.
+   */
+  template < class Tuple = T >
+  typename std::tuple_element<0, Tuple>::type value()
+  {
+    result<Tuple> res(execute());
+    typename result<Tuple>::iterator first = res.begin();
+    if (first == res.end()) {
+      return typename std::tuple_element<0, Tuple>::type();
+    }
+    return std::get<0>(*first);
+  }
+
   /**
    * Creates an insert statement based
    * on the given serializable and.
@@ -218,6 +332,23 @@ public:
    * @return A reference to the query.
    */
   query& insert(const T *obj, const std::string &table)
+  {
+    return insert(obj, table, 1);
+  }
+
+  /**
+   * Creates an insert statement for the given
+   * number of rows based on the given serializable
+   * and the name of the table. Each row gets its
+   * own host values, a prepared statement binds
+   * the rows one after the other.
+   *
+   * @param obj The serializable used for the insert statement.
+   * @param table The name of the table.
+   * @param rows The number of rows to insert.
+   * @return A reference to the query.
+   */
+  query& insert(const T *obj, const std::string &table, std::size_t rows)
   {
     reset();
     sql_.append(std::string("INSERT INTO ") + table + std::string(" ("));
@@ -226,12 +357,14 @@ public:
     s.fields();
     obj->serialize(s);
 
-    sql_.append(") VALUES (");
-
-    s.values();
-    obj->serialize(s);
+    sql_.append(") VALUES ");
 
-    sql_.append(")");
+    for (std::size_t i = 0; i < rows; ++i) {
+      sql_.append(i > 0 ? ", (" : "(");
+      s.values();
+      obj->serialize(s);
+      sql_.append(")");
+    }
 
     state = QUERY_OBJECT_INSERT;
 
@@ -275,6 +408,30 @@ public:
     return *this;
   }
 
+  /**
+   * Creates an update statement setting
+   * only the columns of the given mask.
+   * The flags of the mask are in the order
+   * the serializable writes its columns.
+   *
+   * @param o The serializable used for the update statement.
+   * @param table The name of the table.
+   * @param columns The mask of the columns to set.
+   * @return A reference to the query.
+   */
+  query& update(T *o, const std::string &table, const column_mask &columns)
+  {
+    reset();
+    sql_.append(std::string("UPDATE ") + table + std::string(" SET "));
+
+    query_update s(sql_, columns);
+    o->serialize(s);
+
+    state = QUERY_OBJECT_UPDATE;
+
+    return *this;
+  }
+
   /**
    * Creates an update statement based
    * on the given object_ptr and the name of the table
@@ -363,6 +520,39 @@ public:
     return *this;
   }
 
+  /**
+   * Adds a where clause matching the column
+   * against a list of values to the select,
+   * update or delete statement. Each value
+   * becomes a host value, so a prepared
+   * statement has one placeholder per value
+   * which is bound on execution.
+   *
+   * @tparam V The type of the values.
+   * @param column The name of the column.
+   * @param values The values to match.
+   * @return A reference to the query.
+   */
+  template < class V >
+  query& where_in(const std::string &column, const std::vector<V> &values)
+  {
+    throw_invalid(QUERY_WHERE, state);
+
+    sql_.append(std::string(" WHERE ") + column + std::string(" IN ("));
+    for (typename std::vector<V>::size_type i = 0; i < values.size(); ++i) {
+      if (i > 0) {
+        sql_.append(", ");
+      }
+      std::stringstream valstr;
+      valstr << values[i];
+      sql_.append(column.c_str(), type_traits<V>::data_type(), valstr.str());
+    }
+    sql_.append(")");
+
+    state = QUERY_WHERE;
+    return *this;
+  }
+
   /**
    * Adds an and clause condition to the where
    * clause.
@@ -522,8 +712,6 @@ public:
    */
   result<T> execute()
   {
-//    std::cout << "SQL: " << sql_.direct().c_str() << '\n';
-//    std::cout.flush();
     return db_.execute<T>(sql_.direct(), producer_);
   }
 
@@ -615,6 +803,20 @@ private:
           throw std::logic_error(msg.str());
         }
         break;
+      case query::QUERY_GROUPBY:
+      case query::QUERY_ORDERBY:
+        if (current != query::QUERY_SELECT &&
+            current != query::QUERY_COLUMN &&
+            current != query::QUERY_WHERE &&
+            current != query::QUERY_COND_WHERE &&
+            current != query::QUERY_AND &&
+            current != query::QUERY_OR &&
+            (next != query::QUERY_ORDERBY || current != query::QUERY_GROUPBY))
+        {
+          msg << "invalid next state: [" << next << "] (current: " << current << ")";
+          throw std::logic_error(msg.str());
+        }
+        break;
       default:
         throw std::logic_error("unknown state");
     }
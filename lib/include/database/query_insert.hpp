@@ -46,6 +46,7 @@ public:
   virtual void write(const char *id, const std::string &x);
   virtual void write(const char *id, const date &x);
   virtual void write(const char *id, const time &x);
+  virtual void write(const char *id, const blob &x);
   virtual void write(const char *id, const object_base_ptr &x);
   virtual void write(const char *id, const object_container &x);
   virtual void write(const char *id, const basic_identifier &x);
@@ -71,6 +72,7 @@ public:
   void write_field(const char *id, data_type_t type, const oos::time &x);
   void write_field(const char *id, data_type_t type, const std::string &x);
   void write_field(const char *id, data_type_t type, const varchar_base &x);
+  void write_field(const char *id, data_type_t type, const blob &x);
   void write_field(const char *id, data_type_t type, const char *x);
 
   void fields();
@@ -17,6 +17,7 @@
 #include "object/serializer.hpp"
 
 #include "database/sql.hpp"
+#include "database/column_image.hpp"
 
 #include <sstream>
 
@@ -28,6 +29,7 @@ class OOS_API query_update : public serializer
 {
 public:
   explicit query_update(sql &s);
+  query_update(sql &s, const column_mask &columns);
   virtual ~query_update();
   
   virtual void write(const char *id, char x);
@@ -46,6 +48,7 @@ public:
   virtual void write(const char *id, const std::string &x);
 	virtual void write(const char *id, const date &x);
 	virtual void write(const char *id, const time &x);
+	virtual void write(const char *id, const blob &x);
 	virtual void write(const char *id, const object_base_ptr &x);
   virtual void write(const char *id, const object_container &x);
   virtual void write(const char *id, const basic_identifier &x);
@@ -53,6 +56,9 @@ public:
   template < class T >
   void write_pair(const char *id, data_type_t type, const T &x)
   {
+    if (skip()) {
+      return;
+    }
     if (first) {
       first = false;
     } else {
@@ -67,11 +73,17 @@ public:
   void write_pair(const char *id, data_type_t type, const oos::time &x);
   void write_pair(const char *id, data_type_t type, const std::string &x);
   void write_pair(const char *id, data_type_t type, const varchar_base &x);
+  void write_pair(const char *id, data_type_t type, const blob &x);
   void write_pair(const char *id, data_type_t type, const char *x);
 
+private:
+  bool skip();
+
 private:
   sql &dialect;
   bool first;
+  const column_mask *columns_;
+  column_mask::size_type column_;
 };
 
 /// @endcond
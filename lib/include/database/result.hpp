@@ -21,8 +21,10 @@
 #include "object/serializer.hpp"
 
 #include "database/result_impl.hpp"
+#include "database/tuple_row.hpp"
 
 #include <memory>
+#include <tuple>
 #include <type_traits>
 
 namespace oos {
@@ -44,19 +46,22 @@ public:
   typedef value_type& reference;   /**< Shortcut for the reference type */
 
   base_result_iterator() {}
-  base_result_iterator(oos::detail::result_impl *result_impl, T *obj = nullptr)
+  base_result_iterator(oos::detail::result_impl *result_impl, T *obj = nullptr, bool reuse = false)
   : obj_(obj)
   , result_impl_(result_impl)
+  , reuse_(reuse)
   {}
   base_result_iterator(base_result_iterator&& x)
   : obj_(x.obj_.release())
   , result_impl_(x.result_impl_)
+  , reuse_(x.reuse_)
   {}
 
   base_result_iterator& operator=(base_result_iterator&& x)
   {
     result_impl_ = x.result_impl_;
     obj_.reset(x.obj_.release());
+    reuse_ = x.reuse_;
     return *this;
   }
 
@@ -97,9 +102,27 @@ public:
     return obj_.release();
   }
 
+protected:
+  /*
+   * fetches the next row into the current
+   * object if rows are reused, otherwise
+   * into the given new object
+   */
+  template < class Create >
+  void fetch_next(Create create)
+  {
+    if (!reuse_ || !obj_) {
+      obj_.reset(create());
+    }
+    if (!result_impl_->fetch_row(obj_.get())) {
+      obj_.reset();
+    }
+  }
+
 protected:
   std::unique_ptr<T> obj_;
   oos::detail::result_impl *result_impl_ = nullptr;
+  bool reuse_ = false;
 };
 
 template < class T, class Enable = void >
@@ -120,8 +143,11 @@ public:
   result_iterator(oos::detail::result_impl *result_impl, T *obj = nullptr)
     : base(result_impl, obj)
   {}
+  result_iterator(oos::detail::result_impl *result_impl, T *obj, bool reuse)
+    : base(result_impl, obj, reuse)
+  {}
   result_iterator(result_iterator&& x)
-    : base(x.result_impl_, x.obj_.release())
+    : base(x.result_impl_, x.obj_.release(), x.reuse_)
   {}
 #else
   using base_result_iterator<T>::base_result_iterator;
@@ -129,18 +155,15 @@ public:
 
   self& operator++()
   {
-    serializable *obj = base::result_impl_->producer()->create();
-    base::obj_.reset(obj);
-    if (!base::result_impl_->fetch(base::obj_.get())) {
-      base::obj_.reset();
-    }
+    oos::detail::result_impl *impl = base::result_impl_;
+    base::fetch_next([impl]() { return impl->producer()->create(); });
     return *this;
   }
 
   self operator++(int)
   {
     std::unique_ptr<T> obj(static_cast<T>(base::result_impl_->producer()->create()));
-    base::result_impl_->fetch(obj.get());
+    base::result_impl_->fetch_row(obj.get());
     return self(base::result_impl_, obj.release());
   }
 };
@@ -160,8 +183,11 @@ public:
   result_iterator(oos::detail::result_impl *result_impl, T *obj = nullptr)
     : base(result_impl, obj)
   {}
+  result_iterator(oos::detail::result_impl *result_impl, T *obj, bool reuse)
+    : base(result_impl, obj, reuse)
+  {}
   result_iterator(result_iterator&& x)
-    : base(x.result_impl_, x.obj_.release())
+    : base(x.result_impl_, x.obj_.release(), x.reuse_)
   {}
 #else
   using base_result_iterator<T>::base_result_iterator;
@@ -169,17 +195,14 @@ public:
 
   self& operator++()
   {
-    base::obj_.reset(new T);
-    if (!base::result_impl_->fetch(base::obj_.get())) {
-      base::obj_.reset();
-    }
+    base::fetch_next([]() { return new T; });
     return *this;
   }
 
   self operator++(int)
   {
     std::unique_ptr<T> obj(new T);
-    base::result_impl_->fetch(obj.get());
+    base::result_impl_->fetch_row(obj.get());
     return self(base::result_impl_, obj.release());
   }
 };
@@ -210,6 +233,8 @@ public:
   result(result &&x)
   {
     std::swap(p, x.p);
+    std::swap(db_, x.db_);
+    std::swap(reuse_, x.reuse_);
   }
 
   result& operator=(result &&x)
@@ -219,12 +244,14 @@ public:
       p = nullptr;
     }
     std::swap(p, x.p);
+    std::swap(db_, x.db_);
+    std::swap(reuse_, x.reuse_);
     return *this;
   }
 
   iterator begin()
   {
-    return std::move(++iterator(p));
+    return std::move(++iterator(p, nullptr, reuse_));
   }
 
   iterator end()
@@ -232,19 +259,236 @@ public:
     return iterator();
   }
 
+  /**
+   * Returns true if the result has no rows.
+   * For a streamed result (see size_known())
+   * false is returned unless the backend can
+   * tell that no row is available.
+   *
+   * @return True if the result has no rows.
+   */
   bool empty () const
   {
-    return false;
+    return !p || p->empty();
   }
 
+  /**
+   * Returns the number of rows of the result
+   * if the backend knows it (see size_known()),
+   * otherwise zero. The size doesn't change
+   * while the rows are fetched.
+   *
+   * @return The number of rows.
+   */
   std::size_t size () const
   {
-    return 0;
+    return size_known() ? p->result_rows() : 0;
+  }
+
+  /**
+   * Returns true if the backend knows the number
+   * of rows before they are fetched. SQLite and
+   * MySQL hold the complete result of a direct
+   * query, MySQL stores the result of a prepared
+   * statement as well. A prepared SQLite statement
+   * streams its rows.
+   *
+   * @return True if size() returns the number of rows.
+   */
+  bool size_known() const
+  {
+    return p && p->result_rows_known();
+  }
+
+  /**
+   * Enables or disables the reuse of the row
+   * object while iterating. If enabled each row
+   * is deserialized into the same object, so
+   * the object of the current row is only valid
+   * until the iterator is incremented. An object
+   * taken with release() isn't reused.
+   *
+   * @param reuse True to reuse the row object.
+   */
+  void reuse(bool reuse)
+  {
+    reuse_ = reuse;
+  }
+
+  /**
+   * Returns true if the row object is reused
+   * while iterating.
+   *
+   * @return True if the row object is reused.
+   */
+  bool reuse() const
+  {
+    return reuse_;
+  }
+
+  /**
+   * Calls the given function with each row of
+   * the result. All rows are deserialized into
+   * one object, the reference passed to the
+   * function is only valid during the call.
+   *
+   * @tparam Function The type of the function.
+   * @param func The function called with each row.
+   * @return The number of rows.
+   */
+  template < class Function >
+  std::size_t for_each_row(Function func)
+  {
+    std::size_t rows = 0;
+    iterator last = end();
+    for (iterator first(p, nullptr, true); ++first != last; ++rows) {
+      func(*first);
+    }
+    return rows;
+  }
+
+private:
+  oos::detail::result_impl *p = nullptr;
+  database *db_ = nullptr;
+  bool reuse_ = false;
+};
+
+template < class Tuple >
+class tuple_result_iterator : public std::iterator<std::input_iterator_tag, Tuple>
+{
+public:
+  typedef tuple_result_iterator<Tuple> self; /**< Shortcut for this class. */
+  typedef Tuple value_type;                  /**< Shortcut for the value type. */
+  typedef value_type* pointer;               /**< Shortcut for the pointer type. */
+  typedef value_type& reference;             /**< Shortcut for the reference type */
+
+  tuple_result_iterator() {}
+  tuple_result_iterator(oos::detail::result_impl *result_impl, detail::tuple_row<Tuple> *row)
+    : result_impl_(result_impl)
+    , row_(row)
+  {}
+
+  bool operator==(const tuple_result_iterator &rhs) const
+  {
+    return row_ == rhs.row_;
+  }
+
+  bool operator!=(const tuple_result_iterator &rhs) const
+  {
+    return row_ != rhs.row_;
+  }
+
+  self& operator++()
+  {
+    if (!result_impl_->fetch_row(row_)) {
+      row_ = nullptr;
+    }
+    return *this;
+  }
+
+  reference operator*() const
+  {
+    return row_->values();
+  }
+
+  pointer operator->() const
+  {
+    return &row_->values();
+  }
+
+private:
+  oos::detail::result_impl *result_impl_ = nullptr;
+  detail::tuple_row<Tuple> *row_ = nullptr;
+};
+
+/*
+ * the result of a typed projection, all rows
+ * are read into the same tuple
+ */
+template < class... Types >
+class result<std::tuple<Types...> >
+{
+public:
+  typedef std::tuple<Types...> value_type;
+  typedef tuple_result_iterator<value_type> iterator;
+
+  result(const result &x) = delete;
+  result& operator=(const result &x) = delete;
+
+public:
+  result() {}
+  result(oos::detail::result_impl *impl, database *db)
+    : p(impl)
+    , db_(db)
+    , row_(new detail::tuple_row<value_type>)
+  {}
+
+  ~result()
+  {
+    if (p) {
+      delete p;
+    }
+  }
+
+  result(result &&x)
+  {
+    std::swap(p, x.p);
+    std::swap(db_, x.db_);
+    std::swap(row_, x.row_);
+  }
+
+  result& operator=(result &&x)
+  {
+    if (p) {
+      delete p;
+      p = nullptr;
+    }
+    std::swap(p, x.p);
+    std::swap(db_, x.db_);
+    std::swap(row_, x.row_);
+    return *this;
+  }
+
+  iterator begin()
+  {
+    return ++iterator(p, row_.get());
+  }
+
+  iterator end()
+  {
+    return iterator();
+  }
+
+  bool empty () const
+  {
+    return !p || p->empty();
+  }
+
+  std::size_t size () const
+  {
+    return size_known() ? p->result_rows() : 0;
+  }
+
+  bool size_known() const
+  {
+    return p && p->result_rows_known();
+  }
+
+  template < class Function >
+  std::size_t for_each_row(Function func)
+  {
+    std::size_t rows = 0;
+    while (p->fetch_row(row_.get())) {
+      func(const_cast<const value_type&>(row_->values()));
+      ++rows;
+    }
+    return rows;
   }
 
 private:
   oos::detail::result_impl *p = nullptr;
   database *db_ = nullptr;
+  std::unique_ptr<detail::tuple_row<value_type> > row_;
 };
 
 /// @endcond
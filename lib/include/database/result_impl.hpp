@@ -17,12 +17,16 @@
 #include "object/serializer.hpp"
 #include "object/object_producer.hpp"
 
+#include "database/sql_metrics.hpp"
+
 #include <memory>
+#include <vector>
 
 namespace oos {
 
 class serializable;
 class object_base_ptr;
+class basic_identifier;
 
 namespace detail {
 
@@ -58,10 +62,47 @@ public:
    */
   virtual bool fetch(serializable *) { return false; }
 
+  /**
+   * Fetch next line into the given serializable
+   * and account the fetch time and the fetched
+   * row to the statistics set with measure().
+   *
+   * @param o Object to be deserialized
+   * @return True if serializable was successfully deserialized
+   */
+  bool fetch_row(serializable *o) { return statistics_ == nullptr ? fetch(o) : measured_fetch(o); }
+
+  /**
+   * Sets the statistics entry the fetches
+   * of this result are accounted to.
+   *
+   * @param stats The statistics entry or nullptr.
+   */
+  void measure(sql_metrics::statistics *stats);
+
   virtual size_type affected_rows() const = 0;
 
   virtual size_type result_rows() const = 0;
 
+  /**
+   * Returns true if result_rows() is the number
+   * of rows of the result, i.e. the backend holds
+   * the complete result before it is fetched.
+   * Backends streaming the rows return false.
+   *
+   * @return True if the number of rows is known.
+   */
+  virtual bool result_rows_known() const { return false; }
+
+  /**
+   * Returns true if the result has no rows. If
+   * the number of rows isn't known and the backend
+   * can't tell otherwise, false is returned.
+   *
+   * @return True if the result has no rows.
+   */
+  virtual bool empty() const { return result_rows_known() && result_rows() == 0; }
+
   virtual size_type fields() const = 0;
 
   virtual int transform_index(int index) const = 0;
@@ -74,8 +115,15 @@ protected:
 protected:
   int result_index;
 
+private:
+  bool measured_fetch(serializable *o);
+
 private:
   std::shared_ptr<object_base_producer> producer_;
+  sql_metrics::statistics *statistics_ = nullptr;
+
+  // scratch identifiers of the foreign key columns
+  std::vector<std::unique_ptr<basic_identifier> > foreign_keys_;
 };
 
 /// @endcond
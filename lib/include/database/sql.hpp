@@ -81,6 +81,11 @@ public:
   typedef std::list<token*> token_list_t;
   
 public:
+  sql() {}
+  sql(const sql&) = delete;
+  sql& operator=(const sql&) = delete;
+  sql(sql &&x);
+  sql& operator=(sql &&x);
   ~sql();
   
   void append(const std::string &str);
@@ -0,0 +1,193 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SQL_METRICS_HPP
+#define SQL_METRICS_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace oos {
+
+/**
+ * @class sql_metrics
+ * @brief Execution metrics of the sql statements of a database
+ *
+ * Once enabled, the database counts the executions
+ * and the rows of each sql text and sums up the time
+ * spent binding, executing and fetching. A statement
+ * whose execution takes longer than the slow query
+ * threshold is logged together with its bound values.
+ *
+ * The metrics are disabled by default, then the
+ * database only checks a flag per statement.
+ *
+ * @code
+ * session s(ostore, "sqlite://test.sqlite");
+ * s.db().metrics().enable(true);
+ * s.db().metrics().slow_query_threshold(10.0);
+ * ...
+ * s.db().metrics().write_json(std::cout);
+ * @endcode
+ */
+class OOS_API sql_metrics
+{
+public:
+  /**
+   * The metrics of one sql text.
+   * All times are in nanoseconds.
+   */
+  struct statistics
+  {
+    statistics();
+    unsigned long long executions; /**< Number of executions */
+    unsigned long long rows;       /**< Fetched rows of a select, affected rows otherwise */
+    double execute_ns;             /**< Time spent executing */
+    double max_ns;                 /**< Slowest execution */
+    double bind_ns;                /**< Time spent binding values */
+    double fetch_ns;               /**< Time spent fetching rows */
+    bool is_select;                /**< True if the sql text is a select */
+  };
+
+  typedef std::map<std::string, statistics> t_statistics_map; /**< Shortcut to the statistics map */
+
+  /**
+   * Creates disabled metrics logging
+   * slow queries to std::clog.
+   */
+  sql_metrics();
+
+  /**
+   * Enables or disables the metrics.
+   *
+   * @param enable True to enable the metrics.
+   */
+  void enable(bool enable);
+
+  /**
+   * Returns true if the metrics are enabled.
+   *
+   * @return True if the metrics are enabled.
+   */
+  bool enabled() const
+  {
+    return enabled_;
+  }
+
+  /**
+   * Sets the slow query threshold in milliseconds.
+   * A threshold of zero disables the slow query log.
+   *
+   * @param ms The threshold in milliseconds.
+   */
+  void slow_query_threshold(double ms);
+
+  /**
+   * Returns the slow query threshold in milliseconds.
+   *
+   * @return The slow query threshold.
+   */
+  double slow_query_threshold() const;
+
+  /**
+   * Sets the stream the slow queries are logged to.
+   *
+   * @param out The slow query log stream.
+   */
+  void slow_query_log(std::ostream &out);
+
+  /**
+   * Returns true if slow queries are logged. Only
+   * then the bound values of the statements are kept.
+   *
+   * @return True if slow queries are logged.
+   */
+  bool logs_slow_queries() const
+  {
+    return enabled_ && threshold_ns_ > 0;
+  }
+
+  /**
+   * Returns the statistics of the given sql text,
+   * they are created on first use. The returned
+   * statistics stay valid until the metrics are
+   * destroyed.
+   *
+   * @param sql The sql text.
+   * @return The statistics of the sql text.
+   */
+  statistics* find(const std::string &sql);
+
+  /**
+   * Records one execution of the given sql text
+   * and logs it if it exceeds the slow query
+   * threshold.
+   *
+   * @param stats The statistics of the sql text.
+   * @param sql The sql text.
+   * @param ns The execution time.
+   * @param bind_ns The time spent binding the values.
+   * @param rows The affected rows.
+   * @param values The bound values or an empty list.
+   */
+  void executed(statistics &stats, const std::string &sql, double ns, double bind_ns, unsigned long long rows, const std::vector<std::string> &values);
+
+  /**
+   * Returns all statistics.
+   *
+   * @return All statistics.
+   */
+  const t_statistics_map& statistics_map() const;
+
+  /**
+   * Resets all statistics to zero.
+   */
+  void reset();
+
+  /**
+   * Writes a snapshot of all executed
+   * statements as one json object.
+   *
+   * @param out The stream to write to.
+   */
+  void write_json(std::ostream &out) const;
+
+private:
+  bool enabled_;
+  double threshold_ns_;
+  std::ostream *log_;
+  t_statistics_map statistics_map_;
+};
+
+}
+
+#endif /* SQL_METRICS_HPP */
@@ -64,6 +64,7 @@ public:
   statement(statement &&x)
   {
     std::swap(p, x.p);
+    std::swap(db_, x.db_);
   }
 
   statement& operator=(statement &&x)
@@ -73,6 +74,7 @@ public:
       p = nullptr;
     }
     std::swap(p, x.p);
+    std::swap(db_, x.db_);
     return *this;
   }
 
@@ -85,8 +87,7 @@ public:
 
   result<T> execute()
   {
-//  std::cout << "SQL: " << p->str() << '\n';
-    return result<T>(p->execute(), db_);
+    return result<T>(p->measured_execute(), db_);
   }
 
   void reset()
@@ -99,6 +100,16 @@ public:
     return p->bind(o);
   }
 
+  int bind(T *o, const column_mask &columns)
+  {
+    return p->bind(o, columns);
+  }
+
+  int bind_row(T *o, unsigned long pos)
+  {
+    return p->bind_row(o, pos);
+  }
+
   template < class V >
   int bind(unsigned long i, const V &val)
   {
@@ -110,6 +121,11 @@ public:
     return p->str();
   }
 
+  bool is_prepared() const
+  {
+    return p != nullptr;
+  }
+
 private:
   oos::detail::statement_impl *p = nullptr;
   database *db_ = nullptr;
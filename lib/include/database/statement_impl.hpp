@@ -5,6 +5,12 @@
 #include "object/serializer.hpp"
 
 #include "database/result.hpp"
+#include "database/column_image.hpp"
+#include "database/sql_metrics.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
 
 #ifndef OOS_STATEMENT_IMPL_HPP
 #define OOS_STATEMENT_IMPL_HPP
@@ -40,15 +46,40 @@ public:
 
   virtual detail::result_impl* execute() = 0;
 
+  /*
+   * executes the statement and records
+   * its metrics if they are enabled
+   */
+  detail::result_impl* measured_execute();
+
   virtual void reset() = 0;
 
+  void metrics(sql_metrics *m);
+
   int bind(serializable *o);
 
+  /*
+   * binds only the columns of the mask,
+   * see query::update(o, table, columns)
+   */
+  int bind(serializable *o, const column_mask &columns);
+
+  /*
+   * binds the object as one row of a multi-row
+   * insert starting at the given host index
+   * without resetting the statement, see
+   * query::insert(o, table, rows)
+   */
+  int bind_row(serializable *o, unsigned long pos);
+
   template < class T >
   int bind(unsigned long i, const T &val)
   {
     host_index = i;
     write("", val);
+    if (metrics_ != nullptr && metrics_->logs_slow_queries()) {
+      parameter_printer()->write("", val);
+    }
     return host_index;
   }
 
@@ -57,11 +88,20 @@ public:
 protected:
   void str(const std::string &s);
 
+private:
+  serializer* parameter_printer();
+
 protected:
   int host_index;
 
 private:
   std::string sql_;
+
+  sql_metrics *metrics_ = nullptr;
+  sql_metrics::statistics *statistics_ = nullptr;
+  double bind_ns_ = 0;
+  std::vector<std::string> values_;
+  std::unique_ptr<serializer> parameter_printer_;
 };
 
 /// @endcond
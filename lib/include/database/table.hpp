@@ -43,6 +43,7 @@
 #include <unordered_map>
 #include <map>
 #include <list>
+#include <vector>
 
 namespace oos {
 
@@ -50,6 +51,7 @@ class serializable;
 class object_base_ptr;
 class object_store;
 class prototype_node;
+class basic_value_vector;
 
 /// @cond OOS_DEV
 
@@ -74,20 +76,87 @@ public:
   void load(object_store &ostore);
   void insert(serializable *obj);
   void update(serializable *obj);
+  void update(serializable *obj, const column_mask &columns, const column_mask &vectors);
   void remove(serializable *obj);
+  void remove(const basic_identifier &pk);
+  void execute_removes();
+  void clear_removes();
+  bool has_removes() const;
   void drop();
 
   bool is_loaded() const;
 
+  /*
+   * the largest number of primary keys
+   * deleted with one statement
+   */
+  static const std::size_t max_remove_chunk = 256;
+
+  /*
+   * the largest number of cached update
+   * statements for column subsets
+   */
+  static const std::size_t max_update_statements = 64;
+
+  /*
+   * the largest number of value_vector
+   * elements inserted with one statement
+   */
+  static const std::size_t max_insert_chunk = 256;
+
 protected:
 //  const prototype_node& node() const;
 //
 //  virtual database& db() { return db_; }
 //  virtual const database& db() const { return db_; }
 
+private:
+  /*
+   * the join table of a value_vector field
+   * holding one row per element
+   */
+  struct value_table
+  {
+    typedef std::unordered_map<unsigned long, basic_value_vector*> owner_map_t;
+
+    std::string field;
+    std::string name;
+    // the vector of the prototype object with one element
+    basic_value_vector *prototype;
+
+    statement<serializable> remove;
+    statement<serializable> select;
+    // insert statements for 1, 2, 4, ... rows, prepared on first use
+    std::vector<statement<serializable> > insert_in;
+    std::vector<statement<serializable> > remove_in;
+
+    // the vectors of the owners while loading
+    owner_map_t owners;
+  };
+
+  void update_row(serializable *obj);
+  void update_columns(serializable *obj, const column_mask &columns);
+
+  /*
+   * writes the rows of the value_vectors of the given
+   * object, if vectors is set only the flagged ones. If
+   * replace is true the current rows are deleted before,
+   * i.e. a changed vector is rewritten completely
+   */
+  void write_values(serializable *obj, const column_mask *vectors, bool replace);
+  void load_values();
+  statement<serializable>& insert_statement(value_table &values, std::size_t count, std::size_t &size);
+
+  void execute_removes(std::vector<statement<serializable> > &statements, const std::string &name, const char *column);
+  statement<serializable>& remove_statement(std::vector<statement<serializable> > &statements,
+                                            const std::string &name, const char *column,
+                                            std::size_t count, std::size_t &size);
+
 private:
   friend class relation_filler;
   friend class table_reader;
+  friend class value_row;
+  friend class value_row_producer;
 
   database &db_;
   const prototype_node &node_;
@@ -97,6 +166,16 @@ private:
   statement<serializable> delete_;
   statement<serializable> select_;
 
+  /*
+   * delete statements for 1, 2, 4, ... primary
+   * keys, prepared on first use
+   */
+  std::vector<statement<serializable> > remove_in_;
+  std::vector<const basic_identifier*> removes_;
+
+  // update statements per set of modified columns
+  std::map<column_mask, statement<serializable> > column_updates_;
+
   bool prepared_;
 
   bool is_loaded_;
@@ -104,6 +183,10 @@ private:
   t_to_one_data to_one_data;
 
   identifier_binder primary_key_binder_;
+
+  // the prototype object holding the vectors of the value tables
+  std::unique_ptr<serializable> value_prototype_;
+  std::vector<std::unique_ptr<value_table> > value_tables_;
 };
 
 ///@endcond
@@ -129,6 +129,7 @@ public:
   const session& db() const;
 
   virtual void on_insert(object_proxy *proxy);
+  virtual void on_bulk_insert(const std::vector<object_proxy*> &proxies);
   virtual void on_update(object_proxy *proxy);
   virtual void on_delete(object_proxy *proxy);
 
@@ -0,0 +1,117 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TUPLE_ROW_HPP
+#define TUPLE_ROW_HPP
+
+#include "object/serializable.hpp"
+#include "object/serializer.hpp"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace oos {
+
+namespace detail {
+
+/// @cond OOS_DEV
+
+/*
+ * serializes the tuple elements
+ * starting with element I
+ */
+template < std::size_t I, class Tuple, bool End = (I == std::tuple_size<Tuple>::value) >
+struct tuple_fields
+{
+  static void serialize(serializer &s, const Tuple &values, const std::vector<std::string> &columns)
+  {
+    s.write(I < columns.size() ? columns[I].c_str() : "", std::get<I>(values));
+    tuple_fields<I + 1, Tuple>::serialize(s, values, columns);
+  }
+
+  static void deserialize(deserializer &d, Tuple &values, const std::vector<std::string> &columns)
+  {
+    d.read(I < columns.size() ? columns[I].c_str() : "", std::get<I>(values));
+    tuple_fields<I + 1, Tuple>::deserialize(d, values, columns);
+  }
+};
+
+template < std::size_t I, class Tuple >
+struct tuple_fields<I, Tuple, true>
+{
+  static void serialize(serializer &, const Tuple &, const std::vector<std::string> &) {}
+  static void deserialize(deserializer &, Tuple &, const std::vector<std::string> &) {}
+};
+
+template < class Tuple >
+class tuple_row;
+
+/**
+ * @class tuple_row
+ * @brief Adapts a tuple of column values to the serializable interface
+ * @tparam Types The types of the column values.
+ *
+ * A tuple_row lets a query and a result handle
+ * a tuple of column values like a serializable.
+ * The elements are written and read in tuple order
+ * with the column names given at construction, so
+ * each backend reads the values with its usual
+ * column readers. The row isn't an object of an
+ * object_store and has no producer.
+ */
+template < class... Types >
+class tuple_row<std::tuple<Types...> > : public serializable
+{
+public:
+  typedef std::tuple<Types...> value_type; /**< Shortcut for the tuple type. */
+
+  tuple_row() {}
+
+  explicit tuple_row(const std::vector<std::string> &columns)
+    : columns_(columns)
+  {}
+
+  virtual ~tuple_row() {}
+
+  virtual void deserialize(deserializer &d)
+  {
+    tuple_fields<0, value_type>::deserialize(d, values_, columns_);
+  }
+
+  virtual void serialize(serializer &s) const
+  {
+    tuple_fields<0, value_type>::serialize(s, values_, columns_);
+  }
+
+  value_type& values() { return values_; }
+  const value_type& values() const { return values_; }
+
+  static std::size_t size() { return sizeof...(Types); }
+
+private:
+  value_type values_;
+  std::vector<std::string> columns_;
+};
+
+/// @endcond
+
+}
+
+}
+
+#endif /* TUPLE_ROW_HPP */
@@ -21,6 +21,9 @@
 #include <string>
 
 namespace oos {
+
+class blob;
+
   /**
    * Enumeration of database data types
    */
@@ -141,6 +144,12 @@ template <> struct type_traits<std::string>
   inline static unsigned long type_size() { return 1024; }
 };
 
+template <> struct type_traits<blob>
+{
+  inline static data_type_t data_type() { return type_blob; }
+  inline static unsigned long type_size() { return sizeof(const char*); }
+};
+
 /*
 template <> struct type_traits<object_base_ptr>
 {
@@ -150,8 +150,12 @@ generic_json_parser<T>::parse_json_object(std::istream &in)
    */
   handler_->on_begin_object();
 
-  c = in.get();
+  // skip white
+  in >> std::ws;
+
+  c = in.peek();
   if (in.good() && c == '}') {
+    in.get();
     /*
      * call handler callback
      */
@@ -159,9 +163,6 @@ generic_json_parser<T>::parse_json_object(std::istream &in)
     // empty serializable
     return;
   }
-  
-  // skip white
-  in >> std::ws;
 
   do {
 
@@ -217,15 +218,16 @@ generic_json_parser<T>::parse_json_array(std::istream &in)
   
   handler_->on_begin_array();
 
-  c = in.get();
+  // skip white
+  in >> std::ws;
+
+  c = in.peek();
   if (in.good() && c == ']') {
+    in.get();
     handler_->on_end_array();
     // empty array
     return;
   }
-  
-  // skip white
-  in >> std::ws;
 
   do {
 
@@ -339,6 +341,9 @@ generic_json_parser<T>::parse_json_number(std::istream &in)
   
   switch (c) {
     case ' ':
+    case '\t':
+    case '\r':
+    case '\n':
     case ',':
     case ']':
     case '}':
@@ -0,0 +1,231 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JSON_DESERIALIZER_HPP
+#define JSON_DESERIALIZER_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4355)
+#else
+  #define OOS_API
+#endif
+
+#include "json/generic_json_parser.hpp"
+
+#include "object/serializer.hpp"
+
+#include <string>
+#include <vector>
+#include <typeinfo>
+
+namespace oos {
+
+class serializable;
+class object_store;
+
+/**
+ * @class json_deserializer
+ * @brief Reads serializable objects from json
+ *
+ * The json_deserializer is driven by the callbacks
+ * of the generic_json_parser. The attributes of the
+ * current json object are collected into a small
+ * reusable field table and are then handed over to
+ * the deserialize method of the target serializable.
+ * No json value tree is built.
+ *
+ * Object pointers are resolved by id within the
+ * object_store the deserializer is bound to. Ids
+ * which can't be found are left unset, so referenced
+ * types must be imported first. The content of
+ * containers isn't imported, the elements of a
+ * value_vector are read from a json array.
+ *
+ * Numbers are transported as double by the parser,
+ * integral values are exact up to 2^53.
+ */
+class OOS_API json_deserializer : public generic_json_parser<json_deserializer>, public generic_deserializer<json_deserializer>
+{
+public:
+  /**
+   * Creates a json_deserializer. If an object_store
+   * is given, object pointers are resolved within
+   * this store.
+   *
+   * @param ostore The object_store to resolve object pointers.
+   */
+  explicit json_deserializer(object_store *ostore = nullptr);
+
+  virtual ~json_deserializer();
+
+  /**
+   * Reads the json object from the given stream
+   * into the given serializable.
+   *
+   * @param o The serializable to fill.
+   * @param in The json input stream.
+   */
+  void deserialize(serializable *o, std::istream &in);
+
+  /**
+   * Reads the json object from the given string
+   * into the given serializable.
+   *
+   * @param o The serializable to fill.
+   * @param str The json string.
+   */
+  void deserialize(serializable *o, const std::string &str);
+
+  /**
+   * Reads the json object from the given character
+   * string into the given serializable.
+   *
+   * @param o The serializable to fill.
+   * @param str The json character string.
+   */
+  void deserialize(serializable *o, const char *str);
+
+  /**
+   * Reads a json array of objects of the given type
+   * and inserts each object into the given object_store.
+   * If an object provides an integral primary key its
+   * value is used as the object id. If the id already
+   * exists an object_exception is thrown.
+   *
+   * @param ostore The object_store to insert into.
+   * @param type The type of the objects.
+   * @param in The json input stream.
+   * @return The number of inserted objects.
+   * @throws object_exception
+   */
+  std::size_t deserialize(object_store &ostore, const char *type, std::istream &in);
+
+  /**
+   * Reads a json array of objects of type T
+   * and inserts each object into the given object_store.
+   *
+   * @tparam T The type of the objects.
+   * @param ostore The object_store to insert into.
+   * @param in The json input stream.
+   * @return The number of inserted objects.
+   */
+  template < class T >
+  std::size_t deserialize(object_store &ostore, std::istream &in)
+  {
+    return deserialize(ostore, typeid(T).name(), in);
+  }
+
+/// @cond OOS_DEV
+  void on_begin_object();
+  void on_object_key(const std::string &key);
+  void on_end_object();
+
+  void on_begin_array();
+  void on_end_array();
+
+  void on_string(const std::string &value);
+  void on_number(double value);
+  void on_bool(bool value);
+  void on_null();
+
+  using generic_deserializer<json_deserializer>::read;
+
+  // the elements of a value_vector are read from a json array
+  virtual void read(const char *id, basic_value_vector &x);
+
+  void read_value(const char *id, char &x);
+  void read_value(const char *id, float &x);
+  void read_value(const char *id, double &x);
+  void read_value(const char *id, short &x);
+  void read_value(const char *id, int &x);
+  void read_value(const char *id, long &x);
+  void read_value(const char *id, unsigned char &x);
+  void read_value(const char *id, unsigned short &x);
+  void read_value(const char *id, unsigned int &x);
+  void read_value(const char *id, unsigned long &x);
+  void read_value(const char *id, bool &x);
+  void read_value(const char *id, char *x, size_t s);
+  void read_value(const char *id, std::string &x);
+  void read_value(const char *id, varchar_base &x);
+  void read_value(const char *id, date &x);
+  void read_value(const char *id, time &x);
+  void read_value(const char *id, blob &x);
+  void read_value(const char *id, object_base_ptr &x);
+  void read_value(const char *id, object_container &x);
+  void read_value(const char *id, basic_identifier &x);
+/// @endcond
+
+private:
+  enum field_type {
+    JSON_NULL,
+    JSON_NUMBER,
+    JSON_STRING,
+    JSON_BOOL,
+    JSON_ARRAY
+  };
+
+  struct field
+  {
+    std::string key;
+    field_type type = JSON_NULL;
+    double number = 0.0;
+    bool boolean = false;
+    std::string text;
+    // the elements of an array in elements_
+    std::size_t first = 0;
+    std::size_t count = 0;
+  };
+
+  field* next_field();
+  field* next_element();
+  field* value_field();
+  const field* find_field(const char *id);
+  double find_number(const char *id);
+  void finish_object();
+
+private:
+  std::vector<field> fields_;
+  std::size_t field_count_ = 0;
+  std::size_t cursor_ = 0;
+  field *current_ = nullptr;
+
+  std::vector<field> elements_;
+  std::size_t element_count_ = 0;
+  // the array element read by a value_vector
+  const field *element_ = nullptr;
+
+  int level_ = 0;
+  int object_level_ = 1;
+
+  serializable *target_ = nullptr;
+  object_store *ostore_ = nullptr;
+  object_store *bulk_store_ = nullptr;
+  const char *type_ = nullptr;
+  std::size_t count_ = 0;
+  unsigned long pk_value_ = 0;
+};
+
+}
+
+#endif /* JSON_DESERIALIZER_HPP */
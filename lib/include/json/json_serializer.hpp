@@ -0,0 +1,176 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JSON_SERIALIZER_HPP
+#define JSON_SERIALIZER_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4355)
+#else
+  #define OOS_API
+#endif
+
+#include "object/serializer.hpp"
+#include "object/object_view.hpp"
+
+#include <string>
+
+namespace oos {
+
+class serializable;
+
+/**
+ * @class json_serializer
+ * @brief Writes serializable objects as json
+ *
+ * The json_serializer implements the oos::serializer
+ * interface and streams each written attribute directly
+ * into an internal growable character buffer. No json
+ * value tree is built. The buffer is reused between
+ * calls, so serializing many objects with one
+ * json_serializer instance doesn't allocate once the
+ * buffer has grown to its working size.
+ *
+ * Object pointers are written as the id of the
+ * referenced object (or null), containers as an
+ * array of the ids of their items and value_vectors
+ * as an array of their elements.
+ */
+class OOS_API json_serializer : public generic_serializer<json_serializer>
+{
+public:
+  /**
+   * Creates a json_serializer
+   */
+  json_serializer();
+
+  virtual ~json_serializer();
+
+  /**
+   * Serializes the given serializable into
+   * a json object. The internal buffer is
+   * cleared before.
+   *
+   * @param o The serializable to serialize.
+   * @return The json string.
+   */
+  const std::string& serialize(const serializable *o);
+
+  /**
+   * Serializes all objects of the given
+   * object_view into a json array. The internal
+   * buffer is cleared before.
+   *
+   * @tparam T The type of the object_view.
+   * @param view The object_view to serialize.
+   * @return The json string.
+   */
+  template < class T >
+  const std::string& serialize(const object_view<T> &view)
+  {
+    buffer_.clear();
+    buffer_.push_back('[');
+    bool first = true;
+    for (typename object_view<T>::const_iterator i = view.begin(); i != view.end(); ++i) {
+      if (!first) {
+        buffer_.push_back(',');
+      }
+      first = false;
+      append((*i).get());
+    }
+    buffer_.push_back(']');
+    return buffer_;
+  }
+
+  /**
+   * Appends the given serializable as json
+   * object to the current buffer.
+   *
+   * @param o The serializable to append.
+   */
+  void append(const serializable *o);
+
+  /**
+   * Returns the current json buffer.
+   *
+   * @return The current json buffer.
+   */
+  const std::string& str() const;
+
+  /**
+   * Clears the buffer but keeps
+   * its capacity.
+   */
+  void clear();
+
+  /**
+   * Reserves the given number of characters
+   * in the internal buffer.
+   *
+   * @param size The number of characters to reserve.
+   */
+  void reserve(std::size_t size);
+
+/// @cond OOS_DEV
+  using generic_serializer<json_serializer>::write;
+
+  // the elements of a value_vector are written as json array
+  virtual void write(const char *id, const basic_value_vector &x);
+
+  void write_value(const char *id, char x);
+  void write_value(const char *id, float x);
+  void write_value(const char *id, double x);
+  void write_value(const char *id, short x);
+  void write_value(const char *id, int x);
+  void write_value(const char *id, long x);
+  void write_value(const char *id, unsigned char x);
+  void write_value(const char *id, unsigned short x);
+  void write_value(const char *id, unsigned int x);
+  void write_value(const char *id, unsigned long x);
+  void write_value(const char *id, bool x);
+  void write_value(const char *id, const char *x, size_t s);
+  void write_value(const char *id, const std::string &x);
+  void write_value(const char *id, const varchar_base &x);
+  void write_value(const char *id, const date &x);
+  void write_value(const char *id, const time &x);
+  void write_value(const char *id, const blob &x);
+  void write_value(const char *id, const object_base_ptr &x);
+  void write_value(const char *id, const object_container &x);
+  void write_value(const char *id, const basic_identifier &x);
+/// @endcond
+
+private:
+  void write_key(const char *id);
+  void write_signed(long long x);
+  void write_unsigned(unsigned long long x);
+  void write_string(const char *str, size_t len);
+
+private:
+  std::string buffer_;
+  bool first_ = true;
+};
+
+}
+
+#endif /* JSON_SERIALIZER_HPP */
@@ -24,6 +24,7 @@
 #include "object/identifier.hpp"
 
 #include "tools/varchar.hpp"
+#include "tools/blob.hpp"
 #include "tools/string.hpp"
 
 #include <stdexcept>
@@ -537,6 +538,14 @@ public:
     to_ = to_string(from);
     success_ = true;
   }
+  void write_value(const char *id, const blob &from)
+  {
+    if (id_ != id) {
+      return;
+    }
+    to_.assign(from.data() ? from.data() : "", from.size());
+    success_ = true;
+  }
   void write_value(const char *id, const object_base_ptr &x)
   {
     if (id_ != id) {
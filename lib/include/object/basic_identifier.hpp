@@ -174,6 +174,23 @@ public:
    */
   virtual bool is_valid() const = 0;
 
+  /**
+   * Returns true if the identifier holds
+   * an integral value.
+   *
+   * @return True if the identifier is integral.
+   */
+  virtual bool is_integral() const;
+
+  /**
+   * Returns the value of an integral identifier
+   * as 64 bit number. Throws a logic_error if
+   * the identifier isn't integral.
+   *
+   * @return The integral value.
+   */
+  virtual long long integral_value() const;
+
   /**
    * Cast the value of the concrete identifier
    * to the type T. Throws a logical_error if
@@ -0,0 +1,249 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANGE_FEED_HPP
+#define CHANGE_FEED_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include "object/object_observer.hpp"
+#include "object/object_serializer.hpp"
+
+#include "tools/byte_buffer.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace oos {
+
+class object_store;
+class object_proxy;
+
+/**
+ * @class change_feed
+ * @brief Publishes the changes of an object_store
+ *
+ * The change_feed is an object_observer which writes
+ * a sequence numbered record for every insert, update
+ * and delete of its object_store into a fixed size
+ * ring buffer. Optionally the record contains the
+ * serialized image of the object (see object_serializer).
+ *
+ * The ring buffer has one producer (the thread modifying
+ * the object_store) and any number of consumers. Each
+ * consumer keeps its own cursor and polls the feed without
+ * locking. The producer never waits for consumers: when
+ * a consumer is too slow its records are overwritten and
+ * the next poll reports an overrun. The consumer can then
+ * resynchronize (e.g. via a full load) and continue with
+ * a new cursor. The lag of a consumer (in records) can be
+ * watched to throttle the producer before an overrun happens.
+ *
+ * Because an object is announced as modified before it is
+ * changed, update records are collected and published at
+ * the end of a transaction, on flush() or right before the
+ * next delete record. Before an insert record the collected
+ * updates are published as well, but they stay collected:
+ * the insert may be part of their modification, e.g.
+ * item->ptr(ostore.insert(new child)), so they are published
+ * once more with the final image.
+ */
+class OOS_API change_feed : public object_observer
+{
+public:
+  /**
+   * The kind of change of a record
+   */
+  enum action_type {
+    ACTION_INSERT = 0, /**< Object was inserted */
+    ACTION_UPDATE,     /**< Object was updated */
+    ACTION_DELETE      /**< Object was deleted */
+  };
+
+  /**
+   * Result of a poll
+   */
+  enum poll_result {
+    POLL_RECORD = 0, /**< A record was read */
+    POLL_EMPTY,      /**< There is no new record */
+    POLL_OVERRUN     /**< The records of the cursor were overwritten */
+  };
+
+  /**
+   * @brief One change of the object_store
+   */
+  struct record
+  {
+    unsigned long long sequence = 0; /**< The sequence number of the record */
+    action_type action = ACTION_INSERT; /**< The kind of change */
+    unsigned long id = 0;            /**< The id of the changed object */
+    std::string type;                /**< The prototype type name of the object */
+    bool has_image = false;          /**< True if the record contains an object image */
+    std::string image;               /**< The serialized object image */
+  };
+
+  /**
+   * @brief Read position of one consumer
+   */
+  class cursor
+  {
+  public:
+    cursor() {}
+
+    /**
+     * Returns the sequence number of the
+     * record which is read next.
+     *
+     * @return The next sequence number.
+     */
+    unsigned long long sequence() const { return sequence_; }
+
+  private:
+    friend class change_feed;
+
+    unsigned long long offset_ = 0;
+    unsigned long long sequence_ = 0;
+  };
+
+public:
+  /**
+   * Creates a change_feed for the given object_store
+   * and registers it as observer. The capacity is
+   * the size of the ring buffer in bytes.
+   *
+   * @param ostore The object_store to observe.
+   * @param capacity The size of the ring buffer in bytes.
+   * @param with_image If true the serialized object is added to each record.
+   */
+  explicit change_feed(object_store &ostore, std::size_t capacity = 1 << 20, bool with_image = false);
+
+  /**
+   * Unregisters the change_feed from
+   * its object_store.
+   */
+  virtual ~change_feed();
+
+  /**
+   * Returns a cursor pointing to the oldest
+   * record still available in the ring buffer.
+   *
+   * @return A cursor to the oldest record.
+   */
+  cursor first() const;
+
+  /**
+   * Returns a cursor pointing behind the newest
+   * record. Polling it only returns records
+   * published afterwards.
+   *
+   * @return A cursor behind the newest record.
+   */
+  cursor current() const;
+
+  /**
+   * Reads the next record for the given cursor.
+   * On success the cursor is moved to the
+   * following record.
+   *
+   * @param c The cursor of the consumer.
+   * @param r The record to fill.
+   * @return The result of the poll.
+   */
+  poll_result poll(cursor &c, record &r) const;
+
+  /**
+   * Returns the number of records published
+   * but not yet read by the given cursor.
+   *
+   * @param c The cursor of the consumer.
+   * @return The lag in records.
+   */
+  unsigned long long lag(const cursor &c) const;
+
+  /**
+   * Returns the number of published records.
+   *
+   * @return The number of published records.
+   */
+  unsigned long long sequence() const;
+
+  /**
+   * Returns the size of the ring buffer in bytes.
+   *
+   * @return The size of the ring buffer.
+   */
+  std::size_t capacity() const;
+
+  /**
+   * Publishes all collected update records.
+   * Must be called by the producer thread.
+   */
+  void flush();
+
+/// @cond OOS_DEV
+  virtual void on_insert(object_proxy *proxy);
+  virtual void on_update(object_proxy *proxy);
+  virtual void on_delete(object_proxy *proxy);
+  virtual void on_transaction_end();
+/// @endcond
+
+private:
+  void publish(action_type action, object_proxy *proxy);
+  void publish_pending(std::size_t first);
+  void write(unsigned long long offset, const void *data, std::size_t size);
+  void read(unsigned long long offset, void *data, std::size_t size) const;
+
+private:
+  object_store &ostore_;
+  std::size_t capacity_;
+  bool with_image_;
+
+  std::unique_ptr<char[]> data_;
+
+  // offset behind the newest published record
+  std::atomic<unsigned long long> head_;
+  // offset of the oldest record not yet overwritten
+  std::atomic<unsigned long long> tail_;
+  std::atomic<unsigned long long> sequence_;
+
+  std::vector<unsigned long> pending_;
+  std::unordered_set<unsigned long> pending_ids_;
+  // pending updates already published before an insert
+  std::size_t published_ = 0;
+
+  object_serializer serializer_;
+  byte_buffer buffer_;
+  std::string image_;
+};
+
+}
+
+#endif /* CHANGE_FEED_HPP */
@@ -0,0 +1,274 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FIELD_TABLE_HPP
+#define FIELD_TABLE_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include "object/identifier.hpp"
+
+#include "database/types.hpp"
+
+#include "tools/varchar.hpp"
+
+#include <cstddef>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace oos {
+
+class serializable;
+class object_base_producer;
+
+/// @cond OOS_DEV
+namespace detail {
+
+/*
+ * typed access to a member of type V, the
+ * value type must match the member type
+ */
+template < class V >
+struct field_thunk
+{
+  static bool get(const void *field, void *to, const std::type_info &type)
+  {
+    if (type != typeid(V)) {
+      return false;
+    }
+    *static_cast<V*>(to) = *static_cast<const V*>(field);
+    return true;
+  }
+
+  static bool set(void *field, const void *from, const std::type_info &type)
+  {
+    if (type != typeid(V)) {
+      return false;
+    }
+    *static_cast<V*>(field) = *static_cast<const V*>(from);
+    return true;
+  }
+};
+
+/*
+ * a varchar member is accessed with a string
+ */
+template <>
+struct field_thunk<varchar_base>
+{
+  static bool get(const void *field, void *to, const std::type_info &type)
+  {
+    if (type != typeid(std::string)) {
+      return false;
+    }
+    *static_cast<std::string*>(to) = static_cast<const varchar_base*>(field)->str();
+    return true;
+  }
+
+  static bool set(void *field, const void *from, const std::type_info &type)
+  {
+    if (type != typeid(std::string)) {
+      return false;
+    }
+    *static_cast<varchar_base*>(field) = *static_cast<const std::string*>(from);
+    return true;
+  }
+};
+
+/*
+ * a primary key member is accessed through
+ * its identifier, the value may be shared
+ * with other identifiers
+ */
+template < class V >
+struct identifier_thunk
+{
+  static bool get(const void *field, void *to, const std::type_info &type)
+  {
+    if (type != typeid(V)) {
+      return false;
+    }
+    *static_cast<V*>(to) = static_cast<const identifier<V>*>(static_cast<const basic_identifier*>(field))->value();
+    return true;
+  }
+
+  static bool set(void *field, const void *from, const std::type_info &type)
+  {
+    if (type != typeid(V)) {
+      return false;
+    }
+    static_cast<identifier<V>*>(static_cast<basic_identifier*>(field))->value(*static_cast<const V*>(from));
+    return true;
+  }
+};
+
+}
+/// @endcond
+
+/**
+ * @class field_descriptor
+ * @brief Describes one field of a serializable type
+ *
+ * A field_descriptor holds the name, the data type
+ * and the position of a field of a serializable type.
+ * If the field is a member of the object the
+ * descriptor accesses its value directly when the
+ * requested type matches the type of the member,
+ * without serializing the object.
+ */
+class OOS_API field_descriptor
+{
+public:
+  typedef bool (*getter)(const void*, void*, const std::type_info&); /**< Shortcut to a typed getter */
+  typedef bool (*setter)(void*, const void*, const std::type_info&); /**< Shortcut to a typed setter */
+
+  field_descriptor(const std::string &n, data_type_t t, std::size_t i);
+
+  /**
+   * Copies the value of the field of the given
+   * object into val. Returns false if the field
+   * can't be accessed directly with type T.
+   *
+   * @tparam T The type of the value.
+   * @param obj The object to read.
+   * @param val The value to copy into.
+   * @return True if the value was copied.
+   */
+  template < class T >
+  bool get(const serializable *obj, T &val) const
+  {
+    return get_ && get_(reinterpret_cast<const char*>(obj) + offset, &val, typeid(T));
+  }
+
+  /**
+   * Copies val into the field of the given object.
+   * Returns false if the field can't be accessed
+   * directly with type T.
+   *
+   * @tparam T The type of the value.
+   * @param obj The object to modify.
+   * @param val The value to copy.
+   * @return True if the value was copied.
+   */
+  template < class T >
+  bool set(serializable *obj, const T &val) const
+  {
+    return set_ && set_(reinterpret_cast<char*>(obj) + offset, &val, typeid(T));
+  }
+
+  /**
+   * Returns true if the field can be accessed
+   * directly.
+   *
+   * @return True if the field can be accessed directly.
+   */
+  bool direct() const;
+
+  std::string name;      /**< The name of the field */
+  data_type_t type;      /**< The data type of the field */
+  std::size_t index;     /**< The position of the field */
+  std::ptrdiff_t offset; /**< The offset of the member in the object */
+  getter get_;           /**< The typed getter or nullptr */
+  setter set_;           /**< The typed setter or nullptr */
+};
+
+/**
+ * @class field_table
+ * @brief Holds the field descriptors of a serializable type
+ *
+ * The field table is built once for each prototype
+ * when it is inserted into the prototype tree. The
+ * fields are stored in the order they are serialized,
+ * object containers aren't fields. A field is found
+ * by its position or by its name.
+ */
+class OOS_API field_table
+{
+public:
+  typedef std::vector<field_descriptor> t_field_vector; /**< Shortcut to the field vector */
+  typedef t_field_vector::const_iterator const_iterator; /**< Shortcut to the field iterator */
+
+  static const std::size_t npos; /**< Index of an unknown field */
+
+  /**
+   * Builds the field table for the objects
+   * created by the given producer.
+   *
+   * @param producer The producer of the objects.
+   */
+  void build(const object_base_producer &producer);
+
+  /**
+   * Returns the field with the given name or
+   * nullptr if there is no such field. The
+   * returned descriptor stays valid as long
+   * as the prototype exists.
+   *
+   * @param name The name of the field.
+   * @return The field or nullptr.
+   */
+  const field_descriptor* find(const std::string &name) const;
+
+  /**
+   * Returns the position of the field with the
+   * given name or npos if there is no such field.
+   *
+   * @param name The name of the field.
+   * @return The position of the field.
+   */
+  std::size_t index(const std::string &name) const;
+
+  /**
+   * Returns the field at the given position.
+   *
+   * @param i The position of the field.
+   * @return The field.
+   */
+  const field_descriptor& operator[](std::size_t i) const;
+
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  std::size_t size() const;
+  bool empty() const;
+
+  /**
+   * Removes all fields.
+   */
+  void clear();
+
+private:
+  t_field_vector fields_;
+  std::unordered_map<std::string, std::size_t> names_;
+};
+
+}
+
+#endif /* FIELD_TABLE_HPP */
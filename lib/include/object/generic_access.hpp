@@ -6,6 +6,7 @@
 #define OOS_GENERIC_ACCESS_HPP
 
 #include "object/attribute_serializer.hpp"
+#include "object/field_table.hpp"
 
 namespace oos {
 
@@ -112,5 +113,53 @@ bool get(const O &obj, const std::string &name, T &val, size_t precision)
   return writer.success();
 }
 
+/**
+ * Sets the value of the member described by
+ * the given field. If the type of the value
+ * matches the type of the member, the value is
+ * set directly without serializing the object,
+ * otherwise the member is set by its name.
+ * The field is taken from the field table of the
+ * objects prototype (see prototype_node::fields).
+ *
+ * @tparam O     The object for which the value should be set.
+ * @tparam T     The type of the value to set.
+ * @param obj    The object to set the value into.
+ * @param field  The field of the member variable.
+ * @param val    The new value for the member.
+ * @return       True if the operation succeeds.
+ */
+template < typename O, class T >
+bool set(O &obj, const field_descriptor &field, const T &val)
+{
+  if (field.set(&*obj, val)) {
+    return true;
+  }
+  return set(obj, field.name, val);
+}
+
+/**
+ * Gets the value of the member described by
+ * the given field. If the type of the value
+ * matches the type of the member, the value is
+ * read directly without serializing the object,
+ * otherwise the member is read by its name.
+ *
+ * @tparam O     The object for which the value should be get.
+ * @tparam T     The type of the value to retrieve.
+ * @param obj    The object to get the value from.
+ * @param field  The field of the member variable.
+ * @param val    The reference where the value is assigned to.
+ * @return       True if the operation succeeds.
+ */
+template < typename O, class T >
+bool get(const O &obj, const field_descriptor &field, T &val)
+{
+  if (field.get(&*obj, val)) {
+    return true;
+  }
+  return get(obj, field.name, val);
+}
+
 }
 #endif //OOS_GENERIC_ACCESS_HPP
@@ -28,7 +28,11 @@ template<class T>
 identifier<T> share_identifier(const identifier<T> &id);
 
 /**
- *
+ * An identifier for integral values. The value is
+ * stored inline, it is moved into a shared cell when
+ * the identifier is shared with another identifier
+ * (see share() and share_with()). Identifiers which
+ * are never shared don't allocate memory.
  */
 template<typename T>
 class identifier<T, typename std::enable_if<std::is_integral<T>::value>::type> : public basic_identifier
@@ -36,10 +40,10 @@ class identifier<T, typename std::enable_if<std::is_integral<T>::value>::type> :
 public:
   typedef identifier<T> self;
 
-  identifier() : id_(new T(0))
+  identifier() : value_(0)
   { };
 
-  explicit identifier(T val) : id_(new T(val))
+  explicit identifier(T val) : value_(val)
   { }
 
   virtual ~identifier()
@@ -47,18 +51,18 @@ public:
 
   virtual void serialize(const char *id, serializer &writer) const
   {
-    writer.write(id, *id_);
+    writer.write(id, cell());
   }
 
   virtual void deserialize(const char *id, deserializer &reader)
   {
-    reader.read(id, *id_);
+    reader.read(id, cell());
   }
 
   virtual bool less(const basic_identifier &x) const
   {
     if (this->is_same_type(x)) {
-      return *id_ < static_cast<const self &>(x).value();
+      return cell() < static_cast<const self &>(x).value();
     } else {
       throw std::logic_error("not the same type");
     }
@@ -67,7 +71,7 @@ public:
   virtual bool equal_to(const basic_identifier &x) const
   {
     if (this->is_same_type(x)) {
-      return *id_ == static_cast<const identifier<T> &>(x).value();
+      return cell() == static_cast<const identifier<T> &>(x).value();
     } else {
       throw std::logic_error("not the same type");
     }
@@ -76,7 +80,7 @@ public:
   virtual size_t hash() const
   {
     std::hash<T> pk_hash;
-    return pk_hash(*id_);
+    return pk_hash(cell());
   }
 
   virtual bool is_same_type(const basic_identifier &x) const
@@ -87,26 +91,28 @@ public:
 
   virtual std::ostream &print(std::ostream &out) const
   {
-    out << *id_;
+    out << cell();
     return out;
   }
 
   virtual basic_identifier *clone() const
   {
-    T id = *id_;
-    return new self(id);
+    return new self(cell());
   }
 
   virtual self* share()
   {
     std::unique_ptr<self> shared(new self());
-    shared->id_ = id_;
+    shared->shared_ = shared_cell();
     return shared.release();
   }
 
   virtual void isolate()
   {
-    id_.reset(new T(*id_));
+    if (shared_) {
+      value_ = *shared_;
+      shared_.reset();
+    }
   }
 
   virtual void share_with(basic_identifier &id)
@@ -115,21 +121,52 @@ public:
       return;
     }
     identifier<T> &xid = static_cast<identifier<T> &>(id);
-    xid.id_ = id_;
+    xid.shared_ = shared_cell();
   }
 
   virtual bool is_valid() const {
-    return *id_ != 0;
+    return cell() != 0;
   }
 
+  virtual bool is_integral() const
+  { return true; }
+
+  virtual long long integral_value() const
+  { return static_cast<long long>(cell()); }
+
   T value() const
-  { return *id_; }
+  { return cell(); }
 
   void value(T val)
-  { *id_ = val; }
+  { cell() = val; }
+
+  /**
+   * Returns true if the value is shared
+   * with another identifier.
+   *
+   * @return True if the value is shared.
+   */
+  bool is_shared() const
+  { return shared_ != nullptr; }
+
+private:
+  T& cell()
+  { return shared_ ? *shared_ : value_; }
+
+  const T& cell() const
+  { return shared_ ? *shared_ : value_; }
+
+  const std::shared_ptr<T>& shared_cell()
+  {
+    if (!shared_) {
+      shared_ = std::make_shared<T>(value_);
+    }
+    return shared_;
+  }
 
 private:
-  std::shared_ptr<T> id_;
+  T value_;
+  std::shared_ptr<T> shared_;
 
   static std::type_index type_index_;
 };
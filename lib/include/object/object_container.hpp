@@ -223,6 +223,7 @@ protected:
   friend class object_inserter;
   friend class object_deleter;
   friend class object_serializer;
+  friend class json_serializer;
   friend class prototype_tree;
   friend class relation_handler;
   friend class relation_resolver;
@@ -239,6 +240,14 @@ protected:
    */
   virtual void append_proxy(object_proxy *op) = 0;
 
+  /**
+   * @brief Called after a batch of proxies was appended.
+   *
+   * Containers ordered by a key stored in their
+   * items sort the appended items once here.
+   */
+  virtual void finish_append() {}
+
   object_proxy* proxy(const object_base_ptr &optr) const;
 
   /**
@@ -34,7 +34,8 @@
 
 #include "object/serializer.hpp"
 
-#include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace oos {
 
@@ -53,6 +54,12 @@ class basic_identifier;
  * could be deleted or not.
  * If the check was successful, all the deletable serializable
  * can be accepted via the iterators.
+ *
+ * The collected objects are kept in a flat list in the
+ * order they were visited, an additional hash index maps
+ * the object id to its list position. Each object is
+ * traversed once per check, even if it is reachable on
+ * several paths or is part of a removal batch.
  */
 class object_deleter : public generic_deserializer<object_deleter>
 {
@@ -65,14 +72,16 @@ private:
     unsigned long ref_count;
     unsigned long ptr_count;
     bool ignore;
+    bool visited;
   } t_object_count;
 
 private:
-  typedef std::map<unsigned long, t_object_count> t_object_count_map;
+  typedef std::vector<t_object_count> t_object_count_list;
+  typedef std::unordered_map<unsigned long, std::size_t> t_object_index_map;
 
 public:
-  typedef t_object_count_map::iterator iterator;             /**< Shortcut the serializable map iterator */
-  typedef t_object_count_map::const_iterator const_iterator; /**< Shortcut the serializable map const_iterator */
+  typedef t_object_count_list::iterator iterator;             /**< Shortcut the serializable list iterator */
+  typedef t_object_count_list::const_iterator const_iterator; /**< Shortcut the serializable list const_iterator */
 
   /**
    * Creates an instance of the object_deleter
@@ -97,6 +106,17 @@ public:
    */
   bool is_deletable(object_container &oc);
 
+  /**
+   * Checks wether all objects of the given
+   * list are deletable. The reachable object
+   * graph of all objects is checked within
+   * one traversal.
+   *
+   * @param proxies The list of object_proxy to be checked.
+   * @return True if all objects could be deleted.
+   */
+  bool is_deletable(const std::vector<object_proxy*> &proxies);
+
   /**
    * @brief Returns the first deletable serializable.
    *
@@ -126,7 +146,13 @@ public:
   bool check_object_count_map() const;
 
 private:
-  t_object_count_map object_count_map;
+  void reset();
+  std::pair<std::size_t, bool> acquire(object_proxy *proxy, bool ignore);
+  void visit(std::size_t index);
+
+private:
+  t_object_count_list object_count_list_;
+  t_object_index_map object_index_map_;
 };
 /// @endcond
 }
@@ -46,7 +46,8 @@ public:
     : constant_(c)
   {}
 
-  T operator()(const object_base_ptr&) const
+  template < class P >
+  T operator()(const P&) const
   {
     return constant_;
   }
@@ -334,9 +335,10 @@ public:
   {}
 
 
-  bool operator()(const object_base_ptr &optr) const
+  template < class P >
+  bool operator()(const P &p) const
   {
-    return op_(left_(optr));
+    return op_(left_(p));
   }
 
 private:
@@ -354,9 +356,10 @@ public:
     , op_(op)
   {}
 
-  bool operator()(const object_base_ptr &optr) const
+  template < class P >
+  bool operator()(const P &p) const
   {
-    return op_(left_(optr), right_(optr));
+    return op_(left_(p), right_(p));
   }
 
 private:
@@ -26,6 +26,8 @@
 #include "object/object_proxy.hpp"
 
 #include <stack>
+#include <unordered_set>
+#include <vector>
 
 namespace oos {
 
@@ -71,11 +73,11 @@ public:
   void read_value(const char*, object_container &x);
 
 private:
-  typedef std::set<object_proxy*> t_object_proxy_set;
+  typedef std::unordered_set<object_proxy*> t_object_proxy_set;
 
   t_object_proxy_set object_proxies_;
 
-  std::stack<object_proxy*> object_proxy_stack_;
+  std::stack<object_proxy*, std::vector<object_proxy*> > object_proxy_stack_;
 
   object_store &ostore_;
 };
@@ -18,6 +18,8 @@
 #ifndef OBJECT_OBSERVER_HPP
 #define OBJECT_OBSERVER_HPP
 
+#include <vector>
+
 namespace oos {
 
 class serializable;
@@ -46,6 +48,23 @@ public:
    * @param proxy The proxy of the inserted serializable.
    */
   virtual void on_insert(object_proxy *proxy) = 0;
+
+  /**
+   * @brief Called on batch insertion.
+   *
+   * Called once when several serializables are
+   * inserted into the object_store within one batch.
+   * The default implementation calls on_insert
+   * for each proxy.
+   *
+   * @param proxies The proxies of the inserted serializables.
+   */
+  virtual void on_bulk_insert(const std::vector<object_proxy*> &proxies)
+  {
+    for (std::vector<object_proxy*>::const_iterator i = proxies.begin(); i != proxies.end(); ++i) {
+      on_insert(*i);
+    }
+  }
   
   /**
    * @brief Called on serializable update.
@@ -66,6 +85,33 @@ public:
    * @param proxy The proxy of the deleted serializable.
    */
   virtual void on_delete(object_proxy *proxy) = 0;
+
+  /**
+   * @brief Called on batch deletion.
+   *
+   * Called once when several serializables are
+   * deleted from the object_store within one batch.
+   * The proxies are still valid within this call.
+   * The default implementation calls on_delete
+   * for each proxy.
+   *
+   * @param proxies The proxies of the deleted serializables.
+   */
+  virtual void on_bulk_delete(const std::vector<object_proxy*> &proxies)
+  {
+    for (std::vector<object_proxy*>::const_iterator i = proxies.begin(); i != proxies.end(); ++i) {
+      on_delete(*i);
+    }
+  }
+
+  /**
+   * @brief Called on the end of a transaction.
+   *
+   * Called when a transaction was committed or
+   * rolled back. All modifications announced via
+   * on_update() are done then.
+   */
+  virtual void on_transaction_end() {}
 };
 
 }
@@ -114,14 +114,14 @@ public:
    *
    * @return The underlaying serializable
    */
-  serializable* obj();
+  serializable* obj() { return obj_; }
 
   /**
    * Return the underlaying serializable object
    *
    * @return The underlaying serializable
    */
-  const serializable* obj() const;
+  const serializable* obj() const { return obj_; }
 
   /**
    * Return the underlaying object store
@@ -329,6 +329,7 @@ private:
 
   object_store *ostore_ = nullptr;    /**< The object_store to which the object_proxy belongs. */
   prototype_node *node_ = nullptr;    /**< The prototype_node containing the type of the serializable. */
+  std::size_t node_index_ = 0;        /**< The position inside the proxy array of the prototype_node. */
 
   typedef std::set<object_base_ptr*> ptr_set_t; /**< Shortcut to the object_base_ptr_set. */
   ptr_set_t ptr_set_;      /**< This set contains every object_base_ptr pointing to this object_proxy. */
@@ -45,6 +45,8 @@ class object_proxy;
 class byte_buffer;
 class varchar_base;
 class object_container;
+class blob;
+class basic_value_vector;
 
 /**
  * @cond OOS_DEV
@@ -95,6 +97,16 @@ public:
    */
   bool deserialize(serializable *o, byte_buffer *buffer, object_store *ostore);
 
+  using generic_serializer<object_serializer>::write;
+  using generic_deserializer<object_serializer>::read;
+
+  /*
+   * the elements of a value_vector are
+   * written as one encoded string
+   */
+  virtual void write(const char *id, const basic_value_vector &x);
+  virtual void read(const char *id, basic_value_vector &x);
+
 public:
   template < class T >
   void write_value(const char*, const T &x)
@@ -107,6 +119,7 @@ public:
   void write_value(const char*, const varchar_base &s);
 	void write_value(const char* id, const date &x);
 	void write_value(const char* id, const time &x);
+	void write_value(const char* id, const blob &x);
 	void write_value(const char* id, const object_base_ptr &x);
 	void write_value(const char* id, const object_container &x);
 	void write_value(const char* id, const basic_identifier &);
@@ -122,6 +135,7 @@ public:
   void read_value(const char*, varchar_base &s);
   void read_value(const char* id, date &x);
   void read_value(const char* id, time &x);
+  void read_value(const char* id, blob &x);
   void read_value(const char* id, object_base_ptr &x);
 	void read_value(const char* id, object_container &x);
 	void read_value(const char* id, basic_identifier &x);
@@ -33,6 +33,7 @@
 #include <string>
 #include <ostream>
 #include <list>
+#include <vector>
 
 #ifdef _MSC_VER
   #ifdef oos_EXPORTS
@@ -343,13 +344,83 @@ public:
    */
   void remove(object_container &oc);
 
-  /*
+  /**
+   * Removes all objects of the given range from the
+   * serializable store. The reference and pointer counter
+   * check is done for the whole batch in one traversal,
+   * so objects may point to each other within the batch.
+   * If at least one object isn't removable, nothing is
+   * removed and an exception is thrown.
+   *
+   * The registered observers are notified once for
+   * the whole batch.
+   *
+   * @throw object_exception
+   * @tparam InputIterator Iterator type with object_base_ptr values.
+   * @param first The first object of the range.
+   * @param last The end of the range.
+   */
+  template < class InputIterator >
+  void remove(InputIterator first, InputIterator last)
+  {
+    std::vector<object_proxy*> proxies;
+    while (first != last) {
+      proxies.push_back((*first++).proxy_);
+    }
+    remove_proxies(proxies);
+  }
+
+  /**
+   * Removes all objects of the given view for which
+   * the predicate returns true. The removal is done
+   * as one batch (see remove(first, last)).
+   *
+   * @throw object_exception
+   * @tparam View The type of the object_view.
+   * @tparam Predicate The type of the predicate.
+   * @param view The object_view to check.
+   * @param pred The predicate deciding about removal.
+   * @return The number of removed objects including removed dependents.
+   */
+  template < class View, class Predicate >
+  std::size_t remove_if(const View &view, Predicate pred)
+  {
+    std::vector<object_proxy*> proxies;
+    for (typename View::const_iterator i = view.begin(); i != view.end(); ++i) {
+      if (pred(*i)) {
+        proxies.push_back((*i).proxy_);
+      }
+    }
+    return remove_proxies(proxies);
+  }
+
+  /**
+   * Inserts all serializables of the given range into
+   * the serializable store. The range must contain pointers
+   * to serializables. The prototype node is resolved once
+   * per type and the registered observers are notified
+   * once for the whole batch.
+   *
+   * @throw object_exception
+   * @tparam InputIterator Iterator type with serializable pointer values.
+   * @param first The first serializable of the range.
+   * @param last The end of the range.
+   */
   template < class InputIterator >
   void insert(InputIterator first, InputIterator last)
   {
-   // std::iterator_traits<InputIterator>::value_type *o = *first;
+    std::vector<serializable*> objects(first, last);
+    bulk_insert(objects);
   }
-  */
+
+  /**
+   * Inserts all serializables of the given vector into
+   * the serializable store (see insert(first, last)).
+   *
+   * @throw object_exception
+   * @param objects The serializables to insert.
+   */
+  void bulk_insert(const std::vector<serializable*> &objects);
   
   /**
    * @brief Register an observer with the serializable store
@@ -365,6 +436,14 @@ public:
    */
   void unregister_observer(object_observer *observer);
 
+  /**
+   * @brief Notifies the observers about the end of a transaction
+   *
+   * Called by the session when a transaction was
+   * committed or rolled back.
+   */
+  void end_transaction();
+
   /**
    * @brief Creates and inserts an serializable proxy serializable.
    * 
@@ -452,6 +531,7 @@ private:
   friend class object_deleter;
   friend class object_serializer;
   friend class restore_visitor;
+  friend class replication_follower;
   friend class object_container;
   friend class object_base_ptr;
 
@@ -459,7 +539,10 @@ private:
   void mark_modified(object_proxy *oproxy);
 
   void remove(object_proxy *proxy);
+  // returns the number of removed objects including dependents
+  std::size_t remove_proxies(const std::vector<object_proxy*> &proxies);
 	object_proxy* insert_object(serializable *o, bool notify);
+  object_proxy* insert_object(serializable *o, prototype_iterator &node, bool notify);
 	void remove_object(object_proxy *proxy, bool notify);
 
 
@@ -26,8 +26,10 @@
 
 #include "tools/conditional.hpp"
 
+#include <algorithm>
 #include <functional>
 
+#include <utility>
 #include <vector>
 
 namespace oos {
@@ -89,6 +91,25 @@ private:
 
 /// @endcond
 
+/**
+ * @brief Defines how the order of a vector is stored
+ *
+ * With DENSE_ORDERING the index of each item is its
+ * position. Inserting or erasing an item renumbers all
+ * successor items.
+ *
+ * With GAPPED_ORDERING the index of an item is a sparse
+ * ordering key. A new item gets a key between the keys of
+ * its neighbours, erasing an item doesn't touch any other
+ * item. Only when two neighbours run out of free keys a
+ * small range of items around the insert position is
+ * relabeled, which costs O(log n) amortized modified items.
+ */
+enum vector_ordering {
+  DENSE_ORDERING = 0, /**< The index is the position of the item */
+  GAPPED_ORDERING     /**< The index is a sparse ordering key */
+};
+
 template < class T, class C, class CT >
 class object_vector_iterator;
 
@@ -121,6 +142,7 @@ public:
   typedef typename vector_type::iterator iterator;                  /**< Shortcut for the vector iterator. */
   typedef typename vector_type::const_iterator const_iterator;      /**< Shortcut for the vector const iterator. */
   typedef typename object_container::size_type size_type;           /**< Shortcut for the size type. */
+  typedef unsigned long long key_type;                              /**< Shortcut for the ordering key type. */
 
 //  typedef typename object_vector_iterator<T, S, CT> vector_iterator;
 //  typedef typename const_object_vector_iterator<T, S, CT> const_vector_iterator;
@@ -137,10 +159,38 @@ public:
    *
    * @tparam T Parent serializable type.
    */
-  object_vector_base() {}
+  explicit object_vector_base(vector_ordering ordering = DENSE_ORDERING)
+    : ordering_(ordering)
+  {}
 
   virtual ~object_vector_base() {}
 
+  /**
+   * Returns the ordering of the vector.
+   *
+   * @return The ordering of the vector.
+   */
+  vector_ordering ordering() const
+  {
+    return ordering_;
+  }
+
+  /**
+   * Sets the ordering of the vector. The ordering
+   * must match the stored item indices, so it can
+   * only be changed while the vector is empty.
+   *
+   * @param ordering The new ordering.
+   * @throws object_exception if the vector isn't empty.
+   */
+  void ordering(vector_ordering ordering)
+  {
+    if (!object_vector_.empty()) {
+      throw object_exception("couldn't change ordering of a non empty vector");
+    }
+    ordering_ = ordering;
+  }
+
   /**
    * Return the begin iterator of the vector.
    *
@@ -356,14 +406,161 @@ protected:
     }
   }
 
+  /**
+   * Append a loaded proxy serializable with its
+   * gapped ordering key. The items are loaded in
+   * primary key order, they are sorted by their
+   * keys once in finish_append().
+   *
+   * @param key The ordering key of the item.
+   * @param proxy The object_proxy to append.
+   */
+  void append_proxy_ordered(key_type key, object_proxy *proxy)
+  {
+    if (!object_vector_.empty() && item_key(object_vector_.end() - 1) > key) {
+      unsorted_ = true;
+    }
+    object_vector_.push_back(item_holder(proxy));
+  }
+
+  virtual void finish_append()
+  {
+    if (!unsorted_) {
+      return;
+    }
+    unsorted_ = false;
+    std::vector<std::pair<key_type, item_holder> > items;
+    items.reserve(object_vector_.size());
+    for (const_iterator i = object_vector_.begin(); i != object_vector_.end(); ++i) {
+      items.push_back(std::make_pair(item_key(i), *i));
+    }
+    std::stable_sort(items.begin(), items.end(), [](const std::pair<key_type, item_holder> &a, const std::pair<key_type, item_holder> &b) {
+      return a.first < b.first;
+    });
+    for (size_type i = 0; i < items.size(); ++i) {
+      object_vector_[i] = items[i].second;
+    }
+  }
+
+  /**
+   * Returns the gapped ordering key for a new item
+   * inserted before the given position. If the
+   * neighbours have no free key in between, the
+   * items of the smallest sparse enough key range
+   * around the position are relabeled evenly.
+   *
+   * @param pos The position where the item will be inserted.
+   * @return The ordering key for the new item.
+   * @throws object_exception if all keys are exhausted.
+   */
+  key_type next_key(iterator pos)
+  {
+    const unsigned int bits = key_bits();
+    const key_type limit = key_type(1) << bits;
+    const key_type gap = key_type(1) << (bits / 2);
+
+    size_type p = (size_type)(pos - object_vector_.begin());
+    size_type n = object_vector_.size();
+
+    bool has_lo = p > 0;
+    key_type lo = has_lo ? item_key(pos - 1) : 0;
+    key_type hi = p < n ? item_key(pos) : limit;
+    key_type first = has_lo ? lo + 1 : 0;
+
+    if (first < hi) {
+      key_type key = first + (hi - first) / 2;
+      if (p == n && (!has_lo || hi - lo > gap)) {
+        // append, keep room behind the item
+        key = has_lo ? lo + gap : gap;
+      } else if (p == 0 && hi > gap) {
+        // prepend, keep room in front of the item
+        key = hi - gap;
+      }
+      return key;
+    }
+
+    /*
+     * no free key: find the smallest aligned key range
+     * around the position with a density below 1/1.5^i
+     * and spread its items including the new one evenly
+     */
+    const key_type anchor = has_lo ? lo : hi;
+    size_type a = p;
+    size_type b = p;
+    double threshold = 1.0;
+    for (unsigned int i = 1; i <= bits; ++i) {
+      threshold *= 1.5;
+      key_type range = key_type(1) << i;
+      key_type wlo = anchor & ~(range - 1);
+      key_type whi = wlo + range;
+      while (a > 0 && item_key(object_vector_.begin() + (a - 1)) >= wlo) {
+        --a;
+      }
+      while (b < n && item_key(object_vector_.begin() + b) < whi) {
+        ++b;
+      }
+      key_type count = b - a + 1;
+      if ((double)count * threshold > (double)range && (i < bits || count > range)) {
+        continue;
+      }
+      key_type spacing = range / count;
+      key_type key = wlo + spacing / 2;
+      key_type new_key = 0;
+      for (size_type j = a; j <= b; ++j) {
+        if (j == p) {
+          new_key = key;
+          key += spacing;
+        }
+        if (j == b) {
+          break;
+        }
+        iterator k = object_vector_.begin() + j;
+        if (item_key(k) != key) {
+          item_key(k, key);
+        }
+        key += spacing;
+      }
+      return new_key;
+    }
+    throw object_exception("object_vector ordering keys exhausted");
+  }
+
+  /**
+   * Returns the ordering key of an item.
+   *
+   * @param i The iterator of the item.
+   * @return The ordering key.
+   */
+  virtual key_type item_key(const_iterator i) const = 0;
+
+  /**
+   * Sets the ordering key of an item
+   * and marks the item as modified.
+   *
+   * @param i The iterator of the item.
+   * @param key The new ordering key.
+   */
+  virtual void item_key(iterator i, key_type key) = 0;
+
+  /**
+   * Returns the number of bits usable
+   * for gapped ordering keys.
+   *
+   * @return The number of key bits.
+   */
+  virtual unsigned int key_bits() const = 0;
+
 private:
   virtual void reset()
   {
     object_vector_.clear();
+    unsorted_ = false;
   }
 
 private:
   vector_type object_vector_;
+  vector_ordering ordering_;
+  bool unsorted_ = false;
 };
 
 ///@cond OOS_DEV
@@ -549,6 +746,7 @@ public:
   typedef typename base_vector::size_type size_type;           /**< Shortcut for the size type. */
   typedef typename base_vector::iterator iterator;             /**< Shortcut for the iterator. */
   typedef typename base_vector::const_iterator const_iterator; /**< Shortcut for the const iterator. */
+  typedef typename base_vector::key_type key_type;             /**< Shortcut for the ordering key type. */
 
 public:
   /**
@@ -556,13 +754,17 @@ public:
    *
    * Creates an empty vector. The parent reference
    * and the index is holded by the item itself.
+   * With GAPPED_ORDERING the int index holds
+   * the ordering key of the item.
    *
    * @param f1 The parent reference setter function.
    * @param f2 The index setter function.
    * @param f3 The index getter function.
+   * @param ordering The ordering of the vector.
    */
-  object_vector(FUNC1 f1, FUNC2 f2, FUNC3 f3)
-    : ref_setter(std::mem_fn(f1))
+  object_vector(FUNC1 f1, FUNC2 f2, FUNC3 f3, vector_ordering ordering = DENSE_ORDERING)
+    : base_vector(ordering)
+    , ref_setter(std::mem_fn(f1))
     , int_setter(std::mem_fn(f2))
     , int_getter(std::mem_fn(f3))
   {}
@@ -588,6 +790,12 @@ public:
       this->mark_modified(this->owner());
 //      this->mark_modified(this->parent());
       ref_setter(*x.get(), parent_ref(this->owner()));
+      if (this->ordering() == GAPPED_ORDERING) {
+        // key between the neighbours, successors are untouched
+        this->mark_modified(this->proxy(x));
+        int_setter(*x.get(), (size_t)this->next_key(pos));
+        return this->vector().insert(pos, x);
+      }
       // insert new item serializable
       pos = this->vector().insert(pos, x);
       iterator first = pos;
@@ -652,6 +860,9 @@ protected:
 
   virtual void adjust_index(iterator i)
   {
+    if (this->ordering() == GAPPED_ORDERING) {
+      return;
+    }
 //    iterator j = this->begin();
     iterator j = this->vector().begin();
     size_t start = static_cast<size_t>(std::distance(j, i));
@@ -670,9 +881,32 @@ protected:
     size_t index = this->size();
     if (proxy->obj()) {
       index = int_getter(*static_cast<value_type*>(proxy->obj()));
+      if (this->ordering() == GAPPED_ORDERING) {
+        this->append_proxy_ordered(index, proxy);
+        return;
+      }
     }
     this->insert_proxy(index, proxy);
   }
+
+  virtual key_type item_key(const_iterator i) const
+  {
+    const value_type *item = (*i).get();
+    return item ? (key_type)int_getter(*item) : 0;
+  }
+
+  virtual void item_key(iterator i, key_type key)
+  {
+    // mark item serializable as modified
+    this->mark_modified(this->proxy(*i));
+    int_setter(*(*i).get(), (size_t)key);
+  }
+
+  virtual unsigned int key_bits() const
+  {
+    // the index is an int
+    return 30;
+  }
 ///@endcond
 
 private:
@@ -718,6 +952,7 @@ public:
   typedef typename base_vector::size_type size_type;                                                                      /**< Shortcut for the size type. */
   typedef typename base_vector::iterator iterator;                                                                        /**< Shortcut for the iterator. */
   typedef typename base_vector::const_iterator const_iterator;                                                            /**< Shortcut for the const iterator. */
+  typedef typename base_vector::key_type key_type;                                                                        /**< Shortcut for the ordering key type. */
 
 public:
   /**
@@ -730,9 +965,11 @@ public:
    * @param parent The parent serializable.
    * @param f1 The parent reference setter function.
    * @param f2 The index setter function.
+   * @param ordering The ordering of the vector.
    */
-  explicit object_vector(FUNC1 f1 = 0, FUNC2 f2 = 0)
-    : str_setter(std::mem_fn(f1))
+  explicit object_vector(FUNC1 f1 = 0, FUNC2 f2 = 0, vector_ordering ordering = DENSE_ORDERING)
+    : base_vector(ordering)
+    , str_setter(std::mem_fn(f1))
     , int_setter(std::mem_fn(f2))
   {}
 
@@ -753,6 +990,12 @@ public:
     if (!object_container::ostore()) {
       throw object_exception("invalid object_store pointer");
     } else {
+      if (this->ordering() == GAPPED_ORDERING) {
+        // key between the neighbours, successors are untouched
+        item_ptr item = this->ostore()->insert(new item_type(parent_ref(this->owner()), (typename item_type::size_type)this->next_key(pos), x));
+        this->mark_modified(this->owner());
+        return this->vector().insert(pos, item);
+      }
       // determine index
       iterator last = this->vector().end();
       typename item_type::size_type index = this->vector().size();
@@ -818,6 +1061,9 @@ protected:
 
   void adjust_index(iterator i)
   {
+    if (this->ordering() == GAPPED_ORDERING) {
+      return;
+    }
     size_t start = i - this->begin();
 
     while (i != this->vector().end()) {
@@ -833,10 +1079,33 @@ protected:
     size_t index = this->size();
     if (proxy->obj()) {
       index = static_cast<item_type*>(proxy->obj())->index();
+      if (this->ordering() == GAPPED_ORDERING) {
+        this->append_proxy_ordered(index, proxy);
+        return;
+      }
     }
     this->insert_proxy(index, proxy);
   }
 
+  virtual key_type item_key(const_iterator i) const
+  {
+    const item_type *item = (*i).get();
+    return item ? (key_type)item->index() : 0;
+  }
+
+  virtual void item_key(iterator i, key_type key)
+  {
+    // mark item serializable as modified
+    this->mark_modified(this->proxy(*i));
+    (*i)->index((typename item_type::size_type)key);
+  }
+
+  virtual unsigned int key_bits() const
+  {
+    // keep the keys within a signed 64 bit column
+    return sizeof(typename item_type::size_type) >= 8 ? 62 : 30;
+  }
+
 ///@endcond
 
 private:
@@ -24,8 +24,11 @@
 #include "object/object_exception.hpp"
 #include "object/prototype_node.hpp"
 
+#include "tools/prefetch.hpp"
+
 #include <sstream>
 #include <algorithm>
+#include <vector>
 
 namespace oos {
 
@@ -35,13 +38,149 @@ template < class T > class const_object_view_iterator;
 
 /// @cond OOS_DEV
 
+namespace detail {
+
+/**
+ * @class view_position
+ * @brief Position of a view iterator
+ *
+ * A view_position walks the dense proxy arrays of
+ * a prototype_node and (unless siblings are skipped)
+ * of all nodes below it in depth first order, the
+ * holes of removed proxies are skipped. The end
+ * position has no current node.
+ *
+ * While walking the position prefetches the upcoming
+ * proxies and their objects, so the cache misses of
+ * the following elements overlap with the processing
+ * of the current element.
+ */
+class view_position
+{
+public:
+  view_position()
+  {}
+
+  view_position(prototype_node *root, prototype_node *node, std::size_t index, bool skip_siblings)
+    : root_(root)
+    , node_(node)
+    , index_(index)
+    , skip_siblings_(skip_siblings)
+  {}
+
+  static view_position begin(prototype_node *root, bool skip_siblings)
+  {
+    view_position pos(root, root, 0, skip_siblings);
+    pos.skip_holes();
+    pos.prefetch();
+    return pos;
+  }
+
+  static view_position end(prototype_node *root, bool skip_siblings)
+  {
+    return view_position(root, nullptr, 0, skip_siblings);
+  }
+
+  bool operator==(const view_position &x) const
+  {
+    return node_ == x.node_ && index_ == x.index_;
+  }
+
+  void increment()
+  {
+    if (!node_) {
+      return;
+    }
+    ++index_;
+    skip_holes();
+    prefetch();
+  }
+
+  void decrement()
+  {
+    prototype_node *node = node_;
+    std::size_t index = index_;
+    if (!node) {
+      // start behind the last node of the view
+      node = skip_siblings_ ? root_ : root_->last_subtree_node();
+      index = node->proxy_array.size();
+    }
+    for (;;) {
+      while (index > 0 && node->proxy_array[index - 1] == nullptr) {
+        --index;
+      }
+      if (index > 0) {
+        break;
+      }
+      node = skip_siblings_ ? nullptr : node->previous_subtree_node(root_);
+      if (!node) {
+        // already at the first element
+        return;
+      }
+      index = node->proxy_array.size();
+    }
+    node_ = node;
+    index_ = index - 1;
+  }
+
+  object_proxy* proxy() const
+  {
+    return node_->proxy_array[index_];
+  }
+
+private:
+  /*
+   * moves to the next proxy at or behind the
+   * current position, the holes of removed
+   * proxies and empty nodes are skipped
+   */
+  void skip_holes()
+  {
+    while (node_) {
+      const std::vector<object_proxy*> &proxies = node_->proxy_array;
+      while (index_ < proxies.size() && proxies[index_] == nullptr) {
+        ++index_;
+      }
+      if (index_ < proxies.size()) {
+        return;
+      }
+      index_ = 0;
+      node_ = skip_siblings_ ? nullptr : node_->next_subtree_node(root_);
+    }
+  }
+
+  void prefetch() const
+  {
+    if (!node_) {
+      return;
+    }
+    // the proxies are fetched ahead of their objects
+    const std::vector<object_proxy*> &proxies = node_->proxy_array;
+    if (index_ + 8 < proxies.size()) {
+      oos::prefetch(proxies[index_ + 8]);
+    }
+    if (index_ + 4 < proxies.size() && proxies[index_ + 4]) {
+      oos::prefetch(proxies[index_ + 4]->obj());
+    }
+  }
+
+private:
+  prototype_node *root_ = nullptr;
+  prototype_node *node_ = nullptr;
+  std::size_t index_ = 0;
+  bool skip_siblings_ = false;
+};
+
+}
+
 /**
  * @class object_view_iterator
  * @brief Iterator class for an object_view
  * @tparam T Object type of the iterator
  * 
  * This iterator is used by the object_view
- * class.
+ * class. It walks the dense proxy arrays of
+ * the prototype nodes.
  */
 template < class T >
 class object_view_iterator : public std::iterator<std::bidirectional_iterator_tag, T>
@@ -52,174 +191,78 @@ public:
   typedef T* pointer;                   /**< Shortcut for the pointer type. */
   typedef value_type& reference ;       /**< Shortcut for the reference type */
 
-  /**
-   * Creates an empty iterator
-   */
   object_view_iterator()
   {}
   
-  /**
-   * @brief Creates a iterator for a concrete type.
-   * 
-   * This constructor creates an iterator for a concrete
-   * type and a concrete serializable.
-   * 
-   * @param node The prototype_node of the object_proxy
-   * @param current The object_proxy for the iterator
-   * @param last The last object_proxy for the iterator
-   */
-  object_view_iterator(const prototype_iterator &node, object_proxy *current, object_proxy *last)
-    : node_(node)
-    , current_(current)
-    , last_(last)
+  explicit object_view_iterator(const detail::view_position &pos)
+    : pos_(pos)
   {}
 
-  /**
-   * Copy from a given object_view_iterator.
-   * 
-   * @param x The object_view_iterator to copy from.
-   */
   object_view_iterator(const object_view_iterator &x)
-    : node_(x.node_)
-    , current_(x.current_)
-    , last_(x.last_)
+    : pos_(x.pos_)
   {}
 
-  /**
-   * Assign from a given object_view_iterator.
-   * 
-   * @param x The object_view_iterator to assign from.
-   * @return The assigned object_view_iterator.
-   */
   object_view_iterator& operator=(const object_view_iterator &x)
   {
-    node_ = x.node_;
-    current_ = x.current_;
-    last_ = x.last_;
+    pos_ = x.pos_;
     return *this;
   }
 
   ~object_view_iterator() {}
 
-  /**
-   * @brief Compares this with another iterators.
-   * 
-   * Compares this with another iterators. Returns true
-   * if the iterators current object_proxy are the same.
-   *
-   * @param i The iterator to compare with.
-   * @return True if the iterators are the same.
-   */
   bool operator==(const object_view_iterator &i) const {
-    return (current_ == i.current_);
+    return pos_ == i.pos_;
   }
 
-  /**
-   * @brief Compares this with another iterators.
-   * 
-   * Compares this with another iterators. Returns true
-   * if the iterators current object_proxy are not the same.
-   *
-   * @param i The iterator to compare with.
-   * @return True if the iterators are not the same.
-   */
   bool operator!=(const object_view_iterator &i) const {
-    return (current_ != i.current_);
+    return !(pos_ == i.pos_);
   }
 
-  /**
-   * Pre increments the iterator
-   * 
-   * @return Returns iterators successor.
-   */
   self& operator++() {
-    increment();
+    pos_.increment();
     return *this;
   }
 
-  /**
-   * Post increments the iterator
-   * 
-   * @return Returns iterator before incrementing.
-   */
   self operator++(int) {
-    object_proxy *tmp = current_;
-    increment();
-    return object_view_iterator(node_, tmp, last_);
+    self tmp(*this);
+    pos_.increment();
+    return tmp;
   }
 
-  /**
-   * Pre increments the iterator
-   * 
-   * @return Returns iterators predeccessor.
-   */
   self& operator--() {
-    decrement();
+    pos_.decrement();
     return *this;
   }
 
-  /**
-   * Post decrements the iterator
-   * 
-   * @return Returns iterator before decrementing.
-   */
   self operator--(int) {
-    object_proxy *tmp = current_;
-    decrement();
-    return object_view_iterator(node_, tmp, last_);
+    self tmp(*this);
+    pos_.decrement();
+    return tmp;
   }
 
-  /**
-   * Returns the pointer to the node.
-   * 
-   * @return The pointer to the node.
-   */
   pointer operator->() const
   {
-    return static_cast<pointer>(current_);
+    return static_cast<pointer>(pos_.proxy()->obj());
   }
 
-  /**
-   * Returns the node.
-   * 
-   * @return The iterators underlaying node.
-   */
   value_type operator*() const
   {
     return this->optr();
   }
 
-  /**
-   * Returns the node as object_ptr.
-   * 
-   * @return The iterators underlaying node as object_ptr.
-   */
   value_type optr() const
   {
-    if (current_->obj())
-      return value_type(current_);
+    object_proxy *proxy = pos_.proxy();
+    if (proxy->obj())
+      return value_type(proxy);
     else
       return value_type();
   }
 
-private:
-  void increment() {
-    if (current_ != last_) {
-      current_ = current_->next();
-    }
-  }
-  void decrement() {
-    if (current_ != node_->op_first) {
-      current_ = current_->prev();
-    }
-  }
-
 private:
   friend class const_object_view_iterator<T>;
 
-  prototype_iterator node_;
-  object_proxy *current_;
-  object_proxy *last_;
+  detail::view_position pos_;
 };
 
 /**
@@ -228,7 +271,8 @@ private:
  * @tparam T Object type of the iterator
  * 
  * This iterator is used by the object_view
- * class.
+ * class. It walks the dense proxy arrays of
+ * the prototype nodes.
  */
 template < class T >
 class const_object_view_iterator : public std::iterator<std::bidirectional_iterator_tag, T, std::ptrdiff_t, const T*, const T&>
@@ -239,196 +283,85 @@ public:
   typedef T* pointer;                         /**< Shortcut for the pointer type. */
   typedef value_type& reference ;             /**< Shortcut for the reference type */
 
-  /**
-   * Creates an empty iterator
-   */
   const_object_view_iterator()
   {}
 
-  /**
-   * @brief Creates a iterator for a concrete type.
-   * 
-   * This constructor creates an iterator for a concrete
-   * type and a concrete serializable.
-   * 
-   * @param node The prototype_node of the object_proxy
-   * @param current The object_proxy for the iterator
-   * @param last The last object_proxy for the iterator
-   */
-  const_object_view_iterator(const prototype_iterator &node, object_proxy *current, object_proxy *last)
-    : node_(node)
-    , current_(current)
-    , last_(last)
+  explicit const_object_view_iterator(const detail::view_position &pos)
+    : pos_(pos)
   {}
 
-  /**
-   * Copy from a given const_object_view_iterator.
-   * 
-   * @param x The const_object_view_iterator to copy from.
-   */
   const_object_view_iterator(const const_object_view_iterator &x)
-    : node_(x.node_)
-    , current_(x.current_)
-    , last_(x.last_)
+    : pos_(x.pos_)
   {}
 
-  /**
-   * Copy from a given object_view_iterator.
-   * 
-   * @param x The object_view_iterator to copy from.
-   */
   const_object_view_iterator(const object_view_iterator<T> &x)
-    : node_(x.node_)
-    , current_(x.current_)
-    , last_(x.last_)
+    : pos_(x.pos_)
   {}
 
-  /**
-   * Assign from a given const_object_view_iterator.
-   * 
-   * @param x The const_object_view_iterator to assign from.
-   * @return The assigned const_object_view_iterator.
-   */
   const_object_view_iterator& operator=(const const_object_view_iterator &x)
   {
-    node_ = x.node_;
-    current_ = x.current_;
-    last_ = x.last_;
+    pos_ = x.pos_;
     return *this;
   }
 
-  /**
-   * Assign from a given object_view_iterator.
-   * 
-   * @param x The object_view_iterator to assign from.
-   * @return The assigned const_object_view_iterator.
-   */
   const_object_view_iterator& operator=(const object_view_iterator<T> &x)
   {
-    node_ = x.node_;
-    current_ = x.current_;
-    last_ = x.last_;
+    pos_ = x.pos_;
     return *this;
   }
 
   ~const_object_view_iterator() {}
 
-  /**
-   * @brief Compares this with another iterators.
-   * 
-   * Compares this with another iterators. Returns true
-   * if the iterators current object_proxy are the same.
-   *
-   * @param i The iterator to compare with.
-   * @return True if the iterators are the same.
-   */
   bool operator==(const const_object_view_iterator &i) const {
-    return (current_ == i.current_);
+    return pos_ == i.pos_;
   }
 
-  /**
-   * @brief Compares this with another iterators.
-   * 
-   * Compares this with another iterators. Returns true
-   * if the iterators current object_proxy are not the same.
-   *
-   * @param i The iterator to compare with.
-   * @return True if the iterators are not the same.
-   */
   bool operator!=(const const_object_view_iterator &i) const {
-    return (current_ != i.current_);
+    return !(pos_ == i.pos_);
   }
 
-  /**
-   * Pre increments the iterator
-   * 
-   * @return Returns iterators successor.
-   */
   self& operator++() {
-    increment();
+    pos_.increment();
     return *this;
   }
 
-  /**
-   * Post increments the iterator
-   * 
-   * @return Returns iterator before incrementing.
-   */
   self operator++(int) {
-    object_proxy *tmp = current_;
-    increment();
-    return const_object_view_iterator(node_, tmp, last_);
+    self tmp(*this);
+    pos_.increment();
+    return tmp;
   }
 
-  /**
-   * Pre increments the iterator
-   * 
-   * @return Returns iterators predeccessor.
-   */
   self& operator--() {
-    decrement();
+    pos_.decrement();
     return *this;
   }
 
-  /**
-   * Post decrements the iterator
-   * 
-   * @return Returns iterator before decrementing.
-   */
   self operator--(int) {
-    object_proxy *tmp = current_;
-    decrement();
-    return const_object_view_iterator(node_, tmp, last_);
+    self tmp(*this);
+    pos_.decrement();
+    return tmp;
   }
 
-  /**
-   * Returns the pointer to the node.
-   * 
-   * @return The pointer to the node.
-   */
   pointer operator->() const
   {
-    return static_cast<pointer>(current_);
+    return static_cast<pointer>(pos_.proxy()->obj());
   }
 
-  /**
-   * Returns the node.
-   * 
-   * @return The iterators underlaying node.
-   */
   value_type operator*() const
   {
     return this->optr();
   }
 
-  /**
-   * Returns the node as object_ptr.
-   * 
-   * @return The iterators underlaying node as object_ptr.
-   */
   value_type optr() const {
-    if (current_->obj())
-      return value_type(current_);
+    object_proxy *proxy = pos_.proxy();
+    if (proxy->obj())
+      return value_type(proxy);
     else
       return value_type();
   }
 
 private:
-  void increment() {
-    if (current_ != last_) {
-      current_ = current_->next();
-    }
-  }
-  void decrement() {
-    if (current_ != node_->op_first) {
-      current_ = current_->prev();
-    }
-  }
-
-private:
-  const_prototype_iterator node_;
-  object_proxy *current_;
-  object_proxy *last_;
+  detail::view_position pos_;
 };
 /// @endcond
 
@@ -442,7 +375,8 @@ private:
  * with the base class oos::serializable.
  * When creating it is possible to have the view only over
  * the given type or over the complete subset of objects including
- * child objects.
+ * child objects. The iteration order is the same as of
+ * the object_view.
  */
 
 class generic_view
@@ -483,11 +417,7 @@ public:
    * @return The begin iterator.
    */
   iterator begin() {
-    if (skip_siblings_) {
-      return ++iterator(node_, node_->op_first, node_->op_marker);
-    } else {
-      return ++iterator(node_, node_->op_first, node_->op_last);
-    }
+    return iterator(detail::view_position::begin(node_.get(), skip_siblings_));
   }
 
   /**
@@ -496,11 +426,7 @@ public:
    * @return The begin iterator.
    */
   const_iterator begin() const {
-    if (skip_siblings_) {
-      return ++const_iterator(node_, node_->op_first, node_->op_marker);
-    } else {
-      return ++const_iterator(node_, node_->op_first, node_->op_last);
-    }
+    return const_iterator(detail::view_position::begin(node_.get(), skip_siblings_));
   }
 
   /**
@@ -509,11 +435,7 @@ public:
    * @return The end iterator.
    */
   iterator end() {
-    if (skip_siblings_) {
-      return iterator(node_, node_->op_marker, node_->op_marker);
-    } else {
-      return iterator(node_, node_->op_last, node_->op_last);
-    }
+    return iterator(detail::view_position::end(node_.get(), skip_siblings_));
   }
 
   /**
@@ -522,11 +444,7 @@ public:
    * @return The end iterator.
    */
   const_iterator end() const {
-    if (skip_siblings_) {
-      return const_iterator(node_, node_->op_marker, node_->op_marker);
-    } else {
-      return const_iterator(node_, node_->op_last, node_->op_last);
-    }
+    return const_iterator(detail::view_position::end(node_.get(), skip_siblings_));
   }
 
   /**
@@ -557,7 +475,7 @@ public:
    * @return True if object_view is empty.
    */
   bool empty() const {
-    return node_->op_first->next() == node_->op_last;
+    return node_->empty(skip_siblings_);
   }
 
   /**
@@ -607,6 +525,26 @@ public:
     return std::find_if(begin(), end(), pred);
   }
 
+  /**
+   * Appends the object_proxy of each object
+   * of the view to the given vector. The vector
+   * is a snapshot of the view which can e.g. be
+   * partitioned for parallel processing.
+   *
+   * @param proxies The vector to append to.
+   */
+  void proxies(std::vector<object_proxy*> &proxies) const
+  {
+    prototype_node *root = node_.get();
+    for (prototype_node *node = root; node; node = skip_siblings_ ? nullptr : node->next_subtree_node(root)) {
+      for (std::vector<object_proxy*>::const_iterator i = node->proxy_array.begin(); i != node->proxy_array.end(); ++i) {
+        if (*i && (*i)->obj()) {
+          proxies.push_back(*i);
+        }
+      }
+    }
+  }
+
   /**
    * Return the underlaying prototype node
    *
@@ -631,6 +569,18 @@ private:
  * When creating it is possible to have the view only over
  * the given type or over the complete subset of objects including
  * child objects.
+ *
+ * The view iterates the contiguous proxy arrays of the
+ * prototype nodes: first the objects of the type itself,
+ * then the objects of each child type. The objects of a
+ * type keep the order of the object store's proxy list.
+ * Like in the list a new object is placed before the last
+ * object of its type, which moves one position back. So
+ * inserting while iterating changes the element of an
+ * iterator pointing to the last object to the new object,
+ * the moved object is visited after it. Removing objects
+ * while iterating may skip objects once the holes of the
+ * removed objects are compacted.
  */
 template < class T >
 class object_view
@@ -667,11 +617,7 @@ public:
    * @return The begin iterator.
    */
   iterator begin() {
-    if (skip_siblings_) {
-      return ++iterator(node_, node_->op_first, node_->op_marker);
-    } else {
-      return ++iterator(node_, node_->op_first, node_->op_last);
-    }
+    return iterator(detail::view_position::begin(node_.get(), skip_siblings_));
   }
 
   /**
@@ -680,11 +626,7 @@ public:
    * @return The begin iterator.
    */
   const_iterator begin() const {
-    if (skip_siblings_) {
-      return ++const_iterator(node_, node_->op_first, node_->op_marker);
-    } else {
-      return ++const_iterator(node_, node_->op_first, node_->op_last);
-    }
+    return const_iterator(detail::view_position::begin(node_.get(), skip_siblings_));
   }
 
   /**
@@ -693,11 +635,7 @@ public:
    * @return The end iterator.
    */
   iterator end() {
-    if (skip_siblings_) {
-      return iterator(node_, node_->op_marker, node_->op_marker);
-    } else {
-      return iterator(node_, node_->op_last, node_->op_last);
-    }
+    return iterator(detail::view_position::end(node_.get(), skip_siblings_));
   }
 
   /**
@@ -706,11 +644,7 @@ public:
    * @return The end iterator.
    */
   const_iterator end() const {
-    if (skip_siblings_) {
-      return const_iterator(node_, node_->op_marker, node_->op_marker);
-    } else {
-      return const_iterator(node_, node_->op_last, node_->op_last);
-    }
+    return const_iterator(detail::view_position::end(node_.get(), skip_siblings_));
   }
 
   /**
@@ -741,7 +675,7 @@ public:
    * @return True if object_view is empty.
    */
   bool empty() const {
-    return node_->op_first->next() == node_->op_last;
+    return node_->empty(skip_siblings_);
   }
 
   /**
@@ -791,6 +725,26 @@ public:
     return std::find_if(begin(), end(), pred);
   }
 
+  /**
+   * Appends the object_proxy of each object
+   * of the view to the given vector. The vector
+   * is a snapshot of the view which can e.g. be
+   * partitioned for parallel processing.
+   *
+   * @param proxies The vector to append to.
+   */
+  void proxies(std::vector<object_proxy*> &proxies) const
+  {
+    prototype_node *root = node_.get();
+    for (prototype_node *node = root; node; node = skip_siblings_ ? nullptr : node->next_subtree_node(root)) {
+      for (std::vector<object_proxy*>::const_iterator i = node->proxy_array.begin(); i != node->proxy_array.end(); ++i) {
+        if (*i && (*i)->obj()) {
+          proxies.push_back(*i);
+        }
+      }
+    }
+  }
+
   /**
    * Return the underlaying prototype node
    *
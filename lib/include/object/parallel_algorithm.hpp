@@ -0,0 +1,236 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARALLEL_ALGORITHM_HPP
+#define PARALLEL_ALGORITHM_HPP
+
+#include "object/object_view.hpp"
+#include "object/object_proxy.hpp"
+
+#include "tools/thread_pool.hpp"
+
+#include <atomic>
+#include <vector>
+
+/**
+ * @file parallel_algorithm.hpp
+ * @brief Contains parallel algorithms over object views
+ *
+ * The algorithms take a snapshot of the object proxies
+ * of an object_view or generic_view, split it into chunks
+ * and process the chunks on a thread_pool.
+ *
+ * The functions and predicates are called concurrently
+ * with a const reference of the object. They must only
+ * read the object and must not create or copy object
+ * pointers, because the reference counting of object
+ * pointers isn't thread safe. Expressions of static
+ * variables of depth zero (see make_static_var) can be
+ * used as predicates. The object_store must not be
+ * modified while an algorithm runs.
+ */
+
+namespace oos {
+
+/// @cond OOS_DEV
+
+namespace detail {
+
+/*
+ * chunks of at least grain objects,
+ * a few chunks per thread to balance
+ * uneven work via stealing
+ */
+inline std::size_t chunk_count(std::size_t size, std::size_t grain, const thread_pool &pool)
+{
+  if (grain == 0) {
+    grain = 1;
+  }
+  std::size_t chunks = (size + grain - 1) / grain;
+  std::size_t max_chunks = (pool.size() + 1) * 4;
+  return chunks < max_chunks ? chunks : max_chunks;
+}
+
+template < class R >
+struct partial_result
+{
+  R value;
+};
+
+template < class View >
+class view_partition
+{
+public:
+  typedef typename View::object_pointer::object_type object_type;
+
+  view_partition(const View &view, std::size_t grain, const thread_pool &pool)
+  {
+    view.proxies(proxies_);
+    chunks_ = chunk_count(proxies_.size(), grain, pool);
+  }
+
+  std::size_t chunks() const { return chunks_; }
+
+  object_proxy** begin(std::size_t chunk) { return proxies_.data() + proxies_.size() * chunk / chunks_; }
+  object_proxy** end(std::size_t chunk) { return proxies_.data() + proxies_.size() * (chunk + 1) / chunks_; }
+
+  static const object_type& object(const object_proxy *proxy)
+  {
+    return *static_cast<const object_type*>(proxy->obj());
+  }
+
+private:
+  std::vector<object_proxy*> proxies_;
+  std::size_t chunks_;
+};
+
+}
+
+/// @endcond
+
+/**
+ * @brief Calls a function for each object of a view in parallel
+ *
+ * @tparam View The type of the view.
+ * @tparam Function The type of the function.
+ * @param view The view to process.
+ * @param func The function called with a const reference of each object.
+ * @param pool The thread_pool to run on.
+ * @param grain The minimum number of objects per chunk.
+ */
+template < class View, class Function >
+void parallel_for_each(const View &view, Function func, thread_pool &pool = thread_pool::instance(), std::size_t grain = 1024)
+{
+  detail::view_partition<View> partition(view, grain, pool);
+  pool.run(partition.chunks(), [&](std::size_t chunk) {
+    for (object_proxy **i = partition.begin(chunk); i != partition.end(chunk); ++i) {
+      func(partition.object(*i));
+    }
+  });
+}
+
+/**
+ * @brief Counts the objects of a view matching a predicate in parallel
+ *
+ * @tparam View The type of the view.
+ * @tparam Predicate The type of the predicate.
+ * @param view The view to process.
+ * @param pred The predicate called with a const reference of each object.
+ * @param pool The thread_pool to run on.
+ * @param grain The minimum number of objects per chunk.
+ * @return The number of matching objects.
+ */
+template < class View, class Predicate >
+std::size_t parallel_count_if(const View &view, Predicate pred, thread_pool &pool = thread_pool::instance(), std::size_t grain = 1024)
+{
+  detail::view_partition<View> partition(view, grain, pool);
+  std::vector<std::size_t> counts(partition.chunks(), 0);
+  pool.run(partition.chunks(), [&](std::size_t chunk) {
+    std::size_t count = 0;
+    for (object_proxy **i = partition.begin(chunk); i != partition.end(chunk); ++i) {
+      if (pred(partition.object(*i))) {
+        ++count;
+      }
+    }
+    counts[chunk] = count;
+  });
+  std::size_t count = 0;
+  for (std::vector<std::size_t>::const_iterator i = counts.begin(); i != counts.end(); ++i) {
+    count += *i;
+  }
+  return count;
+}
+
+/**
+ * @brief Finds any object of a view matching a predicate in parallel
+ *
+ * In contrast to find_if the returned object isn't
+ * necessarily the first matching object of the view.
+ * Once an object is found the other chunks stop.
+ *
+ * @tparam View The type of the view.
+ * @tparam Predicate The type of the predicate.
+ * @param view The view to process.
+ * @param pred The predicate called with a const reference of each object.
+ * @param pool The thread_pool to run on.
+ * @param grain The minimum number of objects per chunk.
+ * @return A matching object or an empty object pointer.
+ */
+template < class View, class Predicate >
+typename View::object_pointer parallel_find_any(const View &view, Predicate pred, thread_pool &pool = thread_pool::instance(), std::size_t grain = 1024)
+{
+  detail::view_partition<View> partition(view, grain, pool);
+  std::atomic<object_proxy*> found(nullptr);
+  pool.run(partition.chunks(), [&](std::size_t chunk) {
+    for (object_proxy **i = partition.begin(chunk); i != partition.end(chunk); ++i) {
+      if (found.load(std::memory_order_relaxed)) {
+        return;
+      }
+      if (pred(partition.object(*i))) {
+        object_proxy *expected = nullptr;
+        found.compare_exchange_strong(expected, *i);
+        return;
+      }
+    }
+  });
+  object_proxy *proxy = found.load();
+  return proxy ? typename View::object_pointer(proxy) : typename View::object_pointer();
+}
+
+/**
+ * @brief Transforms the objects of a view and reduces the results in parallel
+ *
+ * The transformed values of each chunk are reduced
+ * in view order, then the chunk results are reduced
+ * in chunk order starting with the initial value.
+ * The reduction must be associative.
+ *
+ * @tparam View The type of the view.
+ * @tparam R The type of the result.
+ * @tparam Reduce The type of the reduce function.
+ * @tparam Transform The type of the transform function.
+ * @param view The view to process.
+ * @param init The initial value.
+ * @param reduce The function combining two values.
+ * @param transform The function called with a const reference of each object.
+ * @param pool The thread_pool to run on.
+ * @param grain The minimum number of objects per chunk.
+ * @return The reduced value.
+ */
+template < class View, class R, class Reduce, class Transform >
+R parallel_transform_reduce(const View &view, R init, Reduce reduce, Transform transform, thread_pool &pool = thread_pool::instance(), std::size_t grain = 1024)
+{
+  detail::view_partition<View> partition(view, grain, pool);
+  // chunks are never empty
+  std::vector<detail::partial_result<R> > results(partition.chunks(), detail::partial_result<R>{ init });
+  pool.run(partition.chunks(), [&](std::size_t chunk) {
+    object_proxy **i = partition.begin(chunk);
+    R result = transform(partition.object(*i));
+    for (++i; i != partition.end(chunk); ++i) {
+      result = reduce(result, transform(partition.object(*i)));
+    }
+    results[chunk].value = result;
+  });
+  for (typename std::vector<detail::partial_result<R> >::const_iterator i = results.begin(); i != results.end(); ++i) {
+    init = reduce(init, i->value);
+  }
+  return init;
+}
+
+}
+
+#endif /* PARALLEL_ALGORITHM_HPP */
@@ -0,0 +1,129 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PK_INDEX_HPP
+#define PK_INDEX_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include <cstddef>
+#include <vector>
+
+namespace oos {
+
+class object_proxy;
+
+/// @cond OOS_DEV
+
+/**
+ * @class pk_index
+ * @brief Maps integral primary keys to object proxies
+ *
+ * The pk_index is an open addressing hash table
+ * with linear probing. Keys and proxies are stored
+ * in one flat array, a slot without a proxy is free.
+ * Removed entries are closed by shifting the following
+ * entries back, so no tombstones are left.
+ */
+class OOS_API pk_index
+{
+public:
+  typedef long long key_type; /**< Shortcut for the key type */
+
+  pk_index();
+  ~pk_index();
+
+  /**
+   * Inserts the proxy with the given key. If
+   * the key already exists the index isn't
+   * changed and false is returned.
+   *
+   * @param key The primary key.
+   * @param proxy The proxy to insert.
+   * @return True if the proxy was inserted.
+   */
+  bool insert(key_type key, object_proxy *proxy);
+
+  /**
+   * Returns the proxy for the given key or
+   * nullptr if the key doesn't exist.
+   *
+   * @param key The primary key to find.
+   * @return The proxy or nullptr.
+   */
+  object_proxy* find(key_type key) const;
+
+  /**
+   * Removes the given key.
+   *
+   * @param key The primary key to remove.
+   * @return True if the key was removed.
+   */
+  bool erase(key_type key);
+
+  /**
+   * Removes all keys. The memory is kept.
+   */
+  void clear();
+
+  /**
+   * Returns the number of keys.
+   *
+   * @return The number of keys.
+   */
+  std::size_t size() const;
+
+  /**
+   * Returns true if the index is empty.
+   *
+   * @return True if the index is empty.
+   */
+  bool empty() const;
+
+private:
+  struct slot
+  {
+    key_type key;
+    object_proxy *proxy;
+  };
+
+  std::size_t home(key_type key) const;
+  std::size_t locate(key_type key) const;
+  void rehash(std::size_t capacity);
+
+private:
+  std::vector<slot> slots_;
+  std::size_t mask_;
+  std::size_t size_;
+};
+
+/// @endcond
+
+}
+
+#endif /* PK_INDEX_HPP */
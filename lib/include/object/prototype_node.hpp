@@ -35,12 +35,15 @@
 #include "object/identifier_resolver.hpp"
 #include "object/identifier.hpp"
 #include "object/object_producer.hpp"
+#include "object/pk_index.hpp"
+#include "object/field_table.hpp"
 
 #include <map>
 #include <list>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace oos {
 
@@ -222,6 +225,35 @@ public:
    */
   prototype_node* previous_node(const prototype_node *root) const;
 
+  /**
+   * Returns the next node of the subtree of the
+   * given root node in depth first order or nullptr
+   * if node is the last node of the subtree.
+   *
+   * @param root The root node of the subtree.
+   * @return The next node of the subtree.
+   */
+  prototype_node* next_subtree_node(const prototype_node *root) const;
+
+  /**
+   * Returns the previous node of the subtree of the
+   * given root node in depth first order or nullptr
+   * if node is the root node.
+   *
+   * @param root The root node of the subtree.
+   * @return The previous node of the subtree.
+   */
+  prototype_node* previous_subtree_node(const prototype_node *root) const;
+
+  /**
+   * Returns the last node of the subtree of this
+   * node in depth first order. If the node has no
+   * children the node itself is returned.
+   *
+   * @return The last node of the subtree.
+   */
+  prototype_node* last_subtree_node() const;
+
   /**
    * Returns true if node is child of given parent node.
    * 
@@ -254,6 +286,16 @@ public:
    */
   object_proxy* find_proxy(const std::shared_ptr<basic_identifier> &pk);
 
+  /**
+   * Find the underlying proxy of the given integral
+   * primary key. If no proxy is found nullptr is
+   * returned
+   *
+   * @param pk The integral primary key
+   * @return The corresponding object_proxy or nullptr
+   */
+  object_proxy* find_proxy(long long pk) const;
+
   /**
    * Prints the node in graphviz layout to the stream.
    * 
@@ -290,6 +332,18 @@ public:
   object_proxy *op_marker = nullptr; /**< The marker of the last list node of the own elements. */
   object_proxy *op_last = nullptr;   /**< The marker of the last list node of all elements. */
   
+  /**
+   * Holds the object proxies of this node (without
+   * the proxies of the child nodes) in a contiguous
+   * array in the order of the linked proxy list. A
+   * removed proxy leaves a hole (nullptr), the holes
+   * are compacted once they make up half of the array.
+   * The last entry is never a hole. The position of
+   * each proxy is stored in the proxy itself.
+   */
+  std::vector<object_proxy*> proxy_array;
+  std::size_t proxy_holes = 0; /**< The number of holes in the proxy array. */
+
   unsigned int depth = 0;  /**< The depth of the node inside of the tree. */
   unsigned long count = 0; /**< The total count of elements. */
 
@@ -318,14 +372,27 @@ public:
   /**
    * Holds the primary keys of all proxies in this node
    */
-  typedef std::unordered_map<pk_ptr, object_proxy*, pk_hash<pk_ptr> > t_primary_key_map;
+  typedef std::unordered_map<pk_ptr, object_proxy*, pk_hash<pk_ptr>, pk_equal> t_primary_key_map;
   t_primary_key_map primary_key_map; /**< The identifier to object_proxy map */
 
+  /**
+   * Holds the integral primary keys of all proxies
+   * in this node, other keys are held by the
+   * primary_key_map
+   */
+  pk_index integral_key_index;
+
   /**
    * a primary key prototype to clone from
    */
   std::unique_ptr<basic_identifier> primary_key;
 
+  /**
+   * the fields of the prototype for generic
+   * access by position or name
+   */
+  field_table fields;
+
   /**
    * a list of prototype_node and ids for
    * which the relation map is yet to be filled
@@ -340,6 +407,9 @@ public:
    */
   typedef std::unordered_map<std::string, std::shared_ptr<basic_identifier> > t_foreign_key_map;
   t_foreign_key_map foreign_keys; /**< The foreign key map */
+
+private:
+  void compact_proxy_array();
 };
 
 }
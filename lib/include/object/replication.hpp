@@ -0,0 +1,224 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REPLICATION_HPP
+#define REPLICATION_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include "object/change_feed.hpp"
+#include "object/object_serializer.hpp"
+
+#include "tools/byte_buffer.hpp"
+
+#include <vector>
+
+namespace oos {
+
+class object_store;
+
+/**
+ * @brief Statistics of a replication endpoint
+ *
+ * The lag is the number of records the follower
+ * is behind the leader, measured with the sequence
+ * number the leader had published when it sent
+ * the last batch.
+ */
+struct OOS_API replication_metrics
+{
+  unsigned long long records = 0;  /**< Number of transferred records */
+  unsigned long long bytes = 0;    /**< Number of transferred bytes */
+  unsigned long long batches = 0;  /**< Number of written or applied batches */
+  unsigned long long sequence = 0; /**< Sequence number of the next record */
+  unsigned long long lag = 0;      /**< Records behind the leader */
+  double seconds = 0.0;            /**< Time spent for transfer and apply */
+
+  /**
+   * Returns the number of records per second.
+   *
+   * @return The record throughput.
+   */
+  double records_per_second() const;
+
+  /**
+   * Returns the number of bytes per second.
+   *
+   * @return The byte throughput.
+   */
+  double bytes_per_second() const;
+};
+
+/**
+ * @class replication_leader
+ * @brief Sends the records of a change_feed to a follower
+ *
+ * The replication_leader reads the records of a
+ * change_feed and writes them in batches to a file
+ * descriptor (e.g. a pipe or a unix domain socket).
+ * The change_feed must be created with object images.
+ *
+ * The leader starts with the records published after
+ * its creation, the follower store is expected to hold
+ * the same objects at this point (e.g. loaded from the
+ * same database). If the follower is so slow that the
+ * feed overwrites unsent records, send() throws and
+ * the follower must be reloaded.
+ */
+class OOS_API replication_leader
+{
+public:
+  /**
+   * Creates a replication_leader for the given
+   * change_feed and file descriptor.
+   *
+   * @param feed The change_feed to replicate.
+   * @param fd The file descriptor to write to.
+   * @param batch_size Size of a written batch in bytes.
+   */
+  replication_leader(change_feed &feed, int fd, std::size_t batch_size = 1 << 16);
+
+  /**
+   * Flushes the change_feed and writes all
+   * available records to the file descriptor.
+   *
+   * @return The number of sent records.
+   * @throws object_exception on overrun or write error.
+   */
+  std::size_t send();
+
+  /**
+   * Returns the number of records published
+   * by the feed but not yet sent.
+   *
+   * @return The lag in records.
+   */
+  unsigned long long lag() const;
+
+  /**
+   * Returns the metrics of the leader.
+   *
+   * @return The metrics of the leader.
+   */
+  const replication_metrics& metrics() const;
+
+private:
+  void write_batch();
+
+private:
+  change_feed &feed_;
+  int fd_;
+  std::size_t batch_size_;
+  change_feed::cursor cursor_;
+  change_feed::record record_;
+  std::vector<char> batch_;
+  replication_metrics metrics_;
+};
+
+/**
+ * @class replication_follower
+ * @brief Applies the records of a replication_leader
+ *
+ * The replication_follower reads the records written
+ * by a replication_leader from a file descriptor and
+ * applies them to its object_store. Each call of receive()
+ * reads what is available (up to the batch size) and
+ * applies all complete records in one go.
+ *
+ * Objects are created and inserted via their proxies,
+ * so object pointers to objects which are replicated
+ * later are wired as soon as the referenced object
+ * arrives. The observers of the follower store are
+ * notified as usual.
+ */
+class OOS_API replication_follower
+{
+public:
+  /**
+   * Creates a replication_follower for the given
+   * object_store and file descriptor.
+   *
+   * @param ostore The object_store to apply the records to.
+   * @param fd The file descriptor to read from.
+   * @param batch_size Size of a read batch in bytes.
+   */
+  replication_follower(object_store &ostore, int fd, std::size_t batch_size = 1 << 16);
+
+  /**
+   * Reads the next batch from the file descriptor
+   * and applies all complete records. Blocks until
+   * data is available.
+   *
+   * @return The number of applied records.
+   * @throws object_exception on read error or sequence gap.
+   */
+  std::size_t receive();
+
+  /**
+   * Receives and applies records until the
+   * leader closes the file descriptor.
+   *
+   * @return The number of applied records.
+   */
+  std::size_t run();
+
+  /**
+   * Returns true if the leader closed
+   * the file descriptor.
+   *
+   * @return True on end of stream.
+   */
+  bool eof() const;
+
+  /**
+   * Returns the metrics of the follower.
+   *
+   * @return The metrics of the follower.
+   */
+  const replication_metrics& metrics() const;
+
+private:
+  void apply(change_feed::action_type action, unsigned long id, const char *type, const char *image, std::size_t image_size);
+
+private:
+  object_store &ostore_;
+  int fd_;
+  std::vector<char> buffer_;
+  std::size_t size_ = 0;
+  bool eof_ = false;
+  bool first_ = true;
+
+  object_serializer serializer_;
+  byte_buffer image_;
+  std::string type_;
+  replication_metrics metrics_;
+};
+
+}
+
+#endif /* REPLICATION_HPP */
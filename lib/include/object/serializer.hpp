@@ -40,6 +40,9 @@ class object_base_ptr;
 class basic_identifier;
 class date;
 class time;
+class blob;
+
+class basic_value_vector;
 
 /**
  * @class serializer
@@ -248,6 +251,18 @@ public:
    */
 	virtual void write(const char*, const time&) = 0;
 
+  /**
+   * @fn virtual void write(const char *id, const blob &x)
+   * @brief Write a blob to the atomizer.
+   *
+   * Write a blob to the atomizer
+   * identified by a unique name.
+   *
+   * @param id Unique id of the data.
+   * @param x The data to read from.
+   */
+	virtual void write(const char*, const blob&) = 0;
+
   /**
    * @fn virtual void write(const char *id, const object_base_ptr &x)
    * @brief Write a object_base_ptr to the atomizer.
@@ -283,6 +298,19 @@ public:
    * @param x The data to read from.
    */
   virtual void write(const char*, const basic_identifier &) = 0;
+
+  /**
+   * @fn virtual void write(const char *id, const basic_value_vector &x)
+   * @brief Write a value_vector to the atomizer.
+   *
+   * A value_vector isn't a single value, by default
+   * it is ignored. Atomizers handling the elements
+   * (e.g. the object store backup) override this.
+   *
+   * @param id Unique id of the data.
+   * @param x The data to read from.
+   */
+  virtual void write(const char*, const basic_value_vector&) {}
 };
 
 /**
@@ -326,6 +354,7 @@ public:
   virtual void write(const char *id, const varchar_base &x) { generic_writer_->write_value(id, x); }
   virtual void write(const char *id, const date &x) { generic_writer_->write_value(id, x); }
   virtual void write(const char *id, const time &x) { generic_writer_->write_value(id, x); }
+  virtual void write(const char *id, const blob &x) { generic_writer_->write_value(id, x); }
   virtual void write(const char *id, const object_base_ptr &x) { generic_writer_->write_value(id, x); }
   virtual void write(const char *id, const object_container &x) { generic_writer_->write_value(id, x); }
   virtual void write(const char *id, const basic_identifier &x) { generic_writer_->write_value(id, x); }
@@ -542,6 +571,18 @@ public:
   */
   virtual void read(const char*, time&) = 0;
 
+  /**
+   * @fn virtual void read(const char *id, blob &x)
+   * @brief Read a blob from the atomizer.
+   *
+   * Read a blob from the atomizer
+   * identified by a unique name.
+   *
+   * @param id Unique id of the data.
+   * @param x The data to write to.
+   */
+  virtual void read(const char*, blob&) = 0;
+
   /**
    * @fn virtual void read(const char *id, object_base_ptr &x)
    * @brief Read an object_base_ptr from the atomizer.
@@ -577,6 +618,20 @@ public:
    * @param x The data to write to.
    */
   virtual void read(const char*, basic_identifier &) = 0;
+
+  /**
+   * @fn virtual void read(const char *id, basic_value_vector &x)
+   * @brief Read a value_vector from the atomizer.
+   *
+   * A value_vector isn't a single value, by default
+   * it is left untouched. Atomizers handling the
+   * elements (e.g. the object store backup) override
+   * this.
+   *
+   * @param id Unique id of the data.
+   * @param x The data to write to.
+   */
+  virtual void read(const char*, basic_value_vector&) {}
 };
 
 /**
@@ -621,6 +676,7 @@ public:
   virtual void read(const char *id, object_base_ptr &x) { generic_reader_->read_value(id, x); }
   virtual void read(const char *id, date &x) { generic_reader_->read_value(id, x); }
   virtual void read(const char *id, time &x) { generic_reader_->read_value(id, x); }
+  virtual void read(const char *id, blob &x) { generic_reader_->read_value(id, x); }
   virtual void read(const char *id, object_container &x) { generic_reader_->read_value(id, x); }
   virtual void read(const char *id, basic_identifier &x) { generic_reader_->read_value(id, x); }
 
@@ -0,0 +1,217 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATIC_EXPRESSION_HPP
+#define STATIC_EXPRESSION_HPP
+
+#include "object/object_expression.hpp"
+
+#include <functional>
+#include <type_traits>
+
+namespace oos {
+
+/**
+ * @tparam R The return type of the member function
+ * @tparam O The serializable type
+ * @tparam V The type of the variable leading to the serializable
+ * @class static_variable
+ * @brief A variable resolved at compile time
+ *
+ * In contrast to the variable class a static_variable
+ * isn't a wrapper around a heap allocated implementation
+ * with a virtual call operator. The complete path to the
+ * value is part of the type and the member functions are
+ * held by value. Evaluating an expression of static
+ * variables therefore doesn't allocate and has no indirect
+ * calls once the expression is inlined into the algorithm
+ * (e.g. std::find_if) it is used with.
+ *
+ * Static variables are created with make_static_var which
+ * takes the same arguments as make_var. Expressions of
+ * static variables and of variables can be combined.
+ *
+ * Expressions of static variables of depth zero can also
+ * be applied to a const reference of the object itself,
+ * e.g. within the parallel algorithms.
+ */
+template < class R, class O, class V = null_var >
+class static_variable
+{
+public:
+  typedef typename std::decay<R>::type return_type; /**< Shortcut for the value type. */
+  typedef O object_type;                            /**< Shortcut for the serializable type. */
+  typedef R (object_type::*memfunc_type)() const;   /**< Shortcut for the member function type. */
+
+  /**
+   * Creates a static variable calling the
+   * given member function on the serializable
+   * the given variable leads to.
+   *
+   * @param m The member function to call.
+   * @param v The variable leading to the serializable.
+   */
+  static_variable(memfunc_type m, const V &v)
+    : v_(v)
+    , m_(m)
+  {}
+
+  /**
+   * Returns the value of the variable
+   * for the given serializable.
+   *
+   * @param optr The serializable to apply the variable to.
+   * @return The value of the variable.
+   */
+  return_type operator()(const object_base_ptr &optr) const
+  {
+    return (static_cast<const object_type*>(v_(optr).ptr())->*m_)();
+  }
+
+private:
+  V v_;
+  memfunc_type m_;
+};
+
+/// @cond OOS_DEV
+
+template < class R, class O >
+class static_variable<R, O, null_var>
+{
+public:
+  typedef typename std::decay<R>::type return_type;
+  typedef O object_type;
+  typedef R (object_type::*memfunc_type)() const;
+
+  explicit static_variable(memfunc_type m)
+    : m_(m)
+  {}
+
+  return_type operator()(const object_base_ptr &optr) const
+  {
+    return (static_cast<const object_type*>(optr.ptr())->*m_)();
+  }
+
+  return_type operator()(const object_type &o) const
+  {
+    return (o.*m_)();
+  }
+
+private:
+  memfunc_type m_;
+};
+
+/// @endcond
+
+/**
+ * @tparam R The return value type
+ * @tparam O The serializable type
+ * @brief Create a static variable with depth zero
+ *
+ * @param mem_func A member function of the object_type.
+ * @return A static variable with return type R.
+ */
+template < class R, class O >
+static_variable<R, O>
+make_static_var(R (O::*mem_func)() const)
+{
+  return static_variable<R, O>(mem_func);
+}
+
+/**
+ * @tparam R The return value type
+ * @tparam O The serializable type
+ * @tparam O1 The object pointer type of the nested serializable
+ * @brief Create a static variable with depth one
+ *
+ * @param mem_func A member function of the object_type.
+ * @param mem_func_1 A member function of the nested object_type.
+ * @return A static variable with return type R.
+ */
+template < class R, class O, class O1 >
+static_variable<R, typename O1::object_type, static_variable<O1, O> >
+make_static_var(O1 (O::*mem_func)() const, R (O1::object_type::*mem_func_1)() const)
+{
+  return static_variable<R, typename O1::object_type, static_variable<O1, O> >(mem_func_1, make_static_var(mem_func));
+}
+
+/**
+ * @tparam R The return value type
+ * @tparam O The serializable type
+ * @tparam O1 The object pointer type of the first nested serializable
+ * @tparam O2 The object pointer type of the second nested serializable
+ * @brief Create a static variable with depth two
+ *
+ * @param mem_func A member function of the object_type.
+ * @param mem_func_1 A member function of the first nested object_type.
+ * @param mem_func_2 A member function of the second nested object_type.
+ * @return A static variable with return type R.
+ */
+template < class R, class O, class O1, class O2 >
+static_variable<R, typename O2::object_type, static_variable<O2, typename O1::object_type, static_variable<O1, O> > >
+make_static_var(O1 (O::*mem_func)() const, O2 (O1::object_type::*mem_func_1)() const, R (O2::object_type::*mem_func_2)() const)
+{
+  return static_variable<R, typename O2::object_type, static_variable<O2, typename O1::object_type, static_variable<O1, O> > >(mem_func_2, make_static_var(mem_func, mem_func_1));
+}
+
+/// @cond OOS_DEV
+
+/*
+ * the constant side of a comparison is always
+ * converted into the value type of the variable,
+ * so e.g. a std::string variable can be compared
+ * with a string literal
+ */
+#define OOS_STATIC_VARIABLE_COMPARISON(OP, FUNCTOR)                                      \
+template < class R, class O, class V >                                                   \
+binary_expression<static_variable<R, O, V>,                                              \
+                  constant<typename static_variable<R, O, V>::return_type>,              \
+                  FUNCTOR<typename static_variable<R, O, V>::return_type> >              \
+operator OP(const static_variable<R, O, V> &l,                                           \
+            const typename static_variable<R, O, V>::return_type &r)                     \
+{                                                                                        \
+  typedef typename static_variable<R, O, V>::return_type value_type;                     \
+  return binary_expression<static_variable<R, O, V>, constant<value_type>,               \
+                           FUNCTOR<value_type> >(l, constant<value_type>(r));            \
+}                                                                                        \
+                                                                                         \
+template < class R, class O, class V >                                                   \
+binary_expression<constant<typename static_variable<R, O, V>::return_type>,              \
+                  static_variable<R, O, V>,                                              \
+                  FUNCTOR<typename static_variable<R, O, V>::return_type> >              \
+operator OP(const typename static_variable<R, O, V>::return_type &l,                     \
+            const static_variable<R, O, V> &r)                                           \
+{                                                                                        \
+  typedef typename static_variable<R, O, V>::return_type value_type;                     \
+  return binary_expression<constant<value_type>, static_variable<R, O, V>,               \
+                           FUNCTOR<value_type> >(constant<value_type>(l), r);            \
+}
+
+OOS_STATIC_VARIABLE_COMPARISON(>, std::greater)
+OOS_STATIC_VARIABLE_COMPARISON(>=, std::greater_equal)
+OOS_STATIC_VARIABLE_COMPARISON(<, std::less)
+OOS_STATIC_VARIABLE_COMPARISON(<=, std::less_equal)
+OOS_STATIC_VARIABLE_COMPARISON(==, std::equal_to)
+OOS_STATIC_VARIABLE_COMPARISON(!=, std::not_equal_to)
+
+#undef OOS_STATIC_VARIABLE_COMPARISON
+
+/// @endcond
+
+}
+
+#endif /* STATIC_EXPRESSION_HPP */
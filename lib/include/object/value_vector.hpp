@@ -0,0 +1,440 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VALUE_VECTOR_HPP
+#define VALUE_VECTOR_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include "object/serializer.hpp"
+
+#include "tools/varchar.hpp"
+
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace oos {
+
+/// @cond OOS_DEV
+
+namespace detail {
+
+/*
+ * the elements of a value_vector are encoded
+ * into a json like array, e.g. [1,2,3] or ["a","b"]
+ */
+OOS_API void append_element(std::string &buf, long long x);
+OOS_API void append_element(std::string &buf, unsigned long long x);
+OOS_API void append_element(std::string &buf, double x);
+OOS_API void append_element(std::string &buf, bool x);
+OOS_API void append_element(std::string &buf, const char *str, std::size_t len);
+
+class OOS_API element_reader
+{
+public:
+  explicit element_reader(const std::string &str);
+
+  /*
+   * moves to the next element, returns
+   * false if the end of the array is reached
+   */
+  bool next();
+
+  void read(long long &x);
+  void read(unsigned long long &x);
+  void read(double &x);
+  void read(bool &x);
+  void read(std::string &x);
+
+private:
+  void skip_whitespace();
+  void expect(char c);
+
+private:
+  const char *pos_;
+  const char *end_;
+  bool first_;
+};
+
+template < class T, class Enable = void >
+struct element_codec;
+
+template < class T >
+struct element_codec<T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type>
+{
+  static void write(std::string &buf, T x) { append_element(buf, (long long)x); }
+  static void read(element_reader &r, T &x) { long long v; r.read(v); x = (T)v; }
+};
+
+template < class T >
+struct element_codec<T, typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value && !std::is_same<T, bool>::value>::type>
+{
+  static void write(std::string &buf, T x) { append_element(buf, (unsigned long long)x); }
+  static void read(element_reader &r, T &x) { unsigned long long v; r.read(v); x = (T)v; }
+};
+
+template < class T >
+struct element_codec<T, typename std::enable_if<std::is_same<T, bool>::value>::type>
+{
+  static void write(std::string &buf, bool x) { append_element(buf, x); }
+  static void read(element_reader &r, bool &x) { r.read(x); }
+};
+
+template < class T >
+struct element_codec<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+  static void write(std::string &buf, T x) { append_element(buf, (double)x); }
+  static void read(element_reader &r, T &x) { double v; r.read(v); x = (T)v; }
+};
+
+template < class T >
+struct element_codec<T, typename std::enable_if<std::is_same<T, std::string>::value>::type>
+{
+  static void write(std::string &buf, const std::string &x) { append_element(buf, x.data(), x.size()); }
+  static void read(element_reader &r, std::string &x) { r.read(x); }
+};
+
+template < class T >
+struct element_codec<T, typename std::enable_if<std::is_base_of<varchar_base, T>::value>::type>
+{
+  static void write(std::string &buf, const T &x) { append_element(buf, x.c_str(), x.size()); }
+  static void read(element_reader &r, T &x)
+  {
+    std::string v;
+    r.read(v);
+    x.assign(v.c_str(), v.size());
+  }
+};
+
+/*
+ * the column type of an element in the join
+ * table, element types without a column type
+ * of their own are converted
+ */
+template < class T, class Enable = void >
+struct element_column
+{
+  typedef T type;
+  static void read(deserializer &d, const char *id, T &x) { d.read(id, x); }
+};
+
+template < class T, class C >
+struct converted_column
+{
+  typedef C type;
+  static void read(deserializer &d, const char *id, T &x) { C v = C(); d.read(id, v); x = (T)v; }
+};
+
+template <> struct element_column<signed char> : public converted_column<signed char, char> {};
+template <> struct element_column<wchar_t> : public converted_column<wchar_t, long> {};
+template <> struct element_column<char16_t> : public converted_column<char16_t, unsigned long> {};
+template <> struct element_column<char32_t> : public converted_column<char32_t, unsigned long> {};
+template <> struct element_column<long long> : public converted_column<long long, long> {};
+template <> struct element_column<unsigned long long> : public converted_column<unsigned long long, unsigned long> {};
+template <> struct element_column<long double> : public converted_column<long double, double> {};
+
+template < class T >
+struct element_column<T, typename std::enable_if<std::is_base_of<varchar_base, T>::value>::type>
+{
+  typedef varchar_base type;
+  static void read(deserializer &d, const char *id, T &x) { d.read(id, static_cast<varchar_base&>(x)); }
+};
+
+}
+
+/**
+ * @class basic_value_vector
+ * @brief Base class of all value_vector types
+ *
+ * Gives access to the elements of a value_vector
+ * without knowing its element type, e.g. to
+ * write them into the join table of the vector.
+ */
+class OOS_API basic_value_vector
+{
+public:
+  typedef std::size_t size_type;
+
+  virtual ~basic_value_vector() {}
+
+  virtual size_type size() const = 0;
+  virtual void resize(size_type n) = 0;
+  virtual void clear() = 0;
+
+  /*
+   * encodes all elements into the given string
+   * or replaces the elements with the decoded
+   * string, an invalid string throws an
+   * object_exception
+   */
+  virtual void encode(std::string &buf) const = 0;
+  virtual void decode(const std::string &buf) = 0;
+
+  /*
+   * writes the element at the given position
+   * or reads one element and appends it
+   */
+  virtual void write_element(const char *id, size_type i, serializer &s) const = 0;
+  virtual void read_element(const char *id, deserializer &d) = 0;
+};
+
+/// @endcond
+
+/**
+ * @class value_vector
+ * @brief A vector of values stored inside its owning object
+ * @tparam T The element type.
+ *
+ * Unlike object_vector and object_list the value_vector
+ * doesn't create an item object for each element. The
+ * elements are kept in one contiguous block of memory
+ * inside the owning serializable and no element is
+ * inserted into the object_store.
+ *
+ * The element type must be an arithmetic type,
+ * std::string or a varchar.
+ *
+ * Each value_vector field is persisted in a join
+ * table named after the owner type and the field
+ * (e.g. sensor_samples) with the columns owner_id,
+ * idx and value, one row per element. The rows of
+ * a vector are rewritten when the vector is modified
+ * and all rows of a table are loaded with one
+ * statement. The owner needs an integral primary key.
+ * Modifications are tracked through the owner: change
+ * the elements via a non const object_ptr of the owner.
+ *
+ * The object store backup and the json serializer
+ * keep the elements encoded as one string.
+ */
+template < class T >
+class value_vector : public basic_value_vector
+{
+public:
+  typedef value_vector<T> self;                                   /**< Shortcut for self class. */
+  typedef T value_type;                                           /**< Shortcut for the value type. */
+  typedef std::vector<T> vector_type;                             /**< Shortcut for the underlying vector type. */
+  typedef typename vector_type::size_type size_type;              /**< Shortcut for the size type. */
+  typedef typename vector_type::iterator iterator;                /**< Shortcut for the iterator type. */
+  typedef typename vector_type::const_iterator const_iterator;    /**< Shortcut for the const iterator type. */
+  typedef typename vector_type::reference reference;              /**< Shortcut for the reference type. */
+  typedef typename vector_type::const_reference const_reference;  /**< Shortcut for the const reference type. */
+
+  static_assert(std::is_arithmetic<T>::value || std::is_same<T, std::string>::value || std::is_base_of<varchar_base, T>::value,
+                "value_vector element type must be arithmetic, std::string or varchar");
+
+public:
+  /**
+   * Creates an empty value_vector.
+   */
+  value_vector() {}
+
+  /**
+   * Creates a value_vector with the
+   * given values.
+   *
+   * @param values The initial values.
+   */
+  value_vector(std::initializer_list<T> values) : values_(values) {}
+
+  iterator begin() { return values_.begin(); }                 /**< @return Iterator to the first element. */
+  const_iterator begin() const { return values_.begin(); }     /**< @return Iterator to the first element. */
+  iterator end() { return values_.end(); }                     /**< @return Iterator behind the last element. */
+  const_iterator end() const { return values_.end(); }         /**< @return Iterator behind the last element. */
+
+  bool empty() const { return values_.empty(); }               /**< @return True if there is no element. */
+  size_type size() const { return values_.size(); }            /**< @return The number of elements. */
+  size_type capacity() const { return values_.capacity(); }    /**< @return The number of reserved elements. */
+
+  /**
+   * Reserves memory for the given
+   * number of elements.
+   *
+   * @param n The number of elements to reserve.
+   */
+  void reserve(size_type n) { values_.reserve(n); }
+
+  /**
+   * Changes the number of elements. New
+   * elements are value initialized.
+   *
+   * @param n The new number of elements.
+   */
+  void resize(size_type n) { values_.resize(n); }
+
+  reference operator[](size_type i) { return values_[i]; }             /**< @return The element at position i. */
+  const_reference operator[](size_type i) const { return values_[i]; } /**< @return The element at position i. */
+  reference at(size_type i) { return values_.at(i); }                  /**< @return The element at position i; throws std::out_of_range. */
+  const_reference at(size_type i) const { return values_.at(i); }      /**< @return The element at position i; throws std::out_of_range. */
+  reference front() { return values_.front(); }                        /**< @return The first element. */
+  const_reference front() const { return values_.front(); }            /**< @return The first element. */
+  reference back() { return values_.back(); }                          /**< @return The last element. */
+  const_reference back() const { return values_.back(); }              /**< @return The last element. */
+
+  /**
+   * Appends a value.
+   *
+   * @param x The value to append.
+   */
+  void push_back(const T &x) { values_.push_back(x); }
+
+  /**
+   * Removes the last element.
+   */
+  void pop_back() { values_.pop_back(); }
+
+  /**
+   * Inserts a value before the given position.
+   *
+   * @param pos The insert position.
+   * @param x The value to insert.
+   * @return Iterator to the inserted element.
+   */
+  iterator insert(iterator pos, const T &x) { return values_.insert(pos, x); }
+
+  /**
+   * Inserts the values of the given range
+   * before the given position.
+   *
+   * @tparam InputIterator The iterator type of the range.
+   * @param pos The insert position.
+   * @param first The first value to insert.
+   * @param last The end of the values to insert.
+   */
+  template < class InputIterator >
+  void insert(iterator pos, InputIterator first, InputIterator last) { values_.insert(pos, first, last); }
+
+  /**
+   * Erases the element at the given position.
+   *
+   * @param pos The element to erase.
+   * @return Iterator to the element behind the erased one.
+   */
+  iterator erase(iterator pos) { return values_.erase(pos); }
+
+  /**
+   * Erases the elements of the given range.
+   *
+   * @param first The first element to erase.
+   * @param last The end of the range.
+   * @return Iterator to the element behind the erased range.
+   */
+  iterator erase(iterator first, iterator last) { return values_.erase(first, last); }
+
+  /**
+   * Removes all elements.
+   */
+  void clear() { values_.clear(); }
+
+  /**
+   * Returns the underlying vector.
+   *
+   * @return The underlying vector.
+   */
+  const vector_type& values() const { return values_; }
+
+  bool operator==(const self &x) const { return values_ == x.values_; } /**< @return True if both contain the same values. */
+  bool operator!=(const self &x) const { return values_ != x.values_; } /**< @return True if the values differ. */
+
+  /**
+   * Encodes all elements into the given
+   * string, e.g. [1,2,3] or ["a","b"].
+   *
+   * @param buf The string receiving the elements.
+   */
+  void encode(std::string &buf) const
+  {
+    buf.clear();
+    buf.reserve(2 + values_.size() * 4);
+    buf.push_back('[');
+    for (const_iterator i = values_.begin(); i != values_.end(); ++i) {
+      if (i != values_.begin()) {
+        buf.push_back(',');
+      }
+      detail::element_codec<T>::write(buf, *i);
+    }
+    buf.push_back(']');
+  }
+
+  /**
+   * Replaces the current elements with the
+   * encoded elements of the given string. An
+   * empty string results in an empty vector. If
+   * the string can't be decoded an object_exception
+   * is thrown.
+   *
+   * @param buf The encoded elements.
+   */
+  void decode(const std::string &buf)
+  {
+    values_.clear();
+    detail::element_reader reader(buf);
+    while (reader.next()) {
+      T x = T();
+      detail::element_codec<T>::read(reader, x);
+      values_.push_back(std::move(x));
+    }
+  }
+
+  /**
+   * Writes the element at the given position
+   * as one value to the given serializer.
+   *
+   * @param id The name of the value.
+   * @param i The position of the element.
+   * @param s The serializer to write to.
+   */
+  void write_element(const char *id, size_type i, serializer &s) const
+  {
+    s.write(id, static_cast<const typename detail::element_column<T>::type&>(values_[i]));
+  }
+
+  /**
+   * Reads one value from the given deserializer
+   * and appends it as new element.
+   *
+   * @param id The name of the value.
+   * @param d The deserializer to read from.
+   */
+  void read_element(const char *id, deserializer &d)
+  {
+    T x = T();
+    detail::element_column<T>::read(d, id, x);
+    values_.push_back(std::move(x));
+  }
+
+private:
+  vector_type values_;
+};
+
+}
+
+#endif /* VALUE_VECTOR_HPP */
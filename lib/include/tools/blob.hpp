@@ -32,65 +32,191 @@
 #endif
 
 #include <cstring>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 namespace oos {
 
-/// @cond OOS_DEV
+/**
+ * @class blob_source
+ * @brief Provides the data of a not yet loaded blob
+ *
+ * A blob_source reads the data of a blob on
+ * request in chunks, i.e. from the database
+ * the blob was read from. It is set by the
+ * database backend when it delays the loading
+ * of a large blob.
+ */
+class OOS_API blob_source
+{
+public:
+  typedef std::size_t size_type; /**< Shortcut to the size type */
+
+  virtual ~blob_source();
+
+  /**
+   * Returns the size of the whole blob.
+   *
+   * @return The size of the blob.
+   */
+  virtual size_type size() const = 0;
+
+  /**
+   * Reads up to len bytes beginning at offset
+   * into the given buffer.
+   *
+   * @param offset The offset to start reading.
+   * @param buf The buffer to read into.
+   * @param len The size of the buffer.
+   * @return The number of bytes read.
+   */
+  virtual size_type read(size_type offset, char *buf, size_type len) const = 0;
+};
+
+/**
+ * @class blob
+ * @brief Binary data of a serializable
+ *
+ * A blob holds binary data of any size. It is
+ * written to and read from the database as a
+ * BLOB column.
+ *
+ * A large blob may be loaded lazy: the database
+ * backend sets a blob_source instead of the data
+ * and the data is loaded on the first call to
+ * data(). With read() the data is copied chunk
+ * by chunk without loading the whole blob. A
+ * lazy blob must be loaded before the database
+ * it was read from is closed, afterwards the
+ * source throws on access.
+ */
 class OOS_API blob
 {
 public:
-  typedef std::size_t size_type;
+  typedef std::size_t size_type; /**< Shortcut to the size type */
 
 public:
   blob();
+
+  /**
+   * Creates a blob with a copy of the given data.
+   *
+   * @param data The data to copy.
+   * @param size The size of the data.
+   */
+  blob(const char *data, size_type size);
+
   ~blob();
   
   /**
    * @brief Assign data to blob.
    * 
-   * Assign data to blob. If data is to
-   * big for blob it isn't assigned and
-   * false is returned. Current data is
-   * cleared.
+   * Assign the bytes of the given value
+   * to blob. Current data is cleared.
    * 
    * @tparam T The type of the data.
    * @param val The value to assign.
    * @return True if data could be assigned.
    */
   template < typename T >
-  bool assign(const T &/*val*/)
+  bool assign(const T &val)
   {
-    return false;
+    static_assert(std::is_pod<T>::value, "only plain data can be assigned to a blob");
+    return assign(reinterpret_cast<const char*>(&val), sizeof(T));
   }
 
   /**
    * @brief Append data to blob.
    * 
-   * Append data to blob. If data is to
-   * big for blob it isn't appended and
-   * false is returned.
+   * Append the bytes of the given value
+   * to blob.
    * 
    * @tparam T The type of the data.
    * @param val The value to append.
    * @return True if data could be appended.
    */
   template < typename T >
-  bool append(const T &/*val*/)
+  bool append(const T &val)
   {
-    return false;
+    static_assert(std::is_pod<T>::value, "only plain data can be appended to a blob");
+    return append(reinterpret_cast<const char*>(&val), sizeof(T));
   }
 
+  /**
+   * Assigns a copy of the given data. Current
+   * data is cleared.
+   *
+   * @param data The data to copy.
+   * @param size The size of the data.
+   * @return True if data could be assigned.
+   */
+  bool assign(const char *data, size_type size);
+
+  /**
+   * Appends a copy of the given data. A lazy
+   * blob is loaded first.
+   *
+   * @param data The data to copy.
+   * @param size The size of the data.
+   * @return True if data could be appended.
+   */
+  bool append(const char *data, size_type size);
+
+  /**
+   * Copies up to len bytes beginning at offset
+   * into the given buffer. A lazy blob isn't
+   * loaded, the chunk is read from its source.
+   *
+   * @param offset The offset to start reading.
+   * @param buf The buffer to read into.
+   * @param len The size of the buffer.
+   * @return The number of bytes copied.
+   */
+  size_type read(size_type offset, char *buf, size_type len) const;
+
   size_type size() const;
 
   size_type capacity() const;
 
+  bool empty() const;
+
+  /**
+   * Returns the data of the blob. A lazy
+   * blob is loaded.
+   *
+   * @return The data of the blob.
+   */
   const char* data() const;
 
+  /**
+   * Returns true if the data of the
+   * blob is loaded.
+   *
+   * @return True if the data is loaded.
+   */
+  bool is_loaded() const;
+
+  /**
+   * Clears the data and the source of the blob.
+   */
+  void clear();
+
+  bool operator==(const blob &x) const;
+  bool operator!=(const blob &x) const;
+
+  /// @cond OOS_DEV
+  void source(const std::shared_ptr<blob_source> &src);
+  /// @endcond
+
 private:
-  std::vector<char> data_;
+  void load() const;
+
+private:
+  mutable std::vector<char> data_;
+  mutable std::shared_ptr<blob_source> source_;
 };
-/// @endcond
+
 }
 
 #endif /* BLOB_HPP */
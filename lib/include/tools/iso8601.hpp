@@ -0,0 +1,111 @@
+#ifndef ISO8601_HPP
+#define ISO8601_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+#define OOS_API
+#endif
+
+#include <cstddef>
+
+namespace oos {
+
+class time;
+class date;
+
+/**
+ * Size of a buffer holding a formatted
+ * ISO8601 time including the milliseconds
+ * and the terminating null character.
+ */
+const std::size_t iso8601_time_size = 24;
+
+/**
+ * Size of a buffer holding a formatted
+ * ISO8601 date including the terminating
+ * null character.
+ */
+const std::size_t iso8601_date_size = 11;
+
+/**
+ * Writes the time into the given buffer in
+ * the format "%F %T.%f" (YYYY-MM-DD HH:MM:SS.mmm)
+ * or "%F %T" if fraction is false. No memory is
+ * allocated. If the buffer is too small or the
+ * year has more than four digits zero is returned.
+ *
+ * @param x The time to format.
+ * @param buf The buffer to write to.
+ * @param size The size of the buffer.
+ * @param fraction True to write the milliseconds.
+ * @return The length of the string without the null character.
+ */
+OOS_API std::size_t format_iso8601(const oos::time &x, char *buf, std::size_t size, bool fraction = true);
+
+/**
+ * Writes the date into the given buffer in
+ * the format "%F" (YYYY-MM-DD).
+ *
+ * @param x The date to format.
+ * @param buf The buffer to write to.
+ * @param size The size of the buffer.
+ * @return The length of the string without the null character.
+ */
+OOS_API std::size_t format_iso8601(const oos::date &x, char *buf, std::size_t size);
+
+/**
+ * Parses a local time in the format "%F %T" with
+ * an optional fraction of up to six digits
+ * (YYYY-MM-DD HH:MM:SS[.ffffff]). The separator
+ * of date and time may be a space or 'T'. The
+ * complete string must match, otherwise false is
+ * returned and the time isn't changed.
+ *
+ * @param str The string to parse.
+ * @param len The length of the string.
+ * @param x The parsed time.
+ * @return True if the string could be parsed.
+ */
+OOS_API bool parse_iso8601(const char *str, std::size_t len, oos::time &x);
+
+/**
+ * Parses a date in the format "%F" (YYYY-MM-DD).
+ * The complete string must match, otherwise false
+ * is returned and the date isn't changed.
+ *
+ * @param str The string to parse.
+ * @param len The length of the string.
+ * @param x The parsed date.
+ * @return True if the string could be parsed.
+ */
+OOS_API bool parse_iso8601(const char *str, std::size_t len, oos::date &x);
+
+/// @cond OOS_DEV
+namespace detail {
+
+/*
+ * returns 2 for the ISO8601 time formats with
+ * fraction, 1 for the formats without and 0
+ * for any other format
+ */
+int iso8601_time_format(const char *format);
+
+/*
+ * returns true for the ISO8601 date format
+ */
+bool is_iso8601_date_format(const char *format);
+
+}
+/// @endcond
+
+}
+
+#endif /* ISO8601_HPP */
@@ -0,0 +1,49 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PREFETCH_HPP
+#define PREFETCH_HPP
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
+
+namespace oos {
+
+/**
+ * @brief Hints the processor to load the given address into the cache
+ *
+ * The address doesn't need to be valid, a prefetch never
+ * faults. On compilers without prefetch support
+ * the function does nothing.
+ *
+ * @param addr The address to prefetch.
+ */
+inline void prefetch(const void *addr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(addr);
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  _mm_prefetch(static_cast<const char*>(addr), _MM_HINT_T0);
+#else
+  (void)addr;
+#endif
+}
+
+}
+
+#endif /* PREFETCH_HPP */
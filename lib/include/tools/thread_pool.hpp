@@ -0,0 +1,143 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace oos {
+
+/**
+ * @class thread_pool
+ * @brief A work stealing pool of worker threads
+ *
+ * The thread_pool runs indexed tasks on a fixed
+ * number of worker threads. Each worker owns a task
+ * queue; a worker takes its own tasks from the back
+ * and steals tasks from the front of the other queues
+ * once its own queue is empty.
+ *
+ * The thread calling run() works on the tasks as well
+ * until all tasks of its call are finished. Therefore
+ * run() may be called from within a task and a pool
+ * without any worker thread runs all tasks in the
+ * calling thread.
+ */
+class OOS_API thread_pool
+{
+public:
+  /**
+   * Creates a thread_pool with the given
+   * number of worker threads.
+   *
+   * @param threads The number of worker threads.
+   */
+  explicit thread_pool(std::size_t threads);
+
+  /**
+   * Waits until the queued tasks are finished
+   * and stops all worker threads.
+   */
+  ~thread_pool();
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /**
+   * Returns the number of worker threads.
+   *
+   * @return The number of worker threads.
+   */
+  std::size_t size() const;
+
+  /**
+   * Calls func(i) for each i in [0, count) and
+   * returns when all calls are finished. If a call
+   * throws, the remaining calls are still done and
+   * the first exception is rethrown afterwards.
+   *
+   * @param count The number of tasks.
+   * @param func The function to call for each task.
+   */
+  void run(std::size_t count, const std::function<void(std::size_t)> &func);
+
+  /**
+   * Returns the default thread_pool. It has one
+   * worker thread less than the hardware provides,
+   * because the calling thread works as well.
+   *
+   * @return The default thread_pool.
+   */
+  static thread_pool& instance();
+
+private:
+  struct job;
+
+  struct task
+  {
+    job *owner;
+    std::size_t index;
+  };
+
+  struct task_queue
+  {
+    std::mutex mutex;
+    std::deque<task> tasks;
+  };
+
+  void work(std::size_t i);
+  bool pop(std::size_t i, task &t);
+  bool steal(std::size_t i, task &t);
+  void execute(const task &t);
+
+private:
+  std::vector<std::unique_ptr<task_queue> > queues_;
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  std::condition_variable work_cond_;
+  std::condition_variable done_cond_;
+  std::atomic<std::size_t> pending_;
+  std::atomic<std::size_t> next_queue_;
+  bool stop_;
+};
+
+}
+
+#endif /* THREAD_POOL_HPP */
@@ -16,6 +16,7 @@
 
 #include "tools/date.hpp"
 
+#include <cstddef>
 #include <ctime>
 #include <cstdint>
 #include <string>
@@ -401,7 +402,11 @@ public:
    */
   friend OOS_API std::ostream &operator<<(std::ostream &out, const time &x);
 
+  friend OOS_API bool parse_iso8601(const char *str, std::size_t len, time &x);
+
 private:
+  void set(const struct timeval &tv, const struct tm &t);
+
   void sync_day(int d);
   void sync_month(int m);
   void sync_year(int y);
@@ -0,0 +1,249 @@
+#ifndef UTC_TIME_HPP
+#define UTC_TIME_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+#define OOS_API
+#endif
+
+#include <iosfwd>
+
+namespace oos {
+
+class date;
+class time;
+
+/**
+ * @class utc_time
+ *
+ * @brief Compact UTC time with microseconds
+ *
+ * The utc_time holds the microseconds since
+ * 1970-01-01 00:00:00 UTC in one 64 bit number.
+ * The date and time parts are calculated with
+ * plain calendar arithmetic, no timezone data
+ * is involved. Construction, comparison and
+ * arithmetic are cheap, so the class suits
+ * large numbers of timestamps.
+ *
+ * A conversion into local time is only done on
+ * request with to_time().
+ */
+class OOS_API utc_time
+{
+public:
+  /**
+   * Creates a utc_time at the epoch
+   * 1970-01-01 00:00:00 UTC
+   */
+  utc_time();
+
+  /**
+   * Creates a utc_time from the
+   * microseconds since the epoch.
+   *
+   * @param usec Microseconds since the epoch.
+   */
+  explicit utc_time(long long usec);
+
+  /**
+   * Creates a utc_time from its UTC parts.
+   * Throws a logic_error if a part is invalid.
+   *
+   * @param year Year value of time
+   * @param month Month value of time
+   * @param day Day value of time
+   * @param hour Hour part of time
+   * @param min Minute part of time
+   * @param sec Second part of time
+   * @param usec Microseconds of time (default is zero)
+   */
+  utc_time(int year, int month, int day, int hour = 0, int min = 0, int sec = 0, long usec = 0);
+
+  /**
+   * Creates a utc_time from the point in
+   * time of the given local time.
+   *
+   * @param t The time to convert.
+   */
+  explicit utc_time(const oos::time &t);
+
+  /**
+   * Gets current time.
+   *
+   * @return Returns current time.
+   */
+  static utc_time now();
+
+  bool operator==(const utc_time &x) const;
+  bool operator!=(const utc_time &x) const;
+  bool operator<(const utc_time &x) const;
+  bool operator<=(const utc_time &x) const;
+  bool operator>(const utc_time &x) const;
+  bool operator>=(const utc_time &x) const;
+
+  /**
+   * Adds the given microseconds.
+   *
+   * @param usec The microseconds to add.
+   * @return Reference to this.
+   */
+  utc_time& operator+=(long long usec);
+
+  /**
+   * Subtracts the given microseconds.
+   *
+   * @param usec The microseconds to subtract.
+   * @return Reference to this.
+   */
+  utc_time& operator-=(long long usec);
+
+  /**
+   * Returns a utc_time the given microseconds
+   * later.
+   *
+   * @param usec The microseconds to add.
+   * @return The new utc_time.
+   */
+  utc_time operator+(long long usec) const;
+
+  /**
+   * Returns a utc_time the given microseconds
+   * earlier.
+   *
+   * @param usec The microseconds to subtract.
+   * @return The new utc_time.
+   */
+  utc_time operator-(long long usec) const;
+
+  /**
+   * Returns the difference to the given
+   * utc_time in microseconds.
+   *
+   * @param x The utc_time to subtract.
+   * @return The difference in microseconds.
+   */
+  long long operator-(const utc_time &x) const;
+
+  /**
+   * Adds the given number of days.
+   *
+   * @param days The days to add.
+   * @return Reference to this.
+   */
+  utc_time& add_days(int days);
+
+  /**
+   * Sets the time by its UTC parts. Throws
+   * a logic_error if a part is invalid.
+   *
+   * @param year The year part of the time.
+   * @param month The month part of the time.
+   * @param day The day part of the time.
+   * @param hour The hour part of the time.
+   * @param min The minute part of the time.
+   * @param sec The seconds part of the time.
+   * @param usec The microseconds part of the time.
+   */
+  void set(int year, int month, int day, int hour, int min, int sec, long usec);
+
+  /**
+   * Returns the microseconds since the epoch.
+   *
+   * @return The microseconds since the epoch.
+   */
+  long long micro_seconds() const;
+
+  int year() const;
+  int month() const;
+  int day() const;
+  int hour() const;
+  int minute() const;
+  int second() const;
+  int milli_second() const;
+  int micro_second() const;
+
+  /**
+   * Returns the day of week number
+   * where sunday is 0 (zero) as
+   * in struct tm.
+   *
+   * @return The day of week number.
+   */
+  int day_of_week() const;
+
+  /**
+   * Returns the day of the year where
+   * the first day of the year is
+   * 0 (zero) as in struct tm.
+   *
+   * @return The day of the year number.
+   */
+  int day_of_year() const;
+
+  /**
+   * Returns the date part of the time.
+   *
+   * @return The UTC date of the time.
+   */
+  date to_date() const;
+
+  /**
+   * Converts the time into the local time.
+   *
+   * @return The local time.
+   */
+  oos::time to_time() const;
+
+  /**
+   * Returns the number of days since the
+   * epoch of the given date in the proleptic
+   * gregorian calendar.
+   *
+   * @param year The year of the date.
+   * @param month The month of the date.
+   * @param day The day of the date.
+   * @return The days since the epoch.
+   */
+  static long long days_from_civil(int year, int month, int day);
+
+  /**
+   * Calculates the date from the given number
+   * of days since the epoch.
+   *
+   * @param days The days since the epoch.
+   * @param year The year of the date.
+   * @param month The month of the date.
+   * @param day The day of the date.
+   */
+  static void civil_from_days(long long days, int &year, int &month, int &day);
+
+  /**
+   * Writes the time to an std::ostream in
+   * ISO8601 format
+   *
+   * @param out The stream to write to.
+   * @param x The time object to be printed
+   * @return Reference to the passed ostream object.
+   */
+  friend OOS_API std::ostream& operator<<(std::ostream &out, const utc_time &x);
+
+private:
+  long long days() const;
+  long long time_of_day() const;
+
+private:
+  long long usec_;
+};
+
+}
+
+#endif /* UTC_TIME_HPP */
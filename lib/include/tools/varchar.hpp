@@ -31,12 +31,19 @@
   #define OOS_API
 #endif
 
+#include <cstring>
 #include <string>
 #include <stdexcept>
 
 namespace oos {
 
 /// @cond OOS_DEV
+/*
+ * The varchar_base works on a character buffer
+ * of capacity plus one bytes. A varchar<C> passes
+ * its inline buffer, a standalone varchar_base
+ * allocates the buffer on its own.
+ */
 class OOS_API varchar_base
 {
 public:
@@ -80,12 +87,16 @@ public:
   friend OOS_API std::ostream& operator<<(std::ostream &out, const varchar_base &val);
 
 protected:
+  varchar_base(char *buffer, size_type capacity);
+
   void ok(const std::string &x);
-  void trim();
+  void append(const char *s, size_t n);
 
 protected:
+  char *data_;
   size_type capacity_;
-  std::string data_;
+  unsigned int size_;
+  bool owner_;
 };
 /// @endcond
 
@@ -98,8 +109,10 @@ protected:
  * SQL VARCHAR type in mind. The capacity of
  * the string is given within the template
  * parameter of type unsigned int.
- * The real string is represented internaly
- * by a std::string.
+ * The string is stored inside the varchar
+ * in a character array of the given capacity,
+ * there is no allocation on the heap. A longer
+ * string is cut to the capacity.
  */
 template < unsigned int C >
 class varchar : public varchar_base
@@ -110,7 +123,7 @@ public:
    * with the given capacity
    */
   varchar()
-    : varchar_base(C)
+    : varchar_base(buffer_, C)
   {}
 
   /**
@@ -120,9 +133,9 @@ public:
    * @param x The varchar to copy.
    */
   varchar(const varchar &x)
-    : varchar_base(C)
+    : varchar_base(buffer_, C)
   {
-    data_ = x.data_;
+    assign(x.c_str(), x.size());
   }
 
   /**
@@ -132,9 +145,9 @@ public:
    * @param x The string value to set.
    */
   explicit varchar(const std::string &x)
-    : varchar_base(C)
+    : varchar_base(buffer_, C)
   {
-    data_ = x;
+    assign(x.c_str(), x.size());
   }
 
   /**
@@ -144,9 +157,9 @@ public:
    * @param x The string value to set.
    */
   varchar(const char *x)
-    : varchar_base(C)
+    : varchar_base(buffer_, C)
   {
-    data_.assign(x);
+    assign(x);
   }
 
   /**
@@ -157,9 +170,7 @@ public:
    */
   varchar& operator=(const varchar &x)
   {
-    
-    capacity_ = C;
-    data_ = x.data_;
+    assign(x.c_str(), x.size());
     return *this;
   }
 
@@ -171,7 +182,7 @@ public:
    */
   varchar& operator=(const std::string &x)
   {
-    data_ = x;
+    assign(x.c_str(), x.size());
     return *this;
   }
 
@@ -183,9 +194,12 @@ public:
    */
   varchar& operator=(const char *x)
   {
-    varchar_base::operator=(x);
+    assign(x);
     return *this;
   }
+
+private:
+  char buffer_[C + 1];
 };
 
 /**
@@ -199,7 +213,7 @@ public:
 template < unsigned int C1, unsigned int C2 >
 bool operator==(const varchar<C1> &l, const varchar<C2> &r)
 {
-  return l.str() == r.str();
+  return static_cast<const varchar_base&>(l) == r;
 }
 
 /**
@@ -212,7 +226,7 @@ bool operator==(const varchar<C1> &l, const varchar<C2> &r)
 template < unsigned int C >
 bool operator==(const varchar<C> &l, const char *r)
 {
-  return l.str() == r;
+  return l.size() == strlen(r) && memcmp(l.c_str(), r, l.size()) == 0;
 }
 
 /**
@@ -226,7 +240,7 @@ bool operator==(const varchar<C> &l, const char *r)
 template < unsigned int C1, unsigned int C2 >
 bool operator!=(const varchar<C1> &l, const varchar<C2> &r)
 {
-  return l.str() != r.str();
+  return static_cast<const varchar_base&>(l) != r;
 }
 
 /**
@@ -239,7 +253,7 @@ bool operator!=(const varchar<C1> &l, const varchar<C2> &r)
 template < unsigned int C >
 bool operator!=(const varchar<C> &l, const char *r)
 {
-  return l.str() != r;
+  return !(l == r);
 }
 
 }
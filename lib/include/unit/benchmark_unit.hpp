@@ -0,0 +1,201 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_UNIT_HPP
+#define BENCHMARK_UNIT_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include "unit/unit_test.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace oos {
+
+/**
+ * @class benchmark_unit
+ * @brief A unit_test measuring the run time of its benchmarks.
+ *
+ * The benchmark_unit is the base class for all
+ * benchmark units. A benchmark is added like a test
+ * and is executed by the test_suite, so benchmark
+ * units share the list and exec commands of the
+ * test units.
+ *
+ * A benchmark consists of an optional setup function
+ * and a run function. Both are called for a number of
+ * warm-up iterations first, then for the measured
+ * iterations. Only the run function is measured. The
+ * minimum, the median, the 99th percentile and the
+ * mean of the iterations are displayed and recorded
+ * as metrics of the test.
+ *
+ * If the benchmark program replaces the global
+ * operator new and reports each allocation with
+ * count_allocation(), the allocations of the run
+ * function are counted too.
+ */
+class OOS_API benchmark_unit : public unit_test
+{
+public:
+  typedef std::function<void ()> bench_func; /**< Shortcut to a benchmark function */
+
+  /**
+   * The statistics of the measured iterations
+   * in nanoseconds.
+   */
+  struct statistics
+  {
+    statistics() : minimum(0), median(0), p99(0), mean(0) {}
+    double minimum; /**< The fastest iteration */
+    double median;  /**< The median of all iterations */
+    double p99;     /**< The 99th percentile of all iterations */
+    double mean;    /**< The mean of all iterations */
+  };
+
+  /**
+   * @brief The constructor for a benchmark_unit
+   *
+   * @param name The name of the benchmark_unit.
+   * @param caption The caption of the benchmark_unit.
+   * @param iterations The number of measured iterations.
+   * @param warmup The number of warm-up iterations.
+   */
+  benchmark_unit(const std::string &name, const std::string &caption, std::size_t iterations = 10, std::size_t warmup = 2);
+  virtual ~benchmark_unit();
+
+  /**
+   * Called once before each benchmark,
+   * the warm-up included.
+   */
+  virtual void initialize() {}
+
+  /**
+   * Called once after each benchmark.
+   */
+  virtual void finalize() {}
+
+  /**
+   * @brief Adds a benchmark to the benchmark_unit.
+   *
+   * The given function is called for each
+   * iteration. If the function handles more than
+   * one item per call, the number of items is
+   * used to calculate the throughput.
+   *
+   * @param name Unique name of the benchmark.
+   * @param run The measured function.
+   * @param caption A short description of the benchmark.
+   * @param items The number of items handled per call.
+   */
+  void add_benchmark(const std::string &name, const bench_func &run, const std::string &caption, std::size_t items = 1);
+
+  /**
+   * @brief Adds a benchmark with setup to the benchmark_unit.
+   *
+   * The setup function is called before each
+   * iteration and isn't measured.
+   *
+   * @param name Unique name of the benchmark.
+   * @param setup The setup function.
+   * @param run The measured function.
+   * @param caption A short description of the benchmark.
+   * @param items The number of items handled per call.
+   */
+  void add_benchmark(const std::string &name, const bench_func &setup, const bench_func &run, const std::string &caption, std::size_t items = 1);
+
+  /**
+   * Returns the number of measured iterations.
+   *
+   * @return The number of measured iterations.
+   */
+  std::size_t iterations() const;
+
+  /**
+   * Returns the number of warm-up iterations.
+   *
+   * @return The number of warm-up iterations.
+   */
+  std::size_t warmup() const;
+
+  /**
+   * Calculates the statistics of the given
+   * samples. The samples are sorted.
+   *
+   * @param samples The samples to evaluate.
+   * @return The statistics of the samples.
+   */
+  static statistics evaluate(std::vector<double> &samples);
+
+  /**
+   * Prints a duration given in nanoseconds
+   * with a fitting unit (ns, us, ms or s).
+   *
+   * @param out The stream to print to.
+   * @param ns The duration in nanoseconds.
+   */
+  static void print_duration(std::ostream &out, double ns);
+
+  /**
+   * Counts one allocation of the given size.
+   * Called by the operator new of the benchmark
+   * program, it must not allocate.
+   *
+   * @param size The size of the allocation.
+   */
+  static void count_allocation(std::size_t size);
+
+  /**
+   * Returns the number of counted allocations.
+   *
+   * @return The number of counted allocations.
+   */
+  static unsigned long long allocation_count();
+
+  /**
+   * Returns the number of counted bytes.
+   *
+   * @return The number of counted bytes.
+   */
+  static unsigned long long allocated_bytes();
+
+private:
+  void measure(const bench_func &setup, const bench_func &run, std::size_t items);
+
+private:
+  std::size_t iterations_;
+  std::size_t warmup_;
+};
+
+}
+
+#endif /* BENCHMARK_UNIT_HPP */
@@ -31,6 +31,8 @@
   #define OOS_API
 #endif
 
+#include <cstddef>
+#include <iosfwd>
 #include <memory>
 #include <map>
 #include <string>
@@ -84,14 +86,24 @@ private:
   typedef struct test_suite_args_struct
   {
     test_suite_args_struct()
-      : cmd(UNKNOWN), initialized(false), brief(false)
+      : cmd(UNKNOWN), initialized(false), brief(false), program("test_oos")
+      , repeat(1), tolerance(10.0), jobs(1)
     {}
     test_suite_cmd cmd;
     bool initialized;
     bool brief;
+    std::string program;
+    std::string json_file;
+    std::string baseline_file;
+    std::string record_file;
+    std::size_t repeat;
+    double tolerance;
+    std::size_t jobs;
     std::vector<test_unit_args> unit_args;
   } test_suite_args;
 
+  typedef std::map<std::string, std::vector<double> > t_sample_map;
+
   typedef std::shared_ptr<unit_test> unit_test_ptr;
   typedef std::map<std::string, unit_test_ptr> t_unit_test_map;
   typedef t_unit_test_map::value_type value_type;
@@ -126,7 +138,22 @@ public:
    * @brief Initialize test_suite
    *
    * Reads, parses and initializes the
-   * test_suite.
+   * test_suite. The execute command takes
+   * the following optional arguments:
+   *
+   * - json <file>: the results of the executed
+   *   tests are written to that file.
+   * - repeat <n>: the tests are executed n times.
+   * - baseline <file>: the benchmark results are
+   *   compared with the baseline in that file.
+   * - record <file>: the benchmark results are
+   *   recorded as baseline into that file.
+   * - tolerance <percent>: the tolerance of new
+   *   baseline entries (default is 10 percent).
+   * - -j <n>: up to n test units are executed in
+   *   parallel, each in its own child process with
+   *   its own working directory. The output of the
+   *   units is displayed in the order of the units.
    *
    * @param argc Number of arguments.
    * @param argv List of arguments.
@@ -194,9 +221,56 @@ public:
    */
   bool run(const std::string &unit, const std::string &test);
 
+  /**
+   * @brief Writes the results as json.
+   *
+   * Writes the results of all executed
+   * tests with their recorded metrics
+   * as one json object.
+   *
+   * @param out The stream to write to.
+   */
+  void write_json(std::ostream &out) const;
+
+  /**
+   * @brief Compares the benchmark results with a baseline.
+   *
+   * The median of the medians of all repeated
+   * runs of a benchmark is compared with the
+   * median stored in the baseline file. If it
+   * is slower than the tolerance of the baseline
+   * entry allows, the benchmark has regressed.
+   * A table of all differences is displayed.
+   *
+   * @param file The baseline file.
+   * @return True if no benchmark regressed.
+   */
+  bool compare_baseline(const std::string &file) const;
+
+  /**
+   * @brief Records the benchmark results as baseline.
+   *
+   * The median of the medians of all repeated
+   * runs of each executed benchmark is written
+   * into the baseline file. Entries of an existing
+   * baseline file are updated, their tolerance and
+   * the entries of benchmarks not executed are kept.
+   *
+   * @param file The baseline file.
+   * @return True if the baseline was written.
+   */
+  bool record_baseline(const std::string &file) const;
+
+private:
+  bool execute();
+  bool execute_parallel();
+  bool merge_json(std::istream &in);
+  void collect_benchmarks();
+
 private:
   test_suite_args args_;
   t_unit_test_map unit_test_map_;
+  t_sample_map benchmark_samples_;
 };
 
 }
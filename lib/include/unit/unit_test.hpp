@@ -39,6 +39,7 @@
 
 #include <functional>
 #include <map>
+#include <utility>
 #include <vector>
 
 #include <cstring>
@@ -636,20 +637,47 @@ public:
    */
   void info(const std::string &msg);
 
+  /**
+   * @brief Sets the summary of the current test.
+   *
+   * If the test succeeds the summary is displayed
+   * instead of the number of assertions.
+   *
+   * @param msg The summary of the test.
+   */
+  void summary(const std::string &msg);
+
+  /**
+   * @brief Records a named value of the current test.
+   *
+   * The recorded values are part of the json
+   * results written by the test_suite. A value
+   * recorded again replaces the former one.
+   *
+   * @param name The name of the value.
+   * @param value The value to record.
+   */
+  void metric(const std::string &name, double value);
+
 private:
   friend class test_suite;
 
+  typedef std::vector<std::pair<std::string, double> > t_metric_vector;
+
   typedef struct test_func_info_struct
   {
     test_func_info_struct(const test_func &f, const std::string &n, const std::string &c)
-      : func(f), succeeded(true), assertion_count(0), name(n), caption(c)
+      : func(f), succeeded(true), executed(false), assertion_count(0), name(n), caption(c)
     {}
     test_func func;
     bool succeeded;
+    bool executed;
     size_t assertion_count;
     std::string name;
     std::string caption;
     std::string message;
+    std::string summary;
+    t_metric_vector metrics;
   } test_func_info;
 
 private:
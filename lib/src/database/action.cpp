@@ -109,6 +109,11 @@ const object_proxy* update_action::proxy() const
   return proxy_;
 }
 
+column_image& update_action::image()
+{
+  return image_;
+}
+
 delete_action::delete_action(const char *classname, unsigned long id, basic_identifier *pk)
   : classname_(classname)
   , id_(id)
@@ -0,0 +1,167 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "database/column_image.hpp"
+
+#include "object/serializable.hpp"
+#include "object/object_ptr.hpp"
+#include "object/basic_identifier.hpp"
+#include "object/value_vector.hpp"
+
+#include "tools/varchar.hpp"
+#include "tools/date.hpp"
+#include "tools/time.hpp"
+#include "tools/blob.hpp"
+
+#include <cstring>
+
+namespace oos {
+
+column_image::column_image()
+  : generic_serializer<column_image>(this)
+  , index_(0)
+  , mask_(nullptr)
+  , modified_(false)
+  , vector_index_(0)
+  , vector_mask_(nullptr)
+{}
+
+column_image::~column_image()
+{}
+
+void column_image::take(const serializable *o)
+{
+  values_.clear();
+  vectors_.clear();
+  index_ = 0;
+  vector_index_ = 0;
+  mask_ = nullptr;
+  vector_mask_ = nullptr;
+  o->serialize(*this);
+}
+
+bool column_image::compare(const serializable *o, column_mask &mask, column_mask &vectors)
+{
+  mask.clear();
+  vectors.clear();
+  index_ = 0;
+  vector_index_ = 0;
+  mask_ = &mask;
+  vector_mask_ = &vectors;
+  modified_ = false;
+  o->serialize(*this);
+  mask_ = nullptr;
+  vector_mask_ = nullptr;
+  return modified_;
+}
+
+bool column_image::empty() const
+{
+  return values_.empty();
+}
+
+void column_image::write(const char*, const basic_value_vector &x)
+{
+  std::string image;
+  x.encode(image);
+  std::size_t index = vector_index_++;
+  if (!vector_mask_) {
+    vectors_.push_back(image);
+    return;
+  }
+  bool modified = index >= vectors_.size() || vectors_[index] != image;
+  vector_mask_->push_back(modified);
+  modified_ = modified_ || modified;
+}
+
+void column_image::write_value(const char*, const char *x, std::size_t s)
+{
+  std::size_t len = 0;
+  while (len < s && x[len] != '\0') {
+    ++len;
+  }
+  column(x, len);
+}
+
+void column_image::write_value(const char*, const std::string &x)
+{
+  column(x.data(), x.size());
+}
+
+void column_image::write_value(const char*, const varchar_base &x)
+{
+  column(x.c_str(), x.size());
+}
+
+void column_image::write_value(const char*, const date &x)
+{
+  int julian = x.julian_date();
+  column(&julian, sizeof(julian));
+}
+
+void column_image::write_value(const char*, const time &x)
+{
+  struct timeval tv = x.get_timeval();
+  long long usec = (long long)tv.tv_sec * 1000000 + tv.tv_usec;
+  column(&usec, sizeof(usec));
+}
+
+void column_image::write_value(const char*, const blob &x)
+{
+  /*
+   * a blob which isn't loaded can't be modified,
+   * its image is the size only. The image of a
+   * loaded blob is the data. A leading flag keeps
+   * both kinds apart.
+   */
+  std::string image(1, x.is_loaded() ? '\1' : '\0');
+  if (x.is_loaded()) {
+    image.append(x.data() ? x.data() : "", x.size());
+  } else {
+    blob::size_type size = x.size();
+    image.append(reinterpret_cast<const char*>(&size), sizeof(size));
+  }
+  column(image.data(), image.size());
+}
+
+void column_image::write_value(const char*, const object_base_ptr &x)
+{
+  // the column holds the id of the referenced object
+  unsigned long id = x.id();
+  column(&id, sizeof(id));
+}
+
+void column_image::write_value(const char *id, const basic_identifier &x)
+{
+  x.serialize(id, *this);
+}
+
+void column_image::column(const void *data, std::size_t size)
+{
+  std::size_t index = index_++;
+  if (!mask_) {
+    values_.push_back(std::string(static_cast<const char*>(data), size));
+    return;
+  }
+  bool modified = index >= values_.size() ||
+                  values_[index].size() != size ||
+                  memcmp(values_[index].data(), data, size) != 0;
+  mask_->push_back(modified);
+  modified_ = modified_ || modified;
+}
+
+}
@@ -27,6 +27,7 @@
 #include "object/object_store.hpp"
 #include "object/prototype_node.hpp"
 
+#include <chrono>
 #include <stdexcept>
 
 namespace oos {
@@ -154,6 +155,31 @@ bool database::is_loaded(const std::string &name) const
 #endif
 }
 
+sql_metrics& database::metrics()
+{
+  return metrics_;
+}
+
+const sql_metrics& database::metrics() const
+{
+  return metrics_;
+}
+
+detail::result_impl* database::execute_direct(const std::string &sql, std::shared_ptr<object_base_producer> ptr)
+{
+  if (!metrics_.enabled()) {
+    return on_execute(sql, ptr);
+  }
+  typedef std::chrono::steady_clock clock_t;
+  clock_t::time_point start = clock_t::now();
+  detail::result_impl *res = on_execute(sql, ptr);
+  double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - start).count();
+  sql_metrics::statistics *stats = metrics_.find(sql);
+  res->measure(stats);
+  metrics_.executed(*stats, sql, ns, 0, stats->is_select ? 0 : res->affected_rows(), std::vector<std::string>());
+  return res;
+}
+
 void database::drop()
 {
   table_map_t::iterator first = table_map_.begin();
@@ -187,6 +213,8 @@ void database::begin()
 
 void database::commit()
 {
+  execute_removes();
+
   // write sequence to db
   sequencer_->commit();
 
@@ -199,6 +227,8 @@ void database::rollback()
 {
   sequencer_->rollback();
 
+  clear_removes();
+
   if (commiting_) {
     on_rollback();
     commiting_ = false;
@@ -223,8 +253,10 @@ void database::visit(insert_action *a)
     //i = table_map_.insert(std::make_pair(node.type, tbl)).first;
     throw database_exception("db", "table not found");
   }
-  
-  
+
+  // keep the order of deletes and inserts
+  execute_removes();
+
   insert_action::const_iterator first = a->begin();
   insert_action::const_iterator last = a->end();
   while (first != last) {
@@ -242,7 +274,19 @@ void database::visit(update_action *a)
     throw database_exception("db", "table not found");
   }
 
-  i->second->update(a->proxy()->obj());
+  execute_removes();
+
+  serializable *obj = a->proxy()->obj();
+  if (a->image().empty()) {
+    i->second->update(obj);
+    return;
+  }
+  // set only the columns and value_vectors modified since the backup
+  column_mask columns;
+  column_mask vectors;
+  if (a->image().compare(obj, columns, vectors)) {
+    i->second->update(obj, columns, vectors);
+  }
 }
 
 void database::visit(delete_action *a)
@@ -252,9 +296,32 @@ void database::visit(delete_action *a)
     throw database_exception("db", "table not found");
   }
 
-  // Todo: handle remove action (one solution: store primary key)
-//  i->second->remove(a->id());
+  // objects without primary key can't be found in the table
+  const basic_identifier *pk = a->pk();
+  if (!pk || !pk->is_valid()) {
+    return;
+  }
 
+  if (!i->second->has_removes()) {
+    removing_tables_.push_back(i->second);
+  }
+  i->second->remove(*pk);
+}
+
+void database::execute_removes()
+{
+  for (std::vector<table_ptr>::iterator i = removing_tables_.begin(); i != removing_tables_.end(); ++i) {
+    (*i)->execute_removes();
+  }
+  removing_tables_.clear();
+}
+
+void database::clear_removes()
+{
+  for (std::vector<table_ptr>::iterator i = removing_tables_.begin(); i != removing_tables_.end(); ++i) {
+    (*i)->clear_removes();
+  }
+  removing_tables_.clear();
 }
 
 const session* database::db() const
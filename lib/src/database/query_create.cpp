@@ -100,6 +100,11 @@ void query_create::write(const char *id, const time &)
   write(id, type_time);
 }
 
+void query_create::write(const char *id, const blob &)
+{
+  write(id, type_blob);
+}
+
 void query_create::write(const char *id, const object_base_ptr &)
 {
   write(id, type_long);
@@ -5,10 +5,37 @@
 #include "tools/varchar.hpp"
 #include "tools/date.hpp"
 #include "tools/time.hpp"
+#include "tools/blob.hpp"
 #include "tools/string.hpp"
 
 namespace oos {
 
+namespace {
+
+/*
+ * writes the blob as hex literal X'...',
+ * the data is read chunk by chunk
+ */
+std::string blob_literal(const blob &x)
+{
+  static const char digits[] = "0123456789ABCDEF";
+  std::string literal("X'");
+  literal.reserve(x.size() * 2 + 3);
+  char chunk[4096];
+  blob::size_type offset = 0, len = 0;
+  while ((len = x.read(offset, chunk, sizeof(chunk))) > 0) {
+    for (blob::size_type i = 0; i < len; ++i) {
+      literal += digits[(unsigned char)chunk[i] >> 4];
+      literal += digits[(unsigned char)chunk[i] & 0x0f];
+    }
+    offset += len;
+  }
+  literal += "'";
+  return literal;
+}
+
+}
+
 query_insert::query_insert(sql &s)
   : dialect(s)
   , first(true)
@@ -96,6 +123,11 @@ void query_insert::write(const char *id, const time &x)
   write_field(id, type_time, x);
 }
 
+void query_insert::write(const char *id, const blob &x)
+{
+  write_field(id, type_blob, x);
+}
+
 void query_insert::write(const char *id, const object_base_ptr &x)
 {
   if (x.has_primary_key()) {
@@ -191,11 +223,25 @@ void query_insert::write_field(const char *id, data_type_t type, const varchar_b
     dialect.append(id);
   } else {
     std::stringstream valstr;
-    valstr << "'" << x.str() << "'";
+    valstr << "'" << x << "'";
     dialect.append(id, type, valstr.str());
   }
 }
 
+void query_insert::write_field(const char *id, data_type_t type, const blob &x)
+{
+  if (first) {
+    first = false;
+  } else {
+    dialect.append(", ");
+  }
+  if (fields_) {
+    dialect.append(id);
+  } else {
+    dialect.append(id, type, blob_literal(x));
+  }
+}
+
 void query_insert::write_field(const char *id, data_type_t type, const char *x)
 {
   if (first) {
@@ -5,13 +5,49 @@
 
 #include "tools/date.hpp"
 #include "tools/time.hpp"
+#include "tools/blob.hpp"
 #include "tools/varchar.hpp"
 
 namespace oos {
 
+namespace {
+
+/*
+ * writes the blob as hex literal X'...',
+ * the data is read chunk by chunk
+ */
+std::string blob_literal(const blob &x)
+{
+  static const char digits[] = "0123456789ABCDEF";
+  std::string literal("X'");
+  literal.reserve(x.size() * 2 + 3);
+  char chunk[4096];
+  blob::size_type offset = 0, len = 0;
+  while ((len = x.read(offset, chunk, sizeof(chunk))) > 0) {
+    for (blob::size_type i = 0; i < len; ++i) {
+      literal += digits[(unsigned char)chunk[i] >> 4];
+      literal += digits[(unsigned char)chunk[i] & 0x0f];
+    }
+    offset += len;
+  }
+  literal += "'";
+  return literal;
+}
+
+}
+
 query_update::query_update(sql &s)
   : dialect(s)
   , first(true)
+  , columns_(nullptr)
+  , column_(0)
+{}
+
+query_update::query_update(sql &s, const column_mask &columns)
+  : dialect(s)
+  , first(true)
+  , columns_(&columns)
+  , column_(0)
 {}
 
 query_update::~query_update() {}
@@ -96,6 +132,11 @@ void query_update::write(const char *id, const time &x)
   write_pair(id, type_time, x);
 }
 
+void query_update::write(const char *id, const blob &x)
+{
+  write_pair(id, type_blob, x);
+}
+
 void query_update::write(const char *id, const object_base_ptr &x)
 {
   write_pair(id, type_long, x.id());
@@ -111,6 +152,9 @@ void query_update::write(const char *id, const basic_identifier &x)
 
 void query_update::write_pair(const char *id, data_type_t type, const oos::date &x)
 {
+  if (skip()) {
+    return;
+  }
   if (first) {
     first = false;
   } else {
@@ -125,6 +169,9 @@ void query_update::write_pair(const char *id, data_type_t type, const oos::date
 
 void query_update::write_pair(const char *id, data_type_t type, const oos::time &x)
 {
+  if (skip()) {
+    return;
+  }
   if (first) {
     first = false;
   } else {
@@ -139,6 +186,9 @@ void query_update::write_pair(const char *id, data_type_t type, const oos::time
 
 void query_update::write_pair(const char *id, data_type_t type, const std::string &x)
 {
+    if (skip()) {
+      return;
+    }
     if (first) {
       first = false;
     } else {
@@ -152,6 +202,9 @@ void query_update::write_pair(const char *id, data_type_t type, const std::strin
 
 void query_update::write_pair(const char *id, data_type_t type, const varchar_base &x)
 {
+    if (skip()) {
+      return;
+    }
     if (first) {
       first = false;
     } else {
@@ -159,12 +212,29 @@ void query_update::write_pair(const char *id, data_type_t type, const varchar_ba
     }
     dialect.append(std::string(id) + "=");
     std::stringstream valstr;
-    valstr << "'" << x.str() << "'";
+    valstr << "'" << x << "'";
     dialect.append(id, type, valstr.str());
 }
 
+void query_update::write_pair(const char *id, data_type_t type, const blob &x)
+{
+    if (skip()) {
+      return;
+    }
+    if (first) {
+      first = false;
+    } else {
+      dialect.append(", ");
+    }
+    dialect.append(std::string(id) + "=");
+    dialect.append(id, type, blob_literal(x));
+}
+
 void query_update::write_pair(const char *id, data_type_t type, const char *x)
 {
+    if (skip()) {
+      return;
+    }
     if (first) {
       first = false;
     } else {
@@ -176,4 +246,11 @@ void query_update::write_pair(const char *id, data_type_t type, const char *x)
     dialect.append(id, type, valstr.str());
 }
 
+bool query_update::skip()
+{
+  // the columns not in the mask are left out
+  column_mask::size_type column = column_++;
+  return columns_ && (column >= columns_->size() || !(*columns_)[column]);
+}
+
 }
@@ -8,6 +8,9 @@
 #include "object/object_ptr.hpp"
 #include "object/prototype_tree.hpp"
 #include "object/serializable.hpp"
+#include "object/basic_identifier.hpp"
+
+#include <chrono>
 
 namespace oos {
 namespace detail {
@@ -28,11 +31,16 @@ void result_impl::get(serializable *o)
 void result_impl::read_foreign_object(const char *id, object_base_ptr &x)
 {
   /*
-   * determine and create primary key of object ptr
-   *
+   * determine primary key of object ptr into the
+   * scratch identifier of the column (the object
+   * may be reused for several rows, its identifier
+   * is only replaced if the key changes)
    */
-
-  std::shared_ptr<basic_identifier> pk = x.primary_key();
+  std::size_t column = (std::size_t)result_index;
+  if (column >= foreign_keys_.size()) {
+    foreign_keys_.resize(column + 1);
+  }
+  std::unique_ptr<basic_identifier> &pk = foreign_keys_[column];
   if (!pk) {
     pk.reset(x.create_identifier());
   }
@@ -40,13 +48,33 @@ void result_impl::read_foreign_object(const char *id, object_base_ptr &x)
   pk->deserialize(id, *this);
   if (!pk->is_valid()) {
     // no pk is set => null
+    if (x.has_primary_key()) {
+      x.reset(nullptr, x.is_reference());
+    }
     return;
   }
 
   // set found primary key into object_base_ptr
-  if (!x.has_primary_key()) {
-    x.reset(pk);
+  if (!x.has_primary_key() || !(*x.primary_key() == *pk)) {
+    x.reset(std::shared_ptr<basic_identifier>(pk->clone()));
+  }
+}
+
+void result_impl::measure(sql_metrics::statistics *stats)
+{
+  statistics_ = stats;
+}
+
+bool result_impl::measured_fetch(serializable *o)
+{
+  typedef std::chrono::steady_clock clock_t;
+  clock_t::time_point start = clock_t::now();
+  bool fetched = fetch(o);
+  statistics_->fetch_ns += (double)std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - start).count();
+  if (fetched && statistics_->is_select) {
+    ++statistics_->rows;
   }
+  return fetched;
 }
 
 std::shared_ptr<object_base_producer> result_impl::producer() const
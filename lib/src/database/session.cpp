@@ -162,11 +162,15 @@ void session::commit(transaction &tr)
   }
 
   impl_->commit();
+
+  ostore_.end_transaction();
 }
 
 void session::rollback()
 {
   impl_->rollback();
+
+  ostore_.end_transaction();
 }
 
 transaction* session::current_transaction() const
@@ -20,6 +20,27 @@
 
 namespace oos {
 
+sql::sql(sql &&x)
+{
+  // the tokens are owned by the list
+  host_field_vector_.swap(x.host_field_vector_);
+  host_field_map_.swap(x.host_field_map_);
+  result_field_vector_.swap(x.result_field_vector_);
+  result_field_map_.swap(x.result_field_map_);
+  token_list_.swap(x.token_list_);
+}
+
+sql& sql::operator=(sql &&x)
+{
+  reset();
+  host_field_vector_.swap(x.host_field_vector_);
+  host_field_map_.swap(x.host_field_map_);
+  result_field_vector_.swap(x.result_field_vector_);
+  result_field_map_.swap(x.result_field_map_);
+  token_list_.swap(x.token_list_);
+  return *this;
+}
+
 sql::~sql()
 {
   reset();
@@ -0,0 +1,159 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "database/sql_metrics.hpp"
+
+#include "json/json.hpp"
+
+#include <cctype>
+#include <iomanip>
+#include <iostream>
+
+namespace oos {
+
+namespace {
+
+bool is_select(const std::string &sql)
+{
+  std::string::size_type i = sql.find_first_not_of(" \t\r\n(");
+  const char *select = "SELECT";
+  for (int j = 0; j < 6; ++j, ++i) {
+    if (i >= sql.size() || std::toupper((unsigned char)sql[i]) != select[j]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+sql_metrics::statistics::statistics()
+  : executions(0)
+  , rows(0)
+  , execute_ns(0)
+  , max_ns(0)
+  , bind_ns(0)
+  , fetch_ns(0)
+  , is_select(false)
+{}
+
+sql_metrics::sql_metrics()
+  : enabled_(false)
+  , threshold_ns_(0)
+  , log_(&std::clog)
+{}
+
+void sql_metrics::enable(bool enable)
+{
+  enabled_ = enable;
+}
+
+void sql_metrics::slow_query_threshold(double ms)
+{
+  threshold_ns_ = ms > 0 ? ms * 1e6 : 0;
+}
+
+double sql_metrics::slow_query_threshold() const
+{
+  return threshold_ns_ / 1e6;
+}
+
+void sql_metrics::slow_query_log(std::ostream &out)
+{
+  log_ = &out;
+}
+
+sql_metrics::statistics* sql_metrics::find(const std::string &sql)
+{
+  t_statistics_map::iterator i = statistics_map_.find(sql);
+  if (i == statistics_map_.end()) {
+    i = statistics_map_.insert(std::make_pair(sql, statistics())).first;
+    i->second.is_select = is_select(sql);
+  }
+  return &i->second;
+}
+
+void sql_metrics::executed(statistics &stats, const std::string &sql, double ns, double bind_ns, unsigned long long rows, const std::vector<std::string> &values)
+{
+  ++stats.executions;
+  stats.rows += rows;
+  stats.execute_ns += ns;
+  stats.bind_ns += bind_ns;
+  if (ns > stats.max_ns) {
+    stats.max_ns = ns;
+  }
+  if (threshold_ns_ <= 0 || ns < threshold_ns_) {
+    return;
+  }
+  std::ostream &out = *log_;
+  std::ios::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision(3);
+  out << "slow query (" << std::fixed << ns / 1e6 << " ms): " << sql;
+  out.flags(flags);
+  out.precision(precision);
+  if (!values.empty()) {
+    out << " [";
+    for (std::vector<std::string>::const_iterator i = values.begin(); i != values.end(); ++i) {
+      out << (i == values.begin() ? "" : ", ") << *i;
+    }
+    out << "]";
+  }
+  out << "\n";
+}
+
+const sql_metrics::t_statistics_map& sql_metrics::statistics_map() const
+{
+  return statistics_map_;
+}
+
+void sql_metrics::reset()
+{
+  // keep the entries, statements refer to them
+  for (t_statistics_map::iterator i = statistics_map_.begin(); i != statistics_map_.end(); ++i) {
+    bool select = i->second.is_select;
+    i->second = statistics();
+    i->second.is_select = select;
+  }
+}
+
+void sql_metrics::write_json(std::ostream &out) const
+{
+  json_value statements(new json_array);
+  for (t_statistics_map::const_iterator i = statistics_map_.begin(); i != statistics_map_.end(); ++i) {
+    const statistics &stats = i->second;
+    if (stats.executions == 0) {
+      continue;
+    }
+    json_value statement(new json_object);
+    statement["sql"] = i->first;
+    statement["executions"] = (double)stats.executions;
+    statement["rows"] = (double)stats.rows;
+    statement["execute_ns"] = stats.execute_ns;
+    statement["max_ns"] = stats.max_ns;
+    statement["bind_ns"] = stats.bind_ns;
+    statement["fetch_ns"] = stats.fetch_ns;
+    statement["total_ns"] = stats.execute_ns + stats.bind_ns + stats.fetch_ns;
+    statements.push_back(statement);
+  }
+  json_object root;
+  root["statements"] = statements;
+  std::streamsize precision = out.precision(15);
+  out << root;
+  out.precision(precision);
+}
+
+}
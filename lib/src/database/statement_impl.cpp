@@ -2,24 +2,270 @@
 // Created by sascha on 18.09.15.
 //
 #include "database/statement_impl.hpp"
+#include "database/result_impl.hpp"
 
 #include "object/serializable.hpp"
+#include "object/basic_identifier.hpp"
+#include "object/object_ptr.hpp"
+
+#include "tools/blob.hpp"
+#include "tools/string.hpp"
+#include "tools/varchar.hpp"
+
+#include <chrono>
+#include <sstream>
 
 namespace oos {
 
 namespace detail {
 
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+double nanoseconds_since(const clock_type::time_point &start)
+{
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count();
+}
+
+/*
+ * writes the bound values as text
+ * for the slow query log
+ */
+class value_printer : public generic_serializer<value_printer>
+{
+public:
+  explicit value_printer(std::vector<std::string> &values)
+    : generic_serializer<value_printer>(this)
+    , values_(values)
+  {}
+
+  template < class T >
+  void write_value(const char*, const T &x)
+  {
+    std::stringstream out;
+    out << x;
+    values_.push_back(out.str());
+  }
+
+  void write_value(const char*, char x)
+  {
+    values_.push_back(quoted(std::string(1, x)));
+  }
+
+  void write_value(const char*, unsigned char x)
+  {
+    write_value("", (unsigned int)x);
+  }
+
+  void write_value(const char*, bool x)
+  {
+    values_.push_back(x ? "true" : "false");
+  }
+
+  void write_value(const char*, const char *x, std::size_t)
+  {
+    values_.push_back(quoted(x));
+  }
+
+  void write_value(const char*, const std::string &x)
+  {
+    values_.push_back(quoted(x));
+  }
+
+  void write_value(const char*, const varchar_base &x)
+  {
+    values_.push_back(quoted(x.str()));
+  }
+
+  void write_value(const char*, const oos::date &x)
+  {
+    values_.push_back(quoted(to_string(x)));
+  }
+
+  void write_value(const char*, const oos::time &x)
+  {
+    values_.push_back(quoted(to_string(x)));
+  }
+
+  void write_value(const char*, const blob &x)
+  {
+    std::stringstream out;
+    out << "<blob of " << x.size() << " bytes>";
+    values_.push_back(out.str());
+  }
+
+  void write_value(const char*, const object_base_ptr &x)
+  {
+    write_value("", x.id());
+  }
+
+  void write_value(const char*, const object_container &) {}
+
+  void write_value(const char *id, const basic_identifier &x)
+  {
+    x.serialize(id, *this);
+  }
+
+private:
+  static std::string quoted(const std::string &x)
+  {
+    return "'" + x + "'";
+  }
+
+private:
+  std::vector<std::string> &values_;
+};
+
+/*
+ * forwards the columns of the
+ * mask to the statement
+ */
+class column_filter : public generic_serializer<column_filter>
+{
+public:
+  column_filter(serializer &s, const column_mask &columns)
+    : generic_serializer<column_filter>(this)
+    , serializer_(s)
+    , columns_(columns)
+    , column_(0)
+  {}
+
+  template < class T >
+  void write_value(const char *id, const T &x)
+  {
+    if (take()) {
+      serializer_.write(id, x);
+    }
+  }
+
+  void write_value(const char *id, const char *x, std::size_t s)
+  {
+    if (take()) {
+      serializer_.write(id, x, s);
+    }
+  }
+
+  void write_value(const char*, const object_container &) {}
+
+  void write_value(const char *id, const basic_identifier &x)
+  {
+    x.serialize(id, *this);
+  }
+
+private:
+  bool take()
+  {
+    column_mask::size_type column = column_++;
+    return column < columns_.size() && columns_[column];
+  }
+
+private:
+  serializer &serializer_;
+  const column_mask &columns_;
+  column_mask::size_type column_;
+};
+
+}
+
 statement_impl::~statement_impl()
 {}
 
 int statement_impl::bind(serializable *o)
 {
+  bool measured = metrics_ != nullptr && metrics_->enabled();
+  clock_type::time_point start;
+  if (measured) {
+    start = clock_type::now();
+  }
   reset();
   host_index = 0;
   o->serialize(*this);
+  if (measured) {
+    bind_ns_ += nanoseconds_since(start);
+    if (metrics_->logs_slow_queries()) {
+      // values bound afterwards (e.g. the primary key) are appended
+      values_.clear();
+      o->serialize(*parameter_printer());
+    }
+  }
   return host_index;
 }
 
+int statement_impl::bind(serializable *o, const column_mask &columns)
+{
+  bool measured = metrics_ != nullptr && metrics_->enabled();
+  clock_type::time_point start;
+  if (measured) {
+    start = clock_type::now();
+  }
+  reset();
+  host_index = 0;
+  column_filter filter(*this, columns);
+  o->serialize(filter);
+  if (measured) {
+    bind_ns_ += nanoseconds_since(start);
+    if (metrics_->logs_slow_queries()) {
+      values_.clear();
+      column_filter printer(*parameter_printer(), columns);
+      o->serialize(printer);
+    }
+  }
+  return host_index;
+}
+
+int statement_impl::bind_row(serializable *o, unsigned long pos)
+{
+  bool measured = metrics_ != nullptr && metrics_->enabled();
+  clock_type::time_point start;
+  if (measured) {
+    start = clock_type::now();
+  }
+  host_index = pos;
+  o->serialize(*this);
+  if (measured) {
+    bind_ns_ += nanoseconds_since(start);
+    if (metrics_->logs_slow_queries()) {
+      if (pos == 0) {
+        values_.clear();
+      }
+      o->serialize(*parameter_printer());
+    }
+  }
+  return host_index;
+}
+
+detail::result_impl* statement_impl::measured_execute()
+{
+  if (metrics_ == nullptr || !metrics_->enabled()) {
+    return execute();
+  }
+  if (statistics_ == nullptr) {
+    statistics_ = metrics_->find(sql_);
+  }
+  clock_type::time_point start = clock_type::now();
+  detail::result_impl *res = execute();
+  double ns = nanoseconds_since(start);
+  res->measure(statistics_);
+  metrics_->executed(*statistics_, sql_, ns, bind_ns_, statistics_->is_select ? 0 : res->affected_rows(), values_);
+  bind_ns_ = 0;
+  values_.clear();
+  return res;
+}
+
+void statement_impl::metrics(sql_metrics *m)
+{
+  metrics_ = m;
+}
+
+serializer* statement_impl::parameter_printer()
+{
+  if (!parameter_printer_) {
+    parameter_printer_.reset(new value_printer(values_));
+  }
+  return parameter_printer_.get();
+}
+
 std::string statement_impl::str() const
 {
   return sql_;
@@ -23,6 +23,11 @@
 #include "database/query.hpp"
 #include "database/condition.hpp"
 
+#include "object/value_vector.hpp"
+#include "object/basic_identifier.hpp"
+
+#include <algorithm>
+
 namespace oos {
 
 class relation_filler : public generic_deserializer<relation_filler>
@@ -94,6 +99,7 @@ public:
           x.append_proxy(j->second.front());
           j->second.pop_front();
         }
+        x.finish_append();
       }
     }
   }
@@ -103,12 +109,157 @@ private:
   object_proxy *proxy_;
 };
 
+/*
+ * collects the value_vectors and the
+ * primary key of an object
+ */
+class value_collector : public generic_deserializer<value_collector>
+{
+public:
+  value_collector()
+    : generic_deserializer<value_collector>(this)
+  {}
+  virtual ~value_collector() {}
+
+  void collect(serializable *obj)
+  {
+    pk = nullptr;
+    fields.clear();
+    vectors.clear();
+    obj->deserialize(*this);
+  }
+
+  unsigned long owner() const
+  {
+    if (!pk || !pk->is_integral()) {
+      throw database_exception("table", "value_vector needs an integral primary key");
+    }
+    return (unsigned long)pk->integral_value();
+  }
+
+  using generic_deserializer<value_collector>::read;
+
+  virtual void read(const char *id, basic_value_vector &x)
+  {
+    fields.push_back(id);
+    vectors.push_back(&x);
+  }
+
+  template < class T >
+  void read_value(const char*, T&) {}
+
+  void read_value(const char*, char*, size_t) {}
+
+  void read_value(const char*, basic_identifier &x)
+  {
+    pk = &x;
+  }
+
+  basic_identifier *pk = nullptr;
+  std::vector<const char*> fields;
+  std::vector<basic_value_vector*> vectors;
+};
+
+/*
+ * one row of the join table of a value_vector: the
+ * primary key of the owner, the position and the value
+ * of the element. While loading a row appends its value
+ * to the vector of the owner.
+ */
+class value_row : public serializable
+{
+public:
+  explicit value_row(table::value_table *values)
+    : vector(values->prototype)
+    , values_(values)
+  {}
+  virtual ~value_row() {}
+
+  virtual void serialize(serializer &s) const
+  {
+    s.write("owner_id", owner_id);
+    s.write("idx", index);
+    vector->write_element("value", index, s);
+  }
+
+  virtual void deserialize(deserializer &d)
+  {
+    d.read("owner_id", owner_id);
+    d.read("idx", index);
+    // the rows are ordered by owner
+    if (!found_ || owner_id != found_owner_) {
+      table::value_table::owner_map_t::iterator i = values_->owners.find(owner_id);
+      vector = i != values_->owners.end() ? i->second : nullptr;
+      found_owner_ = owner_id;
+      found_ = true;
+    }
+    if (vector) {
+      vector->read_element("value", d);
+    }
+  }
+
+  unsigned long owner_id = 0;
+  unsigned long index = 0;
+  basic_value_vector *vector;
+
+private:
+  table::value_table *values_;
+  unsigned long found_owner_ = 0;
+  bool found_ = false;
+};
+
+class value_row_producer : public object_base_producer
+{
+public:
+  explicit value_row_producer(table::value_table *values)
+    : values_(values)
+  {}
+  virtual ~value_row_producer() {}
+
+  virtual object_base_producer* clone() const
+  {
+    return new value_row_producer(values_);
+  }
+
+  virtual serializable* create() const
+  {
+    return new value_row(values_);
+  }
+
+  virtual const char* classname() const
+  {
+    return "value_row";
+  }
+
+private:
+  table::value_table *values_;
+};
+
 table::table(database &db, const prototype_node &node)
   : db_(db)
   , node_(node)
   , prepared_(false)
   , is_loaded_(false)
 {
+  /*
+   * each value_vector field gets a join table,
+   * the prototype object keeps one element per
+   * vector to describe the value column
+   */
+  std::unique_ptr<serializable> o(node_.producer->create());
+  value_collector collector;
+  collector.collect(o.get());
+  for (std::size_t i = 0; i < collector.vectors.size(); ++i) {
+    std::unique_ptr<value_table> values(new value_table);
+    values->field = collector.fields[i];
+    values->name = node_.type + "_" + values->field;
+    values->prototype = collector.vectors[i];
+    values->prototype->resize(1);
+    value_tables_.push_back(std::move(values));
+  }
+  if (!value_tables_.empty()) {
+    value_prototype_ = std::move(o);
+  }
 }
 
 table::~table()
@@ -131,6 +282,18 @@ void table::prepare()
   }
   select_ = q.select(node_.producer->clone()).from(node_.type).prepare();
 
+  if (!value_tables_.empty()) {
+    // the rows reference their owner by its primary key
+    value_collector collector;
+    collector.collect(value_prototype_.get());
+    collector.owner();
+  }
+  for (std::vector<std::unique_ptr<value_table> >::iterator i = value_tables_.begin(); i != value_tables_.end(); ++i) {
+    value_table &values = **i;
+    values.remove = q.remove(values.name).where(cond("owner_id").equal(0)).prepare();
+    values.select = q.select(new value_row_producer(&values)).from(values.name).order_by("owner_id, idx").prepare();
+  }
+
   prepared_ = true;
 }
 
@@ -140,7 +303,12 @@ void table::create()
 
   std::unique_ptr<serializable> obj(node_.producer->create());
   auto res = q.create(node_.type, obj.get()).execute();
-  
+
+  for (std::vector<std::unique_ptr<value_table> >::iterator i = value_tables_.begin(); i != value_tables_.end(); ++i) {
+    value_row row(i->get());
+    auto values_res = q.create((*i)->name, &row).execute();
+  }
+
   // prepare CRUD statements
   prepare();
 }
@@ -157,6 +325,8 @@ void table::load(object_store &ostore)
 
   reader.load(res);
 
+  load_values();
+
 //  select_.clear();
 
   /*
@@ -194,27 +364,252 @@ void table::insert(serializable *obj)
 //  if (res->affected_rows() != 1) {
 //    throw database_exception("insert", "more than one affected row while inserting an object");
 //  }
+
+  write_values(obj, nullptr, false);
 }
 
 void table::update(serializable *obj)
+{
+  update_row(obj);
+  write_values(obj, nullptr, true);
+}
+
+void table::update(serializable *obj, const column_mask &columns, const column_mask &vectors)
+{
+  if (std::find(columns.begin(), columns.end(), true) != columns.end()) {
+    update_columns(obj, columns);
+  }
+  write_values(obj, &vectors, true);
+}
+
+void table::update_row(serializable *obj)
 {
   int pos = update_.bind(obj);
-  // Todo: handle primary key
 
   primary_key_binder_.bind(obj, &update_, pos);
 
-//  update_->bind(pos, obj->id());
   auto res(update_.execute());
-  update_.clear();
 //  if (res->affected_rows() != 1) {
 //    throw database_exception("update", "more than one affected row while updating an object");
 //  }
 }
 
+void table::update_columns(serializable *obj, const column_mask &columns)
+{
+  if (std::find(columns.begin(), columns.end(), false) == columns.end()) {
+    update_row(obj);
+    return;
+  }
+
+  std::map<column_mask, statement<serializable> >::iterator i = column_updates_.find(columns);
+  if (i == column_updates_.end()) {
+    if (column_updates_.size() >= max_update_statements) {
+      // too many different column sets, update all columns
+      update_row(obj);
+      return;
+    }
+    query<serializable> q(db_);
+    i = column_updates_.insert(std::make_pair(columns, q.update(obj, node_.type, columns).where(cond("id").equal(0)).prepare())).first;
+  }
+
+  int pos = i->second.bind(obj, columns);
+
+  primary_key_binder_.bind(obj, &i->second, pos);
+
+  auto res(i->second.execute());
+}
+
 void table::remove(serializable *obj)
 {
-  // Todo: handle primary key
+  if (!prepared_) {
+    prepare();
+  }
+  delete_.reset();
   primary_key_binder_.bind(obj, &delete_, 0);
+  auto res(delete_.execute());
+
+  if (value_tables_.empty()) {
+    return;
+  }
+  value_collector collector;
+  collector.collect(obj);
+  unsigned long owner = collector.owner();
+  for (std::vector<std::unique_ptr<value_table> >::iterator i = value_tables_.begin(); i != value_tables_.end(); ++i) {
+    (*i)->remove.reset();
+    (*i)->remove.bind(0, owner);
+    auto values_res((*i)->remove.execute());
+  }
+}
+
+void table::remove(const basic_identifier &pk)
+{
+  removes_.push_back(&pk);
+}
+
+void table::execute_removes()
+{
+  if (removes_.empty()) {
+    return;
+  }
+  if (!prepared_) {
+    prepare();
+  }
+
+  execute_removes(remove_in_, node_.type, "id");
+  for (std::vector<std::unique_ptr<value_table> >::iterator i = value_tables_.begin(); i != value_tables_.end(); ++i) {
+    execute_removes((*i)->remove_in, (*i)->name, "owner_id");
+  }
+  removes_.clear();
+}
+
+void table::execute_removes(std::vector<statement<serializable> > &statements, const std::string &name, const char *column)
+{
+  /*
+   * delete the primary keys in chunks, the
+   * statement of a chunk may have more
+   * placeholders than keys, they are filled
+   * with the last key of the chunk
+   */
+  std::vector<const basic_identifier*>::size_type first = 0;
+  while (first < removes_.size()) {
+    std::size_t count = removes_.size() - first;
+    if (count > max_remove_chunk) {
+      count = max_remove_chunk;
+    }
+    std::size_t size = 0;
+    statement<serializable> &stmt = remove_statement(statements, name, column, count, size);
+    stmt.reset();
+    unsigned long pos = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      pos = stmt.bind(pos, *removes_[first + (i < count ? i : count - 1)]);
+    }
+    auto res(stmt.execute());
+    first += count;
+  }
+}
+
+void table::clear_removes()
+{
+  removes_.clear();
+}
+
+bool table::has_removes() const
+{
+  return !removes_.empty();
+}
+
+statement<serializable>& table::remove_statement(std::vector<statement<serializable> > &statements,
+                                                 const std::string &name, const char *column,
+                                                 std::size_t count, std::size_t &size)
+{
+  std::size_t index = 0;
+  size = 1;
+  while (size < count) {
+    size <<= 1;
+    ++index;
+  }
+  if (statements.size() <= index) {
+    statements.resize(index + 1);
+  }
+  statement<serializable> &stmt = statements[index];
+  if (!stmt.is_prepared()) {
+    query<serializable> q(db_);
+    stmt = q.remove(name).where_in(column, std::vector<unsigned long>(size, 0)).prepare();
+  }
+  return stmt;
+}
+
+void table::write_values(serializable *obj, const column_mask *vectors, bool replace)
+{
+  if (value_tables_.empty()) {
+    return;
+  }
+  value_collector collector;
+  collector.collect(obj);
+  unsigned long owner = collector.owner();
+  for (std::size_t i = 0; i < value_tables_.size(); ++i) {
+    if (vectors && (i >= vectors->size() || !(*vectors)[i])) {
+      continue;
+    }
+    value_table &values = *value_tables_[i];
+    if (replace) {
+      values.remove.reset();
+      values.remove.bind(0, owner);
+      auto res(values.remove.execute());
+    }
+    /*
+     * insert the elements in chunks of 1, 2, 4, ...
+     * rows, each chunk is the largest one not
+     * exceeding the remaining elements
+     */
+    value_row row(&values);
+    row.owner_id = owner;
+    row.vector = collector.vectors[i];
+    std::size_t count = row.vector->size();
+    row.index = 0;
+    while (row.index < count) {
+      std::size_t size = 0;
+      statement<serializable> &stmt = insert_statement(values, count - row.index, size);
+      stmt.reset();
+      unsigned long pos = 0;
+      for (std::size_t j = 0; j < size; ++j, ++row.index) {
+        pos = stmt.bind_row(&row, pos);
+      }
+      auto res(stmt.execute());
+    }
+  }
+}
+
+statement<serializable>& table::insert_statement(value_table &values, std::size_t count, std::size_t &size)
+{
+  if (count > max_insert_chunk) {
+    count = max_insert_chunk;
+  }
+  std::size_t index = 0;
+  size = 1;
+  while (size * 2 <= count) {
+    size <<= 1;
+    ++index;
+  }
+  if (values.insert_in.size() <= index) {
+    values.insert_in.resize(index + 1);
+  }
+  statement<serializable> &stmt = values.insert_in[index];
+  if (!stmt.is_prepared()) {
+    query<serializable> q(db_);
+    value_row row(&values);
+    stmt = q.insert(&row, values.name, size).prepare();
+  }
+  return stmt;
+}
+
+void table::load_values()
+{
+  if (value_tables_.empty()) {
+    return;
+  }
+  value_collector collector;
+  object_proxy *first = node_.op_first->next();
+  object_proxy *last = node_.op_marker;
+  for (; first != last; first = first->next()) {
+    if (!first->obj()) {
+      continue;
+    }
+    collector.collect(first->obj());
+    unsigned long owner = collector.owner();
+    for (std::size_t i = 0; i < value_tables_.size(); ++i) {
+      collector.vectors[i]->clear();
+      value_tables_[i]->owners[owner] = collector.vectors[i];
+    }
+  }
+
+  for (std::vector<std::unique_ptr<value_table> >::iterator i = value_tables_.begin(); i != value_tables_.end(); ++i) {
+    // each fetched row appends its value to the vector of its owner
+    auto res((*i)->select.execute());
+    res.reuse(true);
+    for (auto row = res.begin(); row != res.end(); ++row) {}
+    (*i)->owners.clear();
+  }
 }
 
 void table::drop()
@@ -223,6 +618,15 @@ void table::drop()
   update_.clear();
   delete_.clear();
   select_.clear();
+  for (std::vector<statement<serializable> >::iterator i = remove_in_.begin(); i != remove_in_.end(); ++i) {
+    i->clear();
+  }
+  remove_in_.clear();
+  removes_.clear();
+  for (std::map<column_mask, statement<serializable> >::iterator i = column_updates_.begin(); i != column_updates_.end(); ++i) {
+    i->second.clear();
+  }
+  column_updates_.clear();
 
   prepared_ = false;
 
@@ -230,6 +634,21 @@ void table::drop()
 
   auto res(q.drop(node_.type).execute());
   // Todo: check drop result
+
+  for (std::vector<std::unique_ptr<value_table> >::iterator i = value_tables_.begin(); i != value_tables_.end(); ++i) {
+    value_table &values = **i;
+    values.remove.clear();
+    values.select.clear();
+    for (std::vector<statement<serializable> >::iterator j = values.insert_in.begin(); j != values.insert_in.end(); ++j) {
+      j->clear();
+    }
+    values.insert_in.clear();
+    for (std::vector<statement<serializable> >::iterator j = values.remove_in.begin(); j != values.remove_in.end(); ++j) {
+      j->clear();
+    }
+    values.remove_in.clear();
+    auto values_res(q.drop(values.name).execute());
+  }
 }
 
 bool table::is_loaded() const
@@ -40,7 +40,7 @@ void table_reader::read_value(const char *, object_base_ptr &x)
    * if proxy can be found object was
    * already read - replace proxy
    */
-  object_proxy *proxy = node->find_proxy(pk);
+  object_proxy *proxy = pk->is_integral() ? node->find_proxy(pk->integral_value()) : node->find_proxy(pk);
   if (proxy) {
     x.reset(proxy, x.is_reference());
   } else {
@@ -91,6 +91,7 @@ void table_reader::read_value(const char *id, object_container &x)
     x.append_proxy(j->second.front());
     j->second.pop_front();
   }
+  x.finish_append();
 }
 
 }
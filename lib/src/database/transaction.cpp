@@ -53,6 +53,40 @@ void transaction::on_insert(object_proxy *proxy)
   }
 }
 
+void transaction::on_bulk_insert(const std::vector<object_proxy*> &proxies)
+{
+  /*****************
+   *
+   * all proxies of one type go into
+   * the same insert action, so only look
+   * for the action when the type changes
+   *
+   *****************/
+  action_inserter ai(action_list_);
+  iterator j = action_list_.end();
+  prototype_node *node = nullptr;
+  for (std::vector<object_proxy*>::const_iterator i = proxies.begin(); i != proxies.end(); ++i) {
+    object_proxy *proxy = *i;
+    if (id_map_.find(proxy->id()) != id_map_.end()) {
+      // ERROR: an serializable with that id already exists
+      std::stringstream msg;
+      msg << "an serializable with id " << proxy->id() << " already exists";
+      throw database_exception("database", msg.str().c_str());
+    }
+    if (j == action_list_.end() || proxy->node() != node) {
+      j = ai.insert(proxy);
+      node = proxy->node();
+      if (j == action_list_.end()) {
+        // should not happen
+        continue;
+      }
+    } else {
+      static_cast<insert_action*>(*j)->push_back(proxy);
+    }
+    id_map_.insert(std::make_pair(proxy->id(), j));
+  }
+}
+
 void transaction::on_update(object_proxy *proxy)
 {
   /*****************
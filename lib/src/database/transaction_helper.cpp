@@ -40,10 +40,12 @@ void backup_visitor::visit(insert_action *)
   // nothing to do
 }
 
-void backup_visitor::visit(update_action*)
+void backup_visitor::visit(update_action *a)
 {
   // serialize serializable
   serializer_.serialize(object_, buffer_);
+  // keep the column values to find the modified columns on commit
+  a->image().take(object_);
 }
 
 void backup_visitor::visit(delete_action*)
@@ -0,0 +1,536 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "json/json_deserializer.hpp"
+
+#include "object/serializable.hpp"
+#include "object/object_store.hpp"
+#include "object/object_proxy.hpp"
+#include "object/object_ptr.hpp"
+#include "object/object_exception.hpp"
+#include "object/basic_identifier.hpp"
+#include "object/value_vector.hpp"
+
+#include "tools/varchar.hpp"
+#include "tools/date.hpp"
+#include "tools/time.hpp"
+#include "tools/blob.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace oos {
+
+namespace detail {
+
+/*
+ * the parser keeps \uXXXX sequences
+ * untouched; decode them into utf-8
+ */
+namespace {
+
+bool is_unicode_escape(const std::string &in, std::string::size_type i)
+{
+  return i + 5 < in.size() && in[i] == '\\' && in[i + 1] == 'u';
+}
+
+unsigned long code_unit(const std::string &in, std::string::size_type i)
+{
+  char hex[5] = { in[i + 2], in[i + 3], in[i + 4], in[i + 5], '\0' };
+  return strtoul(hex, nullptr, 16);
+}
+
+}
+
+void decode_unicode(const std::string &in, std::string &out)
+{
+  out.clear();
+  std::string::size_type len = in.size();
+  for (std::string::size_type i = 0; i < len; ++i) {
+    if (!is_unicode_escape(in, i)) {
+      out.push_back(in[i]);
+      continue;
+    }
+    unsigned long cp = code_unit(in, i);
+    i += 5;
+    if (cp >= 0xdc00 && cp <= 0xdfff) {
+      throw std::logic_error("json string contains a lone low surrogate");
+    } else if (cp >= 0xd800 && cp <= 0xdbff) {
+      // a high surrogate must be followed by a low one
+      unsigned long low = is_unicode_escape(in, i + 1) ? code_unit(in, i + 1) : 0;
+      if (low < 0xdc00 || low > 0xdfff) {
+        throw std::logic_error("json string contains a lone high surrogate");
+      }
+      cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+      i += 6;
+    }
+    if (cp < 0x80) {
+      out.push_back((char)cp);
+    } else if (cp < 0x800) {
+      out.push_back((char)(0xc0 | (cp >> 6)));
+      out.push_back((char)(0x80 | (cp & 0x3f)));
+    } else if (cp < 0x10000) {
+      out.push_back((char)(0xe0 | (cp >> 12)));
+      out.push_back((char)(0x80 | ((cp >> 6) & 0x3f)));
+      out.push_back((char)(0x80 | (cp & 0x3f)));
+    } else {
+      out.push_back((char)(0xf0 | (cp >> 18)));
+      out.push_back((char)(0x80 | ((cp >> 12) & 0x3f)));
+      out.push_back((char)(0x80 | ((cp >> 6) & 0x3f)));
+      out.push_back((char)(0x80 | (cp & 0x3f)));
+    }
+  }
+}
+
+}
+
+json_deserializer::json_deserializer(object_store *ostore)
+  : generic_json_parser<json_deserializer>(this)
+  , generic_deserializer<json_deserializer>(this)
+  , ostore_(ostore)
+{}
+
+json_deserializer::~json_deserializer()
+{}
+
+void json_deserializer::deserialize(serializable *o, std::istream &in)
+{
+  target_ = o;
+  bulk_store_ = nullptr;
+  type_ = nullptr;
+  level_ = 0;
+  object_level_ = 1;
+  count_ = 0;
+  parse_json(in);
+}
+
+void json_deserializer::deserialize(serializable *o, const std::string &str)
+{
+  std::istringstream in(str);
+  deserialize(o, in);
+}
+
+void json_deserializer::deserialize(serializable *o, const char *str)
+{
+  std::istringstream in(str);
+  deserialize(o, in);
+}
+
+std::size_t json_deserializer::deserialize(object_store &ostore, const char *type, std::istream &in)
+{
+  target_ = nullptr;
+  bulk_store_ = &ostore;
+  type_ = type;
+  level_ = 0;
+  object_level_ = 2;
+  count_ = 0;
+  parse_json(in);
+  bulk_store_ = nullptr;
+  return count_;
+}
+
+void json_deserializer::on_begin_object()
+{
+  ++level_;
+  if (level_ == object_level_) {
+    field_count_ = 0;
+    element_count_ = 0;
+    cursor_ = 0;
+    current_ = nullptr;
+    pk_value_ = 0;
+  } else if (level_ < object_level_) {
+    throw std::logic_error("json root must be an array of objects");
+  }
+}
+
+void json_deserializer::on_object_key(const std::string &key)
+{
+  if (level_ == object_level_) {
+    current_ = next_field();
+    current_->key.assign(key);
+  }
+}
+
+void json_deserializer::on_end_object()
+{
+  if (level_ == object_level_) {
+    finish_object();
+  }
+  --level_;
+}
+
+void json_deserializer::on_begin_array()
+{
+  if (level_ == object_level_ && current_) {
+    current_->type = JSON_ARRAY;
+    current_->first = element_count_;
+    current_->count = 0;
+  } else if (level_ == 0 && object_level_ == 1) {
+    throw std::logic_error("json root must be an object");
+  }
+  ++level_;
+}
+
+void json_deserializer::on_end_array()
+{
+  --level_;
+  if (level_ == object_level_) {
+    current_ = nullptr;
+  }
+}
+
+void json_deserializer::on_string(const std::string &value)
+{
+  field *f = value_field();
+  if (f) {
+    f->type = JSON_STRING;
+    if (value.find("\\u") == std::string::npos) {
+      f->text.assign(value);
+    } else {
+      detail::decode_unicode(value, f->text);
+    }
+  }
+}
+
+void json_deserializer::on_number(double value)
+{
+  field *f = value_field();
+  if (f) {
+    f->type = JSON_NUMBER;
+    f->number = value;
+  }
+}
+
+void json_deserializer::on_bool(bool value)
+{
+  field *f = value_field();
+  if (f) {
+    f->type = JSON_BOOL;
+    f->boolean = value;
+  }
+}
+
+void json_deserializer::on_null()
+{
+  field *f = value_field();
+  if (f) {
+    f->type = JSON_NULL;
+  }
+}
+
+void json_deserializer::read_value(const char *id, char &x)
+{
+  const field *f = find_field(id);
+  if (f && f->type == JSON_STRING) {
+    x = f->text.empty() ? '\0' : f->text[0];
+  }
+}
+
+void json_deserializer::read_value(const char *id, float &x)
+{
+  x = (float)find_number(id);
+}
+
+void json_deserializer::read_value(const char *id, double &x)
+{
+  x = find_number(id);
+}
+
+void json_deserializer::read_value(const char *id, short &x)
+{
+  x = (short)find_number(id);
+}
+
+void json_deserializer::read_value(const char *id, int &x)
+{
+  x = (int)find_number(id);
+}
+
+void json_deserializer::read_value(const char *id, long &x)
+{
+  x = (long)find_number(id);
+}
+
+void json_deserializer::read_value(const char *id, unsigned char &x)
+{
+  x = (unsigned char)find_number(id);
+}
+
+void json_deserializer::read_value(const char *id, unsigned short &x)
+{
+  x = (unsigned short)find_number(id);
+}
+
+void json_deserializer::read_value(const char *id, unsigned int &x)
+{
+  x = (unsigned int)find_number(id);
+}
+
+void json_deserializer::read_value(const char *id, unsigned long &x)
+{
+  x = (unsigned long)find_number(id);
+}
+
+void json_deserializer::read_value(const char *id, bool &x)
+{
+  const field *f = find_field(id);
+  x = f && f->type == JSON_BOOL && f->boolean;
+}
+
+void json_deserializer::read_value(const char *id, char *x, size_t s)
+{
+  if (s == 0) {
+    return;
+  }
+  const field *f = find_field(id);
+  if (f && f->type == JSON_STRING) {
+    size_t len = std::min(f->text.size(), s - 1);
+    memcpy(x, f->text.data(), len);
+    x[len] = '\0';
+  } else {
+    x[0] = '\0';
+  }
+}
+
+void json_deserializer::read(const char *id, basic_value_vector &x)
+{
+  x.clear();
+  const field *f = find_field(id);
+  if (!f || f->type != JSON_ARRAY) {
+    return;
+  }
+  // each element is read as the value of the field
+  try {
+    for (std::size_t i = 0; i < f->count; ++i) {
+      element_ = &elements_[f->first + i];
+      x.read_element(id, *this);
+    }
+  } catch (...) {
+    element_ = nullptr;
+    throw;
+  }
+  element_ = nullptr;
+}
+
+void json_deserializer::read_value(const char *id, std::string &x)
+{
+  const field *f = find_field(id);
+  if (f && f->type == JSON_STRING) {
+    x.assign(f->text);
+  } else {
+    x.clear();
+  }
+}
+
+void json_deserializer::read_value(const char *id, varchar_base &x)
+{
+  const field *f = find_field(id);
+  if (f && f->type == JSON_STRING) {
+    x.assign(f->text.c_str(), f->text.size());
+  } else {
+    x.assign("", 0);
+  }
+}
+
+void json_deserializer::read_value(const char *id, date &x)
+{
+  const field *f = find_field(id);
+  if (f && f->type == JSON_STRING) {
+    x.set(f->text.c_str(), "%Y-%m-%d");
+  }
+}
+
+void json_deserializer::read_value(const char *id, time &x)
+{
+  const field *f = find_field(id);
+  if (f && f->type == JSON_STRING) {
+    x = time::parse(f->text, "%Y-%m-%d %H:%M:%S.%f");
+  }
+}
+
+void json_deserializer::read_value(const char *id, blob &x)
+{
+  const field *f = find_field(id);
+  if (!f || f->type != JSON_STRING) {
+    x.clear();
+    return;
+  }
+  // decode the base64 string
+  std::string data;
+  data.reserve(f->text.size() / 4 * 3);
+  unsigned long bits = 0;
+  int count = 0;
+  for (std::string::const_iterator i = f->text.begin(); i != f->text.end(); ++i) {
+    char c = *i;
+    int value;
+    if (c >= 'A' && c <= 'Z') {
+      value = c - 'A';
+    } else if (c >= 'a' && c <= 'z') {
+      value = c - 'a' + 26;
+    } else if (c >= '0' && c <= '9') {
+      value = c - '0' + 52;
+    } else if (c == '+') {
+      value = 62;
+    } else if (c == '/') {
+      value = 63;
+    } else {
+      // padding
+      continue;
+    }
+    bits = (bits << 6) | value;
+    if (++count == 4) {
+      data.push_back((char)(bits >> 16));
+      data.push_back((char)(bits >> 8));
+      data.push_back((char)bits);
+      bits = 0;
+      count = 0;
+    }
+  }
+  if (count == 3) {
+    data.push_back((char)(bits >> 10));
+    data.push_back((char)(bits >> 2));
+  } else if (count == 2) {
+    data.push_back((char)(bits >> 4));
+  }
+  x.assign(data.data(), data.size());
+}
+
+void json_deserializer::read_value(const char *id, object_base_ptr &x)
+{
+  object_store *ostore = bulk_store_ ? bulk_store_ : ostore_;
+  unsigned long oid = (unsigned long)find_number(id);
+  if (oid == 0 || ostore == nullptr) {
+    return;
+  }
+  object_proxy *proxy = ostore->find_proxy(oid);
+  if (proxy) {
+    x.reset(proxy, x.is_reference());
+  }
+}
+
+void json_deserializer::read_value(const char *, object_container &)
+{
+  // container content isn't imported
+}
+
+void json_deserializer::read_value(const char *id, basic_identifier &x)
+{
+  x.deserialize(id, *this);
+  pk_value_ = (unsigned long)find_number(id);
+}
+
+json_deserializer::field* json_deserializer::next_field()
+{
+  if (field_count_ == fields_.size()) {
+    fields_.push_back(field());
+  }
+  field *f = &fields_[field_count_++];
+  f->type = JSON_NULL;
+  f->count = 0;
+  return f;
+}
+
+json_deserializer::field* json_deserializer::next_element()
+{
+  if (element_count_ == elements_.size()) {
+    elements_.push_back(field());
+  }
+  field *f = &elements_[element_count_++];
+  f->type = JSON_NULL;
+  return f;
+}
+
+json_deserializer::field* json_deserializer::value_field()
+{
+  /*
+   * values of the current object and the
+   * elements of its array fields are kept,
+   * nested objects and arrays are skipped
+   */
+  if (current_ == nullptr) {
+    return nullptr;
+  } else if (level_ == object_level_) {
+    return current_;
+  } else if (level_ == object_level_ + 1 && current_->type == JSON_ARRAY) {
+    ++current_->count;
+    return next_element();
+  }
+  return nullptr;
+}
+
+const json_deserializer::field* json_deserializer::find_field(const char *id)
+{
+  if (element_) {
+    return element_;
+  }
+  /*
+   * fields are usually read in the same order
+   * they were written, so try the next field first
+   */
+  if (cursor_ < field_count_ && fields_[cursor_].key == id) {
+    return &fields_[cursor_++];
+  }
+  for (std::size_t i = 0; i < field_count_; ++i) {
+    if (fields_[i].key == id) {
+      cursor_ = i + 1;
+      return &fields_[i];
+    }
+  }
+  return nullptr;
+}
+
+double json_deserializer::find_number(const char *id)
+{
+  const field *f = find_field(id);
+  if (f && f->type == JSON_NUMBER) {
+    return f->number;
+  }
+  return 0.0;
+}
+
+void json_deserializer::finish_object()
+{
+  cursor_ = 0;
+  if (bulk_store_ == nullptr) {
+    if (target_) {
+      target_->deserialize(*this);
+    }
+    return;
+  }
+
+  serializable *o = bulk_store_->create(type_);
+  object_proxy *proxy = new object_proxy(o);
+  try {
+    o->deserialize(*this);
+    if (pk_value_ > 0) {
+      if (bulk_store_->find_proxy(pk_value_)) {
+        throw object_exception("object with id already exists");
+      }
+      proxy->id(pk_value_);
+    }
+    bulk_store_->insert_proxy(proxy);
+  } catch (...) {
+    delete proxy;
+    throw;
+  }
+  ++count_;
+}
+
+}
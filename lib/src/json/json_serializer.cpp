@@ -0,0 +1,351 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "json/json_serializer.hpp"
+
+#include "object/serializable.hpp"
+#include "object/object_container.hpp"
+#include "object/object_proxy.hpp"
+#include "object/basic_identifier.hpp"
+#include "object/value_vector.hpp"
+
+#include "tools/varchar.hpp"
+#include "tools/date.hpp"
+#include "tools/time.hpp"
+#include "tools/blob.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace oos {
+
+json_serializer::json_serializer()
+  : generic_serializer<json_serializer>(this)
+{}
+
+json_serializer::~json_serializer()
+{}
+
+const std::string& json_serializer::serialize(const serializable *o)
+{
+  buffer_.clear();
+  append(o);
+  return buffer_;
+}
+
+void json_serializer::append(const serializable *o)
+{
+  if (o == nullptr) {
+    buffer_.append("null");
+    return;
+  }
+  buffer_.push_back('{');
+  first_ = true;
+  o->serialize(*this);
+  buffer_.push_back('}');
+}
+
+const std::string& json_serializer::str() const
+{
+  return buffer_;
+}
+
+void json_serializer::clear()
+{
+  buffer_.clear();
+}
+
+void json_serializer::reserve(std::size_t size)
+{
+  buffer_.reserve(size);
+}
+
+void json_serializer::write_value(const char *id, char x)
+{
+  write_key(id);
+  write_string(&x, x == '\0' ? 0 : 1);
+}
+
+void json_serializer::write_value(const char *id, float x)
+{
+  write_key(id);
+  if (!std::isfinite(x)) {
+    buffer_.append("null");
+    return;
+  }
+  char buf[32];
+  int len = snprintf(buf, sizeof(buf), "%.9g", (double)x);
+  buffer_.append(buf, len);
+}
+
+void json_serializer::write_value(const char *id, double x)
+{
+  write_key(id);
+  if (!std::isfinite(x)) {
+    buffer_.append("null");
+    return;
+  }
+  char buf[32];
+  int len = snprintf(buf, sizeof(buf), "%.17g", x);
+  buffer_.append(buf, len);
+}
+
+void json_serializer::write_value(const char *id, short x)
+{
+  write_key(id);
+  write_signed(x);
+}
+
+void json_serializer::write_value(const char *id, int x)
+{
+  write_key(id);
+  write_signed(x);
+}
+
+void json_serializer::write_value(const char *id, long x)
+{
+  write_key(id);
+  write_signed(x);
+}
+
+void json_serializer::write_value(const char *id, unsigned char x)
+{
+  write_key(id);
+  write_unsigned(x);
+}
+
+void json_serializer::write_value(const char *id, unsigned short x)
+{
+  write_key(id);
+  write_unsigned(x);
+}
+
+void json_serializer::write_value(const char *id, unsigned int x)
+{
+  write_key(id);
+  write_unsigned(x);
+}
+
+void json_serializer::write_value(const char *id, unsigned long x)
+{
+  write_key(id);
+  write_unsigned(x);
+}
+
+void json_serializer::write_value(const char *id, bool x)
+{
+  write_key(id);
+  buffer_.append(x ? "true" : "false");
+}
+
+void json_serializer::write_value(const char *id, const char *x, size_t s)
+{
+  write_key(id);
+  const char *end = (const char*)memchr(x, '\0', s);
+  write_string(x, end ? (size_t)(end - x) : s);
+}
+
+void json_serializer::write(const char *id, const basic_value_vector &x)
+{
+  write_key(id);
+  buffer_.push_back('[');
+  // the elements are written without a key
+  first_ = true;
+  for (basic_value_vector::size_type i = 0; i < x.size(); ++i) {
+    x.write_element(nullptr, i, *this);
+  }
+  first_ = false;
+  buffer_.push_back(']');
+}
+
+void json_serializer::write_value(const char *id, const std::string &x)
+{
+  write_key(id);
+  write_string(x.data(), x.size());
+}
+
+void json_serializer::write_value(const char *id, const varchar_base &x)
+{
+  write_key(id);
+  write_string(x.c_str(), x.size());
+}
+
+void json_serializer::write_value(const char *id, const date &x)
+{
+  write_key(id);
+  char buf[32];
+  int len = snprintf(buf, sizeof(buf), "\"%04d-%02d-%02d\"", x.year(), x.month(), x.day());
+  buffer_.append(buf, len);
+}
+
+void json_serializer::write_value(const char *id, const time &x)
+{
+  write_key(id);
+  char buf[48];
+  int len = snprintf(buf, sizeof(buf), "\"%04d-%02d-%02d %02d:%02d:%02d.%06ld\"",
+                     x.year(), x.month(), x.day(), x.hour(), x.minute(), x.second(), (long)x.get_timeval().tv_usec);
+  buffer_.append(buf, len);
+}
+
+void json_serializer::write_value(const char *id, const blob &x)
+{
+  // the data is written as base64 string
+  static const char digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  write_key(id);
+  buffer_.push_back('"');
+  // the chunk size is a multiple of three
+  char chunk[3 * 1024];
+  blob::size_type offset = 0, len = 0;
+  while ((len = x.read(offset, chunk, sizeof(chunk))) > 0) {
+    for (blob::size_type i = 0; i < len; i += 3) {
+      unsigned long bits = (unsigned long)(unsigned char)chunk[i] << 16;
+      if (i + 1 < len) {
+        bits |= (unsigned long)(unsigned char)chunk[i + 1] << 8;
+      }
+      if (i + 2 < len) {
+        bits |= (unsigned char)chunk[i + 2];
+      }
+      buffer_.push_back(digits[(bits >> 18) & 0x3f]);
+      buffer_.push_back(digits[(bits >> 12) & 0x3f]);
+      buffer_.push_back(i + 1 < len ? digits[(bits >> 6) & 0x3f] : '=');
+      buffer_.push_back(i + 2 < len ? digits[bits & 0x3f] : '=');
+    }
+    offset += len;
+  }
+  buffer_.push_back('"');
+}
+
+void json_serializer::write_value(const char *id, const object_base_ptr &x)
+{
+  write_key(id);
+  if (x.id() > 0) {
+    write_unsigned(x.id());
+  } else {
+    buffer_.append("null");
+  }
+}
+
+void json_serializer::write_value(const char *id, const object_container &x)
+{
+  write_key(id);
+  buffer_.push_back('[');
+  bool first = true;
+  x.for_each([&](const object_proxy *proxy) {
+    if (!first) {
+      buffer_.push_back(',');
+    }
+    first = false;
+    write_unsigned(proxy->id());
+  });
+  buffer_.push_back(']');
+}
+
+void json_serializer::write_value(const char *id, const basic_identifier &x)
+{
+  x.serialize(id, *this);
+}
+
+void json_serializer::write_key(const char *id)
+{
+  if (!first_) {
+    buffer_.push_back(',');
+  }
+  first_ = false;
+  if (id == nullptr) {
+    // an array element
+    return;
+  }
+  buffer_.push_back('"');
+  buffer_.append(id);
+  buffer_.append("\":", 2);
+}
+
+void json_serializer::write_signed(long long x)
+{
+  if (x < 0) {
+    buffer_.push_back('-');
+    // negate in unsigned space to handle the minimum value
+    write_unsigned(0ULL - (unsigned long long)x);
+  } else {
+    write_unsigned((unsigned long long)x);
+  }
+}
+
+void json_serializer::write_unsigned(unsigned long long x)
+{
+  char buf[24];
+  char *end = buf + sizeof(buf);
+  char *pos = end;
+  do {
+    *--pos = (char)('0' + (x % 10));
+    x /= 10;
+  } while (x > 0);
+  buffer_.append(pos, end - pos);
+}
+
+void json_serializer::write_string(const char *str, size_t len)
+{
+  static const char *hex = "0123456789abcdef";
+
+  buffer_.push_back('"');
+  const char *first = str;
+  const char *last = str + len;
+  const char *chunk = first;
+  while (first != last) {
+    unsigned char c = (unsigned char)*first;
+    if (c >= 0x20 && c != '"' && c != '\\') {
+      ++first;
+      continue;
+    }
+    // flush unescaped chunk
+    buffer_.append(chunk, first - chunk);
+    switch (c) {
+      case '"':
+        buffer_.append("\\\"", 2);
+        break;
+      case '\\':
+        buffer_.append("\\\\", 2);
+        break;
+      case '\b':
+        buffer_.append("\\b", 2);
+        break;
+      case '\f':
+        buffer_.append("\\f", 2);
+        break;
+      case '\n':
+        buffer_.append("\\n", 2);
+        break;
+      case '\r':
+        buffer_.append("\\r", 2);
+        break;
+      case '\t':
+        buffer_.append("\\t", 2);
+        break;
+      default:
+        buffer_.append("\\u00", 4);
+        buffer_.push_back(hex[c >> 4]);
+        buffer_.push_back(hex[c & 0xf]);
+        break;
+    }
+    chunk = ++first;
+  }
+  buffer_.append(chunk, last - chunk);
+  buffer_.push_back('"');
+}
+
+}
@@ -6,6 +6,7 @@
 #include "object/basic_identifier.hpp"
 
 #include <iosfwd>
+#include <stdexcept>
 
 namespace oos {
 basic_identifier::basic_identifier() {
@@ -29,6 +30,16 @@ bool basic_identifier::operator<(const basic_identifier &x) const {
   return less(x);
 }
 
+bool basic_identifier::is_integral() const
+{
+  return false;
+}
+
+long long basic_identifier::integral_value() const
+{
+  throw std::logic_error("identifier isn't integral");
+}
+
 std::ostream &operator<<(std::ostream &os, const basic_identifier &x) {
   return x.print(os);
 }
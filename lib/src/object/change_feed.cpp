@@ -0,0 +1,300 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "object/change_feed.hpp"
+#include "object/object_store.hpp"
+#include "object/object_proxy.hpp"
+#include "object/prototype_node.hpp"
+#include "object/object_exception.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+namespace oos {
+
+namespace {
+
+/*
+ * layout of a record in the ring buffer:
+ * header, type name, image; padded to 8 bytes
+ */
+struct record_header
+{
+  uint32_t size;
+  uint32_t action;
+  uint64_t sequence;
+  uint64_t id;
+  uint32_t type_size;
+  uint32_t image_size;
+};
+
+const uint32_t has_image_flag = 0x100;
+
+std::size_t record_size(std::size_t type_size, std::size_t image_size)
+{
+  return (sizeof(record_header) + type_size + image_size + 7) & ~(std::size_t)7;
+}
+
+}
+
+change_feed::change_feed(object_store &ostore, std::size_t capacity, bool with_image)
+  : ostore_(ostore)
+  , capacity_(capacity)
+  , with_image_(with_image)
+  , data_(new char[capacity])
+  , head_(0)
+  , tail_(0)
+  , sequence_(0)
+{
+  if (capacity_ < record_size(0, 0)) {
+    throw object_exception("change feed capacity too small");
+  }
+  ostore_.register_observer(this);
+}
+
+change_feed::~change_feed()
+{
+  ostore_.unregister_observer(this);
+}
+
+change_feed::cursor change_feed::first() const
+{
+  cursor c;
+  while (true) {
+    unsigned long long t = tail_.load(std::memory_order_acquire);
+    if (t == head_.load(std::memory_order_acquire)) {
+      c.offset_ = t;
+      c.sequence_ = sequence_.load(std::memory_order_acquire);
+      return c;
+    }
+    record_header header;
+    read(t, &header, sizeof(header));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (t == tail_.load(std::memory_order_relaxed)) {
+      c.offset_ = t;
+      c.sequence_ = header.sequence;
+      return c;
+    }
+    // oldest record was overwritten meanwhile, retry
+  }
+}
+
+change_feed::cursor change_feed::current() const
+{
+  cursor c;
+  c.offset_ = head_.load(std::memory_order_acquire);
+  c.sequence_ = sequence_.load(std::memory_order_acquire);
+  return c;
+}
+
+change_feed::poll_result change_feed::poll(cursor &c, record &r) const
+{
+  unsigned long long h = head_.load(std::memory_order_acquire);
+  if (c.offset_ >= h) {
+    return POLL_EMPTY;
+  }
+  if (c.offset_ < tail_.load(std::memory_order_acquire)) {
+    return POLL_OVERRUN;
+  }
+
+  /*
+   * the producer moves the tail before it overwrites
+   * any byte, so the copied data is valid if the
+   * tail is still not behind the cursor afterwards
+   */
+  record_header header;
+  read(c.offset_, &header, sizeof(header));
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (c.offset_ < tail_.load(std::memory_order_relaxed)) {
+    return POLL_OVERRUN;
+  }
+
+  r.type.resize(header.type_size);
+  r.image.resize(header.image_size);
+  unsigned long long offset = c.offset_ + sizeof(header);
+  if (header.type_size > 0) {
+    read(offset, &r.type[0], header.type_size);
+  }
+  offset += header.type_size;
+  if (header.image_size > 0) {
+    read(offset, &r.image[0], header.image_size);
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (c.offset_ < tail_.load(std::memory_order_relaxed)) {
+    return POLL_OVERRUN;
+  }
+
+  r.sequence = header.sequence;
+  r.action = (action_type)(header.action & ~has_image_flag);
+  r.id = (unsigned long)header.id;
+  r.has_image = (header.action & has_image_flag) != 0;
+
+  c.offset_ += header.size;
+  c.sequence_ = header.sequence + 1;
+  return POLL_RECORD;
+}
+
+unsigned long long change_feed::lag(const cursor &c) const
+{
+  unsigned long long seq = sequence_.load(std::memory_order_acquire);
+  return c.sequence_ < seq ? seq - c.sequence_ : 0;
+}
+
+unsigned long long change_feed::sequence() const
+{
+  return sequence_.load(std::memory_order_acquire);
+}
+
+std::size_t change_feed::capacity() const
+{
+  return capacity_;
+}
+
+void change_feed::flush()
+{
+  publish_pending(0);
+  pending_.clear();
+  pending_ids_.clear();
+  published_ = 0;
+}
+
+void change_feed::on_insert(object_proxy *proxy)
+{
+  /*
+   * keep the mutation order but don't flush: the insert
+   * may be part of the modification of a pending object,
+   * e.g. item->ptr(ostore.insert(new child))
+   */
+  publish_pending(published_);
+  published_ = pending_.size();
+  publish(ACTION_INSERT, proxy);
+}
+
+void change_feed::on_update(object_proxy *proxy)
+{
+  // the image is taken on flush, after the modification
+  if (pending_ids_.insert(proxy->id()).second) {
+    pending_.push_back(proxy->id());
+  }
+}
+
+void change_feed::on_delete(object_proxy *proxy)
+{
+  flush();
+  publish(ACTION_DELETE, proxy);
+}
+
+void change_feed::on_transaction_end()
+{
+  flush();
+}
+
+void change_feed::publish_pending(std::size_t first)
+{
+  for (std::size_t i = first; i < pending_.size(); ++i) {
+    // object may be gone meanwhile (e.g. store was cleared)
+    object_proxy *proxy = ostore_.find_proxy(pending_[i]);
+    if (proxy && proxy->obj()) {
+      publish(ACTION_UPDATE, proxy);
+    }
+  }
+}
+
+void change_feed::publish(action_type action, object_proxy *proxy)
+{
+  const std::string *type = proxy->node() ? &proxy->node()->type : nullptr;
+  std::size_t type_size = type ? type->size() : 0;
+
+  bool has_image = false;
+  image_.clear();
+  if (with_image_ && action != ACTION_DELETE && proxy->obj()) {
+    buffer_.clear();
+    serializer_.serialize(proxy->obj(), &buffer_);
+    image_.resize(buffer_.size());
+    if (!image_.empty()) {
+      buffer_.release(&image_[0], image_.size());
+    }
+    has_image = true;
+  }
+
+  std::size_t size = record_size(type_size, image_.size());
+  if (size > capacity_) {
+    // image doesn't fit at all, publish record without it
+    has_image = false;
+    image_.clear();
+    size = record_size(type_size, 0);
+    if (size > capacity_) {
+      throw object_exception("change feed record exceeds capacity");
+    }
+  }
+
+  unsigned long long h = head_.load(std::memory_order_relaxed);
+  unsigned long long t = tail_.load(std::memory_order_relaxed);
+
+  // drop the oldest records until the new one fits
+  while (h + size - t > capacity_) {
+    record_header oldest;
+    read(t, &oldest, sizeof(oldest));
+    t += oldest.size;
+  }
+  tail_.store(t, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  unsigned long long seq = sequence_.load(std::memory_order_relaxed);
+
+  record_header header;
+  header.size = (uint32_t)size;
+  header.action = (uint32_t)action | (has_image ? has_image_flag : 0);
+  header.sequence = seq;
+  header.id = proxy->id();
+  header.type_size = (uint32_t)type_size;
+  header.image_size = (uint32_t)image_.size();
+
+  write(h, &header, sizeof(header));
+  if (type_size > 0) {
+    write(h + sizeof(header), type->data(), type_size);
+  }
+  if (!image_.empty()) {
+    write(h + sizeof(header) + type_size, image_.data(), image_.size());
+  }
+
+  head_.store(h + size, std::memory_order_release);
+  sequence_.store(seq + 1, std::memory_order_release);
+}
+
+void change_feed::write(unsigned long long offset, const void *data, std::size_t size)
+{
+  std::size_t pos = (std::size_t)(offset % capacity_);
+  std::size_t first = std::min(size, capacity_ - pos);
+  memcpy(data_.get() + pos, data, first);
+  if (first < size) {
+    memcpy(data_.get(), (const char*)data + first, size - first);
+  }
+}
+
+void change_feed::read(unsigned long long offset, void *data, std::size_t size) const
+{
+  std::size_t pos = (std::size_t)(offset % capacity_);
+  std::size_t first = std::min(size, capacity_ - pos);
+  memcpy(data, data_.get() + pos, first);
+  if (first < size) {
+    memcpy((char*)data + first, data_.get(), size - first);
+  }
+}
+
+}
@@ -0,0 +1,227 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "object/field_table.hpp"
+#include "object/serializable.hpp"
+#include "object/object_producer.hpp"
+#include "object/object_ptr.hpp"
+
+#include "tools/date.hpp"
+#include "tools/time.hpp"
+#include "tools/blob.hpp"
+
+#include <memory>
+#include <type_traits>
+
+namespace oos {
+
+namespace {
+
+/*
+ * Reads the fields of an object and records
+ * the offset of each member. The fields of a
+ * second object are compared with the recorded
+ * ones, a field with a different offset isn't
+ * a member (i.e. it is read into a temporary)
+ * and can't be accessed directly.
+ */
+class field_analyzer : public generic_deserializer<field_analyzer>
+{
+public:
+  explicit field_analyzer(field_table::t_field_vector &fields)
+    : generic_deserializer<field_analyzer>(this)
+    , fields_(fields)
+  {}
+
+  void analyze(serializable *obj, bool verify)
+  {
+    obj_ = reinterpret_cast<char*>(obj);
+    verify_ = verify;
+    index_ = 0;
+    identifier_ = nullptr;
+    obj->deserialize(*this);
+  }
+
+  template < class V >
+  void read_value(const char *id, V &x)
+  {
+    typename std::is_integral<V>::type is_key;
+    field(id, type_traits<V>::data_type(), &x, is_key);
+  }
+
+  void read_value(const char *id, char *x, size_t)
+  {
+    // character arrays are accessed by name
+    field(id, type_char_pointer, x, nullptr, nullptr);
+  }
+
+  void read_value(const char *id, std::string &x)
+  {
+    field(id, type_text, &x, std::true_type());
+  }
+
+  void read_value(const char *id, varchar_base &x)
+  {
+    field(id, type_varchar, &x, std::false_type());
+  }
+
+  void read_value(const char *id, date &x)
+  {
+    field(id, type_date, &x, std::false_type());
+  }
+
+  void read_value(const char *id, time &x)
+  {
+    field(id, type_time, &x, std::false_type());
+  }
+
+  void read_value(const char *id, object_base_ptr &x)
+  {
+    // object pointers are accessed by name
+    field(id, type_long, &x, nullptr, nullptr);
+  }
+
+  void read_value(const char*, object_container&) {}
+
+  void read_value(const char *id, basic_identifier &x)
+  {
+    identifier_ = &x;
+    x.deserialize(id, *this);
+    identifier_ = nullptr;
+  }
+
+private:
+  // a value of a primary key type may be read by an identifier
+  template < class V >
+  void field(const char *id, data_type_t type, V *member, std::true_type)
+  {
+    if (identifier_) {
+      field(id, type, identifier_, &detail::identifier_thunk<V>::get, &detail::identifier_thunk<V>::set);
+    } else {
+      field(id, type, member, std::false_type());
+    }
+  }
+
+  template < class V >
+  void field(const char *id, data_type_t type, V *member, std::false_type)
+  {
+    field(id, type, member, &detail::field_thunk<V>::get, &detail::field_thunk<V>::set);
+  }
+
+  void field(const char *id, data_type_t type, const void *member, field_descriptor::getter get, field_descriptor::setter set)
+  {
+    std::ptrdiff_t offset = static_cast<const char*>(member) - obj_;
+    std::size_t index = index_++;
+    if (!verify_) {
+      fields_.push_back(field_descriptor(id, type, index));
+      field_descriptor &f = fields_.back();
+      f.offset = offset;
+      f.get_ = get;
+      f.set_ = set;
+    } else if (index < fields_.size() && fields_[index].offset != offset) {
+      fields_[index].get_ = nullptr;
+      fields_[index].set_ = nullptr;
+    }
+  }
+
+private:
+  field_table::t_field_vector &fields_;
+  char *obj_ = nullptr;
+  bool verify_ = false;
+  std::size_t index_ = 0;
+  basic_identifier *identifier_ = nullptr;
+};
+
+}
+
+field_descriptor::field_descriptor(const std::string &n, data_type_t t, std::size_t i)
+  : name(n)
+  , type(t)
+  , index(i)
+  , offset(0)
+  , get_(nullptr)
+  , set_(nullptr)
+{}
+
+bool field_descriptor::direct() const
+{
+  return get_ != nullptr;
+}
+
+const std::size_t field_table::npos = static_cast<std::size_t>(-1);
+
+void field_table::build(const object_base_producer &producer)
+{
+  clear();
+  std::unique_ptr<serializable> first(producer.create());
+  std::unique_ptr<serializable> second(producer.create());
+  if (!first || !second) {
+    return;
+  }
+  field_analyzer analyzer(fields_);
+  analyzer.analyze(first.get(), false);
+  analyzer.analyze(second.get(), true);
+
+  for (t_field_vector::const_iterator i = fields_.begin(); i != fields_.end(); ++i) {
+    names_.insert(std::make_pair(i->name, i->index));
+  }
+}
+
+const field_descriptor* field_table::find(const std::string &name) const
+{
+  std::unordered_map<std::string, std::size_t>::const_iterator i = names_.find(name);
+  return i != names_.end() ? &fields_[i->second] : nullptr;
+}
+
+std::size_t field_table::index(const std::string &name) const
+{
+  std::unordered_map<std::string, std::size_t>::const_iterator i = names_.find(name);
+  return i != names_.end() ? i->second : npos;
+}
+
+const field_descriptor& field_table::operator[](std::size_t i) const
+{
+  return fields_[i];
+}
+
+field_table::const_iterator field_table::begin() const
+{
+  return fields_.begin();
+}
+
+field_table::const_iterator field_table::end() const
+{
+  return fields_.end();
+}
+
+std::size_t field_table::size() const
+{
+  return fields_.size();
+}
+
+bool field_table::empty() const
+{
+  return fields_.empty();
+}
+
+void field_table::clear()
+{
+  fields_.clear();
+  names_.clear();
+}
+
+}
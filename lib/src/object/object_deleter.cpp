@@ -30,6 +30,7 @@ object_deleter::t_object_count_struct::t_object_count_struct(object_proxy *oprox
   , ref_count(oproxy->ref_count())
   , ptr_count(oproxy->ptr_count())
   , ignore(ignr)
+  , visited(false)
 {}
 
 object_deleter::object_deleter()
@@ -42,22 +43,34 @@ object_deleter::~object_deleter()
 bool
 object_deleter::is_deletable(object_proxy *proxy)
 {
-  object_count_map.clear();
-  object_count_map.insert(std::make_pair(proxy->id(), t_object_count(proxy, false)));
+  reset();
+  visit(acquire(proxy, false).first);
 
-  // start collecting information
-  proxy->obj()->deserialize(*this);
-  
   return check_object_count_map();
 }
 
 bool object_deleter::is_deletable(object_container &oc)
 {
-  object_count_map.clear();
+  reset();
   oc.for_each(std::bind(&object_deleter::check_object_list_node, this, _1));
   return check_object_count_map();
 }
 
+bool object_deleter::is_deletable(const std::vector<object_proxy*> &proxies)
+{
+  reset();
+  for (std::vector<object_proxy*>::const_iterator i = proxies.begin(); i != proxies.end(); ++i) {
+    std::pair<std::size_t, bool> ret = acquire(*i, false);
+    /*
+     * an object of the batch may already be collected
+     * as a (not yet traversed) reference of a prior one
+     */
+    object_count_list_[ret.first].ignore = false;
+    visit(ret.first);
+  }
+  return check_object_count_map();
+}
+
 void object_deleter::read_value(const char*, object_base_ptr &x)
 {
   if (!x.ptr()) {
@@ -79,34 +92,32 @@ void object_deleter::read_value(char const *id, basic_identifier &x)
 object_deleter::iterator
 object_deleter::begin()
 {
-  return object_count_map.begin();
+  return object_count_list_.begin();
 }
 
 object_deleter::iterator
 object_deleter::end()
 {
-  return object_count_map.end();
+  return object_count_list_.end();
 }
 
 void object_deleter::check_object(object_proxy *proxy, bool is_ref)
 {
-  std::pair<t_object_count_map::iterator, bool> ret = object_count_map.insert(std::make_pair(proxy->id(), t_object_count(proxy)));
+  std::size_t index = acquire(proxy, true).first;
   if (!is_ref) {
-    --ret.first->second.ptr_count;
+    --object_count_list_[index].ptr_count;
+    object_count_list_[index].ignore = false;
+    visit(index);
   } else {
-    --ret.first->second.ref_count;
-  }
-  if (!is_ref) {
-    ret.first->second.ignore = false;
-    proxy->obj()->deserialize(*this);
+    --object_count_list_[index].ref_count;
   }
 }
 
 void
 object_deleter::check_object_list_node(object_proxy *proxy)
 {
-  std::pair<t_object_count_map::iterator, bool> ret = object_count_map.insert(std::make_pair(proxy->id(), t_object_count(proxy, false)));
-  
+  std::size_t index = acquire(proxy, false).first;
+
   /**********
    * 
    * serializable is already in list and will
@@ -115,25 +126,23 @@ object_deleter::check_object_list_node(object_proxy *proxy)
    * node must be deleted
    * 
    **********/
-  if (!ret.second && ret.first->second.ignore) {
-    ret.first->second.ignore = false;
-  }
+  object_count_list_[index].ignore = false;
 
   // start collecting information
-  proxy->obj()->deserialize(*this);
+  visit(index);
 }
 
 bool
 object_deleter::check_object_count_map() const
 {
   // check the reference and pointer counter of collected objects
-  const_iterator first = object_count_map.begin();
-  const_iterator last = object_count_map.end();
+  const_iterator first = object_count_list_.begin();
+  const_iterator last = object_count_list_.end();
   while (first != last)
   {
-    if (first->second.ignore) {
+    if (first->ignore) {
       ++first;
-    } else if (first->second.ref_count == 0 && first->second.ptr_count == 0) {
+    } else if (first->ref_count == 0 && first->ptr_count == 0) {
       ++first;
     } else {
       return false;
@@ -142,4 +151,30 @@ object_deleter::check_object_count_map() const
   return true;
 }
 
+void object_deleter::reset()
+{
+  // clear keeps the allocated capacity for the next check
+  object_count_list_.clear();
+  object_index_map_.clear();
+}
+
+std::pair<std::size_t, bool> object_deleter::acquire(object_proxy *proxy, bool ignore)
+{
+  std::pair<t_object_index_map::iterator, bool> ret = object_index_map_.insert(std::make_pair(proxy->id(), object_count_list_.size()));
+  if (ret.second) {
+    object_count_list_.push_back(t_object_count(proxy, ignore));
+  }
+  return std::make_pair(ret.first->second, ret.second);
+}
+
+void object_deleter::visit(std::size_t index)
+{
+  if (object_count_list_[index].visited) {
+    return;
+  }
+  object_count_list_[index].visited = true;
+  // the list may grow while traversing, so don't keep a reference
+  object_count_list_[index].proxy->obj()->deserialize(*this);
+}
+
 }
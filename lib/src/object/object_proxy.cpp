@@ -65,15 +65,6 @@ object_proxy::~object_proxy()
   }
 }
   
-serializable *object_proxy::obj()
-{
-  return obj_;
-}
-
-const serializable *object_proxy::obj() const {
-  return obj_;
-}
-
 object_store *object_proxy::ostore() const
 {
   return ostore_;
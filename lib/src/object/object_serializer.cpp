@@ -18,13 +18,16 @@
 #include "tools/date.hpp"
 #include "tools/time.hpp"
 #include "tools/varchar.hpp"
+#include "tools/blob.hpp"
 
 #include "object/object_serializer.hpp"
 #include "object/serializable.hpp"
 #include "object/object_store.hpp"
 #include "object/object_list.hpp"
+#include "object/value_vector.hpp"
 
 #include <cstring>
+#include <vector>
 
 using namespace std::placeholders;
 using namespace std;
@@ -52,6 +55,20 @@ bool object_serializer::deserialize(serializable *o, byte_buffer *buffer, object
   return true;
 }
 
+void object_serializer::write(const char *id, const basic_value_vector &x)
+{
+  std::string buf;
+  x.encode(buf);
+  write_value(id, buf);
+}
+
+void object_serializer::read(const char *id, basic_value_vector &x)
+{
+  std::string buf;
+  read_value(id, buf);
+  x.decode(buf);
+}
+
 void object_serializer::write_value(const char*, const char *c, size_t s)
 {
   size_t len = s;
@@ -73,7 +90,7 @@ void object_serializer::write_value(const char*, const varchar_base &s)
   size_t len = s.size();
   
   buffer_->append(&len, sizeof(len));
-  buffer_->append(s.str().c_str(), len);
+  buffer_->append(s.c_str(), len);
 }
 
 void object_serializer::write_value(const char *id, const date &x)
@@ -88,6 +105,16 @@ void object_serializer::write_value(const char *id, const time &x)
   write_value(id, tv.tv_usec);
 }
 
+void object_serializer::write_value(const char*, const blob &x)
+{
+  size_t len = x.size();
+
+  buffer_->append(&len, sizeof(len));
+  if (len > 0) {
+    buffer_->append(x.data(), len);
+  }
+}
+
 void object_serializer::write_value(const char*, const object_base_ptr &x)
 {
   // write type and id into buffer
@@ -151,6 +178,17 @@ void object_serializer::read_value(const char *, time &x)
   x.set(tv);
 }
 
+void object_serializer::read_value(const char*, blob &x)
+{
+  size_t len = 0;
+  buffer_->release(&len, sizeof(len));
+  std::vector<char> data(len);
+  if (len > 0) {
+    buffer_->release(&data.front(), len);
+  }
+  x.assign(data.empty() ? nullptr : &data.front(), len);
+}
+
 void object_serializer::read_value(const char*, object_base_ptr &x)
 {
   /***************
@@ -196,6 +234,7 @@ void object_serializer::read_value(const char*, object_container &x)
     }
     x.append_proxy(oproxy);
   }
+  x.finish_append();
 }
 
 void object_serializer::read_value(const char *id, basic_identifier &x)
@@ -25,6 +25,7 @@
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <typeinfo>
 
 using namespace std;
 using namespace std::placeholders;
@@ -147,6 +148,11 @@ void object_store::mark_modified(object_proxy *oproxy)
   std::for_each(observer_list_.begin(), observer_list_.end(), std::bind(&object_observer::on_update, _1, oproxy));
 }
 
+void object_store::end_transaction()
+{
+  std::for_each(observer_list_.begin(), observer_list_.end(), std::bind(&object_observer::on_transaction_end, _1));
+}
+
 void object_store::register_observer(object_observer *observer)
 {
   if (std::find(observer_list_.begin(), observer_list_.end(), observer) == observer_list_.end()) {
@@ -180,6 +186,11 @@ object_proxy* object_store::insert_object(serializable *o, bool notify)
     // raise exception
     throw object_exception("couldn't insert serializable");
   }
+  return insert_object(o, node, notify);
+}
+
+object_proxy* object_store::insert_object(serializable *o, prototype_iterator &node, bool notify)
+{
   // retrieve and set new unique number into serializable
   object_proxy *oproxy = nullptr;
   t_serializable_proxy_map::iterator i = serializable_map_.find(o);
@@ -216,6 +227,51 @@ object_proxy* object_store::insert_object(serializable *o, bool notify)
   return initialze_proxy(oproxy, node, notify);
 }
 
+void object_store::bulk_insert(const std::vector<serializable*> &objects)
+{
+  if (objects.empty()) {
+    return;
+  }
+
+  /*
+   * resolve the prototype nodes first (only when
+   * the type changes) so that an invalid object
+   * leaves the store untouched
+   */
+  std::vector<prototype_iterator> nodes;
+  nodes.reserve(objects.size());
+
+  const std::type_info *type = nullptr;
+  prototype_iterator node = prototype_tree_.end();
+
+  for (std::vector<serializable*>::const_iterator i = objects.begin(); i != objects.end(); ++i) {
+    serializable *o = *i;
+    if (!o) {
+      throw object_exception("serializable is null");
+    }
+    if (type == nullptr || typeid(*o) != *type) {
+      type = &typeid(*o);
+      node = prototype_tree_.find(type->name());
+      if (node == prototype_tree_.end()) {
+        throw object_exception("couldn't insert serializable");
+      }
+    }
+    nodes.push_back(node);
+  }
+
+  object_map_.reserve(object_map_.size() + objects.size());
+
+  std::vector<object_proxy*> proxies;
+  proxies.reserve(objects.size());
+
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    proxies.push_back(insert_object(objects[i], nodes[i], false));
+  }
+
+  // notify observer once for the whole batch
+  std::for_each(observer_list_.begin(), observer_list_.end(), std::bind(&object_observer::on_bulk_insert, _1, std::cref(proxies)));
+}
+
 object_proxy *object_store::initialze_proxy(object_proxy *oproxy, prototype_iterator &node, bool notify)
 {// insert new element node
   node->insert(oproxy);
@@ -265,13 +321,60 @@ object_store::remove(object_proxy *proxy)
   object_deleter::iterator last = object_deleter_.end();
   
   while (first != last) {
-    if (!first->second.ignore) {
-      remove_object((first++)->second.proxy, true);
+    if (!first->ignore) {
+      remove_object((first++)->proxy, true);
     } else {
       ++first;
     }
   }
 }
+
+std::size_t
+object_store::remove_proxies(const std::vector<object_proxy*> &proxies)
+{
+  if (proxies.empty()) {
+    return 0;
+  }
+  for (std::vector<object_proxy*>::const_iterator i = proxies.begin(); i != proxies.end(); ++i) {
+    if (*i == nullptr) {
+      throw object_exception("serializable proxy is nullptr");
+    }
+    if ((*i)->node() == nullptr) {
+      throw object_exception("prototype node is nullptr");
+    }
+  }
+  // check the whole batch at once
+  if (!object_deleter_.is_deletable(proxies)) {
+    throw object_exception("serializable is not removable");
+  }
+
+  std::vector<object_proxy*> removed;
+  removed.reserve(object_deleter_.end() - object_deleter_.begin());
+
+  object_deleter::iterator first = object_deleter_.begin();
+  object_deleter::iterator last = object_deleter_.end();
+
+  for (; first != last; ++first) {
+    if (first->ignore) {
+      continue;
+    }
+    object_proxy *proxy = first->proxy;
+    if (object_map_.erase(proxy->id()) != 1) {
+      throw object_exception("couldn't remove serializable");
+    }
+    proxy->node()->remove(proxy);
+    removed.push_back(proxy);
+  }
+
+  // notify observer once for the whole batch
+  std::for_each(observer_list_.begin(), observer_list_.end(), std::bind(&object_observer::on_bulk_delete, _1, std::cref(removed)));
+
+  for (std::vector<object_proxy*>::iterator i = removed.begin(); i != removed.end(); ++i) {
+    delete *i;
+  }
+  return removed.size();
+}
+
 void
 object_store::remove_object(object_proxy *proxy, bool notify)
 {
@@ -324,8 +427,8 @@ object_store::remove(object_container &oc)
   object_deleter::iterator last = object_deleter_.end();
   
   while (first != last) {
-    if (!first->second.ignore) {
-      remove_object((first++)->second.proxy, true);
+    if (!first->ignore) {
+      remove_object((first++)->proxy, true);
     } else {
       ++first;
     }
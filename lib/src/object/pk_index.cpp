@@ -0,0 +1,145 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "object/pk_index.hpp"
+
+namespace oos {
+
+namespace {
+
+const std::size_t min_capacity = 16;
+
+}
+
+pk_index::pk_index()
+  : mask_(0)
+  , size_(0)
+{}
+
+pk_index::~pk_index()
+{}
+
+bool pk_index::insert(key_type key, object_proxy *proxy)
+{
+  // keep the load factor below 3/4
+  if ((size_ + 1) * 4 > slots_.size() * 3) {
+    rehash(slots_.empty() ? min_capacity : slots_.size() * 2);
+  }
+  std::size_t i = home(key);
+  while (slots_[i].proxy) {
+    if (slots_[i].key == key) {
+      return false;
+    }
+    i = (i + 1) & mask_;
+  }
+  slots_[i].key = key;
+  slots_[i].proxy = proxy;
+  ++size_;
+  return true;
+}
+
+object_proxy* pk_index::find(key_type key) const
+{
+  std::size_t i = locate(key);
+  return i < slots_.size() ? slots_[i].proxy : nullptr;
+}
+
+bool pk_index::erase(key_type key)
+{
+  std::size_t i = locate(key);
+  if (i == slots_.size()) {
+    return false;
+  }
+  --size_;
+  /*
+   * shift the following entries of the probe
+   * sequence back into the free slot unless
+   * their home slot lies behind the free slot
+   */
+  for (;;) {
+    slots_[i].proxy = nullptr;
+    std::size_t j = i;
+    for (;;) {
+      j = (j + 1) & mask_;
+      if (!slots_[j].proxy) {
+        return true;
+      }
+      std::size_t k = home(slots_[j].key);
+      bool stays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+      if (!stays) {
+        break;
+      }
+    }
+    slots_[i] = slots_[j];
+    i = j;
+  }
+}
+
+void pk_index::clear()
+{
+  for (std::vector<slot>::iterator i = slots_.begin(); i != slots_.end(); ++i) {
+    i->proxy = nullptr;
+  }
+  size_ = 0;
+}
+
+std::size_t pk_index::size() const
+{
+  return size_;
+}
+
+bool pk_index::empty() const
+{
+  return size_ == 0;
+}
+
+std::size_t pk_index::home(key_type key) const
+{
+  // fibonacci hashing spreads consecutive keys
+  unsigned long long h = static_cast<unsigned long long>(key) * 0x9E3779B97F4A7C15ULL;
+  return static_cast<std::size_t>(h ^ (h >> 32)) & mask_;
+}
+
+std::size_t pk_index::locate(key_type key) const
+{
+  if (size_ == 0) {
+    return slots_.size();
+  }
+  std::size_t i = home(key);
+  while (slots_[i].proxy) {
+    if (slots_[i].key == key) {
+      return i;
+    }
+    i = (i + 1) & mask_;
+  }
+  return slots_.size();
+}
+
+void pk_index::rehash(std::size_t capacity)
+{
+  std::vector<slot> old(capacity, slot{0, nullptr});
+  old.swap(slots_);
+  mask_ = capacity - 1;
+  size_ = 0;
+  for (std::vector<slot>::const_iterator i = old.begin(); i != old.end(); ++i) {
+    if (i->proxy) {
+      insert(i->key, i->proxy);
+    }
+  }
+}
+
+}
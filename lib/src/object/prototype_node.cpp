@@ -168,11 +168,24 @@ void prototype_node::insert(object_proxy *proxy)
   }
   // set prototype node
   proxy->node_ = this;
+  // like in the list the proxy goes before the last proxy
+  if (proxy_array.empty()) {
+    proxy->node_index_ = 0;
+    proxy_array.push_back(proxy);
+  } else {
+    object_proxy *back = proxy_array.back();
+    proxy->node_index_ = proxy_array.size() - 1;
+    back->node_index_ = proxy_array.size();
+    proxy_array.back() = proxy;
+    proxy_array.push_back(back);
+  }
   // adjust size
   ++count;
   // find and insert primary key
   std::shared_ptr<basic_identifier> pk(identifier_resolver::resolve(proxy->obj()));
-  if (pk) {
+  if (pk && pk->is_integral()) {
+    integral_key_index.insert(pk->integral_value(), proxy);
+  } else if (pk) {
     primary_key_map.insert(std::make_pair(pk, proxy));
   }
 }
@@ -197,8 +210,24 @@ void prototype_node::remove(object_proxy *proxy)
   proxy->prev_ = nullptr;
   proxy->next_ = nullptr;
 
-  if (has_primary_key()) {
-    if (primary_key_map.erase(proxy->primary_key_) == 0) {
+  // leave a hole in the dense array to keep the order
+  if (proxy->node_index_ < proxy_array.size() && proxy_array[proxy->node_index_] == proxy) {
+    proxy_array[proxy->node_index_] = nullptr;
+    ++proxy_holes;
+    while (!proxy_array.empty() && proxy_array.back() == nullptr) {
+      proxy_array.pop_back();
+      --proxy_holes;
+    }
+    if (proxy_holes * 2 > proxy_array.size()) {
+      compact_proxy_array();
+    }
+  }
+  proxy->node_index_ = 0;
+
+  if (has_primary_key() && proxy->primary_key_) {
+    if (proxy->primary_key_->is_integral()) {
+      integral_key_index.erase(proxy->primary_key_->integral_value());
+    } else if (primary_key_map.erase(proxy->primary_key_) == 0) {
       // couldn't find and erase primary key
     }
   }
@@ -207,6 +236,19 @@ void prototype_node::remove(object_proxy *proxy)
   --count;
 }
 
+void prototype_node::compact_proxy_array()
+{
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < proxy_array.size(); ++i) {
+    if (proxy_array[i]) {
+      proxy_array[i]->node_index_ = size;
+      proxy_array[size++] = proxy_array[i];
+    }
+  }
+  proxy_array.resize(size);
+  proxy_holes = 0;
+}
+
 void prototype_node::clear(bool recursive)
 {
   if (!empty(true)) {
@@ -221,6 +263,9 @@ void prototype_node::clear(bool recursive)
       delete op;
     }
     primary_key_map.clear();
+    integral_key_index.clear();
+    proxy_array.clear();
+    proxy_holes = 0;
     count = 0;
   }
 
@@ -317,6 +362,45 @@ prototype_node* prototype_node::previous_node(const prototype_node *root) const
   }
 }
 
+prototype_node* prototype_node::next_subtree_node(const prototype_node *root) const
+{
+  // children first
+  if (first && first->next != last.get()) {
+    return first->next;
+  }
+  // then the next sibling of this node or of
+  // the nearest parent inside of the subtree
+  const prototype_node *node = this;
+  while (node != root) {
+    if (node->next != node->parent->last.get()) {
+      return node->next;
+    }
+    node = node->parent;
+  }
+  return nullptr;
+}
+
+prototype_node* prototype_node::previous_subtree_node(const prototype_node *root) const
+{
+  if (this == root) {
+    return nullptr;
+  }
+  // the last node of the previous siblings subtree
+  if (prev != parent->first.get()) {
+    return prev->last_subtree_node();
+  }
+  return parent;
+}
+
+prototype_node* prototype_node::last_subtree_node() const
+{
+  const prototype_node *node = this;
+  while (node->first && node->first->next != node->last.get()) {
+    node = node->last->prev;
+  }
+  return const_cast<prototype_node*>(node);
+}
+
 bool prototype_node::is_child_of(const prototype_node *parent) const
 {
   const prototype_node *node = this;
@@ -339,13 +423,18 @@ bool prototype_node::has_primary_key() const
 
 object_proxy *prototype_node::find_proxy(const std::shared_ptr<basic_identifier> &pk)
 {
-  t_primary_key_map::iterator i = std::find_if(primary_key_map.begin(), primary_key_map.end(), [pk](const t_primary_key_map::value_type &x) {
-    return *pk == *(x.first);
-  });
-//  t_primary_key_map::iterator i = primary_key_map.find(pk);
+  if (pk->is_integral()) {
+    return integral_key_index.find(pk->integral_value());
+  }
+  t_primary_key_map::iterator i = primary_key_map.find(pk);
   return (i != primary_key_map.end() ? i->second : nullptr);
 }
 
+object_proxy *prototype_node::find_proxy(long long pk) const
+{
+  return integral_key_index.find(pk);
+}
+
 std::ostream& operator <<(std::ostream &os, const prototype_node &pn)
 {
   if (pn.parent) {
@@ -622,6 +622,9 @@ prototype_tree::iterator prototype_tree::initialize(prototype_node *node)
   primary_key_analyzer pk_analyzer(*node);
   pk_analyzer.analyze();
 
+  // Build the field table for generic access
+  node->fields.build(*node->producer);
+
   // Check if nodes serializable has 'to-many' relations
   std::unique_ptr<serializable> o(node->producer->create());
   relation_resolver rb(*node);
@@ -0,0 +1,290 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "object/replication.hpp"
+#include "object/object_store.hpp"
+#include "object/object_proxy.hpp"
+#include "object/object_exception.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#include <io.h>
+#define oos_read _read
+#define oos_write _write
+#else
+#include <unistd.h>
+#define oos_read ::read
+#define oos_write ::write
+#endif
+
+namespace oos {
+
+namespace {
+
+/*
+ * layout of a replicated record:
+ * header, type name, image; not padded
+ */
+struct frame_header
+{
+  uint32_t size;
+  uint32_t action;
+  uint64_t sequence;
+  uint64_t published;
+  uint64_t id;
+  uint32_t type_size;
+  uint32_t image_size;
+};
+
+typedef std::chrono::steady_clock clock_type;
+
+double seconds_since(const clock_type::time_point &start)
+{
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+}
+
+double replication_metrics::records_per_second() const
+{
+  return seconds > 0.0 ? (double)records / seconds : 0.0;
+}
+
+double replication_metrics::bytes_per_second() const
+{
+  return seconds > 0.0 ? (double)bytes / seconds : 0.0;
+}
+
+replication_leader::replication_leader(change_feed &feed, int fd, std::size_t batch_size)
+  : feed_(feed)
+  , fd_(fd)
+  , batch_size_(batch_size)
+  , cursor_(feed.current())
+{
+  batch_.reserve(batch_size_);
+  metrics_.sequence = cursor_.sequence();
+}
+
+std::size_t replication_leader::send()
+{
+  clock_type::time_point start = clock_type::now();
+
+  feed_.flush();
+
+  std::size_t count = 0;
+  change_feed::poll_result result;
+  while ((result = feed_.poll(cursor_, record_)) == change_feed::POLL_RECORD) {
+    if (!record_.has_image && record_.action != change_feed::ACTION_DELETE) {
+      throw object_exception("replication needs a change feed with object images");
+    }
+    frame_header header;
+    header.size = (uint32_t)(sizeof(header) + record_.type.size() + record_.image.size());
+    header.action = (uint32_t)record_.action;
+    header.sequence = record_.sequence;
+    header.published = feed_.sequence();
+    header.id = record_.id;
+    header.type_size = (uint32_t)record_.type.size();
+    header.image_size = (uint32_t)record_.image.size();
+
+    const char *h = (const char*)&header;
+    batch_.insert(batch_.end(), h, h + sizeof(header));
+    batch_.insert(batch_.end(), record_.type.begin(), record_.type.end());
+    batch_.insert(batch_.end(), record_.image.begin(), record_.image.end());
+    ++count;
+
+    if (batch_.size() >= batch_size_) {
+      write_batch();
+    }
+  }
+  if (result == change_feed::POLL_OVERRUN) {
+    throw object_exception("replication follower was overrun");
+  }
+  write_batch();
+
+  metrics_.records += count;
+  metrics_.sequence = cursor_.sequence();
+  metrics_.lag = feed_.sequence() - cursor_.sequence();
+  metrics_.seconds += seconds_since(start);
+  return count;
+}
+
+unsigned long long replication_leader::lag() const
+{
+  return feed_.lag(cursor_);
+}
+
+const replication_metrics& replication_leader::metrics() const
+{
+  return metrics_;
+}
+
+void replication_leader::write_batch()
+{
+  if (batch_.empty()) {
+    return;
+  }
+  const char *data = batch_.data();
+  std::size_t size = batch_.size();
+  while (size > 0) {
+    long n = (long)oos_write(fd_, data, (unsigned int)size);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw object_exception("couldn't write replication batch");
+    }
+    data += n;
+    size -= (std::size_t)n;
+  }
+  metrics_.bytes += batch_.size();
+  ++metrics_.batches;
+  batch_.clear();
+}
+
+replication_follower::replication_follower(object_store &ostore, int fd, std::size_t batch_size)
+  : ostore_(ostore)
+  , fd_(fd)
+  , buffer_(std::max(batch_size, sizeof(frame_header)))
+{}
+
+std::size_t replication_follower::receive()
+{
+  if (eof_) {
+    return 0;
+  }
+
+  long n = 0;
+  do {
+    n = (long)oos_read(fd_, buffer_.data() + size_, (unsigned int)(buffer_.size() - size_));
+  } while (n < 0 && errno == EINTR);
+
+  if (n < 0) {
+    throw object_exception("couldn't read replication batch");
+  } else if (n == 0) {
+    eof_ = true;
+    if (size_ > 0) {
+      throw object_exception("replication stream ends with an incomplete record");
+    }
+    return 0;
+  }
+
+  clock_type::time_point start = clock_type::now();
+
+  size_ += (std::size_t)n;
+  metrics_.bytes += (unsigned long long)n;
+
+  // apply all complete records of the batch
+  std::size_t count = 0;
+  std::size_t offset = 0;
+  frame_header header;
+  while (size_ - offset >= sizeof(header)) {
+    memcpy(&header, buffer_.data() + offset, sizeof(header));
+    if (size_ - offset < header.size) {
+      break;
+    }
+    if (!first_ && header.sequence != metrics_.sequence) {
+      throw object_exception("replication sequence gap");
+    }
+    first_ = false;
+
+    const char *type = buffer_.data() + offset + sizeof(header);
+    type_.assign(type, header.type_size);
+    apply((change_feed::action_type)header.action, (unsigned long)header.id, type_.c_str(), type + header.type_size, header.image_size);
+
+    metrics_.sequence = header.sequence + 1;
+    metrics_.lag = header.published - metrics_.sequence;
+    offset += header.size;
+    ++count;
+  }
+
+  // keep an incomplete record for the next read
+  size_ -= offset;
+  if (size_ > 0 && offset > 0) {
+    memmove(buffer_.data(), buffer_.data() + offset, size_);
+  }
+  if (size_ >= sizeof(header)) {
+    memcpy(&header, buffer_.data(), sizeof(header));
+    if (header.size > buffer_.size()) {
+      buffer_.resize(header.size);
+    }
+  }
+
+  metrics_.records += count;
+  ++metrics_.batches;
+  metrics_.seconds += seconds_since(start);
+  return count;
+}
+
+std::size_t replication_follower::run()
+{
+  std::size_t count = 0;
+  while (!eof_) {
+    count += receive();
+  }
+  return count;
+}
+
+bool replication_follower::eof() const
+{
+  return eof_;
+}
+
+const replication_metrics& replication_follower::metrics() const
+{
+  return metrics_;
+}
+
+void replication_follower::apply(change_feed::action_type action, unsigned long id, const char *type, const char *image, std::size_t image_size)
+{
+  object_proxy *proxy = ostore_.find_proxy(id);
+
+  if (action == change_feed::ACTION_DELETE) {
+    if (proxy && proxy->obj()) {
+      ostore_.remove_object(proxy, true);
+    }
+    return;
+  }
+
+  image_.clear();
+  image_.append(image, image_size);
+
+  if (!proxy) {
+    // not even referenced yet
+    proxy = ostore_.create_proxy(id);
+  }
+  if (!proxy->obj()) {
+    /*
+     * create the object for the proxy, object
+     * pointers to this proxy are wired already
+     */
+    proxy->reset(ostore_.create(type));
+    // reset clears the id
+    proxy->id(id);
+    serializer_.deserialize(proxy->obj(), &image_, &ostore_);
+    ostore_.insert_proxy(proxy, true, false);
+  } else {
+    ostore_.mark_modified(proxy);
+    serializer_.deserialize(proxy->obj(), &image_, &ostore_);
+  }
+}
+
+}
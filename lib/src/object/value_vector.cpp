@@ -0,0 +1,251 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "object/value_vector.hpp"
+#include "object/object_exception.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+namespace oos {
+
+namespace detail {
+
+void append_element(std::string &buf, long long x)
+{
+  if (x < 0) {
+    buf.push_back('-');
+    // negate in unsigned space to handle the minimum value
+    append_element(buf, 0ULL - (unsigned long long)x);
+  } else {
+    append_element(buf, (unsigned long long)x);
+  }
+}
+
+void append_element(std::string &buf, unsigned long long x)
+{
+  char tmp[24];
+  char *end = tmp + sizeof(tmp);
+  char *pos = end;
+  do {
+    *--pos = (char)('0' + (x % 10));
+    x /= 10;
+  } while (x > 0);
+  buf.append(pos, end - pos);
+}
+
+void append_element(std::string &buf, double x)
+{
+  // strtod reads inf and nan back
+  char tmp[32];
+  int len = snprintf(tmp, sizeof(tmp), "%.17g", x);
+  buf.append(tmp, len);
+}
+
+void append_element(std::string &buf, bool x)
+{
+  buf.append(x ? "true" : "false");
+}
+
+void append_element(std::string &buf, const char *str, std::size_t len)
+{
+  static const char *hex = "0123456789abcdef";
+
+  buf.push_back('"');
+  const char *chunk = str;
+  const char *last = str + len;
+  for (const char *first = str; first != last; ++first) {
+    unsigned char c = (unsigned char)*first;
+    if (c >= 0x20 && c != '"' && c != '\\') {
+      continue;
+    }
+    buf.append(chunk, first - chunk);
+    chunk = first + 1;
+    switch (c) {
+      case '"':
+        buf.append("\\\"", 2);
+        break;
+      case '\\':
+        buf.append("\\\\", 2);
+        break;
+      case '\n':
+        buf.append("\\n", 2);
+        break;
+      case '\r':
+        buf.append("\\r", 2);
+        break;
+      case '\t':
+        buf.append("\\t", 2);
+        break;
+      default:
+        buf.append("\\u00", 4);
+        buf.push_back(hex[c >> 4]);
+        buf.push_back(hex[c & 0xf]);
+        break;
+    }
+  }
+  buf.append(chunk, last - chunk);
+  buf.push_back('"');
+}
+
+element_reader::element_reader(const std::string &str)
+  : pos_(str.data())
+  , end_(str.data() + str.size())
+  , first_(true)
+{
+  skip_whitespace();
+  // an unset field results in an empty vector
+  if (pos_ == end_) {
+    return;
+  }
+  expect('[');
+}
+
+bool element_reader::next()
+{
+  skip_whitespace();
+  if (pos_ == end_) {
+    if (first_) {
+      return false;
+    }
+    throw object_exception("value_vector: unexpected end of data");
+  }
+  if (*pos_ == ']') {
+    ++pos_;
+    return false;
+  }
+  if (!first_) {
+    expect(',');
+    skip_whitespace();
+  }
+  first_ = false;
+  return true;
+}
+
+void element_reader::read(long long &x)
+{
+  // the data is always terminated by ']'
+  char *last = nullptr;
+  errno = 0;
+  x = strtoll(pos_, &last, 10);
+  if (last == pos_ || errno == ERANGE) {
+    throw object_exception("value_vector: invalid integral value");
+  }
+  pos_ = last;
+}
+
+void element_reader::read(unsigned long long &x)
+{
+  char *last = nullptr;
+  errno = 0;
+  x = strtoull(pos_, &last, 10);
+  if (last == pos_ || errno == ERANGE) {
+    throw object_exception("value_vector: invalid integral value");
+  }
+  pos_ = last;
+}
+
+void element_reader::read(double &x)
+{
+  char *last = nullptr;
+  x = strtod(pos_, &last);
+  if (last == pos_) {
+    throw object_exception("value_vector: invalid floating point value");
+  }
+  pos_ = last;
+}
+
+void element_reader::read(bool &x)
+{
+  if (end_ - pos_ >= 4 && std::string(pos_, 4) == "true") {
+    x = true;
+    pos_ += 4;
+  } else if (end_ - pos_ >= 5 && std::string(pos_, 5) == "false") {
+    x = false;
+    pos_ += 5;
+  } else {
+    throw object_exception("value_vector: invalid boolean value");
+  }
+}
+
+void element_reader::read(std::string &x)
+{
+  expect('"');
+  x.clear();
+  const char *chunk = pos_;
+  while (pos_ != end_ && *pos_ != '"') {
+    if (*pos_ != '\\') {
+      ++pos_;
+      continue;
+    }
+    x.append(chunk, pos_ - chunk);
+    if (++pos_ == end_) {
+      break;
+    }
+    switch (*pos_) {
+      case 'n':
+        x.push_back('\n');
+        break;
+      case 'r':
+        x.push_back('\r');
+        break;
+      case 't':
+        x.push_back('\t');
+        break;
+      case 'u':
+        if (end_ - pos_ < 5) {
+          throw object_exception("value_vector: invalid escape sequence");
+        } else {
+          // only single bytes are escaped this way
+          char hex[5] = { pos_[1], pos_[2], pos_[3], pos_[4], '\0' };
+          x.push_back((char)strtoul(hex, nullptr, 16));
+          pos_ += 4;
+        }
+        break;
+      default:
+        x.push_back(*pos_);
+        break;
+    }
+    chunk = ++pos_;
+  }
+  if (pos_ == end_) {
+    throw object_exception("value_vector: unterminated string");
+  }
+  x.append(chunk, pos_ - chunk);
+  ++pos_;
+}
+
+void element_reader::skip_whitespace()
+{
+  while (pos_ != end_ && (*pos_ == ' ' || *pos_ == '\t' || *pos_ == '\n' || *pos_ == '\r')) {
+    ++pos_;
+  }
+}
+
+void element_reader::expect(char c)
+{
+  if (pos_ == end_ || *pos_ != c) {
+    std::string msg = std::string("value_vector: expected '") + c + "'";
+    throw object_exception(msg.c_str());
+  }
+  ++pos_;
+}
+
+}
+
+}
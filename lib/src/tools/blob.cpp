@@ -1,17 +1,60 @@
 #include "tools/blob.hpp"
 
+#include <algorithm>
+
 namespace oos {
 
+namespace {
+
+// size of the chunks a lazy blob is loaded with
+const blob::size_type chunk_size = 64 * 1024;
+
+}
+
+blob_source::~blob_source()
+{}
+
 blob::blob()
 {}
 
+blob::blob(const char *data, size_type size)
+  : data_(data, data + size)
+{}
+
 blob::~blob()
 {
 }
 
+bool blob::assign(const char *data, size_type size)
+{
+  source_.reset();
+  data_.assign(data, data + size);
+  return true;
+}
+
+bool blob::append(const char *data, size_type size)
+{
+  load();
+  data_.insert(data_.end(), data, data + size);
+  return true;
+}
+
+blob::size_type blob::read(size_type offset, char *buf, size_type len) const
+{
+  if (source_) {
+    return source_->read(offset, buf, len);
+  }
+  if (offset >= data_.size()) {
+    return 0;
+  }
+  len = std::min(len, data_.size() - offset);
+  memcpy(buf, &data_[offset], len);
+  return len;
+}
+
 blob::size_type blob::size() const
 {
-  return data_.size();
+  return source_ ? source_->size() : data_.size();
 }
 
 blob::size_type blob::capacity() const
@@ -19,9 +62,65 @@ blob::size_type blob::capacity() const
   return data_.capacity();
 }
 
+bool blob::empty() const
+{
+  return size() == 0;
+}
+
 const char* blob::data() const
 {
-  return &data_.front();
+  load();
+  return data_.empty() ? nullptr : &data_.front();
+}
+
+bool blob::is_loaded() const
+{
+  return !source_;
+}
+
+void blob::clear()
+{
+  source_.reset();
+  data_.clear();
+}
+
+bool blob::operator==(const blob &x) const
+{
+  if (size() != x.size()) {
+    return false;
+  }
+  return size() == 0 || memcmp(data(), x.data(), size()) == 0;
+}
+
+bool blob::operator!=(const blob &x) const
+{
+  return !operator==(x);
+}
+
+void blob::source(const std::shared_ptr<blob_source> &src)
+{
+  data_.clear();
+  source_ = src;
+}
+
+void blob::load() const
+{
+  if (!source_) {
+    return;
+  }
+  std::vector<char> data(source_->size());
+  size_type offset = 0;
+  while (offset < data.size()) {
+    size_type len = source_->read(offset, &data[offset], std::min(chunk_size, data.size() - offset));
+    if (len == 0) {
+      // the source ended early
+      data.resize(offset);
+      break;
+    }
+    offset += len;
+  }
+  data_.swap(data);
+  source_.reset();
 }
 
 }
@@ -1,7 +1,9 @@
 #include "tools/date.hpp"
 #include "tools/calendar.h"
 #include "tools/strptime.hpp"
+#include "tools/iso8601.hpp"
 
+#include <cstring>
 #include <ctime>
 #include <stdexcept>
 
@@ -19,7 +21,7 @@ void throw_invalid_date(int d, int m, int y)
 date::date()
 {
   // should calc now
-  time_t t = time(0);
+  time_t t = ::time(0);
   struct tm now;
 #ifdef _MSC_VER
   localtime_s(&now, &t);
@@ -165,6 +167,9 @@ operator<<(std::ostream &lhs, const date &rhs) {
 
 void date::set(const char *datestr, const char *format)
 {
+  if (detail::is_iso8601_date_format(format) && parse_iso8601(datestr, strlen(datestr), *this)) {
+    return;
+  }
   struct tm t;
   detail::strptime(datestr, format, &t);
   sync_date(t.tm_mday, t.tm_mon + 1, t.tm_year + 1900);
@@ -191,12 +196,8 @@ bool date::is_valid_date(int year, int month, int day)
   if (month < 1 || month > 12) {
     return false;
   }
-  if (month == 2 && (month_days[month-1] + (is_leap ? 1 : 0) < day || day < 1)) {
-    return false;
-  } else if (month_days[month-1] < day || day < 1) {
-    return false;
-  }
-  return true;
+  int days = month_days[month-1] + (month == 2 && is_leap ? 1 : 0);
+  return day >= 1 && day <= days;
 }
 
 
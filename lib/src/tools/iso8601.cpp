@@ -0,0 +1,183 @@
+#include "tools/iso8601.hpp"
+#include "tools/time.hpp"
+#include "tools/date.hpp"
+
+#include <cstring>
+#include <ctime>
+
+#ifndef _MSC_VER
+#include <sys/time.h>
+#endif
+
+namespace oos {
+
+namespace {
+
+/*
+ * reads n digits, the digits are checked all
+ * at once after the loop
+ */
+inline bool read_digits(const char *str, int n, int &value)
+{
+  unsigned int result = 0;
+  unsigned int invalid = 0;
+  for (int i = 0; i < n; ++i) {
+    unsigned int digit = (unsigned int)(unsigned char)str[i] - '0';
+    invalid |= (digit > 9);
+    result = result * 10 + digit;
+  }
+  value = (int)result;
+  return invalid == 0;
+}
+
+inline char* write_2_digits(char *buf, int value)
+{
+  buf[0] = (char)('0' + value / 10);
+  buf[1] = (char)('0' + value % 10);
+  return buf + 2;
+}
+
+inline char* write_date(char *buf, int year, int month, int day)
+{
+  buf = write_2_digits(buf, year / 100);
+  buf = write_2_digits(buf, year % 100);
+  *buf++ = '-';
+  buf = write_2_digits(buf, month);
+  *buf++ = '-';
+  return write_2_digits(buf, day);
+}
+
+/*
+ * parses YYYY-MM-DD
+ */
+inline bool read_date(const char *str, int &year, int &month, int &day)
+{
+  bool valid = read_digits(str, 4, year) &
+               (str[4] == '-') &
+               read_digits(str + 5, 2, month) &
+               (str[7] == '-') &
+               read_digits(str + 8, 2, day);
+  return valid && date::is_valid_date(year, month, day);
+}
+
+}
+
+std::size_t format_iso8601(const oos::time &x, char *buf, std::size_t size, bool fraction)
+{
+  std::size_t len = fraction ? iso8601_time_size - 1 : iso8601_time_size - 5;
+  struct tm t = x.get_tm();
+  int year = t.tm_year + 1900;
+  if (size <= len || year < 0 || year > 9999) {
+    return 0;
+  }
+  char *p = write_date(buf, year, t.tm_mon + 1, t.tm_mday);
+  *p++ = ' ';
+  p = write_2_digits(p, t.tm_hour);
+  *p++ = ':';
+  p = write_2_digits(p, t.tm_min);
+  *p++ = ':';
+  p = write_2_digits(p, t.tm_sec);
+  if (fraction) {
+    int millis = x.milli_second();
+    *p++ = '.';
+    *p++ = (char)('0' + millis / 100);
+    p = write_2_digits(p, millis % 100);
+  }
+  *p = '\0';
+  return len;
+}
+
+std::size_t format_iso8601(const oos::date &x, char *buf, std::size_t size)
+{
+  int year = x.year();
+  if (size < iso8601_date_size || year < 0 || year > 9999) {
+    return 0;
+  }
+  write_date(buf, year, x.month(), x.day())[0] = '\0';
+  return iso8601_date_size - 1;
+}
+
+bool parse_iso8601(const char *str, std::size_t len, oos::time &x)
+{
+  // YYYY-MM-DD HH:MM:SS[.f{1,6}]
+  if (len < 19 || len == 20 || len > 26) {
+    return false;
+  }
+  int year, month, day, hour, min, sec;
+  if (!read_date(str, year, month, day)) {
+    return false;
+  }
+  bool valid = (str[10] == ' ' || str[10] == 'T') &
+               read_digits(str + 11, 2, hour) &
+               (str[13] == ':') &
+               read_digits(str + 14, 2, min) &
+               (str[16] == ':') &
+               read_digits(str + 17, 2, sec);
+  if (!valid || hour > 23 || min > 59 || sec > 59) {
+    return false;
+  }
+  int usec = 0;
+  if (len > 19) {
+    int digits = (int)len - 20;
+    if (str[19] != '.' || !read_digits(str + 20, digits, usec)) {
+      return false;
+    }
+    static const int scale[] = { 1, 100000, 10000, 1000, 100, 10, 1 };
+    usec *= scale[digits];
+  }
+
+  struct tm t;
+  memset(&t, 0, sizeof(struct tm));
+  t.tm_year = year - 1900;
+  t.tm_mon = month - 1;
+  t.tm_mday = day;
+  t.tm_hour = hour;
+  t.tm_min = min;
+  t.tm_sec = sec;
+  // let mktime decide about daylight saving, so
+  // a formatted time is parsed into the same time
+  t.tm_isdst = -1;
+
+  struct timeval tv;
+#ifdef _MSC_VER
+  tv.tv_sec = (long)mktime(&t);
+#else
+  tv.tv_sec = mktime(&t);
+#endif
+  tv.tv_usec = usec;
+  // mktime normalized the broken down time, no localtime needed
+  x.set(tv, t);
+  return true;
+}
+
+bool parse_iso8601(const char *str, std::size_t len, oos::date &x)
+{
+  int year, month, day;
+  if (len != iso8601_date_size - 1 || !read_date(str, year, month, day)) {
+    return false;
+  }
+  x.set(day, month, year);
+  return true;
+}
+
+namespace detail {
+
+int iso8601_time_format(const char *format)
+{
+  if (strcmp(format, "%F %T.%f") == 0 || strcmp(format, "%Y-%m-%d %H:%M:%S.%f") == 0) {
+    return 2;
+  } else if (strcmp(format, "%F %T") == 0 || strcmp(format, "%Y-%m-%d %H:%M:%S") == 0) {
+    return 1;
+  } else {
+    return 0;
+  }
+}
+
+bool is_iso8601_date_format(const char *format)
+{
+  return strcmp(format, "%F") == 0 || strcmp(format, "%Y-%m-%d") == 0;
+}
+
+}
+
+}
@@ -4,6 +4,8 @@
 
 #include "tools/string.hpp"
 #include "tools/time.hpp"
+#include "tools/date.hpp"
+#include "tools/iso8601.hpp"
 
 #include <stdexcept>
 #include <cstring>
@@ -39,8 +41,31 @@ std::string trim(const std::string& str, const std::string& whitespace)
   return str.substr(first, range);
 }
 
+namespace {
+
+std::string milli_seconds(const oos::time &x)
+{
+  char millis[4];
+  int ms = x.milli_second();
+  millis[0] = (char)('0' + ms / 100);
+  millis[1] = (char)('0' + ms / 10 % 10);
+  millis[2] = (char)('0' + ms % 10);
+  millis[3] = '\0';
+  return millis;
+}
+
+}
+
 std::string to_string(const oos::time &x, const char *format)
 {
+  int iso_format = detail::iso8601_time_format(format);
+  if (iso_format != 0) {
+    char buffer[iso8601_time_size];
+    std::size_t len = format_iso8601(x, buffer, sizeof(buffer), iso_format == 2);
+    if (len > 0) {
+      return std::string(buffer, len);
+    }
+  }
   struct tm timeinfo = x.get_tm();
 #ifndef _MSC_VER
   char buffer[255];
@@ -51,7 +76,7 @@ std::string to_string(const oos::time &x, const char *format)
   // check for %f
   auto pos = result.find("%f");
   if (pos != std::string::npos) {
-    std::string millis = std::to_string(x.milli_second());
+    std::string millis = milli_seconds(x);
     // replace %f with millis
     result.replace(pos, 2, millis);
   }
@@ -66,7 +91,7 @@ std::string to_string(const oos::time &x, const char *format)
     char *d = new char[len + 1];
     strncpy_s(d, len + 1, format, len);
     d[len] = '\0';
-    std::string fstr = to_string(x, d) + std::to_string(x.milli_second());
+    std::string fstr = to_string(x, d) + milli_seconds(x);
     delete[] d;
     fstr += to_string(x, fpos+2);
     return fstr;
@@ -90,6 +115,13 @@ std::string to_string(const oos::time &x, const char *format)
 
 std::string to_string(const oos::date &x, const char *format)
 {
+  if (detail::is_iso8601_date_format(format)) {
+    char buffer[iso8601_date_size];
+    std::size_t len = format_iso8601(x, buffer, sizeof(buffer));
+    if (len > 0) {
+      return std::string(buffer, len);
+    }
+  }
   time_t now = std::time(NULL);
   struct tm timeinfo;
 
@@ -0,0 +1,178 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tools/thread_pool.hpp"
+
+#include <exception>
+
+namespace oos {
+
+struct thread_pool::job
+{
+  const std::function<void(std::size_t)> *func;
+  std::atomic<std::size_t> remaining;
+  std::mutex error_mutex;
+  std::exception_ptr error;
+};
+
+thread_pool::thread_pool(std::size_t threads)
+  : pending_(0)
+  , next_queue_(0)
+  , stop_(false)
+{
+  // one queue per worker, callers of run() only steal
+  for (std::size_t i = 0; i < threads; ++i) {
+    queues_.push_back(std::unique_ptr<task_queue>(new task_queue));
+  }
+  for (std::size_t i = 0; i < threads; ++i) {
+    threads_.push_back(std::thread(&thread_pool::work, this, i));
+  }
+}
+
+thread_pool::~thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_cond_.notify_all();
+  for (std::vector<std::thread>::iterator i = threads_.begin(); i != threads_.end(); ++i) {
+    i->join();
+  }
+}
+
+std::size_t thread_pool::size() const
+{
+  return threads_.size();
+}
+
+void thread_pool::run(std::size_t count, const std::function<void(std::size_t)> &func)
+{
+  if (count == 0) {
+    return;
+  }
+  if (queues_.empty() || count == 1) {
+    for (std::size_t i = 0; i < count; ++i) {
+      func(i);
+    }
+    return;
+  }
+
+  job j;
+  j.func = &func;
+  j.remaining = count;
+
+  // count before pushing, a worker may take a task right away
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ += count;
+  }
+  // spread the tasks over the worker queues
+  std::size_t first = next_queue_.fetch_add(1, std::memory_order_relaxed);
+  for (std::size_t i = 0; i < count; ++i) {
+    task_queue &q = *queues_[(first + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    q.tasks.push_back(task{ &j, i });
+  }
+  work_cond_.notify_all();
+
+  // help until all tasks of this job are done
+  task t;
+  while (j.remaining.load(std::memory_order_acquire) > 0) {
+    if (steal(queues_.size(), t)) {
+      execute(t);
+    } else {
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_cond_.wait(lock, [&j]() { return j.remaining.load(std::memory_order_acquire) == 0; });
+    }
+  }
+
+  if (j.error) {
+    std::rethrow_exception(j.error);
+  }
+}
+
+thread_pool& thread_pool::instance()
+{
+  static thread_pool pool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0);
+  return pool;
+}
+
+void thread_pool::work(std::size_t i)
+{
+  task t;
+  while (true) {
+    if (pop(i, t) || steal(i, t)) {
+      execute(t);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_cond_.wait(lock, [this]() { return stop_ || pending_.load() > 0; });
+    if (stop_ && pending_.load() == 0) {
+      return;
+    }
+  }
+}
+
+bool thread_pool::pop(std::size_t i, task &t)
+{
+  task_queue &q = *queues_[i];
+  std::lock_guard<std::mutex> lock(q.mutex);
+  if (q.tasks.empty()) {
+    return false;
+  }
+  t = q.tasks.back();
+  q.tasks.pop_back();
+  --pending_;
+  return true;
+}
+
+bool thread_pool::steal(std::size_t i, task &t)
+{
+  std::size_t n = queues_.size();
+  for (std::size_t k = 1; k <= n; ++k) {
+    task_queue &q = *queues_[(i + k) % n];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (!q.tasks.empty()) {
+      t = q.tasks.front();
+      q.tasks.pop_front();
+      --pending_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void thread_pool::execute(const task &t)
+{
+  job *j = t.owner;
+  try {
+    (*j->func)(t.index);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(j->error_mutex);
+    if (!j->error) {
+      j->error = std::current_exception();
+    }
+  }
+  if (j->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    // the owner may wait for the job
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_cond_.notify_all();
+  }
+}
+
+}
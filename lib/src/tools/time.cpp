@@ -1,6 +1,7 @@
 #include "tools/time.hpp"
 #include "tools/string.hpp"
 #include "tools/strptime.hpp"
+#include "tools/iso8601.hpp"
 
 #include <stdexcept>
 #include <cstring>
@@ -159,6 +160,18 @@ bool time::is_valid_time(int hour, int min, int sec, long millis) {
 
 time time::parse(const std::string &tstr, const char *format)
 {
+  /*
+   * the ISO8601 formats of the backends are parsed
+   * without strptime, a string with another layout
+   * takes the generic path
+   */
+  int iso_format = detail::iso8601_time_format(format);
+  if (iso_format == 2 || (iso_format == 1 && tstr.size() == 19)) {
+    time t(0);
+    if (parse_iso8601(tstr.data(), tstr.size(), t)) {
+      return t;
+    }
+  }
   /*
   * find the %f format token
   * and split the string to parse
@@ -251,6 +264,12 @@ void time::set(timeval tv)
   detail::localtime(temp, tm_);
 }
 
+void time::set(const struct timeval &tv, const struct tm &t)
+{
+  time_ = tv;
+  tm_ = t;
+}
+
 int time::year() const
 {
   return tm_.tm_year + 1900;
@@ -0,0 +1,260 @@
+#include "tools/utc_time.hpp"
+#include "tools/time.hpp"
+#include "tools/date.hpp"
+
+#include <cstdio>
+#include <ostream>
+#include <stdexcept>
+
+#ifndef _MSC_VER
+#include <sys/time.h>
+#endif
+
+namespace oos {
+
+namespace {
+
+const long long usec_per_second = 1000000LL;
+const long long usec_per_day = 86400LL * usec_per_second;
+
+// floor division, the epoch splits negative and positive values
+long long floor_div(long long a, long long b)
+{
+  long long q = a / b;
+  return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+}
+
+utc_time::utc_time()
+  : usec_(0)
+{}
+
+utc_time::utc_time(long long usec)
+  : usec_(usec)
+{}
+
+utc_time::utc_time(int year, int month, int day, int hour, int min, int sec, long usec)
+  : usec_(0)
+{
+  set(year, month, day, hour, min, sec, usec);
+}
+
+utc_time::utc_time(const oos::time &t)
+{
+  struct timeval tv = t.get_timeval();
+  usec_ = (long long)tv.tv_sec * usec_per_second + tv.tv_usec;
+}
+
+utc_time utc_time::now()
+{
+  return utc_time(oos::time::now());
+}
+
+bool utc_time::operator==(const utc_time &x) const
+{
+  return usec_ == x.usec_;
+}
+
+bool utc_time::operator!=(const utc_time &x) const
+{
+  return usec_ != x.usec_;
+}
+
+bool utc_time::operator<(const utc_time &x) const
+{
+  return usec_ < x.usec_;
+}
+
+bool utc_time::operator<=(const utc_time &x) const
+{
+  return usec_ <= x.usec_;
+}
+
+bool utc_time::operator>(const utc_time &x) const
+{
+  return usec_ > x.usec_;
+}
+
+bool utc_time::operator>=(const utc_time &x) const
+{
+  return usec_ >= x.usec_;
+}
+
+utc_time& utc_time::operator+=(long long usec)
+{
+  usec_ += usec;
+  return *this;
+}
+
+utc_time& utc_time::operator-=(long long usec)
+{
+  usec_ -= usec;
+  return *this;
+}
+
+utc_time utc_time::operator+(long long usec) const
+{
+  return utc_time(usec_ + usec);
+}
+
+utc_time utc_time::operator-(long long usec) const
+{
+  return utc_time(usec_ - usec);
+}
+
+long long utc_time::operator-(const utc_time &x) const
+{
+  return usec_ - x.usec_;
+}
+
+utc_time& utc_time::add_days(int days)
+{
+  usec_ += days * usec_per_day;
+  return *this;
+}
+
+void utc_time::set(int year, int month, int day, int hour, int min, int sec, long usec)
+{
+  throw_invalid_date(day, month, year);
+  if (hour < 0 || hour > 23 || min < 0 || min > 59 || sec < 0 || sec > 59 || usec < 0 || usec > 999999) {
+    throw std::logic_error("time isn't valid");
+  }
+  usec_ = days_from_civil(year, month, day) * usec_per_day +
+          ((hour * 60LL + min) * 60LL + sec) * usec_per_second + usec;
+}
+
+long long utc_time::micro_seconds() const
+{
+  return usec_;
+}
+
+int utc_time::year() const
+{
+  int y, m, d;
+  civil_from_days(days(), y, m, d);
+  return y;
+}
+
+int utc_time::month() const
+{
+  int y, m, d;
+  civil_from_days(days(), y, m, d);
+  return m;
+}
+
+int utc_time::day() const
+{
+  int y, m, d;
+  civil_from_days(days(), y, m, d);
+  return d;
+}
+
+int utc_time::hour() const
+{
+  return (int)(time_of_day() / (3600LL * usec_per_second));
+}
+
+int utc_time::minute() const
+{
+  return (int)(time_of_day() / (60LL * usec_per_second) % 60);
+}
+
+int utc_time::second() const
+{
+  return (int)(time_of_day() / usec_per_second % 60);
+}
+
+int utc_time::milli_second() const
+{
+  return (int)(time_of_day() % usec_per_second / 1000);
+}
+
+int utc_time::micro_second() const
+{
+  return (int)(time_of_day() % usec_per_second);
+}
+
+int utc_time::day_of_week() const
+{
+  // the epoch was a thursday
+  long long w = (days() + 4) % 7;
+  return (int)(w < 0 ? w + 7 : w);
+}
+
+int utc_time::day_of_year() const
+{
+  int y, m, d;
+  civil_from_days(days(), y, m, d);
+  return (int)(days() - days_from_civil(y, 1, 1));
+}
+
+date utc_time::to_date() const
+{
+  int y, m, d;
+  civil_from_days(days(), y, m, d);
+  return date(d, m, y);
+}
+
+oos::time utc_time::to_time() const
+{
+  struct timeval tv;
+  long long sec = floor_div(usec_, usec_per_second);
+  tv.tv_sec = (long)sec;
+  tv.tv_usec = (long)(usec_ - sec * usec_per_second);
+  return oos::time(tv);
+}
+
+/*
+ * The civil calendar conversions follow the
+ * algorithms of Howard Hinnant, working on
+ * eras of 400 years starting in march.
+ */
+long long utc_time::days_from_civil(int year, int month, int day)
+{
+  long long y = year - (month <= 2 ? 1 : 0);
+  long long era = (y >= 0 ? y : y - 399) / 400;
+  long long yoe = y - era * 400;
+  long long doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  long long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+void utc_time::civil_from_days(long long days, int &year, int &month, int &day)
+{
+  days += 719468;
+  long long era = (days >= 0 ? days : days - 146096) / 146097;
+  long long doe = days - era * 146097;
+  long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  long long mp = (5 * doy + 2) / 153;
+  day = (int)(doy - (153 * mp + 2) / 5 + 1);
+  month = (int)(mp < 10 ? mp + 3 : mp - 9);
+  year = (int)(yoe + era * 400 + (month <= 2 ? 1 : 0));
+}
+
+std::ostream& operator<<(std::ostream &out, const utc_time &x)
+{
+  int y, m, d;
+  utc_time::civil_from_days(x.days(), y, m, d);
+  char buf[32];
+#ifdef _MSC_VER
+  sprintf_s(buf, sizeof(buf), "%04d-%02d-%02dT%02d:%02d:%02d.%06dZ", y, m, d, x.hour(), x.minute(), x.second(), x.micro_second());
+#else
+  snprintf(buf, sizeof(buf), "%04d-%02d-%02dT%02d:%02d:%02d.%06dZ", y, m, d, x.hour(), x.minute(), x.second(), x.micro_second());
+#endif
+  out << buf;
+  return out;
+}
+
+long long utc_time::days() const
+{
+  return floor_div(usec_, usec_per_day);
+}
+
+long long utc_time::time_of_day() const
+{
+  return usec_ - days() * usec_per_day;
+}
+
+}
@@ -1,46 +1,76 @@
 #include "tools/varchar.hpp"
 
 #include <algorithm>
+#include <cstring>
+#include <ostream>
 
 namespace oos {
 
 varchar_base::varchar_base(size_type capacity)
-  : capacity_(capacity)
-{}
+  : data_(new char[capacity + 1])
+  , capacity_(capacity)
+  , size_(0)
+  , owner_(true)
+{
+  data_[0] = '\0';
+}
+
+varchar_base::varchar_base(char *buffer, size_type capacity)
+  : data_(buffer)
+  , capacity_(capacity)
+  , size_(0)
+  , owner_(false)
+{
+  data_[0] = '\0';
+}
 
 varchar_base::varchar_base(const varchar_base &x)
-  : capacity_(x.capacity_)
-  , data_(x.data_)
-{}
+  : data_(new char[x.capacity_ + 1])
+  , capacity_(x.capacity_)
+  , size_(0)
+  , owner_(true)
+{
+  assign(x.data_, x.size_);
+}
 
 varchar_base& varchar_base::operator=(const varchar_base &x)
 {
-  capacity_ = x.capacity_;
-  data_ = x.data_;
+  if (this == &x) {
+    return *this;
+  }
+  if (owner_ && capacity_ != x.capacity_) {
+    // a standalone varchar takes the capacity
+    char *data = new char[x.capacity_ + 1];
+    delete [] data_;
+    data_ = data;
+    capacity_ = x.capacity_;
+  }
+  assign(x.data_, x.size_);
   return *this;
 }
 
 varchar_base& varchar_base::operator=(const std::string &x)
 {
-  data_ = x;
-  trim();
+  assign(x.c_str(), x.size());
   return *this;
 }
 
 varchar_base& varchar_base::operator=(const char *x)
 {
-//  ok(x);
-  data_.assign(x);
-  trim();
+  assign(x);
   return *this;
 }
 
 varchar_base::~varchar_base()
-{}
+{
+  if (owner_) {
+    delete [] data_;
+  }
+}
 
 bool varchar_base::operator==(const varchar_base &x) const
 {
-  return data_ == x.data_;
+  return size_ == x.size_ && memcmp(data_, x.data_, size_) == 0;
 }
 
 bool varchar_base::operator!=(const varchar_base &x) const
@@ -50,49 +80,46 @@ bool varchar_base::operator!=(const varchar_base &x) const
 
 varchar_base& varchar_base::operator+=(const varchar_base &x)
 {
-  data_ += x.str();
-  trim();
+  append(x.data_, x.size_);
   return *this;
 }
 
 varchar_base& varchar_base::operator+=(const std::string &x)
 {
-  data_ += x;
-  trim();
+  append(x.c_str(), x.size());
   return *this;
 }
 
 varchar_base& varchar_base::operator+=(const char *x)
 {
-  data_ += x;
-  trim();
+  append(x, strlen(x));
   return *this;
 }
 
 void varchar_base::assign(const char *s, size_t n)
 {
-  data_.assign(s, n);
-  trim();
+  size_ = 0;
+  append(s, n);
 }
 
 void varchar_base::assign(const char *s)
 {
-  data_.assign(s);
+  assign(s, strlen(s));
 }
 
 std::string varchar_base::str() const
 {
-  return data_;
+  return std::string(data_, size_);
 }
 
 const char* varchar_base::c_str() const
 {
-  return data_.c_str();
+  return data_;
 }
 
 varchar_base::size_type varchar_base::size() const
 {
-  return data_.size();
+  return size_;
 }
 
 varchar_base::size_type varchar_base::capacity() const
@@ -102,7 +129,7 @@ varchar_base::size_type varchar_base::capacity() const
 
 std::ostream& operator<<(std::ostream &out, const varchar_base &val)
 {
-  out << val.str();
+  out.write(val.data_, val.size_);
   return out;
 }
 
@@ -113,9 +140,14 @@ void varchar_base::ok(const std::string &x)
   }
 }
 
-void varchar_base::trim()
+void varchar_base::append(const char *s, size_t n)
 {
-  data_.resize(std::min(capacity_, data_.size()));
+  // a string longer than the capacity is cut
+  size_t len = std::min(capacity_ - size_, n);
+  // the source may overlap with the buffer
+  memmove(data_ + size_, s, len);
+  size_ += (unsigned int)len;
+  data_[size_] = '\0';
 }
 
 }
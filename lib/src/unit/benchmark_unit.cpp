@@ -0,0 +1,168 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "unit/benchmark_unit.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace oos {
+
+namespace {
+
+std::atomic<unsigned long long> allocations_(0);
+std::atomic<unsigned long long> allocated_bytes_(0);
+
+}
+
+benchmark_unit::benchmark_unit(const std::string &name, const std::string &caption, std::size_t iterations, std::size_t warmup)
+  : unit_test(name, caption)
+  , iterations_(iterations > 0 ? iterations : 1)
+  , warmup_(warmup)
+{}
+
+benchmark_unit::~benchmark_unit()
+{}
+
+void benchmark_unit::add_benchmark(const std::string &name, const bench_func &run, const std::string &caption, std::size_t items)
+{
+  add_benchmark(name, bench_func(), run, caption, items);
+}
+
+void benchmark_unit::add_benchmark(const std::string &name, const bench_func &setup, const bench_func &run, const std::string &caption, std::size_t items)
+{
+  add_test(name, std::bind(&benchmark_unit::measure, this, setup, run, items), caption);
+}
+
+std::size_t benchmark_unit::iterations() const
+{
+  return iterations_;
+}
+
+std::size_t benchmark_unit::warmup() const
+{
+  return warmup_;
+}
+
+benchmark_unit::statistics benchmark_unit::evaluate(std::vector<double> &samples)
+{
+  statistics stats;
+  if (samples.empty()) {
+    return stats;
+  }
+  std::sort(samples.begin(), samples.end());
+  std::size_t n = samples.size();
+  stats.minimum = samples.front();
+  stats.median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+  // nearest rank
+  std::size_t rank = (99 * n + 99) / 100;
+  stats.p99 = samples[rank - 1];
+  double sum = 0;
+  for (std::vector<double>::const_iterator i = samples.begin(); i != samples.end(); ++i) {
+    sum += *i;
+  }
+  stats.mean = sum / n;
+  return stats;
+}
+
+void benchmark_unit::print_duration(std::ostream &out, double ns)
+{
+  static const char *units[] = { "ns", "us", "ms", "s" };
+  int unit = 0;
+  while (ns >= 1000.0 && unit < 3) {
+    ns /= 1000.0;
+    ++unit;
+  }
+  out << std::setprecision(3) << ns << " " << units[unit];
+}
+
+void benchmark_unit::count_allocation(std::size_t size)
+{
+  allocations_.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes_.fetch_add(size, std::memory_order_relaxed);
+}
+
+unsigned long long benchmark_unit::allocation_count()
+{
+  return allocations_.load(std::memory_order_relaxed);
+}
+
+unsigned long long benchmark_unit::allocated_bytes()
+{
+  return allocated_bytes_.load(std::memory_order_relaxed);
+}
+
+void benchmark_unit::measure(const bench_func &setup, const bench_func &run, std::size_t items)
+{
+  for (std::size_t i = 0; i < warmup_; ++i) {
+    if (setup) {
+      setup();
+    }
+    run();
+  }
+
+  typedef std::chrono::steady_clock clock_t;
+
+  std::vector<double> samples;
+  samples.reserve(iterations_);
+  unsigned long long allocations = 0;
+  unsigned long long bytes = 0;
+  for (std::size_t i = 0; i < iterations_; ++i) {
+    if (setup) {
+      setup();
+    }
+    unsigned long long allocations_before = allocation_count();
+    unsigned long long bytes_before = allocated_bytes();
+    clock_t::time_point start = clock_t::now();
+    run();
+    clock_t::time_point stop = clock_t::now();
+    allocations += allocation_count() - allocations_before;
+    bytes += allocated_bytes() - bytes_before;
+    samples.push_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+  }
+
+  statistics stats = evaluate(samples);
+
+  metric("iterations", (double)iterations_);
+  metric("items", (double)items);
+  metric("min_ns", stats.minimum);
+  metric("median_ns", stats.median);
+  metric("p99_ns", stats.p99);
+  metric("mean_ns", stats.mean);
+  if (stats.median > 0) {
+    metric("items_per_second", items * 1e9 / stats.median);
+  }
+  metric("allocations", (double)allocations / iterations_);
+  metric("allocated_bytes", (double)bytes / iterations_);
+
+  std::stringstream out;
+  out << "median ";
+  print_duration(out, stats.median);
+  out << ", min ";
+  print_duration(out, stats.minimum);
+  out << ", p99 ";
+  print_duration(out, stats.p99);
+  if (allocation_count() > 0) {
+    out << ", " << std::fixed << std::setprecision(0) << (double)allocations / iterations_ << " allocs";
+  }
+  summary(out.str());
+}
+
+}
@@ -1,12 +1,137 @@
 #include "unit/test_suite.hpp"
 #include "unit/unit_test.hpp"
+#include "unit/benchmark_unit.hpp"
+
+#include "json/json.hpp"
+#include "json/json_parser.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <functional>
+#include <iomanip>
 #include <iostream>
 
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#define OOS_UNIT_NO_FORK
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 namespace oos {
 
+namespace {
+
+struct baseline_entry
+{
+  baseline_entry() : median(0), tolerance(0) {}
+  double median;
+  double tolerance;
+};
+
+typedef std::map<std::string, baseline_entry> t_baseline_map;
+
+const json_value* find_member(const json_object &obj, const std::string &key)
+{
+  for (json_object::const_iterator i = obj.begin(); i != obj.end(); ++i) {
+    if (i->first.value() == key) {
+      return &i->second;
+    }
+  }
+  return nullptr;
+}
+
+std::string string_member(const json_object &obj, const std::string &key)
+{
+  const json_value *val = find_member(obj, key);
+  if (val == nullptr || !val->is_type<json_string>()) {
+    return "";
+  }
+  return val->value_type<json_string>()->value();
+}
+
+bool bool_member(const json_object &obj, const std::string &key, bool def)
+{
+  const json_value *val = find_member(obj, key);
+  if (val == nullptr || !val->is_type<json_bool>()) {
+    return def;
+  }
+  return val->value_type<json_bool>()->value();
+}
+
+double number_member(const json_object &obj, const std::string &key, double def)
+{
+  const json_value *val = find_member(obj, key);
+  if (val == nullptr || !val->is_type<json_number>()) {
+    return def;
+  }
+  return val->value_type<json_number>()->value();
+}
+
+// reads the entries of a baseline file, returns false on an invalid file
+bool read_baseline(std::istream &in, double tolerance, t_baseline_map &entries)
+{
+  json_value root;
+  try {
+    json_parser parser;
+    root = parser.parse(in);
+  } catch (std::exception &) {
+    return false;
+  }
+  const json_object *obj = root.value_type<json_object>();
+  const json_value *benchmarks = obj ? find_member(*obj, "benchmarks") : nullptr;
+  if (benchmarks == nullptr || !benchmarks->is_type<json_object>()) {
+    return false;
+  }
+  const json_object *bobj = benchmarks->value_type<json_object>();
+  for (json_object::const_iterator i = bobj->begin(); i != bobj->end(); ++i) {
+    const json_object *eobj = i->second.value_type<json_object>();
+    if (eobj == nullptr) {
+      continue;
+    }
+    baseline_entry entry;
+    entry.median = number_member(*eobj, "median_ns", 0);
+    entry.tolerance = number_member(*eobj, "tolerance", tolerance);
+    entries[i->first.value()] = entry;
+  }
+  return true;
+}
+
+std::string duration_string(double ns)
+{
+  std::stringstream out;
+  benchmark_unit::print_duration(out, ns);
+  return out.str();
+}
+
+#ifndef OOS_UNIT_NO_FORK
+// removes the working directory of a unit with all its files
+void remove_directory(const std::string &dir)
+{
+  DIR *d = ::opendir(dir.c_str());
+  if (d != nullptr) {
+    struct dirent *entry = nullptr;
+    while ((entry = ::readdir(d)) != nullptr) {
+      if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
+        ::unlink((dir + "/" + entry->d_name).c_str());
+      }
+    }
+    ::closedir(d);
+  }
+  ::rmdir(dir.c_str());
+}
+#endif
+
+}
+
 test_suite::test_suite()
 {}
 
@@ -55,6 +180,10 @@ test_suite::~test_suite()
 
 void test_suite::init(int argc, char *argv[])
 {
+  if (argc > 0) {
+    std::string program(argv[0]);
+    args_.program = program.substr(program.find_last_of("/\\") + 1);
+  }
   // check for
   if (argc < 2) {
     // no arguments
@@ -106,6 +235,23 @@ void test_suite::init(int argc, char *argv[])
         args_.unit_args.push_back(unit_args);
       }
     }
+    for (int i = 3; i < argc - 1; ++i) {
+      if (strcmp(argv[i], "json") == 0) {
+        args_.json_file = argv[++i];
+      } else if (strcmp(argv[i], "baseline") == 0) {
+        args_.baseline_file = argv[++i];
+      } else if (strcmp(argv[i], "record") == 0) {
+        args_.record_file = argv[++i];
+      } else if (strcmp(argv[i], "repeat") == 0) {
+        int repeat = std::atoi(argv[++i]);
+        args_.repeat = repeat > 0 ? (std::size_t)repeat : 1;
+      } else if (strcmp(argv[i], "tolerance") == 0) {
+        args_.tolerance = std::atof(argv[++i]);
+      } else if (strcmp(argv[i], "-j") == 0) {
+        int jobs = std::atoi(argv[++i]);
+        args_.jobs = jobs > 0 ? (std::size_t)jobs : 1;
+      }
+    }
   } else {
     return;
   }
@@ -120,29 +266,433 @@ bool test_suite::run()
         std::for_each(unit_test_map_.begin(), unit_test_map_.end(), unit_lister(std::cout, args_.brief));
         break;
       case EXECUTE:
-        if (!args_.unit_args.empty()) {
-          bool result = true;
-          for (auto item : args_.unit_args) {
-            bool succeeded = run(item);
-            if (result && !succeeded) {
-              result = succeeded;
-            }
+      {
+        benchmark_samples_.clear();
+        bool result = true;
+        for (std::size_t i = 0; i < args_.repeat; ++i) {
+          if (args_.repeat > 1) {
+            std::cout << "Run " << i + 1 << " of " << args_.repeat << "\n";
           }
-          return result;
-        } else {
-          unit_executer ue;
-          std::for_each(unit_test_map_.begin(), unit_test_map_.end(), ue);
-          return ue.succeeded;
+          if (!(args_.jobs > 1 ? execute_parallel() : execute())) {
+            result = false;
+          }
+          collect_benchmarks();
+        }
+        if (!args_.json_file.empty()) {
+          std::ofstream out(args_.json_file.c_str());
+          if (!out) {
+            std::cout << "couldn't open json file [" << args_.json_file << "]\n";
+            return false;
+          }
+          write_json(out);
+        }
+        if (!args_.record_file.empty() && !record_baseline(args_.record_file)) {
+          result = false;
+        }
+        if (!args_.baseline_file.empty() && !compare_baseline(args_.baseline_file)) {
+          result = false;
         }
+        return result;
+      }
       default:
         break;
       }
   } else {
-    std::cout << "usage: test_oos [list]|[exec <val>]\n";
+    std::cout << "usage: " << args_.program << " [list [brief]]|[exec <val> [json <file>] [repeat <n>] [record|baseline <file>] [tolerance <percent>] [-j <n>]]\n";
   }
   return true;
 }
 
+bool test_suite::execute()
+{
+  if (args_.unit_args.empty()) {
+    // for_each works on a copy of the executer
+    return std::for_each(unit_test_map_.begin(), unit_test_map_.end(), unit_executer()).succeeded;
+  }
+  bool result = true;
+  for (auto item : args_.unit_args) {
+    bool succeeded = run(item);
+    if (result && !succeeded) {
+      result = succeeded;
+    }
+  }
+  return result;
+}
+
+bool test_suite::execute_parallel()
+{
+#ifdef OOS_UNIT_NO_FORK
+  std::cout << "parallel execution isn't supported on this platform\n";
+  return execute();
+#else
+  typedef std::chrono::steady_clock clock_type;
+
+  struct unit_job
+  {
+    unit_job() : pid(0), done(false), succeeded(false), seconds(0) {}
+    test_unit_args args;
+    std::string dir;
+    pid_t pid;
+    bool done;
+    bool succeeded;
+    std::string error;
+    clock_type::time_point start;
+    double seconds;
+  };
+
+  std::vector<unit_job> jobs;
+  if (args_.unit_args.empty()) {
+    for (t_unit_test_map::const_iterator i = unit_test_map_.begin(); i != unit_test_map_.end(); ++i) {
+      jobs.push_back(unit_job());
+      jobs.back().args.unit = i->first;
+    }
+  } else {
+    for (auto item : args_.unit_args) {
+      jobs.push_back(unit_job());
+      jobs.back().args = item;
+    }
+  }
+
+  const char *tmpdir = getenv("TMPDIR");
+  std::string base(tmpdir != nullptr && *tmpdir != '\0' ? tmpdir : "/tmp");
+
+  clock_type::time_point start = clock_type::now();
+  bool result = true;
+  std::size_t next = 0;
+  std::size_t running = 0;
+  std::size_t reported = 0;
+  while (reported < jobs.size()) {
+    // start units until all job slots are taken
+    while (next < jobs.size() && running < args_.jobs) {
+      unit_job &job = jobs[next++];
+      job.start = clock_type::now();
+      if (unit_test_map_.find(job.args.unit) == unit_test_map_.end()) {
+        job.done = true;
+        job.error = "couldn't find test unit [" + job.args.unit + "]";
+        continue;
+      }
+      // each unit gets its own working directory, so
+      // relative database files don't collide
+      std::string dir_template = base + "/" + args_.program + "-" + job.args.unit + "-XXXXXX";
+      std::vector<char> dir(dir_template.begin(), dir_template.end());
+      dir.push_back('\0');
+      if (::mkdtemp(&dir.front()) == nullptr) {
+        job.done = true;
+        job.error = "couldn't create working directory for test unit [" + job.args.unit + "]";
+        continue;
+      }
+      job.dir = &dir.front();
+      // don't inherit buffered output
+      std::cout.flush();
+      std::fflush(stdout);
+      job.pid = ::fork();
+      if (job.pid == 0) {
+        bool succeeded = false;
+        int fd = -1;
+        if (::chdir(job.dir.c_str()) == 0 && (fd = ::open("output", O_WRONLY | O_CREAT | O_TRUNC, 0644)) >= 0) {
+          ::dup2(fd, 1);
+          ::dup2(fd, 2);
+          ::close(fd);
+          try {
+            succeeded = run(job.args);
+          } catch (std::exception &ex) {
+            std::cout << "caught exception: " << ex.what() << "\n";
+          }
+          std::ofstream out("result.json");
+          write_json(out);
+        }
+        std::cout.flush();
+        std::fflush(stdout);
+        ::_exit(succeeded ? 0 : 1);
+      } else if (job.pid < 0) {
+        remove_directory(job.dir);
+        job.done = true;
+        job.error = "couldn't start test unit [" + job.args.unit + "]";
+        continue;
+      }
+      ++running;
+    }
+
+    // display the finished units in their order
+    while (reported < jobs.size() && jobs[reported].done) {
+      unit_job &job = jobs[reported++];
+      if (!job.dir.empty()) {
+        std::ifstream output((job.dir + "/output").c_str());
+        if (output && output.peek() != std::ifstream::traits_type::eof()) {
+          std::cout << output.rdbuf();
+        }
+        std::ifstream in((job.dir + "/result.json").c_str());
+        if (in) {
+          merge_json(in);
+        }
+        remove_directory(job.dir);
+      }
+      if (!job.error.empty()) {
+        std::cout << job.error << "\n";
+      }
+      std::cout << "Test unit [" << job.args.unit << "] " << (job.succeeded ? "succeeded" : "failed")
+                << " in " << std::fixed << std::setprecision(3) << job.seconds << " s\n";
+      std::cout.unsetf(std::ios::fixed);
+      if (!job.succeeded) {
+        result = false;
+      }
+    }
+
+    if (running == 0) {
+      continue;
+    }
+
+    int status = 0;
+    pid_t pid = ::waitpid(-1, &status, 0);
+    if (pid < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // no child left to wait for
+      for (std::size_t i = reported; i < next; ++i) {
+        if (!jobs[i].done) {
+          jobs[i].done = true;
+          jobs[i].error = "lost test unit [" + jobs[i].args.unit + "]";
+        }
+      }
+      running = 0;
+      continue;
+    }
+    for (std::size_t i = reported; i < next; ++i) {
+      unit_job &job = jobs[i];
+      if (job.pid != pid || job.done) {
+        continue;
+      }
+      job.done = true;
+      job.seconds = std::chrono::duration<double>(clock_type::now() - job.start).count();
+      job.succeeded = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+      if (WIFSIGNALED(status)) {
+        std::stringstream msg;
+        msg << "test unit [" << job.args.unit << "] terminated by signal " << WTERMSIG(status);
+        job.error = msg.str();
+      }
+      --running;
+      break;
+    }
+  }
+  std::cout << "Executed " << jobs.size() << " test units with " << args_.jobs << " jobs in "
+            << std::fixed << std::setprecision(3)
+            << std::chrono::duration<double>(clock_type::now() - start).count() << " s\n";
+  std::cout.unsetf(std::ios::fixed);
+  return result;
+#endif
+}
+
+bool test_suite::merge_json(std::istream &in)
+{
+  json_value root;
+  try {
+    json_parser parser;
+    root = parser.parse(in);
+  } catch (std::exception &) {
+    return false;
+  }
+  const json_object *obj = root.value_type<json_object>();
+  const json_value *units = obj ? find_member(*obj, "units") : nullptr;
+  if (units == nullptr || !units->is_type<json_array>()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < units->size(); ++i) {
+    const json_object *uobj = (*units)[i].value_type<json_object>();
+    const json_value *tests = uobj ? find_member(*uobj, "tests") : nullptr;
+    if (tests == nullptr || !tests->is_type<json_array>()) {
+      continue;
+    }
+    t_unit_test_map::iterator unit = unit_test_map_.find(string_member(*uobj, "name"));
+    if (unit == unit_test_map_.end()) {
+      continue;
+    }
+    unit_test::t_test_func_info_vector &infos = unit->second->test_func_infos_;
+    for (std::size_t j = 0; j < tests->size(); ++j) {
+      const json_object *tobj = (*tests)[j].value_type<json_object>();
+      if (tobj == nullptr) {
+        continue;
+      }
+      std::string name = string_member(*tobj, "name");
+      unit_test::t_test_func_info_vector::iterator info = std::find_if(infos.begin(), infos.end(), [&name](const unit_test::test_func_info &x) {
+        return x.name == name;
+      });
+      if (info == infos.end()) {
+        continue;
+      }
+      info->executed = true;
+      info->succeeded = bool_member(*tobj, "succeeded", false);
+      info->assertion_count = (size_t)number_member(*tobj, "assertions", 0);
+      info->message = string_member(*tobj, "message");
+      info->metrics.clear();
+      const json_value *metrics = find_member(*tobj, "metrics");
+      const json_object *mobj = metrics ? metrics->value_type<json_object>() : nullptr;
+      if (mobj == nullptr) {
+        continue;
+      }
+      for (json_object::const_iterator k = mobj->begin(); k != mobj->end(); ++k) {
+        if (k->second.is_type<json_number>()) {
+          info->metrics.push_back(std::make_pair(k->first.value(), k->second.value_type<json_number>()->value()));
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void test_suite::collect_benchmarks()
+{
+  for (t_unit_test_map::const_iterator i = unit_test_map_.begin(); i != unit_test_map_.end(); ++i) {
+    const unit_test::t_test_func_info_vector &infos = i->second->test_func_infos_;
+    for (unit_test::t_test_func_info_vector::const_iterator j = infos.begin(); j != infos.end(); ++j) {
+      if (!j->executed || !j->succeeded) {
+        continue;
+      }
+      // only benchmarks record a median
+      for (unit_test::t_metric_vector::const_iterator k = j->metrics.begin(); k != j->metrics.end(); ++k) {
+        if (k->first == "median_ns") {
+          benchmark_samples_[i->first + ":" + j->name].push_back(k->second);
+        }
+      }
+    }
+  }
+}
+
+bool test_suite::compare_baseline(const std::string &file) const
+{
+  std::ifstream in(file.c_str());
+  t_baseline_map baseline;
+  if (!in || !read_baseline(in, args_.tolerance, baseline)) {
+    std::cout << "couldn't read baseline file [" << file << "]\n";
+    return false;
+  }
+
+  std::cout << "Comparing with baseline [" << file << "]\n";
+  std::cout << std::left << std::setw(50) << "benchmark" << std::right
+            << std::setw(12) << "baseline" << std::setw(12) << "current"
+            << std::setw(11) << "diff" << std::setw(10) << "spread"
+            << std::setw(11) << "tolerance" << "  status\n";
+
+  std::size_t regressions = 0;
+  for (t_sample_map::const_iterator i = benchmark_samples_.begin(); i != benchmark_samples_.end(); ++i) {
+    std::vector<double> medians(i->second);
+    benchmark_unit::statistics stats = benchmark_unit::evaluate(medians);
+    // spread of the repeated runs relative to their median
+    double spread = stats.median > 0 ? (medians.back() - medians.front()) * 100.0 / stats.median : 0;
+
+    std::cout << std::left << std::setw(50) << i->first << std::right;
+    t_baseline_map::const_iterator entry = baseline.find(i->first);
+    if (entry == baseline.end() || entry->second.median <= 0) {
+      std::cout << std::setw(12) << "-" << std::setw(12) << duration_string(stats.median)
+                << std::setw(11) << "-" << std::setw(9) << std::fixed << std::setprecision(1) << spread << "%"
+                << std::setw(11) << "-" << "  new\n";
+      std::cout.unsetf(std::ios::fixed);
+      continue;
+    }
+    double diff = (stats.median - entry->second.median) * 100.0 / entry->second.median;
+    const char *status = "ok";
+    if (diff > entry->second.tolerance) {
+      status = "REGRESSION";
+      ++regressions;
+    } else if (diff < -entry->second.tolerance) {
+      status = "faster";
+    }
+    std::cout << std::setw(12) << duration_string(entry->second.median)
+              << std::setw(12) << duration_string(stats.median)
+              << std::fixed << std::setprecision(1)
+              << std::setw(10) << std::showpos << diff << std::noshowpos << "%"
+              << std::setw(9) << spread << "%"
+              << std::setw(10) << entry->second.tolerance << "%"
+              << "  " << status << "\n";
+    std::cout.unsetf(std::ios::fixed);
+  }
+  std::cout << benchmark_samples_.size() << " benchmarks compared, " << regressions << " regressed\n";
+  return regressions == 0;
+}
+
+bool test_suite::record_baseline(const std::string &file) const
+{
+  t_baseline_map baseline;
+  {
+    // keep the entries of an existing baseline
+    std::ifstream in(file.c_str());
+    if (in && !read_baseline(in, args_.tolerance, baseline)) {
+      std::cout << "couldn't read baseline file [" << file << "]\n";
+      return false;
+    }
+  }
+
+  for (t_sample_map::const_iterator i = benchmark_samples_.begin(); i != benchmark_samples_.end(); ++i) {
+    std::vector<double> medians(i->second);
+    t_baseline_map::iterator entry = baseline.find(i->first);
+    if (entry == baseline.end()) {
+      entry = baseline.insert(std::make_pair(i->first, baseline_entry())).first;
+      entry->second.tolerance = args_.tolerance;
+    }
+    entry->second.median = benchmark_unit::evaluate(medians).median;
+  }
+
+  json_value benchmarks(new json_object);
+  for (t_baseline_map::const_iterator i = baseline.begin(); i != baseline.end(); ++i) {
+    json_value entry(new json_object);
+    entry["median_ns"] = i->second.median;
+    entry["tolerance"] = i->second.tolerance;
+    benchmarks[i->first] = entry;
+  }
+  json_object root;
+  root["benchmarks"] = benchmarks;
+
+  std::ofstream out(file.c_str());
+  if (!out) {
+    std::cout << "couldn't open baseline file [" << file << "]\n";
+    return false;
+  }
+  out.precision(15);
+  out << root << "\n";
+  std::cout << "Recorded " << benchmark_samples_.size() << " benchmarks into baseline [" << file << "]\n";
+  return true;
+}
+
+void test_suite::write_json(std::ostream &out) const
+{
+  json_value units(new json_array);
+  for (t_unit_test_map::const_iterator i = unit_test_map_.begin(); i != unit_test_map_.end(); ++i) {
+    json_value tests(new json_array);
+    const unit_test::t_test_func_info_vector &infos = i->second->test_func_infos_;
+    for (unit_test::t_test_func_info_vector::const_iterator j = infos.begin(); j != infos.end(); ++j) {
+      if (!j->executed) {
+        continue;
+      }
+      json_value metrics(new json_object);
+      for (unit_test::t_metric_vector::const_iterator k = j->metrics.begin(); k != j->metrics.end(); ++k) {
+        metrics[k->first] = k->second;
+      }
+      json_value test(new json_object);
+      test["name"] = j->name;
+      test["caption"] = j->caption;
+      test["succeeded"] = j->succeeded;
+      test["assertions"] = (double)j->assertion_count;
+      test["message"] = j->message;
+      test["metrics"] = metrics;
+      tests.push_back(test);
+    }
+    if (tests.size() == 0) {
+      continue;
+    }
+    json_value unit(new json_object);
+    unit["name"] = i->first;
+    unit["caption"] = i->second->caption();
+    unit["tests"] = tests;
+    units.push_back(unit);
+  }
+  json_object root;
+  root["units"] = units;
+  // keep the digits of large measured values
+  std::streamsize precision = out.precision(15);
+  out << root << "\n";
+  out.precision(precision);
+}
+
 bool test_suite::run(const std::string &unit)
 {
   t_unit_test_map::const_iterator i = unit_test_map_.find(unit);
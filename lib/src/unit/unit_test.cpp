@@ -123,12 +123,37 @@ void unit_test::info(const std::string &msg)
   std::cout << "INFO: " << msg;
 }
 
+void unit_test::summary(const std::string &msg)
+{
+  current_test_func_info->summary = msg;
+}
+
+void unit_test::metric(const std::string &name, double value)
+{
+  t_metric_vector &metrics = current_test_func_info->metrics;
+  for (t_metric_vector::iterator i = metrics.begin(); i != metrics.end(); ++i) {
+    if (i->first == name) {
+      i->second = value;
+      return;
+    }
+  }
+  metrics.push_back(std::make_pair(name, value));
+}
+
 void unit_test::execute(test_func_info &test_info)
 {
+    // a test may be executed more than once
+    test_info.executed = true;
+    test_info.succeeded = true;
+    test_info.assertion_count = 0;
+    test_info.message.clear();
+    test_info.summary.clear();
+    test_info.metrics.clear();
+    // initialize may already record metrics of the test
+    current_test_func_info = &test_info;
     initialize();
     std::cout << std::left << std::setw(70) << test_info.caption << " ... " << std::flush;
     try {
-      current_test_func_info = &test_info;
       test_info.func();
     } catch (unit_exception &ex) {
       test_info.succeeded = false;
@@ -138,7 +163,9 @@ void unit_test::execute(test_func_info &test_info)
       test_info.message = ex.what();
     }
     finalize();
-    if (test_info.succeeded) {
+    if (test_info.succeeded && !test_info.summary.empty()) {
+      std::cout << "PASS (" << test_info.summary << ")\n";
+    } else if (test_info.succeeded) {
       std::cout << "PASS (" << test_info.assertion_count << " assertions)\n";
     } else {
       std::cout << "FAILED\n\t" << test_info.message << "\n";
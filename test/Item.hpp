@@ -24,10 +24,12 @@
 #include "object/object_list.hpp"
 #include "object/object_vector.hpp"
 #include "object/linked_object_list.hpp"
+#include "object/value_vector.hpp"
 
 #include "tools/time.hpp"
 #include "tools/date.hpp"
 #include "tools/varchar.hpp"
+#include "tools/blob.hpp"
 
 class Item : public oos::serializable
 {
@@ -959,6 +961,154 @@ public:
   bool empty() const { return tracks_.empty(); }
 };
 
+class chart : public oos::serializable
+{
+public:
+  typedef oos::object_ref<track> track_ref;
+  typedef oos::object_vector<chart, track_ref, true> track_list_t;
+  typedef track_list_t::item_type item_type;
+  typedef /*typename*/ track_list_t::size_type size_type;
+  typedef track_list_t::iterator iterator;
+  typedef track_list_t::const_iterator const_iterator;
+
+private:
+  oos::identifier<unsigned long> id_;
+  std::string name_;
+  track_list_t tracks_;
+
+public:
+  chart()
+    : tracks_(0, 0, oos::GAPPED_ORDERING)
+  {}
+  chart(const std::string &name)
+    : name_(name)
+    , tracks_(0, 0, oos::GAPPED_ORDERING)
+  {}
+
+  virtual ~chart() {}
+
+  virtual void deserialize(oos::deserializer &deserializer)
+  {
+    deserializer.read("id", id_);
+    deserializer.read("name", name_);
+    deserializer.read("tracks", tracks_);
+  }
+  virtual void serialize(oos::serializer &serializer) const
+  {
+    serializer.write("id", id_);
+    serializer.write("name", name_);
+    serializer.write("tracks", tracks_);
+  }
+
+  unsigned long id() { return id_.value(); }
+
+  std::string name() const { return name_; }
+
+  void add(const track_ref &b)
+  {
+    tracks_.push_back(b);
+  }
+
+  iterator insert(iterator pos, const track_ref &b)
+  {
+    return tracks_.insert(pos, b);
+  }
+
+  iterator begin() { return tracks_.begin(); }
+  const_iterator begin() const { return tracks_.begin(); }
+
+  iterator end() { return tracks_.end(); }
+  const_iterator end() const { return tracks_.end(); }
+
+  iterator erase(iterator i) { return tracks_.erase(i); }
+
+  size_type size() const { return tracks_.size(); }
+  bool empty() const { return tracks_.empty(); }
+};
+
+class sensor : public oos::serializable
+{
+public:
+  typedef oos::value_vector<int> sample_vector_t;
+  typedef oos::value_vector<std::string> tag_vector_t;
+
+private:
+  oos::identifier<unsigned long> id_;
+  std::string name_;
+  sample_vector_t samples_;
+  tag_vector_t tags_;
+
+public:
+  sensor() {}
+  sensor(const std::string &name)
+    : name_(name)
+  {}
+
+  virtual ~sensor() {}
+
+  virtual void deserialize(oos::deserializer &deserializer)
+  {
+    deserializer.read("id", id_);
+    deserializer.read("name", name_);
+    deserializer.read("samples", samples_);
+    deserializer.read("tags", tags_);
+  }
+  virtual void serialize(oos::serializer &serializer) const
+  {
+    serializer.write("id", id_);
+    serializer.write("name", name_);
+    serializer.write("samples", samples_);
+    serializer.write("tags", tags_);
+  }
+
+  unsigned long id() { return id_.value(); }
+
+  std::string name() const { return name_; }
+
+  sample_vector_t& samples() { return samples_; }
+  const sample_vector_t& samples() const { return samples_; }
+
+  tag_vector_t& tags() { return tags_; }
+  const tag_vector_t& tags() const { return tags_; }
+};
+
+class picture : public oos::serializable
+{
+private:
+  oos::identifier<unsigned long> id_;
+  std::string name_;
+  oos::blob data_;
+
+public:
+  picture() {}
+  picture(const std::string &name, const oos::blob &data)
+    : name_(name)
+    , data_(data)
+  {}
+
+  virtual ~picture() {}
+
+  virtual void deserialize(oos::deserializer &deserializer)
+  {
+    deserializer.read("id", id_);
+    deserializer.read("name", name_);
+    deserializer.read("data", data_);
+  }
+  virtual void serialize(oos::serializer &serializer) const
+  {
+    serializer.write("id", id_);
+    serializer.write("name", name_);
+    serializer.write("data", data_);
+  }
+
+  unsigned long id() { return id_.value(); }
+
+  std::string name() const { return name_; }
+
+  const oos::blob& data() const { return data_; }
+  void data(const oos::blob &d) { data_ = d; }
+};
+
 class child : public oos::serializable
 {
 public:
@@ -23,8 +23,13 @@
 
 #include "database/session.hpp"
 #include "database/database_exception.hpp"
+#include "database/transaction.hpp"
+#include "database/query.hpp"
 
+#include <cstring>
 #include <fstream>
+#include <sstream>
+#include <vector>
 
 using namespace oos;
 using namespace std;
@@ -39,10 +44,15 @@ DatabaseTestUnit::DatabaseTestUnit(const std::string &name, const std::string &m
   add_test("pk", std::bind(&DatabaseTestUnit::test_primary_key, this), "test primary key serializable with database");
   add_test("insert", std::bind(&DatabaseTestUnit::test_insert, this), "insert an item into the database");
   add_test("update", std::bind(&DatabaseTestUnit::test_update, this), "update an item on the database");
+  add_test("update_columns", std::bind(&DatabaseTestUnit::test_update_columns, this), "update only the modified columns of an item");
   add_test("delete", std::bind(&DatabaseTestUnit::test_delete, this), "delete an item from the database");
+  add_test("delete_batch", std::bind(&DatabaseTestUnit::test_delete_batch, this), "delete many items with batched statements");
   add_test("reload_simple", std::bind(&DatabaseTestUnit::test_reload_simple, this), "simple reload database test");
   add_test("reload", std::bind(&DatabaseTestUnit::test_reload, this), "reload database test");
   add_test("reload_container", std::bind(&DatabaseTestUnit::test_reload_container, this), "reload serializable list database test");
+  add_test("reload_gapped", std::bind(&DatabaseTestUnit::test_reload_gapped, this), "reload gapped vector database test");
+  add_test("reload_values", std::bind(&DatabaseTestUnit::test_reload_values, this), "reload value vector database test");
+  add_test("blob", std::bind(&DatabaseTestUnit::test_reload_blob, this), "reload small and large blobs");
   add_test("relation", std::bind(&DatabaseTestUnit::test_reload_relation, this), "reload relation test");
 }
 
@@ -58,6 +68,9 @@ DatabaseTestUnit::initialize()
   ostore_.insert_prototype(new vector_object_producer<ItemPtrVector>("ptr_vector"), "item_ptr_vector");
   ostore_.insert_prototype<album>("album");
   ostore_.insert_prototype<track>("track");
+  ostore_.insert_prototype<chart>("chart");
+  ostore_.insert_prototype<sensor>("sensor");
+  ostore_.insert_prototype<picture>("picture");
 
   ostore_.insert_prototype<children_list>("children_list");
   ostore_.insert_prototype<master>("master");
@@ -277,6 +290,63 @@ void DatabaseTestUnit::test_update()
   UNIT_ASSERT_EQUAL("Mars", item->get_string(), "expected string must be 'Mars'");
 }
 
+void DatabaseTestUnit::test_update_columns()
+{
+  typedef object_ptr<Item> item_ptr;
+  typedef std::tuple<std::string, int, double> row_t;
+
+  transaction tr(*session_);
+  tr.begin();
+  item_ptr item = ostore_.insert(new Item("Erde", 1));
+  tr.commit();
+
+  std::stringstream where;
+  where << "id = " << item->id();
+
+  // change a column behind the back of the object store
+  query<Item> q(session_->db());
+  q.update("item").set("val_string", type_text, "'Mond'").where(where.str()).execute();
+
+  // an update must only set the modified column
+  tr.begin();
+  item->set_int(2);
+  tr.commit();
+
+  row_t row;
+  query<row_t> rq(session_->db());
+  rq.select({"val_string", "val_int", "val_double"}).from("item");
+  result<row_t> res(rq.execute());
+  row = *res.begin();
+  UNIT_ASSERT_EQUAL(std::get<0>(row), "Mond", "string column must not be updated");
+  UNIT_ASSERT_EQUAL(std::get<1>(row), 2, "integer column must be updated");
+
+  // the statement of the column set is reused
+  tr.begin();
+  item->set_int(3);
+  tr.commit();
+
+  tr.begin();
+  item->set_double(2.5);
+  tr.commit();
+
+  res = rq.execute();
+  row = *res.begin();
+  UNIT_ASSERT_EQUAL(std::get<0>(row), "Mond", "string column must not be updated");
+  UNIT_ASSERT_EQUAL(std::get<1>(row), 3, "integer column must be updated");
+  UNIT_ASSERT_EQUAL(std::get<2>(row), 2.5, "double column must be updated");
+
+  // an unchanged object isn't written
+  q.reset().update("item").set("val_int", type_int, 42).where(where.str()).execute();
+
+  tr.begin();
+  item->set_int(3);
+  tr.commit();
+
+  res = rq.execute();
+  row = *res.begin();
+  UNIT_ASSERT_EQUAL(std::get<1>(row), 42, "unmodified object must not be updated");
+}
+
 void DatabaseTestUnit::test_delete()
 {
   typedef object_ptr<Item> item_ptr;
@@ -317,6 +387,56 @@ void DatabaseTestUnit::test_delete()
   }
 }
 
+void DatabaseTestUnit::test_delete_batch()
+{
+  typedef object_ptr<Item> item_ptr;
+  typedef object_view<Item> oview_t;
+
+  oview_t oview(ostore_);
+  query<Item> q(session_->db());
+
+  transaction tr(*session_);
+  tr.begin();
+  for (int i = 0; i < 600; ++i) {
+    ostore_.insert(new Item("Item", i));
+  }
+  tr.commit();
+
+  UNIT_ASSERT_EQUAL(q.aggregate<long>(aggregate_count, "*", "item").value(), 600L, "expected 600 stored items");
+
+  // two full chunks and a remainder
+  tr.begin();
+  std::size_t count = ostore_.remove_if(oview, [](const item_ptr &x) {
+    return x->get_int() % 3 != 0;
+  });
+  tr.commit();
+
+  UNIT_ASSERT_EQUAL(count, (std::size_t)400, "400 items must be removed");
+  UNIT_ASSERT_EQUAL(q.aggregate<long>(aggregate_count, "*", "item").value(), 200L, "expected 200 stored items");
+  UNIT_ASSERT_EQUAL(q.aggregate<long>(aggregate_count, "*", "item").where("val_int % 3 <> 0").value(), 0L, "wrong items deleted");
+
+  // deletes before and after an insert
+  tr.begin();
+  item_ptr item = oview.front();
+  ostore_.remove(item);
+  ostore_.insert(new Item("Item", 1000));
+  ostore_.remove_if(oview, [](const item_ptr &x) {
+    return x->get_int() == 597;
+  });
+  tr.commit();
+
+  UNIT_ASSERT_EQUAL(q.aggregate<long>(aggregate_count, "*", "item").value(), 199L, "expected 199 stored items");
+  UNIT_ASSERT_EQUAL(q.aggregate<long>(aggregate_count, "*", "item").where("val_int = 1000").value(), 1L, "inserted item must be stored");
+
+  // a rollback discards the queued deletes
+  tr.begin();
+  ostore_.remove_if(oview, [](const item_ptr &) { return true; });
+  tr.rollback();
+
+  UNIT_ASSERT_EQUAL(oview.size(), (std::size_t)199, "expected 199 items");
+  UNIT_ASSERT_EQUAL(q.aggregate<long>(aggregate_count, "*", "item").value(), 199L, "expected 199 stored items");
+}
+
 void
 DatabaseTestUnit::test_reload_simple()
 {
@@ -569,6 +689,242 @@ DatabaseTestUnit::test_reload_container()
   }
 }
 
+void DatabaseTestUnit::test_reload_gapped()
+{
+  typedef object_ptr<chart> chart_ptr;
+
+  transaction tr(*session_);
+  try {
+    tr.begin();
+
+    chart_ptr c = ostore_.insert(new chart("Top"));
+
+    // each track is inserted at the front
+    for (int i = 0; i < 100; ++i) {
+      stringstream name;
+      name << "Track " << i;
+      c->insert(c->begin(), ostore_.insert(new track(name.str())));
+    }
+
+    tr.commit();
+
+    tr.begin();
+    // the new track takes a key between its neighbours
+    c->insert(c->begin() + 50, ostore_.insert(new track("Middle")));
+
+    tr.commit();
+  } catch (database_exception &ex) {
+    // error, abort transaction
+    UNIT_WARN("caught database exception: " << ex.what() << " (start rollback)");
+    tr.rollback();
+  } catch (object_exception &ex) {
+    // error, abort transaction
+    UNIT_WARN("caught serializable exception: " << ex.what() << " (start rollback)");
+    tr.rollback();
+  }
+
+  session_->close();
+
+  ostore_.clear();
+
+  session_->open();
+
+  session_->load();
+
+  typedef object_view<chart> chart_view_t;
+  chart_view_t oview(ostore_);
+
+  UNIT_ASSERT_TRUE(oview.begin() != oview.end(), "chart view must not be empty");
+
+  chart_ptr c = *oview.begin();
+
+  UNIT_ASSERT_EQUAL((int)c->size(), 101, "invalid chart size");
+
+  int n = 100;
+  for (chart::iterator first = c->begin(); first != c->end(); ++first) {
+    stringstream name;
+    if (first == c->begin() + 50) {
+      name << "Middle";
+    } else {
+      name << "Track " << --n;
+    }
+    UNIT_ASSERT_EQUAL((*first)->value()->title(), name.str(), "invalid track order");
+  }
+}
+
+void DatabaseTestUnit::test_reload_values()
+{
+  typedef object_ptr<sensor> sensor_ptr;
+
+  transaction tr(*session_);
+  try {
+    tr.begin();
+
+    sensor_ptr s = ostore_.insert(new sensor("barometer"));
+    for (int i = 0; i < 10000; ++i) {
+      s->samples().push_back(i);
+    }
+    s->tags().push_back("roof");
+    s->tags().push_back("it's \"calibrated\"");
+
+    tr.commit();
+
+    tr.begin();
+    // drop the odd samples
+    sensor::sample_vector_t &samples = s->samples();
+    for (sensor::sample_vector_t::iterator i = samples.begin(); i != samples.end();) {
+      i = (*i % 2) ? samples.erase(i) : i + 1;
+    }
+    tr.commit();
+
+    tr.begin();
+    s->samples().clear();
+    s->tags().push_back("discarded");
+    tr.rollback();
+
+    UNIT_ASSERT_EQUAL((int)s->samples().size(), 5000, "rollback must restore the samples");
+    UNIT_ASSERT_EQUAL((int)s->tags().size(), 2, "rollback must restore the tags");
+  } catch (database_exception &ex) {
+    // error, abort transaction
+    UNIT_WARN("caught database exception: " << ex.what() << " (start rollback)");
+    tr.rollback();
+  } catch (object_exception &ex) {
+    // error, abort transaction
+    UNIT_WARN("caught serializable exception: " << ex.what() << " (start rollback)");
+    tr.rollback();
+  }
+
+  session_->close();
+
+  ostore_.clear();
+
+  session_->open();
+
+  session_->load();
+
+  typedef object_view<sensor> sensor_view_t;
+  sensor_view_t oview(ostore_);
+
+  UNIT_ASSERT_TRUE(oview.begin() != oview.end(), "sensor view must not be empty");
+
+  sensor_ptr s = *oview.begin();
+
+  UNIT_ASSERT_EQUAL(s->name(), std::string("barometer"), "invalid sensor name");
+  UNIT_ASSERT_EQUAL((int)s->samples().size(), 5000, "invalid sample count");
+  for (int i = 0; i < 5000; ++i) {
+    UNIT_ASSERT_EQUAL(s->samples()[i], i * 2, "invalid sample");
+  }
+  UNIT_ASSERT_EQUAL((int)s->tags().size(), 2, "invalid tag count");
+  UNIT_ASSERT_EQUAL(s->tags()[1], std::string("it's \"calibrated\""), "invalid tag");
+
+  // each element is one row of the join table of its vector
+  query<sensor> q(session_->db());
+  UNIT_ASSERT_EQUAL(q.aggregate<long>(aggregate_count, "*", "sensor_samples").value(), 5000L, "invalid sample row count");
+  UNIT_ASSERT_EQUAL(q.aggregate<long>(aggregate_count, "*", "sensor_tags").value(), 2L, "invalid tag row count");
+
+  transaction remove_tr(*session_);
+  remove_tr.begin();
+  ostore_.remove(s);
+  remove_tr.commit();
+
+  UNIT_ASSERT_EQUAL(q.aggregate<long>(aggregate_count, "*", "sensor_samples").value(), 0L, "sample rows must be deleted");
+  UNIT_ASSERT_EQUAL(q.aggregate<long>(aggregate_count, "*", "sensor_tags").value(), 0L, "tag rows must be deleted");
+}
+
+void DatabaseTestUnit::test_reload_blob()
+{
+  typedef object_ptr<picture> picture_ptr;
+
+  // a large blob exceeds the size read at once
+  std::vector<char> large(3 * 1024 * 1024 + 17);
+  for (std::size_t i = 0; i < large.size(); ++i) {
+    large[i] = (char)(i * 31 % 251);
+  }
+  // binary data with zero bytes
+  const char small[] = { 'o', 'o', 's', '\0', '\x7f', '\xff', '\0', 'x' };
+
+  transaction tr(*session_);
+  try {
+    tr.begin();
+    ostore_.insert(new picture("small", blob(small, sizeof(small))));
+    ostore_.insert(new picture("large", blob(&large[0], large.size())));
+    ostore_.insert(new picture("empty", blob()));
+    tr.commit();
+  } catch (database_exception &ex) {
+    // error, abort transaction
+    UNIT_WARN("caught database exception: " << ex.what() << " (start rollback)");
+    tr.rollback();
+  } catch (object_exception &ex) {
+    // error, abort transaction
+    UNIT_WARN("caught serializable exception: " << ex.what() << " (start rollback)");
+    tr.rollback();
+  }
+
+  session_->close();
+
+  ostore_.clear();
+
+  session_->open();
+
+  session_->load();
+
+  typedef object_view<picture> picture_view_t;
+  picture_view_t oview(ostore_);
+
+  UNIT_ASSERT_EQUAL((int)oview.size(), 3, "invalid picture count");
+
+  picture_ptr small_pic, large_pic, empty_pic;
+  for (picture_view_t::iterator i = oview.begin(); i != oview.end(); ++i) {
+    if ((*i)->name() == "small") {
+      small_pic = *i;
+    } else if ((*i)->name() == "large") {
+      large_pic = *i;
+    } else {
+      empty_pic = *i;
+    }
+  }
+
+  UNIT_ASSERT_TRUE(small_pic->data() == blob(small, sizeof(small)), "invalid small blob");
+  UNIT_ASSERT_TRUE(empty_pic->data().empty(), "blob must be empty");
+
+  // read a chunk across the end of the large blob
+  const blob &data = large_pic->data();
+  UNIT_ASSERT_EQUAL(data.size(), large.size(), "invalid blob size");
+  // a lazy copy keeps reading from the database
+  blob unread(data);
+  char chunk[64];
+  blob::size_type offset = large.size() - 40;
+  UNIT_ASSERT_EQUAL(data.read(offset, chunk, sizeof(chunk)), (blob::size_type)40, "invalid chunk size");
+  UNIT_ASSERT_TRUE(memcmp(chunk, &large[offset], 40) == 0, "invalid chunk");
+  UNIT_ASSERT_EQUAL(data.read(large.size(), chunk, sizeof(chunk)), (blob::size_type)0, "no chunk expected");
+
+  UNIT_ASSERT_TRUE(memcmp(data.data(), &large[0], large.size()) == 0, "invalid large blob");
+  UNIT_ASSERT_TRUE(data.is_loaded(), "blob must be loaded");
+
+  tr.begin();
+  large_pic->data(blob(small, sizeof(small)));
+  tr.commit();
+
+  session_->close();
+
+  if (!unread.is_loaded()) {
+    UNIT_ASSERT_EXCEPTION(unread.data(), database_exception, "couldn't read blob: database is closed", "a lazy blob of a closed database must not be read");
+  }
+
+  ostore_.clear();
+
+  session_->open();
+
+  session_->load();
+
+  picture_view_t pview(ostore_);
+  for (picture_view_t::iterator i = pview.begin(); i != pview.end(); ++i) {
+    if ((*i)->name() == "large") {
+      UNIT_ASSERT_TRUE((*i)->data() == blob(small, sizeof(small)), "invalid updated blob");
+    }
+  }
+}
+
 void DatabaseTestUnit::test_reload_relation()
 {
   oos::prototype_tree &tree = ostore_.prototypes();
@@ -41,10 +41,15 @@ public:
   void test_primary_key();
   void test_insert();
   void test_update();
+  void test_update_columns();
   void test_delete();
+  void test_delete_batch();
   void test_reload_simple();
   void test_reload();
   void test_reload_container();
+  void test_reload_gapped();
+  void test_reload_values();
+  void test_reload_blob();
   void test_reload_relation();
 
 protected:
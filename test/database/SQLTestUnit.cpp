@@ -9,6 +9,13 @@
 #include "database/session.hpp"
 #include "database/query.hpp"
 #include "database/statement.hpp"
+#include "database/identifier_binder.hpp"
+#include "database/condition.hpp"
+
+#include "json/json.hpp"
+#include "json/json_parser.hpp"
+
+#include <sstream>
 
 using namespace oos;
 
@@ -19,6 +26,10 @@ SQLTestUnit::SQLTestUnit(const std::string &name, const std::string &msg, const
   add_test("create", std::bind(&SQLTestUnit::test_create, this), "test direct sql create statement");
   add_test("statement", std::bind(&SQLTestUnit::test_statement, this), "test prepared sql statement");
   add_test("foreign_query", std::bind(&SQLTestUnit::test_foreign_query, this), "test query with foreign key");
+  add_test("reuse", std::bind(&SQLTestUnit::test_reuse_rows, this), "test reusing the row object of a result");
+  add_test("tuple", std::bind(&SQLTestUnit::test_tuple_select, this), "test selecting columns into tuples");
+  add_test("aggregate", std::bind(&SQLTestUnit::test_aggregate, this), "test aggregates and result sizes");
+  add_test("metrics", std::bind(&SQLTestUnit::test_metrics, this), "test statement metrics and slow query log");
 }
 
 SQLTestUnit::~SQLTestUnit() {}
@@ -143,6 +154,282 @@ void SQLTestUnit::test_foreign_query()
   q.drop("item").execute();
 }
 
+void SQLTestUnit::test_reuse_rows()
+{
+  session_->open();
+
+  query<Item> q(session_->db());
+
+  result<Item> res(q.create("item").execute());
+
+  for (int i = 0; i < 5; ++i) {
+    Item item(i % 2 == 0 ? "Hans" : "", i);
+    item.id(i + 1);
+    res = q.insert(&item, "item").execute();
+  }
+
+  res = q.select().from("item").execute();
+  res.reuse(true);
+
+  UNIT_ASSERT_TRUE(res.reuse(), "result must reuse rows");
+
+  auto first = res.begin();
+  auto last = res.end();
+
+  Item *row = first.get();
+  int count = 0;
+  int sum = 0;
+  while (first != last) {
+    UNIT_ASSERT_TRUE(first.get() == row, "row object must be reused");
+    // the values of the previous row must be overwritten
+    UNIT_ASSERT_EQUAL(first->get_string(), first->get_int() % 2 == 0 ? "Hans" : "", "invalid name");
+    sum += first->get_int();
+    ++count;
+    ++first;
+  }
+
+  UNIT_ASSERT_EQUAL(count, 5, "invalid number of rows");
+  UNIT_ASSERT_EQUAL(sum, 10, "invalid sum of rows");
+
+  res = q.select().from("item").execute();
+
+  sum = 0;
+  std::size_t rows = res.for_each_row([&](const Item &item) {
+    sum += item.get_int();
+  });
+
+  UNIT_ASSERT_EQUAL(rows, 5UL, "invalid number of rows");
+  UNIT_ASSERT_EQUAL(sum, 10, "invalid sum of rows");
+
+  // a null foreign key resets the pointer of the reused object
+  using t_object_item = ObjectItem<Item>;
+
+  query<t_object_item> object_item_query(session_->db());
+  result<t_object_item> ores = object_item_query.create("object_item").execute();
+
+  object_ptr<Item> hans(new Item("Hans", 4711));
+  hans->id(23);
+
+  t_object_item with_item("with", 1);
+  with_item.id(1);
+  with_item.ptr(hans);
+  ores = object_item_query.insert(&with_item, "object_item").execute();
+
+  t_object_item without_item("without", 2);
+  without_item.id(2);
+  ores = object_item_query.insert(&without_item, "object_item").execute();
+
+  ores = object_item_query.select().from("object_item").execute();
+
+  int with_ptr = 0;
+  rows = ores.for_each_row([&](const t_object_item &oitem) {
+    if (oitem.ptr().has_primary_key()) {
+      ++with_ptr;
+    }
+  });
+
+  UNIT_ASSERT_EQUAL(rows, 2UL, "invalid number of rows");
+  UNIT_ASSERT_EQUAL(with_ptr, 1, "only one row has a foreign key");
+
+  object_item_query.drop("object_item").execute();
+
+  q.drop("item").execute();
+}
+
+void SQLTestUnit::test_tuple_select()
+{
+  session_->open();
+
+  query<Item> q(session_->db());
+
+  result<Item> res(q.create("item").execute());
+
+  for (int i = 0; i < 3; ++i) {
+    Item item("Hans", i * 10);
+    item.id(i + 1);
+    item.set_varchar(varchar<64>(std::string(i == 1 ? "Mond" : "Erde")));
+    res = q.insert(&item, "item").execute();
+  }
+
+  typedef std::tuple<unsigned long, varchar<64>, int> row_t;
+
+  result<row_t> rows(q.select<row_t>({"id", "val_varchar", "val_int"}).from("item").order_by("id").execute());
+
+  unsigned long id = 0;
+  for (result<row_t>::iterator first = rows.begin(); first != rows.end(); ++first) {
+    ++id;
+    UNIT_ASSERT_EQUAL(std::get<0>(*first), id, "invalid id");
+    UNIT_ASSERT_EQUAL(std::get<1>(*first).str(), id == 2 ? "Mond" : "Erde", "invalid varchar");
+    UNIT_ASSERT_EQUAL(std::get<2>(*first), (int)(id - 1) * 10, "invalid integer");
+  }
+
+  UNIT_ASSERT_EQUAL(id, 3UL, "invalid number of rows");
+
+  // prepared statement and for_each_row
+  query<std::tuple<std::string, int> > tq(session_->db());
+  statement<std::tuple<std::string, int> > stmt(tq.select({"val_string", "val_int"}).from("item").prepare());
+  result<std::tuple<std::string, int> > trows(stmt.execute());
+
+  int sum = 0;
+  std::size_t count = trows.for_each_row([&](const std::tuple<std::string, int> &row) {
+    UNIT_ASSERT_EQUAL(std::get<0>(row), "Hans", "invalid string");
+    sum += std::get<1>(row);
+  });
+
+  UNIT_ASSERT_EQUAL(count, 3UL, "invalid number of rows");
+  UNIT_ASSERT_EQUAL(sum, 30, "invalid sum");
+
+  UNIT_ASSERT_EXCEPTION(tq.select({"val_string"}), std::logic_error, "number of columns doesn't match the tuple size", "column count must match");
+
+  q.drop("item").execute();
+}
+
+void SQLTestUnit::test_aggregate()
+{
+  session_->open();
+
+  query<Item> q(session_->db());
+
+  result<Item> res(q.create("item").execute());
+
+  for (int i = 0; i < 6; ++i) {
+    Item item(i % 2 ? "Mond" : "Erde", i * 10);
+    item.id(i + 1);
+    res = q.insert(&item, "item").execute();
+  }
+
+  // scalars
+  UNIT_ASSERT_EQUAL(q.aggregate<long>(aggregate_count, "*", "item").value(), 6L, "invalid count");
+  UNIT_ASSERT_EQUAL(q.aggregate<long>(aggregate_count, "*", "item").where("val_int > 100").value(), 0L, "invalid count");
+  UNIT_ASSERT_EQUAL(q.aggregate<long>(aggregate_sum, "val_int", "item").where("val_string = 'Mond'").value(), 90L, "invalid sum");
+  UNIT_ASSERT_EQUAL(q.aggregate<int>(aggregate_min, "val_int", "item").value(), 0, "invalid min");
+  UNIT_ASSERT_EQUAL(q.aggregate<int>(aggregate_max, "val_int", "item").value(), 50, "invalid max");
+  UNIT_ASSERT_EQUAL(q.aggregate<double>(aggregate_avg, "val_int", "item").value(), 25.0, "invalid avg");
+  UNIT_ASSERT_EQUAL(q.aggregate<std::string>(aggregate_max, "val_string", "item").value(), "Mond", "invalid max");
+
+  // grouped
+  typedef std::tuple<std::string, long, long> group_t;
+  result<group_t> groups(q.select<group_t>({"val_string", aggregate_column(aggregate_count), aggregate_column(aggregate_sum, "val_int")})
+                          .from("item").group_by("val_string").order_by("val_string").execute());
+
+  std::vector<group_t> expected = { group_t("Erde", 3, 60), group_t("Mond", 3, 90) };
+  std::vector<group_t> actual;
+  for (result<group_t>::iterator first = groups.begin(); first != groups.end(); ++first) {
+    actual.push_back(*first);
+  }
+  UNIT_ASSERT_TRUE(actual == expected, "invalid groups");
+
+  // result sizes
+  res = q.select().from("item").execute();
+  UNIT_ASSERT_FALSE(res.empty(), "result must not be empty");
+  if (res.size_known()) {
+    UNIT_ASSERT_EQUAL(res.size(), 6UL, "invalid result size");
+  }
+  std::size_t rows = res.for_each_row([](const Item &) {});
+  UNIT_ASSERT_EQUAL(rows, 6UL, "invalid number of rows");
+  if (res.size_known()) {
+    UNIT_ASSERT_EQUAL(res.size(), 6UL, "result size must not change while fetching");
+  }
+
+  statement<Item> stmt(q.select().from("item").where("val_int > 100").prepare());
+  res = stmt.execute();
+  if (res.size_known()) {
+    UNIT_ASSERT_EQUAL(res.size(), 0UL, "invalid result size");
+  }
+  // mssql can't tell without fetching
+  if (db().compare(0, 5, "mssql") != 0) {
+    UNIT_ASSERT_TRUE(res.empty(), "result must be empty");
+  }
+
+  q.drop("item").execute();
+}
+
+void SQLTestUnit::test_metrics()
+{
+  session_->open();
+
+  sql_metrics &metrics = session_->db().metrics();
+  UNIT_ASSERT_FALSE(metrics.enabled(), "metrics must be disabled by default");
+
+  std::stringstream log;
+  metrics.enable(true);
+  metrics.slow_query_threshold(0.000001);
+  metrics.slow_query_log(log);
+
+  query<Item> q(session_->db());
+
+  result<Item> res(q.create("item").execute());
+
+  Item prototype;
+  statement<Item> stmt(q.insert(&prototype, "item").prepare());
+  for (int i = 0; i < 3; ++i) {
+    Item item("Hans", 4711 + i);
+    item.id(i + 1);
+    stmt.bind(&item);
+    res = stmt.execute();
+  }
+  std::string insert_sql = stmt.str();
+
+  statement<Item> select(q.select().from("item").prepare());
+  res = select.execute();
+  std::size_t rows = res.for_each_row([](const Item &) {});
+  UNIT_ASSERT_EQUAL(rows, 3UL, "invalid number of rows");
+
+  const sql_metrics::t_statistics_map &stats = metrics.statistics_map();
+  sql_metrics::t_statistics_map::const_iterator i = stats.find(insert_sql);
+  UNIT_ASSERT_TRUE(i != stats.end(), "insert statement must be measured");
+  UNIT_ASSERT_EQUAL(i->second.executions, 3ULL, "invalid number of executions");
+  UNIT_ASSERT_EQUAL(i->second.rows, 3ULL, "invalid number of affected rows");
+  UNIT_ASSERT_FALSE(i->second.is_select, "insert isn't a select");
+
+  i = stats.find(select.str());
+  UNIT_ASSERT_TRUE(i != stats.end(), "select statement must be measured");
+  UNIT_ASSERT_EQUAL(i->second.executions, 1ULL, "invalid number of executions");
+  UNIT_ASSERT_EQUAL(i->second.rows, 3ULL, "invalid number of fetched rows");
+  UNIT_ASSERT_TRUE(i->second.is_select, "select must be a select");
+  UNIT_ASSERT_TRUE(i->second.max_ns <= i->second.execute_ns, "max time exceeds total time");
+
+  UNIT_ASSERT_TRUE(log.str().find(insert_sql) != std::string::npos, "insert must be logged");
+  UNIT_ASSERT_TRUE(log.str().find("'Hans'") != std::string::npos, "bound value must be logged");
+
+  // the key of the where clause is logged with the bound columns
+  Item changed("Otto", 815);
+  changed.id(2);
+  query<serializable> oq(session_->db());
+  statement<serializable> update(oq.update(&changed, "item").where(cond("id").equal(0)).prepare());
+  statement<serializable> remove(oq.remove("item").where(cond("id").equal(0)).prepare());
+  identifier_binder binder;
+  binder.bind(&changed, &update, update.bind(&changed));
+  update.execute();
+  binder.bind(&changed, &remove, 0);
+  remove.execute();
+  std::string lines = log.str();
+  std::string::size_type pos = lines.find(update.str() + " [");
+  UNIT_ASSERT_TRUE(pos != std::string::npos, "update must be logged");
+  std::string line = lines.substr(pos, lines.find('\n', pos) - pos);
+  UNIT_ASSERT_TRUE(line.find("'Otto'") != std::string::npos, "bound column of update must be logged");
+  UNIT_ASSERT_EQUAL(line.substr(line.size() - 4), std::string(", 2]"), "key of update must be logged");
+  UNIT_ASSERT_TRUE(lines.find(remove.str() + " [2]\n") != std::string::npos, "key of delete must be logged");
+
+  std::stringstream out;
+  metrics.write_json(out);
+  json_value root = json_parser().parse(out);
+  UNIT_ASSERT_TRUE(root["statements"].is_type<json_array>(), "statements must be an array");
+  UNIT_ASSERT_TRUE(root["statements"].size() >= 3, "invalid number of statements");
+
+  metrics.reset();
+  i = stats.find(insert_sql);
+  UNIT_ASSERT_EQUAL(i->second.executions, 0ULL, "executions must be reset");
+  UNIT_ASSERT_EQUAL(i->second.rows, 0ULL, "rows must be reset");
+
+  metrics.enable(false);
+  metrics.slow_query_threshold(0);
+  res = q.drop("item").execute();
+  UNIT_ASSERT_EQUAL(metrics.statistics_map().size(), stats.size(), "disabled metrics must not measure");
+  i = stats.find(select.str());
+  UNIT_ASSERT_EQUAL(i->second.executions, 0ULL, "disabled metrics must not count");
+}
+
 session* SQLTestUnit::create_session()
 {
   return new session(ostore_, db_);
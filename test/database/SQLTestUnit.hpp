@@ -25,6 +25,10 @@ public:
   void test_create();
   void test_statement();
   void test_foreign_query();
+  void test_reuse_rows();
+  void test_tuple_select();
+  void test_aggregate();
+  void test_metrics();
 
 protected:
   oos::session* create_session();
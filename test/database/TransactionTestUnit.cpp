@@ -19,6 +19,7 @@ TransactionTestUnit::TransactionTestUnit(const std::string &name, const std::str
   add_test("complex", std::bind(&TransactionTestUnit::test_with_sub, this), "serializable with sub serializable database test");
   add_test("list", std::bind(&TransactionTestUnit::test_with_list, this), "serializable with serializable list database test");
   add_test("vector", std::bind(&TransactionTestUnit::test_with_vector, this), "serializable with serializable vector database test");
+  add_test("bulk", std::bind(&TransactionTestUnit::test_bulk, this), "bulk insert and remove database test");
 }
 
 
@@ -129,6 +130,79 @@ TransactionTestUnit::test_simple()
   session_->close();
 }
 
+void
+TransactionTestUnit::test_bulk()
+{
+  // open connection
+  session_->open();
+  // create schema
+  session_->create();
+
+  typedef object_ptr<Item> item_ptr;
+  typedef object_view<Item> item_view;
+
+  item_view view(ostore_);
+
+  transaction tr(*session_);
+  try {
+    std::vector<Item*> items;
+    for (int i = 0; i < 10; ++i) {
+      items.push_back(new Item("item", i));
+    }
+
+    tr.begin();
+
+    ostore_.insert(items.begin(), items.end());
+
+    UNIT_ASSERT_EQUAL(view.size(), (std::size_t)10, "there must be 10 items");
+
+    tr.rollback();
+
+    UNIT_ASSERT_TRUE(view.empty(), "item view must be empty");
+
+    items.clear();
+    for (int i = 0; i < 10; ++i) {
+      items.push_back(new Item("item", i));
+    }
+
+    tr.begin();
+
+    ostore_.insert(items.begin(), items.end());
+
+    tr.commit();
+
+    UNIT_ASSERT_EQUAL(view.size(), (std::size_t)10, "there must be 10 items");
+
+    tr.begin();
+
+    std::size_t count = ostore_.remove_if(view, [](const item_ptr &x) {
+      return x->get_int() < 5;
+    });
+
+    UNIT_ASSERT_EQUAL(count, (std::size_t)5, "5 items must be removed");
+    UNIT_ASSERT_EQUAL(view.size(), (std::size_t)5, "there must be 5 items");
+
+    tr.rollback();
+
+    UNIT_ASSERT_EQUAL(view.size(), (std::size_t)10, "there must be 10 items");
+
+    tr.begin();
+
+    ostore_.remove_if(view, [](const item_ptr &) { return true; });
+
+    tr.commit();
+
+    UNIT_ASSERT_TRUE(view.empty(), "item view must be empty");
+  } catch (database_exception &ex) {
+    // error, abort transaction
+    UNIT_WARN("transaction [" << tr.id() << "] rolled back: " << ex.what());
+    tr.rollback();
+  }
+  session_->drop();
+  // close db
+  session_->close();
+}
+
 void
 TransactionTestUnit::test_with_sub()
 {
@@ -39,6 +39,7 @@ public:
   void test_with_sub();
   void test_with_list();
   void test_with_vector();
+  void test_bulk();
 
 private:
   oos::session* create_session();
@@ -0,0 +1,218 @@
+#include "JsonSerializerTestUnit.hpp"
+
+#include "../Item.hpp"
+
+#include "json/json_serializer.hpp"
+#include "json/json_deserializer.hpp"
+
+#include "object/object_view.hpp"
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+using namespace oos;
+
+namespace {
+
+/*
+ * the expected json field of a time, the
+ * local hour depends on the time zone of the host
+ */
+std::string json_time(const oos::time &t)
+{
+  std::stringstream str;
+  str << std::setfill('0') << "\"val_time\":\"" << t.year() << "-" << std::setw(2) << t.month() << "-" << std::setw(2) << t.day()
+      << " " << std::setw(2) << t.hour() << ":" << std::setw(2) << t.minute() << ":" << std::setw(2) << t.second()
+      << "." << std::setw(6) << t.get_timeval().tv_usec << "\"";
+  return str.str();
+}
+
+}
+
+JsonSerializerTestUnit::JsonSerializerTestUnit()
+  : unit_test("json_serializer", "json serializer test unit")
+{
+  add_test("item", std::bind(&JsonSerializerTestUnit::item_test, this), "json serialize item test");
+  add_test("escape", std::bind(&JsonSerializerTestUnit::escape_test, this), "json serialize escape test");
+  add_test("compact", std::bind(&JsonSerializerTestUnit::compact_test, this), "json deserialize compact input test");
+  add_test("value_vector", std::bind(&JsonSerializerTestUnit::value_vector_test, this), "json value vector test");
+  add_test("view", std::bind(&JsonSerializerTestUnit::view_test, this), "json serialize object view test");
+}
+
+JsonSerializerTestUnit::~JsonSerializerTestUnit()
+{}
+
+void JsonSerializerTestUnit::initialize()
+{
+  ostore_.insert_prototype<Item>("item");
+  ostore_.insert_prototype<ObjectItem<Item> >("object_item");
+  import_.insert_prototype<Item>("item");
+  import_.insert_prototype<ObjectItem<Item> >("object_item");
+}
+
+void JsonSerializerTestUnit::finalize()
+{
+  ostore_.clear(true);
+  import_.clear(true);
+}
+
+void JsonSerializerTestUnit::item_test()
+{
+  Item item("hello world", 42);
+  item.id(7);
+  item.set_long(-1234567);
+  item.set_unsigned_long(987654321);
+  item.set_double(1.5);
+  item.set_bool(true);
+  item.set_varchar(varchar<64>("varchar"));
+  item.set_date(date(13, 5, 2015));
+  item.set_time(oos::time(2015, 5, 13, 8, 9, 10, 11));
+
+  json_serializer serializer;
+  std::string str = serializer.serialize(&item);
+
+  UNIT_ASSERT_TRUE(str.find("\"id\":7,") != std::string::npos, "id must be written");
+  UNIT_ASSERT_TRUE(str.find("\"val_string\":\"hello world\"") != std::string::npos, "string must be written");
+  UNIT_ASSERT_TRUE(str.find("\"val_date\":\"2015-05-13\"") != std::string::npos, "date must be written");
+  UNIT_ASSERT_TRUE(str.find(json_time(item.get_time())) != std::string::npos, "time must be written");
+
+  Item result;
+  json_deserializer deserializer;
+  deserializer.deserialize(&result, str);
+
+  UNIT_ASSERT_EQUAL(result.id(), 7UL, "id isn't as expected");
+  UNIT_ASSERT_EQUAL(result.get_int(), 42, "int isn't as expected");
+  UNIT_ASSERT_EQUAL(result.get_long(), -1234567L, "long isn't as expected");
+  UNIT_ASSERT_EQUAL(result.get_unsigned_long(), 987654321UL, "unsigned long isn't as expected");
+  UNIT_ASSERT_EQUAL(result.get_double(), 1.5, "double isn't as expected");
+  UNIT_ASSERT_EQUAL(result.get_float(), item.get_float(), "float isn't as expected");
+  UNIT_ASSERT_EQUAL(result.get_char(), 'c', "char isn't as expected");
+  UNIT_ASSERT_TRUE(result.get_bool(), "bool must be true");
+  UNIT_ASSERT_EQUAL(result.get_string(), "hello world", "string isn't as expected");
+  UNIT_ASSERT_EQUAL(result.get_varchar().str(), "varchar", "varchar isn't as expected");
+  UNIT_ASSERT_EQUAL(std::string(result.get_cstr()), "Hallo", "cstr isn't as expected");
+  UNIT_ASSERT_EQUAL(result.get_date(), item.get_date(), "date isn't as expected");
+  UNIT_ASSERT_EQUAL(result.get_time(), item.get_time(), "time isn't as expected");
+
+  // the buffer is reused
+  std::string again = serializer.serialize(&result);
+  UNIT_ASSERT_EQUAL(again, str, "serialized json isn't as expected");
+
+  // microseconds survive the round trip
+  struct timeval tv = item.get_time().get_timeval();
+  tv.tv_usec = 11123;
+  item.set_time(oos::time(tv));
+  str = serializer.serialize(&item);
+  UNIT_ASSERT_TRUE(str.find(json_time(item.get_time())) != std::string::npos, "microseconds must be written");
+  deserializer.deserialize(&result, str);
+  UNIT_ASSERT_EQUAL(result.get_time(), item.get_time(), "time isn't as expected");
+}
+
+void JsonSerializerTestUnit::escape_test()
+{
+  Item item("quote \" backslash \\ tab \t newline \n bell \a", 1);
+
+  json_serializer serializer;
+  std::string str = serializer.serialize(&item);
+
+  UNIT_ASSERT_TRUE(str.find("\"quote \\\" backslash \\\\ tab \\t newline \\n bell \\u0007\"") != std::string::npos, "string isn't escaped as expected");
+
+  Item result;
+  json_deserializer deserializer;
+  deserializer.deserialize(&result, str);
+
+  UNIT_ASSERT_EQUAL(result.get_string(), item.get_string(), "string isn't as expected");
+
+  // G clef, outside the basic multilingual plane
+  deserializer.deserialize(&result, "{\"val_string\":\"clef \\ud834\\udd1e\"}");
+  UNIT_ASSERT_EQUAL(result.get_string(), "clef \xf0\x9d\x84\x9e", "surrogate pair isn't decoded as expected");
+
+  UNIT_ASSERT_EXCEPTION(deserializer.deserialize(&result, "{\"val_string\":\"\\ud834 \"}"), std::logic_error, "json string contains a lone high surrogate", "lone high surrogate must fail");
+  UNIT_ASSERT_EXCEPTION(deserializer.deserialize(&result, "{\"val_string\":\"\\udd1e\"}"), std::logic_error, "json string contains a lone low surrogate", "lone low surrogate must fail");
+}
+
+void JsonSerializerTestUnit::compact_test()
+{
+  Item result;
+  json_deserializer deserializer;
+  deserializer.deserialize(&result, "{\"id\":3,\"val_int\":-8,\"val_list\":[],\"val_object\":{},\"val_string\":\"compact\"}");
+
+  UNIT_ASSERT_EQUAL(result.id(), 3UL, "id isn't as expected");
+  UNIT_ASSERT_EQUAL(result.get_int(), -8, "int isn't as expected");
+  UNIT_ASSERT_EQUAL(result.get_string(), "compact", "string isn't as expected");
+
+  UNIT_ASSERT_EXCEPTION(deserializer.deserialize(&result, "[{\"id\":3}]"), std::logic_error, "json root must be an object", "root array must fail");
+}
+
+void JsonSerializerTestUnit::value_vector_test()
+{
+  sensor s("barometer");
+  s.samples().push_back(3);
+  s.samples().push_back(-1);
+  s.samples().push_back(42);
+  s.tags().push_back("roof");
+  s.tags().push_back("it's \"calibrated\"");
+
+  json_serializer serializer;
+  std::string str = serializer.serialize(&s);
+
+  UNIT_ASSERT_TRUE(str.find("\"samples\":[3,-1,42]") != std::string::npos, "samples must be written as array");
+  UNIT_ASSERT_TRUE(str.find("\"tags\":[\"roof\",\"it's \\\"calibrated\\\"\"]") != std::string::npos, "tags must be written as array");
+
+  sensor result;
+  result.samples().push_back(7);
+  json_deserializer deserializer;
+  deserializer.deserialize(&result, str);
+
+  UNIT_ASSERT_EQUAL(result.name(), std::string("barometer"), "name isn't as expected");
+  UNIT_ASSERT_TRUE(result.samples() == s.samples(), "samples aren't as expected");
+  UNIT_ASSERT_TRUE(result.tags() == s.tags(), "tags aren't as expected");
+
+  // empty arrays, nested values are skipped
+  deserializer.deserialize(&result, "{\"name\":\"empty\",\"samples\":[],\"tags\":[\"a\",[\"b\"],{\"c\":\"d\"},\"e\"]}");
+  UNIT_ASSERT_TRUE(result.samples().empty(), "samples must be empty");
+  UNIT_ASSERT_EQUAL((int)result.tags().size(), 2, "invalid tag count");
+  UNIT_ASSERT_EQUAL(result.tags()[1], std::string("e"), "invalid tag");
+}
+
+void JsonSerializerTestUnit::view_test()
+{
+  typedef ObjectItem<Item> TestItem;
+
+  for (int i = 0; i < 10; ++i) {
+    object_ptr<Item> item = ostore_.insert(new Item("item", i));
+    TestItem *titem = new TestItem("test item", i * 2);
+    titem->ptr(item);
+    ostore_.insert(titem);
+  }
+
+  json_serializer serializer;
+  std::string items = serializer.serialize(object_view<Item>(ostore_));
+  std::string test_items = serializer.serialize(object_view<TestItem>(ostore_));
+
+  json_deserializer deserializer;
+  std::istringstream items_in(items);
+  UNIT_ASSERT_EQUAL(deserializer.deserialize<Item>(import_, items_in), (std::size_t)10, "there must be 10 items");
+
+  std::istringstream test_items_in(test_items);
+  UNIT_ASSERT_EQUAL(deserializer.deserialize<TestItem>(import_, test_items_in), (std::size_t)10, "there must be 10 test items");
+
+  object_view<TestItem> target(import_);
+
+  UNIT_ASSERT_EQUAL(target.size(), (std::size_t)10, "size of imported view must be 10");
+
+  for (object_view<TestItem>::iterator i = target.begin(); i != target.end(); ++i) {
+    object_proxy *proxy = ostore_.find_proxy((*i)->id());
+    UNIT_ASSERT_NOT_NULL(proxy, "source object must exist");
+    TestItem *source = static_cast<TestItem*>(proxy->obj());
+    UNIT_ASSERT_EQUAL(source->get_int(), (*i)->get_int(), "int isn't as expected");
+    UNIT_ASSERT_NOT_NULL((*i)->ptr().get(), "item pointer must be resolved");
+    UNIT_ASSERT_EQUAL(source->ptr().id(), (*i)->ptr().id(), "referenced item isn't as expected");
+    UNIT_ASSERT_EQUAL(source->ptr()->get_int(), (*i)->ptr()->get_int(), "referenced item isn't as expected");
+  }
+
+  // importing the same ids again must fail
+  std::istringstream again(items);
+  UNIT_ASSERT_EXCEPTION(deserializer.deserialize<Item>(import_, again), object_exception, "object with id already exists", "duplicate id must fail");
+}
@@ -0,0 +1,28 @@
+#ifndef JSONSERIALIZERTESTUNIT_HPP
+#define JSONSERIALIZERTESTUNIT_HPP
+
+#include "unit/unit_test.hpp"
+
+#include "object/object_store.hpp"
+
+class JsonSerializerTestUnit : public oos::unit_test
+{
+public:
+  JsonSerializerTestUnit();
+  virtual ~JsonSerializerTestUnit();
+
+  void item_test();
+  void escape_test();
+  void compact_test();
+  void value_vector_test();
+  void view_test();
+
+  virtual void initialize();
+  virtual void finalize();
+
+private:
+  oos::object_store ostore_;
+  oos::object_store import_;
+};
+
+#endif /* JSONSERIALIZERTESTUNIT_HPP */
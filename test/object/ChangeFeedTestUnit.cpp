@@ -0,0 +1,223 @@
+#include "ChangeFeedTestUnit.hpp"
+
+#include "../Item.hpp"
+
+#include "object/change_feed.hpp"
+#include "object/object_serializer.hpp"
+#include "object/object_view.hpp"
+
+#include "database/session.hpp"
+#include "database/transaction.hpp"
+
+#include <thread>
+
+using namespace oos;
+
+ChangeFeedTestUnit::ChangeFeedTestUnit()
+  : unit_test("feed", "change feed test unit")
+{
+  add_test("records", std::bind(&ChangeFeedTestUnit::test_records, this), "change feed records test");
+  add_test("image", std::bind(&ChangeFeedTestUnit::test_image, this), "change feed image test");
+  add_test("transaction", std::bind(&ChangeFeedTestUnit::test_transaction, this), "change feed transaction test");
+  add_test("overrun", std::bind(&ChangeFeedTestUnit::test_overrun, this), "change feed overrun test");
+  add_test("thread", std::bind(&ChangeFeedTestUnit::test_consumer_thread, this), "change feed consumer thread test");
+}
+
+ChangeFeedTestUnit::~ChangeFeedTestUnit()
+{}
+
+void ChangeFeedTestUnit::initialize()
+{
+  ostore_.insert_prototype<Item>("item");
+}
+
+void ChangeFeedTestUnit::finalize()
+{
+  ostore_.clear(true);
+}
+
+void ChangeFeedTestUnit::test_records()
+{
+  typedef object_ptr<Item> item_ptr;
+
+  change_feed feed(ostore_);
+  change_feed::cursor c = feed.current();
+  change_feed::record r;
+
+  UNIT_ASSERT_EQUAL(feed.poll(c, r), change_feed::POLL_EMPTY, "feed must be empty");
+
+  item_ptr item = ostore_.insert(new Item("item", 1));
+  item->set_int(2);
+  item->set_int(3);
+
+  // update isn't published until flush
+  UNIT_ASSERT_EQUAL(feed.sequence(), 1ULL, "only insert must be published");
+
+  feed.flush();
+
+  UNIT_ASSERT_EQUAL(feed.sequence(), 2ULL, "update must be published once");
+
+  unsigned long id = item->id();
+  ostore_.remove(item);
+
+  UNIT_ASSERT_EQUAL(feed.poll(c, r), change_feed::POLL_RECORD, "there must be a record");
+  UNIT_ASSERT_EQUAL(r.sequence, 0ULL, "invalid sequence");
+  UNIT_ASSERT_EQUAL(r.action, change_feed::ACTION_INSERT, "must be an insert record");
+  UNIT_ASSERT_EQUAL(r.id, id, "invalid id");
+  UNIT_ASSERT_EQUAL(r.type, "item", "invalid type");
+  UNIT_ASSERT_FALSE(r.has_image, "record mustn't have an image");
+
+  UNIT_ASSERT_EQUAL(feed.poll(c, r), change_feed::POLL_RECORD, "there must be a record");
+  UNIT_ASSERT_EQUAL(r.sequence, 1ULL, "invalid sequence");
+  UNIT_ASSERT_EQUAL(r.action, change_feed::ACTION_UPDATE, "must be an update record");
+
+  UNIT_ASSERT_EQUAL(feed.poll(c, r), change_feed::POLL_RECORD, "there must be a record");
+  UNIT_ASSERT_EQUAL(r.sequence, 2ULL, "invalid sequence");
+  UNIT_ASSERT_EQUAL(r.action, change_feed::ACTION_DELETE, "must be a delete record");
+  UNIT_ASSERT_EQUAL(r.id, id, "invalid id");
+
+  UNIT_ASSERT_EQUAL(feed.poll(c, r), change_feed::POLL_EMPTY, "feed must be empty");
+  UNIT_ASSERT_EQUAL(feed.lag(c), 0ULL, "lag must be zero");
+  UNIT_ASSERT_EQUAL(c.sequence(), feed.sequence(), "cursor must be up to date");
+
+  // a second consumer starts from the oldest record
+  change_feed::cursor c2 = feed.first();
+  UNIT_ASSERT_EQUAL(c2.sequence(), 0ULL, "first cursor must start with sequence 0");
+  UNIT_ASSERT_EQUAL(feed.lag(c2), 3ULL, "lag must be three records");
+}
+
+void ChangeFeedTestUnit::test_image()
+{
+  typedef object_ptr<Item> item_ptr;
+
+  change_feed feed(ostore_, 1 << 16, true);
+  change_feed::cursor c = feed.current();
+
+  item_ptr item = ostore_.insert(new Item("item", 1));
+  item->set_int(42);
+  feed.flush();
+
+  change_feed::record r;
+  UNIT_ASSERT_EQUAL(feed.poll(c, r), change_feed::POLL_RECORD, "there must be a record");
+  UNIT_ASSERT_TRUE(r.has_image, "insert record must have an image");
+  UNIT_ASSERT_EQUAL(feed.poll(c, r), change_feed::POLL_RECORD, "there must be a record");
+  UNIT_ASSERT_EQUAL(r.action, change_feed::ACTION_UPDATE, "must be an update record");
+  UNIT_ASSERT_TRUE(r.has_image, "update record must have an image");
+
+  // image contains the state after the modification
+  byte_buffer buffer;
+  buffer.append(r.image.data(), r.image.size());
+  Item copy;
+  object_serializer serializer;
+  serializer.deserialize(&copy, &buffer, &ostore_);
+
+  UNIT_ASSERT_EQUAL(copy.get_int(), 42, "image must contain the modified value");
+  UNIT_ASSERT_EQUAL(copy.get_string(), "item", "image must contain the string value");
+}
+
+void ChangeFeedTestUnit::test_transaction()
+{
+  typedef object_ptr<Item> item_ptr;
+
+  change_feed feed(ostore_);
+  change_feed::cursor c = feed.current();
+
+  session s(ostore_);
+  s.open();
+
+  item_ptr item = ostore_.insert(new Item("item", 1));
+
+  transaction tr(s);
+  tr.begin();
+  item->set_int(2);
+  UNIT_ASSERT_EQUAL(feed.sequence(), 1ULL, "update mustn't be published before commit");
+  tr.commit();
+  UNIT_ASSERT_EQUAL(feed.sequence(), 2ULL, "update must be published on commit");
+
+  // the pending update is published before the insert and again on commit
+  tr.begin();
+  item->set_int(3);
+  ostore_.insert(new Item("other", 4));
+  tr.commit();
+
+  s.close();
+
+  UNIT_ASSERT_EQUAL(feed.lag(c), 5ULL, "lag must be five records");
+
+  change_feed::action_type expected[] = {
+    change_feed::ACTION_INSERT, change_feed::ACTION_UPDATE,
+    change_feed::ACTION_UPDATE, change_feed::ACTION_INSERT, change_feed::ACTION_UPDATE
+  };
+  change_feed::record r;
+  for (std::size_t i = 0; i < 5; ++i) {
+    UNIT_ASSERT_EQUAL(feed.poll(c, r), change_feed::POLL_RECORD, "there must be a record");
+    UNIT_ASSERT_EQUAL(r.action, expected[i], "invalid record action");
+  }
+  UNIT_ASSERT_EQUAL(feed.poll(c, r), change_feed::POLL_EMPTY, "feed must be empty");
+}
+
+void ChangeFeedTestUnit::test_overrun()
+{
+  // room for a few records only
+  change_feed feed(ostore_, 256);
+  change_feed::cursor c = feed.current();
+
+  for (int i = 0; i < 100; ++i) {
+    ostore_.insert(new Item("item", i));
+  }
+
+  change_feed::record r;
+  UNIT_ASSERT_EQUAL(feed.poll(c, r), change_feed::POLL_OVERRUN, "slow consumer must be overrun");
+
+  // resync with the oldest available record
+  c = feed.first();
+  UNIT_ASSERT_GREATER(c.sequence(), 0ULL, "oldest records must be dropped");
+
+  unsigned long long expected = c.sequence();
+  while (feed.poll(c, r) == change_feed::POLL_RECORD) {
+    UNIT_ASSERT_EQUAL(r.sequence, expected++, "invalid sequence");
+  }
+  UNIT_ASSERT_EQUAL(expected, 100ULL, "all remaining records must be read");
+}
+
+void ChangeFeedTestUnit::test_consumer_thread()
+{
+  const unsigned long long count = 10000;
+
+  change_feed feed(ostore_, 1 << 22);
+  change_feed::cursor start = feed.current();
+
+  unsigned long long received = 0;
+  bool in_order = true;
+  bool overrun = false;
+
+  std::thread consumer([&]() {
+    change_feed::cursor c = start;
+    change_feed::record r;
+    unsigned long long expected = start.sequence();
+    while (received < count && !overrun) {
+      switch (feed.poll(c, r)) {
+        case change_feed::POLL_RECORD:
+          in_order = in_order && r.sequence == expected++;
+          ++received;
+          break;
+        case change_feed::POLL_OVERRUN:
+          overrun = true;
+          break;
+        default:
+          std::this_thread::yield();
+          break;
+      }
+    }
+  });
+
+  for (unsigned long long i = 0; i < count; ++i) {
+    ostore_.insert(new Item("item", (int)i));
+  }
+
+  consumer.join();
+
+  UNIT_ASSERT_FALSE(overrun, "consumer mustn't be overrun");
+  UNIT_ASSERT_EQUAL(received, count, "consumer must receive all records");
+  UNIT_ASSERT_TRUE(in_order, "records must be received in order");
+}
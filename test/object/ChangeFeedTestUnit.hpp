@@ -0,0 +1,27 @@
+#ifndef CHANGE_FEED_TEST_UNIT_HPP
+#define CHANGE_FEED_TEST_UNIT_HPP
+
+#include "unit/unit_test.hpp"
+
+#include "object/object_store.hpp"
+
+class ChangeFeedTestUnit : public oos::unit_test
+{
+public:
+  ChangeFeedTestUnit();
+  virtual ~ChangeFeedTestUnit();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void test_records();
+  void test_image();
+  void test_transaction();
+  void test_overrun();
+  void test_consumer_thread();
+
+private:
+  oos::object_store ostore_;
+};
+
+#endif /* CHANGE_FEED_TEST_UNIT_HPP */
@@ -2,8 +2,10 @@
 #include "../Item.hpp"
 
 #include "object/object_expression.hpp"
+#include "object/static_expression.hpp"
 #include "object/object_serializer.hpp"
 #include "object/object_view.hpp"
+#include "object/object_observer.hpp"
 #include "object/generic_access.hpp"
 
 #include "tools/algorithm.hpp"
@@ -23,6 +25,7 @@ ObjectStoreTestUnit::ObjectStoreTestUnit()
   add_test("version", std::bind(&ObjectStoreTestUnit::version_test, this), "test oos version");
   add_test("optr", std::bind(&ObjectStoreTestUnit::optr_test, this), "test optr behaviour");
   add_test("expression", std::bind(&ObjectStoreTestUnit::expression_test, this), "test serializable expressions");
+  add_test("static_expression", std::bind(&ObjectStoreTestUnit::static_expression_test, this), "test compile time serializable expressions");
   add_test("set", std::bind(&ObjectStoreTestUnit::set_test, this), "access serializable values via set interface");
   add_test("get", std::bind(&ObjectStoreTestUnit::get_test, this), "access serializable values via get interface");
   add_test("serializer", std::bind(&ObjectStoreTestUnit::serializer, this), "serializer test");
@@ -34,14 +37,19 @@ ObjectStoreTestUnit::ObjectStoreTestUnit()
   add_test("delete", std::bind(&ObjectStoreTestUnit::delete_object, this), "serializable deletion test");
   add_test("hierarchy", std::bind(&ObjectStoreTestUnit::hierarchy, this), "serializable hierarchy test");
   add_test("view", std::bind(&ObjectStoreTestUnit::view_test, this), "serializable view test");
+  add_test("view_order", std::bind(&ObjectStoreTestUnit::view_order_test, this), "serializable view order test");
   add_test("clear", std::bind(&ObjectStoreTestUnit::clear_test, this), "serializable store clear test");
   add_test("generic", std::bind(&ObjectStoreTestUnit::generic_test, this), "generic serializable access test");
+  add_test("field_access", std::bind(&ObjectStoreTestUnit::field_access_test, this), "generic serializable access by field test");
   add_test("structure", std::bind(&ObjectStoreTestUnit::test_structure, this), "serializable transient structure test");
   add_test("structure_cyclic", std::bind(&ObjectStoreTestUnit::test_structure_cyclic, this), "serializable transient cyclic structure test");
   add_test("structure_container", std::bind(&ObjectStoreTestUnit::test_structure_container, this), "serializable transient container structure test");
   add_test("transient_optr", std::bind(&ObjectStoreTestUnit::test_transient_optr, this), "test transient object pointer");
   add_test("insert", std::bind(&ObjectStoreTestUnit::test_insert, this), "serializable insert test");
   add_test("remove", std::bind(&ObjectStoreTestUnit::test_remove, this), "serializable remove test");
+  add_test("remove_range", std::bind(&ObjectStoreTestUnit::test_remove_range, this), "serializable batch remove test");
+  add_test("remove_if", std::bind(&ObjectStoreTestUnit::test_remove_if, this), "serializable remove if test");
+  add_test("bulk_insert", std::bind(&ObjectStoreTestUnit::test_bulk_insert, this), "serializable bulk insert test");
   add_test("pk", std::bind(&ObjectStoreTestUnit::test_primary_key, this), "serializable proxy primary key test");
 //  add_test("to_many", std::bind(&ObjectStoreTestUnit::test_to_many, this), "to many test");
 }
@@ -177,6 +185,55 @@ ObjectStoreTestUnit::expression_test()
   UNIT_ASSERT_EQUAL((*j)->get_string(), "ObjectItem", "couldn't find item 'ObjectItem'");
 }
 
+void
+ObjectStoreTestUnit::static_expression_test()
+{
+  typedef ObjectItem<Item> object_item;
+  typedef object_ptr<object_item> object_item_ptr;
+
+  for (int i = 0; i < 10; ++i) {
+    object_item_ptr oi = ostore_.insert(new object_item("ObjectItem", i));
+    oi->ptr(ostore_.insert(new Item("Item", i * 10)));
+  }
+
+  auto x = make_static_var(&object_item::get_int);
+  auto y = make_static_var(&object_item::get_string);
+  auto z = make_static_var(&object_item::ptr, &Item::get_int);
+
+  object_view<object_item> oview(ostore_);
+
+  int count(0);
+  for_each_if(oview.begin(), oview.end(), x >= 3 && x <= 7 && x != 5, item_counter(count));
+  UNIT_ASSERT_EQUAL(count, 4, "invalid number of objects found");
+
+  count = 0;
+  for_each_if(oview.begin(), oview.end(), 6 > x, item_counter(count));
+  UNIT_ASSERT_EQUAL(count, 6, "invalid number of objects found");
+
+  object_view<object_item>::iterator j = std::find_if(oview.begin(), oview.end(), x == 6);
+  UNIT_ASSERT_EQUAL((*j)->get_int(), 6, "couldn't find item 6");
+
+  // the constant is converted into the value type
+  j = std::find_if(oview.begin(), oview.end(), (x > 6) && (y == "ObjectItem"));
+  UNIT_ASSERT_EQUAL((*j)->get_int(), 7, "couldn't find item 7");
+
+  j = std::find_if(oview.begin(), oview.end(), y == "Simple");
+  UNIT_ASSERT_TRUE(j == oview.end(), "iterator must be end");
+
+  j = std::find_if(oview.begin(), oview.end(), z == 40);
+  UNIT_ASSERT_EQUAL((*j)->get_int(), 4, "couldn't find item 4 by nested value");
+
+  count = 0;
+  for_each_if(oview.begin(), oview.end(), !(z < 80), item_counter(count));
+  UNIT_ASSERT_EQUAL(count, 2, "invalid number of objects found by nested value");
+
+  // static and runtime variables can be mixed
+  variable<int> v(make_var(&object_item::get_int));
+  count = 0;
+  for_each_if(oview.begin(), oview.end(), (x > 2 && v < 5) || (z >= 90 && v == 9), item_counter(count));
+  UNIT_ASSERT_EQUAL(count, 3, "invalid number of mixed objects found");
+}
+
 void
 ObjectStoreTestUnit::serializer()
 {  
@@ -589,6 +646,83 @@ ObjectStoreTestUnit::view_test()
   UNIT_ASSERT_GREATER(item->id(), 0UL, "invalid item");
 }
 
+namespace {
+
+template < class View >
+std::string view_names(const View &view)
+{
+  std::string names;
+  for (typename View::const_iterator i = view.begin(); i != view.end(); ++i) {
+    names += (*i)->name();
+  }
+  return names;
+}
+
+template < class View >
+std::string reverse_view_names(const View &view)
+{
+  std::string names;
+  typename View::const_iterator first = view.begin();
+  typename View::const_iterator i = view.end();
+  while (i != first) {
+    --i;
+    names += (*i)->name();
+  }
+  return names;
+}
+
+}
+
+void
+ObjectStoreTestUnit::view_order_test()
+{
+  typedef object_ptr<person> person_ptr;
+  typedef object_view<person> person_view_t;
+
+  person_ptr a = ostore_.insert(new person("a"));
+  ostore_.insert(new person("b"));
+  ostore_.insert(new employee("x"));
+  ostore_.insert(new person("c"));
+  object_ptr<employee> y = ostore_.insert(new employee("y"));
+
+  person_view_t pview(ostore_);
+  person_view_t own_view(ostore_, true);
+
+  // own objects in list order (the first one last), then the objects of the child types
+  UNIT_ASSERT_EQUAL(view_names(pview), "bcayx", "invalid view order");
+  UNIT_ASSERT_EQUAL(reverse_view_names(pview), "xyacb", "invalid reverse view order");
+  UNIT_ASSERT_EQUAL(view_names(own_view), "bca", "invalid view order");
+  UNIT_ASSERT_EQUAL(reverse_view_names(own_view), "acb", "invalid reverse view order");
+  UNIT_ASSERT_EQUAL(pview.back()->name(), "x", "invalid last object");
+  UNIT_ASSERT_EQUAL(own_view.back()->name(), "a", "invalid last object");
+
+  // removing an object keeps the order of the others
+  ostore_.remove(a);
+
+  UNIT_ASSERT_EQUAL(view_names(pview), "bcyx", "invalid view order");
+  UNIT_ASSERT_EQUAL(reverse_view_names(pview), "xycb", "invalid reverse view order");
+  UNIT_ASSERT_EQUAL(own_view.back()->name(), "c", "invalid last object");
+
+  ostore_.insert(new person("d"));
+
+  UNIT_ASSERT_EQUAL(view_names(pview), "bdcyx", "invalid view order");
+
+  ostore_.remove(y);
+
+  UNIT_ASSERT_EQUAL(view_names(pview), "bdcx", "invalid view order");
+
+  // an empty type node is skipped
+  while (!own_view.empty()) {
+    person_ptr p = own_view.front();
+    ostore_.remove(p);
+  }
+
+  UNIT_ASSERT_TRUE(own_view.begin() == own_view.end(), "view must be empty");
+  UNIT_ASSERT_EQUAL(view_names(pview), "x", "invalid view order");
+  UNIT_ASSERT_EQUAL(reverse_view_names(pview), "x", "invalid reverse view order");
+  UNIT_ASSERT_EQUAL((int)pview.size(), 1, "invalid view size");
+}
+
 void
 ObjectStoreTestUnit::clear_test()
 {
@@ -768,6 +902,60 @@ ObjectStoreTestUnit::generic_test()
   UNIT_ASSERT_EQUAL(timeval.result, timeval.expected, "not expected result value");
 }
 
+void
+ObjectStoreTestUnit::field_access_test()
+{
+  prototype_iterator node = ostore_.find_prototype<Item>();
+  const oos::field_table &fields = node->fields;
+
+  UNIT_ASSERT_EQUAL(fields.size(), 16UL, "invalid number of fields");
+  UNIT_ASSERT_EQUAL(fields[0].name, "id", "invalid field name");
+  UNIT_ASSERT_EQUAL(fields.index("val_int"), 5UL, "invalid field index");
+  UNIT_ASSERT_EQUAL(fields.index("unknown"), oos::field_table::npos, "field must not be found");
+  UNIT_ASSERT_NULL(fields.find("unknown"), "field must not be found");
+
+  const oos::field_descriptor *val_int = fields.find("val_int");
+  UNIT_ASSERT_NOT_NULL(val_int, "field must be found");
+  UNIT_ASSERT_TRUE(val_int->type == oos::type_int, "invalid field type");
+  UNIT_ASSERT_TRUE(val_int->direct(), "field must be accessed directly");
+  UNIT_ASSERT_TRUE(fields.find("val_varchar")->type == oos::type_varchar, "invalid field type");
+  UNIT_ASSERT_FALSE(fields.find("val_cstr")->direct(), "field must be accessed by name");
+
+  std::unique_ptr<Item> item(new Item("Item", 42));
+
+  int ival = 0;
+  UNIT_ASSERT_TRUE(oos::get(item, *val_int, ival), "get must succeed");
+  UNIT_ASSERT_EQUAL(ival, 42, "not expected result value");
+
+  UNIT_ASSERT_TRUE(oos::set(item, *val_int, -98765), "set must succeed");
+  UNIT_ASSERT_EQUAL(item->get_int(), -98765, "not expected result value");
+
+  // a value of another type is converted by name
+  std::string str;
+  UNIT_ASSERT_TRUE(oos::get(item, *val_int, str), "get must succeed");
+  UNIT_ASSERT_EQUAL(str, "-98765", "not expected result value");
+
+  UNIT_ASSERT_TRUE(oos::set(item, fields[fields.index("val_string")], std::string("Hallo Welt")), "set must succeed");
+  UNIT_ASSERT_EQUAL(item->get_string(), "Hallo Welt", "not expected result value");
+
+  UNIT_ASSERT_TRUE(oos::set(item, *fields.find("val_varchar"), std::string("The answer is 42")), "set must succeed");
+  UNIT_ASSERT_TRUE(oos::get(item, *fields.find("val_varchar"), str), "get must succeed");
+  UNIT_ASSERT_EQUAL(str, "The answer is 42", "not expected result value");
+
+  oos::date d("29.4.1972");
+  oos::date dresult;
+  UNIT_ASSERT_TRUE(oos::set(item, *fields.find("val_date"), d), "set must succeed");
+  UNIT_ASSERT_TRUE(oos::get(item, *fields.find("val_date"), dresult), "get must succeed");
+  UNIT_ASSERT_EQUAL(dresult, d, "not expected result value");
+
+  // the primary key is accessed through its identifier
+  typedef object_ptr<Item> item_ptr;
+  item_ptr optr = ostore_.insert(item.release());
+  unsigned long id = 0;
+  UNIT_ASSERT_TRUE(oos::get(optr, fields[0], id), "get must succeed");
+  UNIT_ASSERT_EQUAL(id, optr->id(), "not expected result value");
+}
+
 void ObjectStoreTestUnit::test_structure()
 {
   typedef ObjectItem<Item> object_item_t;
@@ -894,6 +1082,150 @@ void ObjectStoreTestUnit::test_remove()
   UNIT_ASSERT_EXCEPTION(ostore_.remove(item), object_exception, "prototype node is nullptr", "transient serializable shouldn't be removable");
 }
 
+struct delete_counter : public object_observer
+{
+  virtual void on_insert(object_proxy *) {}
+  virtual void on_update(object_proxy *) {}
+  virtual void on_delete(object_proxy *) { ++single; }
+  virtual void on_bulk_delete(const std::vector<object_proxy*> &proxies)
+  {
+    ++bulk;
+    deleted += proxies.size();
+  }
+
+  int single = 0;
+  int bulk = 0;
+  std::size_t deleted = 0;
+};
+
+struct insert_counter : public object_observer
+{
+  virtual void on_insert(object_proxy *) { ++single; }
+  virtual void on_update(object_proxy *) {}
+  virtual void on_delete(object_proxy *) {}
+  virtual void on_bulk_insert(const std::vector<object_proxy*> &proxies)
+  {
+    ++bulk;
+    inserted += proxies.size();
+  }
+
+  int single = 0;
+  int bulk = 0;
+  std::size_t inserted = 0;
+};
+
+void ObjectStoreTestUnit::test_remove_range()
+{
+  typedef ObjectItem<Item> TestItem;
+  typedef object_ptr<Item> item_ptr;
+
+  std::vector<item_ptr> items;
+  std::vector<item_ptr> all;
+
+  for (int i = 0; i < 10; ++i) {
+    item_ptr item = ostore_.insert(new Item("item", i));
+    TestItem *ti = new TestItem("test item", i);
+    ti->ref(item);
+    item_ptr testitem = ostore_.insert<Item>(ti);
+    items.push_back(item);
+    all.push_back(item);
+    all.push_back(testitem);
+  }
+
+  // items are still referenced by the test items
+  UNIT_ASSERT_EXCEPTION(ostore_.remove(items.begin(), items.end()), object_exception, "serializable is not removable", "items shouldn't be removable");
+
+  object_view<Item> item_view(ostore_);
+  object_view<TestItem> test_item_view(ostore_);
+  UNIT_ASSERT_EQUAL(item_view.size(), (std::size_t)10, "no item must be removed");
+  UNIT_ASSERT_EQUAL(test_item_view.size(), (std::size_t)10, "no test item must be removed");
+
+  delete_counter counter;
+  ostore_.register_observer(&counter);
+
+  // referencing test items are part of the batch
+  ostore_.remove(all.begin(), all.end());
+
+  ostore_.unregister_observer(&counter);
+
+  UNIT_ASSERT_TRUE(item_view.empty(), "all items must be removed");
+  UNIT_ASSERT_TRUE(test_item_view.empty(), "all test items must be removed");
+  UNIT_ASSERT_EQUAL(counter.bulk, 1, "observer must be notified once");
+  UNIT_ASSERT_EQUAL(counter.single, 0, "observer mustn't be notified for each object");
+  UNIT_ASSERT_EQUAL(counter.deleted, (std::size_t)20, "observer must be notified for 20 objects");
+}
+
+void ObjectStoreTestUnit::test_remove_if()
+{
+  typedef ObjectItem<Item> TestItem;
+  typedef object_ptr<TestItem> test_item_ptr;
+  typedef object_ptr<Item> item_ptr;
+
+  for (int i = 0; i < 10; ++i) {
+    item_ptr item = ostore_.insert(new Item("item", i));
+    TestItem *ti = new TestItem("test item", i);
+    ti->ptr(item);
+    ostore_.insert(ti);
+  }
+
+  typedef object_view<TestItem> test_item_view_t;
+  test_item_view_t test_item_view(ostore_);
+
+  std::size_t count = ostore_.remove_if(test_item_view, [](const test_item_ptr &x) {
+    return x->get_int() % 2 == 0;
+  });
+
+  // the count includes the pointed items
+  UNIT_ASSERT_EQUAL(count, (std::size_t)10, "5 test items and 5 items must be removed");
+  UNIT_ASSERT_EQUAL(test_item_view.size(), (std::size_t)5, "5 test items must be left");
+
+  // pointed items are removed with their test items
+  object_view<Item> item_view(ostore_);
+  UNIT_ASSERT_EQUAL(item_view.size(), (std::size_t)5, "5 items must be left");
+
+  for (test_item_view_t::iterator i = test_item_view.begin(); i != test_item_view.end(); ++i) {
+    UNIT_ASSERT_EQUAL((*i)->get_int() % 2, 1, "only odd test items must be left");
+  }
+}
+
+void ObjectStoreTestUnit::test_bulk_insert()
+{
+  typedef ObjectItem<Item> TestItem;
+
+  std::vector<Item*> items;
+  for (int i = 0; i < 10; ++i) {
+    items.push_back(new Item("item", i));
+    items.push_back(new TestItem("test item", i));
+  }
+
+  insert_counter counter;
+  ostore_.register_observer(&counter);
+
+  ostore_.insert(items.begin(), items.end());
+
+  ostore_.unregister_observer(&counter);
+
+  UNIT_ASSERT_EQUAL(counter.bulk, 1, "observer must be notified once");
+  UNIT_ASSERT_EQUAL(counter.single, 0, "observer mustn't be notified for each object");
+  UNIT_ASSERT_EQUAL(counter.inserted, (std::size_t)20, "observer must be notified for 20 objects");
+
+  object_view<Item> item_view(ostore_);
+  object_view<TestItem> test_item_view(ostore_);
+
+  UNIT_ASSERT_EQUAL(item_view.size(), (std::size_t)10, "there must be 10 items");
+  UNIT_ASSERT_EQUAL(test_item_view.size(), (std::size_t)10, "there must be 10 test items");
+
+  for (std::vector<Item*>::iterator i = items.begin(); i != items.end(); ++i) {
+    UNIT_ASSERT_GREATER((*i)->id(), 0UL, "id must be greater zero");
+    object_proxy *proxy = ostore_.find_proxy((*i)->id());
+    UNIT_ASSERT_NOT_NULL(proxy, "proxy must be found");
+    UNIT_ASSERT_TRUE(proxy->obj() == *i, "proxy must hold the inserted item");
+  }
+
+  std::vector<Item*> invalid(1, nullptr);
+  UNIT_ASSERT_EXCEPTION(ostore_.insert(invalid.begin(), invalid.end()), object_exception, "serializable is null", "null shouldn't be insertable");
+}
+
 void ObjectStoreTestUnit::test_primary_key()
 {
   typedef object_ptr<Item> item_ptr;
@@ -20,6 +20,7 @@ public:
   void version_test();
   void optr_test();
   void expression_test();
+  void static_expression_test();
   void set_test();
   void get_test();
   void serializer();
@@ -31,14 +32,19 @@ public:
   void delete_object();
   void hierarchy();
   void view_test();
+  void view_order_test();
   void clear_test();
   void generic_test();
+  void field_access_test();
   void test_structure();
   void test_structure_cyclic();
   void test_structure_container();
   void test_transient_optr();
   void test_insert();
   void test_remove();
+  void test_remove_range();
+  void test_remove_if();
+  void test_bulk_insert();
   void test_primary_key();
   void test_to_many();
 
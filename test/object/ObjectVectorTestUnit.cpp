@@ -5,9 +5,17 @@
 #include "object/object_vector.hpp"
 #include "object/object_view.hpp"
 #include "object/generic_access.hpp"
+#include "object/object_observer.hpp"
+#include "object/object_serializer.hpp"
+#include "object/object_exception.hpp"
+#include "object/value_vector.hpp"
+
+#include "tools/byte_buffer.hpp"
 
 #include <iostream>
 #include <fstream>
+#include <unordered_set>
+#include <limits>
 
 using namespace oos;
 using namespace std;
@@ -19,6 +27,9 @@ ObjectVectorTestUnit::ObjectVectorTestUnit()
   add_test("ptr", std::bind(&ObjectVectorTestUnit::test_ptr_vector, this), "test serializable vector with pointers");
   add_test("ref", std::bind(&ObjectVectorTestUnit::test_ref_vector, this), "test serializable vector with references");
   add_test("direct_ref", std::bind(&ObjectVectorTestUnit::test_direct_ref_vector, this), "test direct serializable vector with references");
+  add_test("gapped", std::bind(&ObjectVectorTestUnit::test_gapped_vector, this), "test serializable vector with gapped ordering");
+  add_test("value", std::bind(&ObjectVectorTestUnit::test_value_vector, this), "test value vector inside its owner");
+  add_test("value_codec", std::bind(&ObjectVectorTestUnit::test_value_vector_codec, this), "test value vector encoding");
 }
 
 ObjectVectorTestUnit::~ObjectVectorTestUnit()
@@ -32,6 +43,8 @@ void ObjectVectorTestUnit::initialize()
   ostore_.insert_prototype(new vector_object_producer<IntVector>("int_vector"), "item_int_vector");
   ostore_.insert_prototype<album>("album");
   ostore_.insert_prototype<track>("track");
+  ostore_.insert_prototype<chart>("chart");
+  ostore_.insert_prototype<sensor>("sensor");
 }
 
 void ObjectVectorTestUnit::finalize()
@@ -228,3 +241,189 @@ void ObjectVectorTestUnit::test_direct_ref_vector()
 
 //  std::for_each(alb1->begin(), alb1->end(), print_track);
 }
+
+struct item_update_counter : public object_observer
+{
+  virtual void on_insert(object_proxy *) {}
+  virtual void on_update(object_proxy *proxy)
+  {
+    if (dynamic_cast<chart::item_type*>(proxy->obj())) {
+      proxies.insert(proxy);
+    }
+  }
+  virtual void on_delete(object_proxy *) {}
+
+  std::size_t reset()
+  {
+    std::size_t count = proxies.size();
+    proxies.clear();
+    return count;
+  }
+
+  std::unordered_set<object_proxy*> proxies;
+};
+
+void ObjectVectorTestUnit::test_gapped_vector()
+{
+  typedef object_ptr<chart> chart_ptr;
+  typedef object_ptr<track> track_ptr;
+
+  chart_ptr c = ostore_.insert(new chart("Top"));
+
+  UNIT_ASSERT_EQUAL(c->begin() == c->end(), true, "chart must be empty");
+
+  item_update_counter counter;
+  ostore_.register_observer(&counter);
+
+  // insert each track at the front
+  const int count = 2000;
+  std::size_t modified = 0;
+  for (int i = 0; i < count; ++i) {
+    stringstream name;
+    name << "Track " << i;
+    track_ptr trk = ostore_.insert(new track(name.str()));
+    c->insert(c->begin(), trk);
+    modified += counter.reset();
+  }
+
+  UNIT_ASSERT_EQUAL((int)c->size(), count, "invalid chart size");
+  // dense ordering would modify count * (count - 1) / 2 items
+  UNIT_ASSERT_LESS(modified, (std::size_t)count * 10, "too many modified items");
+
+  // order and keys must be ascending
+  int n = count;
+  unsigned long last_key = 0;
+  for (chart::iterator i = c->begin(); i != c->end(); ++i) {
+    stringstream name;
+    name << "Track " << --n;
+    UNIT_ASSERT_EQUAL((*i)->value()->title(), name.str(), "invalid track order");
+    if (i != c->begin()) {
+      UNIT_ASSERT_GREATER((unsigned long)(*i)->index(), last_key, "keys must be ascending");
+    }
+    last_key = (*i)->index();
+  }
+
+  // erasing doesn't touch any other item
+  counter.reset();
+  chart::iterator i = c->erase(c->begin() + count / 2);
+  UNIT_ASSERT_EQUAL(counter.reset(), (std::size_t)0, "no item must be modified on erase");
+
+  // inserting into the middle takes a free key
+  track_ptr trk = ostore_.insert(new track("Middle"));
+  unsigned long prev_key = (*(i - 1))->index();
+  unsigned long next_key = (*i)->index();
+  counter.reset();
+  i = c->insert(i, trk);
+  UNIT_ASSERT_LESS(counter.reset(), (std::size_t)2, "only the new item may be modified");
+  UNIT_ASSERT_EQUAL((*i)->value()->title(), "Middle", "invalid track");
+  UNIT_ASSERT_GREATER((unsigned long)(*i)->index(), prev_key, "key must be greater than predecessor key");
+  UNIT_ASSERT_LESS((unsigned long)(*i)->index(), next_key, "key must be less than successor key");
+
+  ostore_.unregister_observer(&counter);
+}
+
+void ObjectVectorTestUnit::test_value_vector()
+{
+  typedef object_ptr<sensor> sensor_ptr;
+
+  sensor_ptr s = ostore_.insert(new sensor("thermometer"));
+
+  for (int i = 0; i < 1000; ++i) {
+    s->samples().push_back(i);
+  }
+  s->tags().push_back("outdoor");
+  s->tags().push_back("with \"quotes\", commas and \\ backslash");
+  s->tags().push_back("line\nbreak\ttab\x01");
+  s->tags().push_back("");
+
+  UNIT_ASSERT_EQUAL(s->samples().size(), (sensor::sample_vector_t::size_type)1000, "invalid sample count");
+
+  s->samples().erase(s->samples().begin());
+  s->samples().insert(s->samples().begin() + 10, -7);
+  UNIT_ASSERT_EQUAL(s->samples().front(), 1, "invalid first sample");
+  UNIT_ASSERT_EQUAL(s->samples()[10], -7, "invalid inserted sample");
+
+  // the elements don't create any item prototype or object
+  prototype_iterator node = ostore_.find_prototype<sensor>();
+  UNIT_ASSERT_TRUE(node != ostore_.end(), "couldn't find sensor prototype");
+  UNIT_ASSERT_TRUE(node->relations.empty(), "sensor prototype must not have relations");
+  UNIT_ASSERT_EQUAL(node->size(), 1UL, "there must be exactly one sensor object");
+
+  object_serializer serializer;
+  byte_buffer buffer;
+  serializer.serialize(s.get(), &buffer);
+
+  sensor restored;
+  serializer.deserialize(&restored, &buffer, &ostore_);
+
+  UNIT_ASSERT_EQUAL(restored.name(), std::string("thermometer"), "invalid restored name");
+  UNIT_ASSERT_TRUE(restored.samples() == s->samples(), "restored samples differ");
+  UNIT_ASSERT_TRUE(restored.tags() == s->tags(), "restored tags differ");
+
+  s->samples().clear();
+  s->tags().clear();
+  serializer.serialize(s.get(), &buffer);
+  serializer.deserialize(&restored, &buffer, &ostore_);
+  UNIT_ASSERT_TRUE(restored.samples().empty(), "restored samples must be empty");
+  UNIT_ASSERT_TRUE(restored.tags().empty(), "restored tags must be empty");
+}
+
+namespace {
+
+template < class T >
+std::string encode(const value_vector<T> &x)
+{
+  std::string buf;
+  x.encode(buf);
+  return buf;
+}
+
+template < class T >
+void decode(const std::string &str, value_vector<T> &x)
+{
+  x.decode(str);
+}
+
+}
+
+void ObjectVectorTestUnit::test_value_vector_codec()
+{
+  value_vector<long long> longs = { 0, -1, 42, std::numeric_limits<long long>::min(), std::numeric_limits<long long>::max() };
+  UNIT_ASSERT_EQUAL(encode(longs), std::string("[0,-1,42,-9223372036854775808,9223372036854775807]"), "invalid long long encoding");
+  value_vector<long long> restored_longs;
+  decode(encode(longs), restored_longs);
+  UNIT_ASSERT_TRUE(restored_longs == longs, "restored longs differ");
+
+  value_vector<unsigned long> ulongs = { 0, std::numeric_limits<unsigned long>::max() };
+  value_vector<unsigned long> restored_ulongs;
+  decode(encode(ulongs), restored_ulongs);
+  UNIT_ASSERT_TRUE(restored_ulongs == ulongs, "restored unsigned longs differ");
+
+  value_vector<double> doubles = { 0.1, -1.5e300, 3.0 };
+  value_vector<double> restored_doubles;
+  decode(encode(doubles), restored_doubles);
+  UNIT_ASSERT_TRUE(restored_doubles == doubles, "restored doubles differ");
+
+  value_vector<bool> bools = { true, false, true };
+  UNIT_ASSERT_EQUAL(encode(bools), std::string("[true,false,true]"), "invalid bool encoding");
+  value_vector<bool> restored_bools;
+  decode(encode(bools), restored_bools);
+  UNIT_ASSERT_TRUE(restored_bools == bools, "restored bools differ");
+
+  value_vector<varchar<16> > names = { varchar<16>("alpha"), varchar<16>("be\"ta") };
+  UNIT_ASSERT_EQUAL(encode(names), std::string("[\"alpha\",\"be\\\"ta\"]"), "invalid varchar encoding");
+  value_vector<varchar<16> > restored_names;
+  decode(encode(names), restored_names);
+  UNIT_ASSERT_EQUAL(restored_names.size(), (std::size_t)2, "invalid restored varchar count");
+  UNIT_ASSERT_EQUAL(restored_names[1].str(), std::string("be\"ta"), "invalid restored varchar");
+
+  // an unset field is an empty vector
+  decode("", restored_longs);
+  UNIT_ASSERT_TRUE(restored_longs.empty(), "restored longs must be empty");
+  decode(" [ 1 , 2 ] ", restored_longs);
+  UNIT_ASSERT_EQUAL(restored_longs.size(), (std::size_t)2, "invalid restored long count");
+
+  UNIT_ASSERT_EXCEPTION(decode("[1", restored_longs), object_exception, "value_vector: unexpected end of data", "incomplete data must throw");
+  UNIT_ASSERT_EXCEPTION(decode("[1;2]", restored_longs), object_exception, "value_vector: expected ','", "invalid separator must throw");
+  UNIT_ASSERT_EXCEPTION(decode("[\"a]", restored_names), object_exception, "value_vector: unterminated string", "unterminated string must throw");
+}
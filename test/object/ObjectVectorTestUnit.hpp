@@ -19,6 +19,9 @@ public:
   void test_ptr_vector();
 
   void test_direct_ref_vector();
+  void test_gapped_vector();
+  void test_value_vector();
+  void test_value_vector_codec();
 
 private:
   oos::object_store ostore_;
@@ -0,0 +1,214 @@
+#include "ParallelTestUnit.hpp"
+
+#include "../Item.hpp"
+
+#include "object/parallel_algorithm.hpp"
+#include "object/static_expression.hpp"
+
+#include "tools/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace oos;
+
+ParallelTestUnit::ParallelTestUnit()
+  : unit_test("parallel", "parallel algorithm test unit")
+{
+  add_test("pool", std::bind(&ParallelTestUnit::test_pool, this), "thread pool test");
+  add_test("pool_exception", std::bind(&ParallelTestUnit::test_pool_exception, this), "thread pool exception test");
+  add_test("for_each", std::bind(&ParallelTestUnit::test_for_each, this), "parallel for each test");
+  add_test("count_if", std::bind(&ParallelTestUnit::test_count_if, this), "parallel count if test");
+  add_test("find_any", std::bind(&ParallelTestUnit::test_find_any, this), "parallel find any test");
+  add_test("transform_reduce", std::bind(&ParallelTestUnit::test_transform_reduce, this), "parallel transform reduce test");
+}
+
+ParallelTestUnit::~ParallelTestUnit()
+{}
+
+void ParallelTestUnit::initialize()
+{
+  ostore_.insert_prototype<Item>("item");
+  ostore_.insert_prototype<ObjectItem<Item> >("object_item");
+
+  for (int i = 0; i < 10000; ++i) {
+    ostore_.insert(new Item("item", i));
+  }
+}
+
+void ParallelTestUnit::finalize()
+{
+  ostore_.clear(true);
+}
+
+void ParallelTestUnit::test_pool()
+{
+  thread_pool pool(3);
+
+  UNIT_ASSERT_EQUAL(pool.size(), 3UL, "pool must have three threads");
+
+  std::vector<int> calls(100, 0);
+  pool.run(calls.size(), [&](std::size_t i) {
+    ++calls[i];
+  });
+
+  for (std::size_t i = 0; i < calls.size(); ++i) {
+    UNIT_ASSERT_EQUAL(calls[i], 1, "each task must be called once");
+  }
+
+  // run may be called from within a task
+  std::atomic<int> count(0);
+  pool.run(8, [&](std::size_t) {
+    pool.run(8, [&](std::size_t) {
+      ++count;
+    });
+  });
+
+  UNIT_ASSERT_EQUAL(count.load(), 64, "all nested tasks must be called");
+
+  // a pool without threads runs in the calling thread
+  thread_pool empty(0);
+  count = 0;
+  empty.run(10, [&](std::size_t) {
+    ++count;
+  });
+
+  UNIT_ASSERT_EQUAL(count.load(), 10, "all tasks must be called");
+}
+
+void ParallelTestUnit::test_pool_exception()
+{
+  thread_pool pool(2);
+
+  std::atomic<int> count(0);
+  bool caught = false;
+  try {
+    pool.run(20, [&](std::size_t i) {
+      ++count;
+      if (i == 7) {
+        throw std::runtime_error("task failed");
+      }
+    });
+  } catch (std::runtime_error &) {
+    caught = true;
+  }
+
+  UNIT_ASSERT_TRUE(caught, "exception must be rethrown");
+  UNIT_ASSERT_EQUAL(count.load(), 20, "remaining tasks must be called");
+
+  // pool is still usable
+  count = 0;
+  pool.run(5, [&](std::size_t) {
+    ++count;
+  });
+
+  UNIT_ASSERT_EQUAL(count.load(), 5, "all tasks must be called");
+}
+
+void ParallelTestUnit::test_for_each()
+{
+  thread_pool pool(3);
+  object_view<Item> view(ostore_);
+
+  std::atomic<long long> sum(0);
+  std::atomic<int> count(0);
+  parallel_for_each(view, [&](const Item &item) {
+    sum += item.get_int();
+    ++count;
+  }, pool, 100);
+
+  UNIT_ASSERT_EQUAL(count.load(), 10000, "each item must be visited once");
+  UNIT_ASSERT_EQUAL(sum.load(), 49995000LL, "invalid sum");
+
+  // empty view
+  object_view<ObjectItem<Item> > empty(ostore_);
+  count = 0;
+  parallel_for_each(empty, [&](const ObjectItem<Item> &) {
+    ++count;
+  }, pool);
+
+  UNIT_ASSERT_EQUAL(count.load(), 0, "no item must be visited");
+}
+
+void ParallelTestUnit::test_count_if()
+{
+  thread_pool pool(3);
+  object_view<Item> view(ostore_);
+
+  std::size_t count = parallel_count_if(view, [](const Item &item) {
+    return item.get_int() % 3 == 0;
+  }, pool, 100);
+
+  UNIT_ASSERT_EQUAL(count, 3334UL, "invalid number of items");
+
+  auto x = make_static_var(&Item::get_int);
+
+  count = parallel_count_if(view, x >= 5000 && x < 5100, pool, 100);
+
+  UNIT_ASSERT_EQUAL(count, 100UL, "invalid number of items");
+
+  // default pool and grain
+  count = parallel_count_if(view, x < 10);
+
+  UNIT_ASSERT_EQUAL(count, 10UL, "invalid number of items");
+}
+
+void ParallelTestUnit::test_find_any()
+{
+  thread_pool pool(3);
+  object_view<Item> view(ostore_);
+
+  auto x = make_static_var(&Item::get_int);
+
+  object_ptr<Item> item = parallel_find_any(view, x == 7777, pool, 100);
+
+  UNIT_ASSERT_FALSE(item.ptr() == nullptr, "item must be found");
+  UNIT_ASSERT_EQUAL(item->get_int(), 7777, "invalid item");
+
+  item = parallel_find_any(view, x > 100 && x < 200, pool, 100);
+
+  UNIT_ASSERT_FALSE(item.ptr() == nullptr, "item must be found");
+  UNIT_ASSERT_TRUE(item->get_int() > 100 && item->get_int() < 200, "invalid item");
+
+  item = parallel_find_any(view, x < 0, pool, 100);
+
+  UNIT_ASSERT_TRUE(item.ptr() == nullptr, "item must not be found");
+}
+
+void ParallelTestUnit::test_transform_reduce()
+{
+  thread_pool pool(3);
+  object_view<Item> view(ostore_);
+
+  long long sequential = 0;
+  int max = 0;
+  for (object_view<Item>::const_iterator i = view.begin(); i != view.end(); ++i) {
+    sequential += (*i)->get_int() * 2;
+    max = std::max(max, (*i)->get_int());
+  }
+
+  long long sum = parallel_transform_reduce(view, 0LL, [](long long a, long long b) {
+    return a + b;
+  }, [](const Item &item) {
+    return (long long)item.get_int() * 2;
+  }, pool, 100);
+
+  UNIT_ASSERT_EQUAL(sum, sequential, "parallel and sequential sum must be equal");
+
+  int pmax = parallel_transform_reduce(view, 0, [](int a, int b) {
+    return std::max(a, b);
+  }, make_static_var(&Item::get_int), pool, 100);
+
+  UNIT_ASSERT_EQUAL(pmax, max, "invalid maximum");
+
+  // reduction isn't commutative, chunks are reduced in view order
+  std::string names = parallel_transform_reduce(view, std::string(), [](const std::string &a, const std::string &b) {
+    return a + b;
+  }, [](const Item &item) {
+    return std::string(item.get_int() < 3 ? "x" : "");
+  }, pool, 100);
+
+  UNIT_ASSERT_EQUAL(names, "xxx", "invalid concatenation");
+}
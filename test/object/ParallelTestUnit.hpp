@@ -0,0 +1,28 @@
+#ifndef PARALLEL_TEST_UNIT_HPP
+#define PARALLEL_TEST_UNIT_HPP
+
+#include "unit/unit_test.hpp"
+
+#include "object/object_store.hpp"
+
+class ParallelTestUnit : public oos::unit_test
+{
+public:
+  ParallelTestUnit();
+  virtual ~ParallelTestUnit();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void test_pool();
+  void test_pool_exception();
+  void test_for_each();
+  void test_count_if();
+  void test_find_any();
+  void test_transform_reduce();
+
+private:
+  oos::object_store ostore_;
+};
+
+#endif /* PARALLEL_TEST_UNIT_HPP */
@@ -5,14 +5,18 @@
 #include "PrimaryKeyUnitTest.hpp"
 
 #include "object/identifier.hpp"
+#include "object/pk_index.hpp"
 
 #include <memory>
+#include <vector>
 
 PrimaryKeyUnitTest::PrimaryKeyUnitTest()
   : unit_test("pk", "Primary Key Unit Test")
 {
   add_test("create", std::bind(&PrimaryKeyUnitTest::test_create, this), "test create");
   add_test("share", std::bind(&PrimaryKeyUnitTest::test_share, this), "test share");
+  add_test("share_integral", std::bind(&PrimaryKeyUnitTest::test_share_integral, this), "test share integral identifier");
+  add_test("index", std::bind(&PrimaryKeyUnitTest::test_index, this), "test integral primary key index");
 }
 
 PrimaryKeyUnitTest::~PrimaryKeyUnitTest()
@@ -61,3 +65,83 @@ void PrimaryKeyUnitTest::test_share()
   UNIT_ASSERT_EQUAL(gollum, email.value(), "invalid identifier value");
   UNIT_ASSERT_EQUAL(gollum, shared_email.value(), "invalid identifier value");
 }
+
+void PrimaryKeyUnitTest::test_share_integral()
+{
+  oos::identifier<unsigned long> id(7);
+
+  UNIT_ASSERT_FALSE(id.is_shared(), "identifier must not be shared");
+  UNIT_ASSERT_TRUE(id.is_integral(), "identifier must be integral");
+  UNIT_ASSERT_EQUAL(7LL, id.integral_value(), "invalid integral value");
+
+  std::unique_ptr<oos::identifier<unsigned long> > shared(id.share());
+
+  UNIT_ASSERT_TRUE(id.is_shared(), "identifier must be shared");
+  UNIT_ASSERT_EQUAL(7UL, shared->value(), "invalid identifier value");
+
+  id.value(8);
+
+  UNIT_ASSERT_EQUAL(8UL, shared->value(), "invalid identifier value");
+
+  oos::identifier<unsigned long> other;
+  id.share_with(other);
+  other.value(9);
+
+  UNIT_ASSERT_EQUAL(9UL, id.value(), "invalid identifier value");
+  UNIT_ASSERT_EQUAL(9UL, shared->value(), "invalid identifier value");
+
+  shared->isolate();
+  shared->value(10);
+
+  UNIT_ASSERT_FALSE(shared->is_shared(), "identifier must not be shared");
+  UNIT_ASSERT_EQUAL(9UL, id.value(), "invalid identifier value");
+  UNIT_ASSERT_EQUAL(10UL, shared->value(), "invalid identifier value");
+
+  std::unique_ptr<oos::basic_identifier> clone(id.clone());
+
+  UNIT_ASSERT_TRUE(*clone == id, "identifiers must be equal");
+  id.value(11);
+  UNIT_ASSERT_FALSE(*clone == id, "identifiers must not be equal");
+
+  oos::identifier<std::string> email("max@mustermann.de");
+  UNIT_ASSERT_FALSE(email.is_integral(), "identifier must not be integral");
+  UNIT_ASSERT_EXCEPTION(email.integral_value(), std::logic_error, "identifier isn't integral", "integral value must throw");
+}
+
+void PrimaryKeyUnitTest::test_index()
+{
+  oos::pk_index index;
+
+  UNIT_ASSERT_TRUE(index.empty(), "index must be empty");
+  UNIT_ASSERT_NULL(index.find(1), "key must not be found");
+
+  // proxies are only stored, fake addresses are sufficient
+  std::vector<oos::object_proxy*> proxies;
+  for (long long i = 0; i < 1000; ++i) {
+    proxies.push_back(reinterpret_cast<oos::object_proxy*>(static_cast<std::size_t>(i * 8 + 8)));
+    UNIT_ASSERT_TRUE(index.insert(i * 3, proxies.back()), "key must be inserted");
+  }
+  UNIT_ASSERT_EQUAL(index.size(), 1000UL, "invalid index size");
+  UNIT_ASSERT_FALSE(index.insert(3, proxies.front()), "key must not be inserted twice");
+  UNIT_ASSERT_TRUE(index.find(3) == proxies[1], "invalid proxy");
+
+  for (long long i = 0; i < 1000; i += 2) {
+    UNIT_ASSERT_TRUE(index.erase(i * 3), "key must be erased");
+  }
+  UNIT_ASSERT_FALSE(index.erase(0), "key must not be erased twice");
+  UNIT_ASSERT_EQUAL(index.size(), 500UL, "invalid index size");
+
+  for (long long i = 0; i < 1000; ++i) {
+    oos::object_proxy *proxy = index.find(i * 3);
+    if (i % 2 == 0) {
+      UNIT_ASSERT_NULL(proxy, "key must not be found");
+    } else {
+      UNIT_ASSERT_TRUE(proxy == proxies[i], "invalid proxy");
+    }
+  }
+
+  index.clear();
+
+  UNIT_ASSERT_TRUE(index.empty(), "index must be empty");
+  UNIT_ASSERT_NULL(index.find(3), "key must not be found");
+}
@@ -20,6 +20,8 @@ public:
 
   void test_create();
   void test_share();
+  void test_share_integral();
+  void test_index();
 };
 
 
@@ -0,0 +1,207 @@
+#include "ReplicationTestUnit.hpp"
+
+#include "../Item.hpp"
+
+#include "object/object_store.hpp"
+#include "object/object_view.hpp"
+#include "object/replication.hpp"
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace oos;
+
+namespace {
+
+typedef object_ptr<Item> item_ptr;
+typedef ObjectItem<Item> object_item;
+typedef object_ptr<object_item> object_item_ptr;
+
+const int item_count = 1000;
+
+void prepare(object_store &ostore)
+{
+  ostore.insert_prototype<Item>("item");
+  ostore.insert_prototype<object_item>("object_item");
+}
+
+/*
+ * runs in the follower process, the exit
+ * code tells the leader what went wrong
+ */
+int follow(int fd)
+{
+  try {
+    object_store ostore;
+    prepare(ostore);
+
+    replication_follower follower(ostore, fd, 4096);
+    follower.run();
+
+    object_view<Item> items(ostore);
+    // deleted every tenth item
+    if (items.size() != (std::size_t)(item_count - item_count / 10 + 1)) {
+      return 2;
+    }
+    for (object_view<Item>::iterator i = items.begin(); i != items.end(); ++i) {
+      if ((*i)->get_int() % 10 == 0 && (*i)->get_string() != "child") {
+        return 3;
+      }
+      if ((*i)->get_int() % 10 == 1 && (*i)->get_string() != "updated") {
+        return 4;
+      }
+    }
+
+    object_view<object_item> oitems(ostore);
+    if (oitems.size() != 1) {
+      return 5;
+    }
+    object_item_ptr oitem = oitems.front();
+    if (oitem->ptr().get() == nullptr || oitem->ptr()->get_string() != "child") {
+      return 6;
+    }
+    if (oitem->ref().get() == nullptr || oitem->ref()->get_int() != 1) {
+      return 7;
+    }
+
+    const replication_metrics &m = follower.metrics();
+    if (m.lag != 0 || m.sequence != m.records || m.records == 0 || m.batches == 0) {
+      return 8;
+    }
+    return 0;
+  } catch (...) {
+    return 1;
+  }
+}
+
+}
+
+ReplicationTestUnit::ReplicationTestUnit()
+  : unit_test("replication", "replication test unit")
+{
+  add_test("pipe", std::bind(&ReplicationTestUnit::test_pipe, this), "replication over pipe test");
+  add_test("socket", std::bind(&ReplicationTestUnit::test_socket, this), "replication over unix socket test");
+  add_test("references", std::bind(&ReplicationTestUnit::test_references, this), "replication of forward references test");
+}
+
+ReplicationTestUnit::~ReplicationTestUnit()
+{}
+
+void ReplicationTestUnit::test_pipe()
+{
+  int fds[2];
+  UNIT_ASSERT_EQUAL(pipe(fds), 0, "couldn't create pipe");
+  replicate(fds[1], fds[0]);
+}
+
+void ReplicationTestUnit::test_socket()
+{
+  int fds[2];
+  UNIT_ASSERT_EQUAL(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0, "couldn't create socket pair");
+  replicate(fds[0], fds[1]);
+}
+
+void ReplicationTestUnit::test_references()
+{
+  int fds[2];
+  UNIT_ASSERT_EQUAL(pipe(fds), 0, "couldn't create pipe");
+
+  object_store leader_store;
+  prepare(leader_store);
+  object_store follower_store;
+  prepare(follower_store);
+
+  change_feed feed(leader_store, 1 << 16, true);
+  replication_leader leader(feed, fds[1]);
+  replication_follower follower(follower_store, fds[0]);
+
+  object_item *oi = new object_item("parent", 1);
+  oi->ptr(new Item("child", 2));
+  object_item_ptr oitem = leader_store.insert(oi);
+
+  UNIT_ASSERT_EQUAL(leader.send(), (std::size_t)2, "two records must be sent");
+  UNIT_ASSERT_EQUAL(leader.lag(), 0ULL, "leader mustn't lag");
+  UNIT_ASSERT_EQUAL(follower.receive(), (std::size_t)2, "two records must be applied");
+
+  object_proxy *proxy = follower_store.find_proxy(oitem->id());
+  UNIT_ASSERT_NOT_NULL(proxy, "object must be replicated");
+  object_item_ptr copy(proxy);
+  UNIT_ASSERT_EQUAL(copy->get_string(), "parent", "invalid string");
+  UNIT_ASSERT_NOT_NULL(copy->ptr().get(), "child must be wired");
+  UNIT_ASSERT_EQUAL(copy->ptr()->get_string(), "child", "invalid child");
+  UNIT_ASSERT_EQUAL(copy->ptr()->id(), oitem->ptr()->id(), "child id must be equal");
+
+  // replace child, update parent
+  oitem->ptr(leader_store.insert(new Item("other", 3)));
+  leader.send();
+  follower.receive();
+
+  UNIT_ASSERT_EQUAL(copy->ptr()->get_string(), "other", "child must be replaced");
+  UNIT_ASSERT_EQUAL(follower.metrics().lag, 0ULL, "follower mustn't lag");
+
+  unsigned long id = oitem->id();
+  copy.reset();
+  leader_store.remove(oitem);
+  leader.send();
+  follower.receive();
+
+  UNIT_ASSERT_NULL(follower_store.find_proxy(id), "object must be removed");
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
+void ReplicationTestUnit::replicate(int leader_fd, int follower_fd)
+{
+  pid_t pid = fork();
+  UNIT_ASSERT_TRUE(pid >= 0, "couldn't fork follower");
+  if (pid == 0) {
+    close(leader_fd);
+    int result = follow(follower_fd);
+    close(follower_fd);
+    _exit(result);
+  }
+  close(follower_fd);
+
+  object_store ostore;
+  prepare(ostore);
+
+  change_feed feed(ostore, 1 << 20, true);
+  replication_leader leader(feed, leader_fd, 4096);
+
+  std::vector<item_ptr> items;
+  for (int i = 0; i < item_count; ++i) {
+    items.push_back(ostore.insert(new Item("item", i)));
+    if (i % 100 == 99) {
+      leader.send();
+    }
+  }
+  for (int i = 1; i < item_count; i += 10) {
+    items[i]->set_string("updated");
+  }
+  leader.send();
+
+  // object pointer to a new and a reference to an existing object
+  object_item *oi = new object_item("parent", 0);
+  oi->ptr(new Item("child", 10));
+  oi->ref(items[1]);
+  ostore.insert(oi);
+
+  for (int i = 0; i < item_count; i += 10) {
+    ostore.remove(items[i]);
+  }
+  leader.send();
+  close(leader_fd);
+
+  int status = 0;
+  UNIT_ASSERT_EQUAL(waitpid(pid, &status, 0), pid, "couldn't wait for follower");
+  UNIT_ASSERT_TRUE(WIFEXITED(status), "follower must exit normally");
+  UNIT_ASSERT_EQUAL(WEXITSTATUS(status), 0, "follower must contain the replicated objects");
+
+  const replication_metrics &m = leader.metrics();
+  UNIT_ASSERT_EQUAL(m.records, feed.sequence(), "all records must be sent");
+  UNIT_ASSERT_EQUAL(m.lag, 0ULL, "leader mustn't lag");
+  UNIT_ASSERT_GREATER(m.batches, 10ULL, "records must be sent in batches");
+  UNIT_ASSERT_GREATER(m.records_per_second(), 0.0, "throughput must be measured");
+}
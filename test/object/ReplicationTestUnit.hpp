@@ -0,0 +1,23 @@
+#ifndef REPLICATION_TEST_UNIT_HPP
+#define REPLICATION_TEST_UNIT_HPP
+
+#include "unit/unit_test.hpp"
+
+class ReplicationTestUnit : public oos::unit_test
+{
+public:
+  ReplicationTestUnit();
+  virtual ~ReplicationTestUnit();
+
+  virtual void initialize() {}
+  virtual void finalize() {}
+
+  void test_pipe();
+  void test_socket();
+  void test_references();
+
+private:
+  void replicate(int leader_fd, int follower_fd);
+};
+
+#endif /* REPLICATION_TEST_UNIT_HPP */
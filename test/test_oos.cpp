@@ -17,10 +17,12 @@
 
 #include "unit/FirstTestUnit.hpp"
 #include "unit/SecondTestUnit.hpp"
+#include "unit/TestSuiteTestUnit.hpp"
 
 #include "tools/BlobTestUnit.hpp"
 #include "tools/DateTestUnit.hpp"
 #include "tools/TimeTestUnit.hpp"
+#include "tools/UtcTimeTestUnit.hpp"
 #include "tools/VarCharTestUnit.hpp"
 #include "tools/FactoryTestUnit.hpp"
 #include "tools/StringTestUnit.hpp"
@@ -31,6 +33,9 @@
 #include "object/ObjectVectorTestUnit.hpp"
 #include "object/PrototypeTreeTest.hpp"
 #include "object/PrimaryKeyUnitTest.hpp"
+#include "object/ChangeFeedTestUnit.hpp"
+#include "object/ReplicationTestUnit.hpp"
+#include "object/ParallelTestUnit.hpp"
 
 #include "database/DatabaseTestUnit.hpp"
 #include "database/SessionTestUnit.hpp"
@@ -38,6 +43,7 @@
 #include "database/SQLTestUnit.hpp"
 
 #include "json/JsonTestUnit.hpp"
+#include "json/JsonSerializerTestUnit.hpp"
 
 #include "connections.hpp"
 
@@ -59,10 +65,12 @@ int main(int argc, char *argv[])
 
   suite.register_unit(new FirstTestUnit());
   suite.register_unit(new SecondTestUnit());
+  suite.register_unit(new TestSuiteTestUnit());
 
   suite.register_unit(new DateTestUnit());
   suite.register_unit(new TimeTestUnit());
-//  suite.register_unit(new BlobTestUnit());
+  suite.register_unit(new UtcTimeTestUnit());
+  suite.register_unit(new BlobTestUnit());
   suite.register_unit(new VarCharTestUnit());
   suite.register_unit(new FactoryTestUnit());
   suite.register_unit(new StringTestUnit());
@@ -73,6 +81,9 @@ int main(int argc, char *argv[])
   suite.register_unit(new ObjectStoreTestUnit());
   suite.register_unit(new ObjectListTestUnit());
   suite.register_unit(new ObjectVectorTestUnit());
+  suite.register_unit(new ChangeFeedTestUnit());
+  suite.register_unit(new ReplicationTestUnit());
+  suite.register_unit(new ParallelTestUnit());
 
 
 #ifdef OOS_MYSQL
@@ -99,6 +110,7 @@ int main(int argc, char *argv[])
   suite.register_unit(new TransactionTestUnit("memory_transaction", "memory transaction test unit"));
 
   suite.register_unit(new JsonTestUnit());
+  suite.register_unit(new JsonSerializerTestUnit());
 
   bool result = suite.run();
   return result ? 0 : 1;
@@ -2,16 +2,50 @@
 
 #include "tools/blob.hpp"
 
-#include <iostream>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 using namespace oos;
 
-using std::cout;
+namespace {
+
+/*
+ * provides the numbers 0 to 255 repeatedly
+ * and counts the reads
+ */
+class counting_source : public blob_source
+{
+public:
+  explicit counting_source(size_type size) : size_(size), reads(0) {}
+  virtual ~counting_source() {}
+
+  virtual size_type size() const { return size_; }
+
+  virtual size_type read(size_type offset, char *buf, size_type len) const
+  {
+    ++reads;
+    size_type i = 0;
+    for (; i < len && offset + i < size_; ++i) {
+      buf[i] = (char)((offset + i) % 256);
+    }
+    return i;
+  }
+
+  size_type size_;
+  mutable int reads;
+};
+
+}
 
 BlobTestUnit::BlobTestUnit()
   : unit_test("blob", "blob test unit")
 {
   add_test("create", std::bind(&BlobTestUnit::create_blob, this), "create blob");
+  add_test("assign", std::bind(&BlobTestUnit::assign_blob, this), "assign blob");
+  add_test("append", std::bind(&BlobTestUnit::append_blob, this), "append blob");
+  add_test("read", std::bind(&BlobTestUnit::read_blob, this), "read blob in chunks");
+  add_test("lazy", std::bind(&BlobTestUnit::lazy_blob, this), "load blob from source");
 }
 
 BlobTestUnit::~BlobTestUnit()
@@ -19,24 +53,110 @@ BlobTestUnit::~BlobTestUnit()
 
 void BlobTestUnit::create_blob()
 {
-  /*
-  cout << "\n";
+  blob b1;
+
+  UNIT_ASSERT_TRUE(b1.empty(), "blob must be empty");
+  UNIT_ASSERT_EQUAL(b1.size(), (blob::size_type)0, "blob size must be zero");
+  UNIT_ASSERT_NULL(b1.data(), "data of empty blob must be null");
+
+  const char data[] = { 'a', '\0', 'b' };
+  blob b2(data, sizeof(data));
+
+  UNIT_ASSERT_EQUAL(b2.size(), (blob::size_type)3, "blob size must be three");
+  UNIT_ASSERT_TRUE(memcmp(b2.data(), data, sizeof(data)) == 0, "invalid blob data");
 
+  blob b3(b2);
+
+  UNIT_ASSERT_TRUE(b3 == b2, "blobs must be equal");
+  UNIT_ASSERT_TRUE(b3 != b1, "blobs must not be equal");
+}
+
+void BlobTestUnit::assign_blob()
+{
   blob b1;
-  
+
   int val = 8;
   b1.assign(val);
   b1.assign(val);
 
-  cout << "size: " << b1.size() << "\n";
-  cout << "capacity: " << b1.capacity() << "\n";
+  UNIT_ASSERT_EQUAL(b1.size(), sizeof(int), "blob size must be size of int");
+
+  int res = 0;
+  memcpy(&res, b1.data(), sizeof(int));
+  UNIT_ASSERT_EQUAL(res, val, "invalid blob value");
+
+  b1.clear();
+
+  UNIT_ASSERT_TRUE(b1.empty(), "blob must be empty");
+}
+
+void BlobTestUnit::append_blob()
+{
+  blob b1;
+
+  int val = 8;
+  b1.append(val);
+  b1.append(val);
+
+  UNIT_ASSERT_EQUAL(b1.size(), 2 * sizeof(int), "blob size must be two ints");
+  UNIT_ASSERT_TRUE(b1.capacity() >= b1.size(), "blob capacity must not be less than its size");
+
+  b1.append("oos", 3);
+
+  UNIT_ASSERT_EQUAL(b1.size(), 2 * sizeof(int) + 3, "invalid blob size");
+  UNIT_ASSERT_TRUE(memcmp(b1.data() + 2 * sizeof(int), "oos", 3) == 0, "invalid appended data");
+}
+
+void BlobTestUnit::read_blob()
+{
+  std::vector<char> data(1000);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = (char)(i % 256);
+  }
+  blob b1(&data[0], data.size());
+
+  char chunk[64];
+  std::vector<char> result;
+  blob::size_type offset = 0, len = 0;
+  while ((len = b1.read(offset, chunk, sizeof(chunk))) > 0) {
+    result.insert(result.end(), chunk, chunk + len);
+    offset += len;
+  }
+
+  UNIT_ASSERT_TRUE(result == data, "invalid chunked data");
+  UNIT_ASSERT_EQUAL(b1.read(2000, chunk, sizeof(chunk)), (blob::size_type)0, "no data expected");
+}
+
+void BlobTestUnit::lazy_blob()
+{
+  std::shared_ptr<counting_source> src(new counting_source(200 * 1024));
+
+  blob b1;
+  b1.source(src);
+
+  UNIT_ASSERT_FALSE(b1.is_loaded(), "blob must not be loaded");
+  UNIT_ASSERT_EQUAL(b1.size(), (blob::size_type)(200 * 1024), "invalid blob size");
+
+  // a chunk is read from the source
+  char chunk[16];
+  UNIT_ASSERT_EQUAL(b1.read(300, chunk, sizeof(chunk)), sizeof(chunk), "invalid chunk size");
+  UNIT_ASSERT_EQUAL((unsigned char)chunk[0], (unsigned char)(300 % 256), "invalid chunk");
+  UNIT_ASSERT_FALSE(b1.is_loaded(), "blob must not be loaded");
+  UNIT_ASSERT_EQUAL(src->reads, 1, "one read expected");
+
+  // the data is loaded in chunks
+  const char *data = b1.data();
+
+  UNIT_ASSERT_TRUE(b1.is_loaded(), "blob must be loaded");
+  UNIT_ASSERT_EQUAL(src->reads, 5, "four chunks expected");
+  UNIT_ASSERT_EQUAL((unsigned char)data[200 * 1024 - 1], (unsigned char)((200 * 1024 - 1) % 256), "invalid data");
+  UNIT_ASSERT_EQUAL(src.use_count(), 1L, "source must be released");
 
+  // appending loads a lazy blob
   blob b2;
-  
-  b2.assign(val);
-  b2.assign(val);
+  b2.source(std::make_shared<counting_source>(10));
+  b2.append("x", 1);
 
-  cout << "size: " << b2.size() << "\n";
-  cout << "capacity: " << b2.capacity() << "\n";
-  */
+  UNIT_ASSERT_TRUE(b2.is_loaded(), "blob must be loaded");
+  UNIT_ASSERT_EQUAL(b2.size(), (blob::size_type)11, "invalid blob size");
 }
@@ -10,6 +10,10 @@ public:
   virtual ~BlobTestUnit();
   
   void create_blob();
+  void assign_blob();
+  void append_blob();
+  void read_blob();
+  void lazy_blob();
 
   /**
    * Initializes a test unit
@@ -19,4 +23,3 @@ public:
 };
 
 #endif /* BLOBTESTUNIT_HPP */
-
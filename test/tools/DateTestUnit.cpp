@@ -75,6 +75,9 @@ void DateTestUnit::test_invalid()
   UNIT_ASSERT_EXCEPTION(date d(42, 12, 2015), std::logic_error, "date isn't valid", "date should not be valid");
   UNIT_ASSERT_EXCEPTION(date d(31, 13, 2015), std::logic_error, "date isn't valid", "date should not be valid");
   UNIT_ASSERT_EXCEPTION(date d(29, 2, 2015), std::logic_error, "date isn't valid", "date should not be valid");
+  UNIT_ASSERT_EXCEPTION(date d(30, 2, 2016), std::logic_error, "date isn't valid", "date should not be valid");
+  UNIT_ASSERT_TRUE(date::is_valid_date(2016, 2, 29), "leap day must be valid");
+  UNIT_ASSERT_FALSE(date::is_valid_date(1900, 2, 29), "1900 isn't a leap year");
 }
 
 void DateTestUnit::test_copy()
@@ -2,8 +2,12 @@
 
 #include "tools/time.hpp"
 #include "tools/string.hpp"
+#include "tools/date.hpp"
+#include "tools/iso8601.hpp"
 
 #include <stdexcept>
+#include <random>
+#include <cstring>
 
 using namespace oos;
 
@@ -19,6 +23,7 @@ TimeTestUnit::TimeTestUnit()
   add_test("modify", std::bind(&TimeTestUnit::test_modify, this), "modify time");
   add_test("parse", std::bind(&TimeTestUnit::test_parse, this), "parse time");
   add_test("format", std::bind(&TimeTestUnit::test_format, this), "format time");
+  add_test("iso8601", std::bind(&TimeTestUnit::test_iso8601, this), "iso8601 time");
 }
 
 TimeTestUnit::~TimeTestUnit()
@@ -286,3 +291,70 @@ void TimeTestUnit::test_format()
 
   UNIT_ASSERT_EQUAL(tstr, "11:35:07.123 31.01.2015", "invalid time string [" + tstr + "]");
 }
+
+void TimeTestUnit::test_iso8601()
+{
+  char buf[oos::iso8601_time_size];
+
+  oos::time t(2015, 1, 31, 11, 35, 7, 5);
+  UNIT_ASSERT_EQUAL(23UL, oos::format_iso8601(t, buf, sizeof(buf)), "length must be 23");
+  UNIT_ASSERT_EQUAL(std::string(buf), "2015-01-31 11:35:07.005", "invalid time string [" + std::string(buf) + "]");
+  UNIT_ASSERT_EQUAL(19UL, oos::format_iso8601(t, buf, sizeof(buf), false), "length must be 19");
+  UNIT_ASSERT_EQUAL(std::string(buf), "2015-01-31 11:35:07", "invalid time string [" + std::string(buf) + "]");
+  UNIT_ASSERT_EQUAL(0UL, oos::format_iso8601(t, buf, 10), "buffer is too small");
+  UNIT_ASSERT_EQUAL(to_string(t, "%F %T.%f"), "2015-01-31 11:35:07.005", "invalid time string");
+  UNIT_ASSERT_EQUAL(to_string(t, "%H:%M:%S.%f"), "11:35:07.005", "invalid time string");
+
+  oos::time pt;
+  UNIT_ASSERT_TRUE(oos::parse_iso8601("2015-01-31T11:35:07.123456", 26, pt), "time must be parsed");
+  UNIT_ASSERT_EQUAL(123456, pt.get_timeval().tv_usec, "microseconds must be 123456");
+  UNIT_ASSERT_TRUE(oos::parse_iso8601("2015-01-31 11:35:07.5", 21, pt), "time must be parsed");
+  UNIT_ASSERT_EQUAL(500, pt.milli_second(), "millisecond must be 500");
+
+  const char *invalid[] = {
+    "2015-01-31 11:35:07.",
+    "2015-01-31 11:35:7.123",
+    "2015-02-30 11:35:07.123",
+    "2015-01-31 24:35:07.123",
+    "2015-01-31 11:60:07.123",
+    "2015-01-31 11:35:60.123",
+    "2015-01-31 11:35:07,123",
+    "2015/01/31 11:35:07.123",
+    "2015-01-31 11:35:07.12a",
+    "2015-01-31_11:35:07.123",
+    "2015-01-31 11:35:07.1234567",
+    ""
+  };
+  for (const char *str : invalid) {
+    UNIT_ASSERT_FALSE(oos::parse_iso8601(str, strlen(str), pt), "time string must be invalid [" + std::string(str) + "]");
+  }
+
+  // round trips with random times, the hours of a
+  // daylight saving change are left out
+  std::mt19937 gen(4711);
+  std::uniform_int_distribution<int> year(1971, 2037);
+  std::uniform_int_distribution<int> month(1, 12);
+  std::uniform_int_distribution<int> day(1, 28);
+  std::uniform_int_distribution<int> hour(4, 23);
+  std::uniform_int_distribution<int> minsec(0, 59);
+  std::uniform_int_distribution<int> millis(0, 999);
+  for (int i = 0; i < 1000; ++i) {
+    oos::time expected(year(gen), month(gen), day(gen), hour(gen), minsec(gen), minsec(gen), millis(gen));
+    std::size_t len = oos::format_iso8601(expected, buf, sizeof(buf));
+    UNIT_ASSERT_EQUAL(23UL, len, "length must be 23");
+    UNIT_ASSERT_TRUE(oos::parse_iso8601(buf, len, pt), "time must be parsed [" + std::string(buf) + "]");
+    UNIT_ASSERT_EQUAL(expected, pt, "times must be equal [" + std::string(buf) + "]");
+    UNIT_ASSERT_EQUAL(expected.hour(), pt.hour(), "hours must be equal [" + std::string(buf) + "]");
+    UNIT_ASSERT_EQUAL(expected, oos::time::parse(to_string(expected, "%F %T.%f"), "%F %T.%f"), "times must be equal [" + std::string(buf) + "]");
+    UNIT_ASSERT_EQUAL(23UL, to_string(expected, "%d.%m.%Y %H:%M:%S.%f").size(), "slow format must have 23 characters");
+
+    oos::date d(expected.to_date());
+    oos::date pd;
+    len = oos::format_iso8601(d, buf, sizeof(buf));
+    UNIT_ASSERT_EQUAL(10UL, len, "length must be 10");
+    UNIT_ASSERT_TRUE(oos::parse_iso8601(buf, len, pd), "date must be parsed [" + std::string(buf) + "]");
+    UNIT_ASSERT_EQUAL(d, pd, "dates must be equal [" + std::string(buf) + "]");
+    UNIT_ASSERT_EQUAL(to_string(d, "%F"), std::string(buf), "date strings must be equal");
+    UNIT_ASSERT_EQUAL(d, oos::date(buf, "%Y-%m-%d"), "dates must be equal [" + std::string(buf) + "]");
+  }
+}
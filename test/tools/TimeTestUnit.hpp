@@ -21,6 +21,7 @@ public:
   void test_modify();
   void test_parse();
   void test_format();
+  void test_iso8601();
 };
 
 #endif /* TIMETESTUNIT_HPP */
@@ -0,0 +1,152 @@
+#include "UtcTimeTestUnit.hpp"
+
+#include "tools/utc_time.hpp"
+#include "tools/time.hpp"
+#include "tools/date.hpp"
+
+#include <ctime>
+#include <sstream>
+#include <stdexcept>
+
+using namespace oos;
+
+UtcTimeTestUnit::UtcTimeTestUnit()
+  : unit_test("utc_time", "utc time test unit")
+{
+  add_test("create", std::bind(&UtcTimeTestUnit::test_create, this), "create utc time");
+  add_test("invalid", std::bind(&UtcTimeTestUnit::test_invalid, this), "invalid utc time");
+  add_test("civil", std::bind(&UtcTimeTestUnit::test_civil, this), "utc time calendar calculation");
+  add_test("compare", std::bind(&UtcTimeTestUnit::test_compare, this), "compare utc time");
+  add_test("arithmetic", std::bind(&UtcTimeTestUnit::test_arithmetic, this), "utc time arithmetic");
+  add_test("convert", std::bind(&UtcTimeTestUnit::test_convert, this), "convert utc time");
+}
+
+UtcTimeTestUnit::~UtcTimeTestUnit()
+{}
+
+void UtcTimeTestUnit::test_create()
+{
+  utc_time epoch;
+
+  UNIT_ASSERT_EQUAL(epoch.micro_seconds(), 0LL, "epoch must be zero");
+  UNIT_ASSERT_EQUAL(epoch.year(), 1970, "year isn't equal");
+  UNIT_ASSERT_EQUAL(epoch.month(), 1, "month of year isn't equal");
+  UNIT_ASSERT_EQUAL(epoch.day(), 1, "day of month isn't equal");
+  UNIT_ASSERT_EQUAL(epoch.day_of_week(), 4, "day of week isn't equal");
+
+  utc_time t(2015, 10, 16, 8, 54, 32, 123456);
+
+  UNIT_ASSERT_EQUAL(t.year(), 2015, "year isn't equal");
+  UNIT_ASSERT_EQUAL(t.month(), 10, "month of year isn't equal");
+  UNIT_ASSERT_EQUAL(t.day(), 16, "day of month isn't equal");
+  UNIT_ASSERT_EQUAL(t.hour(), 8, "hour of day isn't equal");
+  UNIT_ASSERT_EQUAL(t.minute(), 54, "minute of day isn't equal");
+  UNIT_ASSERT_EQUAL(t.second(), 32, "second of day isn't equal");
+  UNIT_ASSERT_EQUAL(t.milli_second(), 123, "millisecond of second isn't equal");
+  UNIT_ASSERT_EQUAL(t.micro_second(), 123456, "microsecond of second isn't equal");
+  UNIT_ASSERT_EQUAL(t.micro_seconds(), 1444985672123456LL, "microseconds aren't equal");
+
+  std::stringstream out;
+  out << t;
+  UNIT_ASSERT_EQUAL(out.str(), "2015-10-16T08:54:32.123456Z", "invalid time string");
+
+  // before the epoch
+  utc_time before(1969, 12, 31, 23, 59, 59, 999999);
+  UNIT_ASSERT_EQUAL(before.micro_seconds(), -1LL, "microseconds aren't equal");
+  UNIT_ASSERT_EQUAL(before.year(), 1969, "year isn't equal");
+  UNIT_ASSERT_EQUAL(before.day(), 31, "day of month isn't equal");
+  UNIT_ASSERT_EQUAL(before.hour(), 23, "hour of day isn't equal");
+  UNIT_ASSERT_EQUAL(before.micro_second(), 999999, "microsecond of second isn't equal");
+  UNIT_ASSERT_EQUAL(before.day_of_week(), 3, "day of week isn't equal");
+}
+
+void UtcTimeTestUnit::test_invalid()
+{
+  UNIT_ASSERT_EXCEPTION(utc_time(2015, 2, 29), std::logic_error, "date isn't valid", "date must be invalid");
+  UNIT_ASSERT_EXCEPTION(utc_time(2015, 13, 1), std::logic_error, "date isn't valid", "date must be invalid");
+  UNIT_ASSERT_EXCEPTION(utc_time(2015, 1, 1, 24, 0, 0), std::logic_error, "time isn't valid", "time must be invalid");
+  UNIT_ASSERT_EXCEPTION(utc_time(2015, 1, 1, 0, 0, 0, 1000000), std::logic_error, "time isn't valid", "time must be invalid");
+}
+
+void UtcTimeTestUnit::test_civil()
+{
+  // compare every day of several centuries with gmtime
+  for (long long days = -80000; days < 80000; days += 7) {
+    time_t t = (time_t)(days * 86400);
+    struct tm tm;
+#ifdef _MSC_VER
+    if (t < 0) {
+      continue;
+    }
+    gmtime_s(&tm, &t);
+#else
+    gmtime_r(&t, &tm);
+#endif
+    int y, m, d;
+    utc_time::civil_from_days(days, y, m, d);
+    UNIT_ASSERT_EQUAL(y, tm.tm_year + 1900, "year isn't equal");
+    UNIT_ASSERT_EQUAL(m, tm.tm_mon + 1, "month of year isn't equal");
+    UNIT_ASSERT_EQUAL(d, tm.tm_mday, "day of month isn't equal");
+    UNIT_ASSERT_EQUAL(utc_time::days_from_civil(y, m, d), days, "days aren't equal");
+
+    utc_time ut(days * 86400LL * 1000000LL);
+    UNIT_ASSERT_EQUAL(ut.day_of_week(), tm.tm_wday, "day of week isn't equal");
+    UNIT_ASSERT_EQUAL(ut.day_of_year(), tm.tm_yday, "day of year isn't equal");
+  }
+}
+
+void UtcTimeTestUnit::test_compare()
+{
+  utc_time t1(2015, 10, 16, 8, 54, 32, 123);
+  utc_time t2(2015, 10, 16, 8, 54, 32, 124);
+  utc_time t3(t1);
+
+  UNIT_ASSERT_TRUE(t1 == t3, "times must be equal");
+  UNIT_ASSERT_TRUE(t1 != t2, "times must not be equal");
+  UNIT_ASSERT_TRUE(t1 < t2, "time must be less");
+  UNIT_ASSERT_TRUE(t1 <= t3, "time must be less equal");
+  UNIT_ASSERT_TRUE(t2 > t1, "time must be greater");
+  UNIT_ASSERT_TRUE(t2 >= t1, "time must be greater equal");
+}
+
+void UtcTimeTestUnit::test_arithmetic()
+{
+  utc_time t(2016, 2, 28, 23, 0, 0);
+
+  t += 3600LL * 1000000LL;
+  UNIT_ASSERT_EQUAL(t.month(), 2, "month of year isn't equal");
+  UNIT_ASSERT_EQUAL(t.day(), 29, "day of month isn't equal");
+  UNIT_ASSERT_EQUAL(t.hour(), 0, "hour of day isn't equal");
+
+  t.add_days(1);
+  UNIT_ASSERT_EQUAL(t.month(), 3, "month of year isn't equal");
+  UNIT_ASSERT_EQUAL(t.day(), 1, "day of month isn't equal");
+
+  utc_time t2 = t - 1;
+  UNIT_ASSERT_EQUAL(t2.day(), 29, "day of month isn't equal");
+  UNIT_ASSERT_EQUAL(t2.micro_second(), 999999, "microsecond of second isn't equal");
+  UNIT_ASSERT_EQUAL(t - t2, 1LL, "difference isn't equal");
+
+  t2 -= 86400LL * 1000000LL * 365;
+  UNIT_ASSERT_EQUAL(t2.year(), 2015, "year isn't equal");
+  UNIT_ASSERT_EQUAL(t2.month(), 3, "month of year isn't equal");
+  UNIT_ASSERT_EQUAL(t2.day(), 1, "day of month isn't equal");
+}
+
+void UtcTimeTestUnit::test_convert()
+{
+  oos::time local(2015, 10, 16, 8, 54, 32, 123);
+
+  utc_time t(local);
+  struct timeval tv = local.get_timeval();
+  UNIT_ASSERT_EQUAL(t.micro_seconds(), (long long)tv.tv_sec * 1000000LL + tv.tv_usec, "microseconds aren't equal");
+
+  oos::time back = t.to_time();
+  UNIT_ASSERT_TRUE(back == local, "times must be equal");
+  UNIT_ASSERT_EQUAL(back.hour(), local.hour(), "hour of day isn't equal");
+
+  date d = utc_time(2015, 10, 16, 23, 0, 0).to_date();
+  UNIT_ASSERT_EQUAL(d.year(), 2015, "year isn't equal");
+  UNIT_ASSERT_EQUAL(d.month(), 10, "month of year isn't equal");
+  UNIT_ASSERT_EQUAL(d.day(), 16, "day of month isn't equal");
+}
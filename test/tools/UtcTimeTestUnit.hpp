@@ -0,0 +1,23 @@
+#ifndef UTCTIMETESTUNIT_HPP
+#define UTCTIMETESTUNIT_HPP
+
+#include "unit/unit_test.hpp"
+
+class UtcTimeTestUnit : public oos::unit_test
+{
+public:
+  UtcTimeTestUnit();
+  virtual ~UtcTimeTestUnit();
+
+  virtual void initialize() {}
+  virtual void finalize() {}
+
+  void test_create();
+  void test_invalid();
+  void test_civil();
+  void test_compare();
+  void test_arithmetic();
+  void test_convert();
+};
+
+#endif /* UTCTIMETESTUNIT_HPP */
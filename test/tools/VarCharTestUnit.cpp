@@ -2,7 +2,9 @@
 
 #include "tools/varchar.hpp"
 
+#include <cstring>
 #include <iostream>
+#include <sstream>
 
 using oos::varchar;
 using std::cout;
@@ -15,6 +17,8 @@ VarCharTestUnit::VarCharTestUnit()
   add_test("copy", std::bind(&VarCharTestUnit::copy_varchar, this), "copy varchar");
   add_test("assign", std::bind(&VarCharTestUnit::assign_varchar, this), "assign varchar");
   add_test("init", std::bind(&VarCharTestUnit::init_varchar, this), "init varchar");
+  add_test("truncate", std::bind(&VarCharTestUnit::truncate_varchar, this), "truncate varchar");
+  add_test("base", std::bind(&VarCharTestUnit::base_varchar, this), "varchar base");
 }
 
 VarCharTestUnit::~VarCharTestUnit()
@@ -68,3 +72,72 @@ void VarCharTestUnit::init_varchar()
   UNIT_ASSERT_EQUAL((int)str.size(), 5, "size of varchar must be zero");
   UNIT_ASSERT_EQUAL(str, "hallo", "size of varchar must be zero");
 }
+
+void VarCharTestUnit::truncate_varchar()
+{
+  // the string is stored inline
+  UNIT_ASSERT_TRUE(sizeof(varchar<255>) <= 256 + 3 * sizeof(void*), "varchar must be stored inline");
+
+  varchar<8> str("Hallo Welt");
+
+  UNIT_ASSERT_EQUAL((int)str.size(), 8, "size of varchar must be 8");
+  UNIT_ASSERT_EQUAL(str, "Hallo We", "expected string must be 'Hallo We'");
+
+  str = std::string("0123456789");
+
+  UNIT_ASSERT_EQUAL(str, "01234567", "expected string must be '01234567'");
+
+  str = "abc";
+  str += "defghijk";
+
+  UNIT_ASSERT_EQUAL(str, "abcdefgh", "expected string must be 'abcdefgh'");
+  UNIT_ASSERT_EQUAL((int)strlen(str.c_str()), 8, "string must be terminated");
+
+  varchar<4> str4;
+  str4.assign(str.c_str(), str.size());
+
+  UNIT_ASSERT_EQUAL(str4, "abcd", "expected string must be 'abcd'");
+
+  str4 += str4;
+
+  UNIT_ASSERT_EQUAL(str4, "abcd", "expected string must be 'abcd'");
+
+  str.assign(str.c_str() + 2, 3);
+
+  UNIT_ASSERT_EQUAL(str, "cde", "expected string must be 'cde'");
+
+  std::stringstream out;
+  out << str;
+
+  UNIT_ASSERT_EQUAL(out.str(), "cde", "expected string must be 'cde'");
+}
+
+void VarCharTestUnit::base_varchar()
+{
+  varchar<16> str("hallo");
+
+  // a copy of the base owns its string
+  oos::varchar_base base(str);
+
+  UNIT_ASSERT_EQUAL((int)base.capacity(), 16, "invalid capacity of varchar");
+  UNIT_ASSERT_TRUE(base.c_str() != str.c_str(), "string must be copied");
+
+  str = "welt";
+
+  UNIT_ASSERT_EQUAL(base.str(), "hallo", "expected string must be 'hallo'");
+  UNIT_ASSERT_TRUE(base != str, "strings must not be equal");
+
+  varchar<32> str32("guten morgen");
+  base = str32;
+
+  UNIT_ASSERT_EQUAL((int)base.capacity(), 32, "invalid capacity of varchar");
+  UNIT_ASSERT_EQUAL(base.str(), "guten morgen", "expected string must be 'guten morgen'");
+
+  // the view keeps its capacity
+  oos::varchar_base &view = str;
+  view = str32;
+
+  UNIT_ASSERT_EQUAL((int)str.capacity(), 16, "invalid capacity of varchar");
+  UNIT_ASSERT_EQUAL(str, "guten morgen", "expected string must be 'guten morgen'");
+  UNIT_ASSERT_TRUE(base == str, "strings must be equal");
+}
@@ -13,6 +13,8 @@ public:
   void copy_varchar();
   void assign_varchar();
   void init_varchar();
+  void truncate_varchar();
+  void base_varchar();
 
   /**
    * Initializes a test unit
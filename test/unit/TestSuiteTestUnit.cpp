@@ -0,0 +1,166 @@
+#include "TestSuiteTestUnit.hpp"
+
+#include "FirstTestUnit.hpp"
+#include "SecondTestUnit.hpp"
+
+#include "unit/benchmark_unit.hpp"
+#include "unit/test_suite.hpp"
+
+#include "json/json.hpp"
+#include "json/json_parser.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace oos;
+
+namespace {
+
+/*
+ * a benchmark spinning for the given delay,
+ * a longer delay is a regression
+ */
+class DelayBenchmark : public benchmark_unit
+{
+public:
+  explicit DelayBenchmark(long delay_us)
+    : benchmark_unit("delay", "delay benchmark unit", 5, 1)
+    , delay_us_(delay_us)
+  {
+    add_benchmark("spin", [this]() { spin(); }, "spin for the delay");
+  }
+
+private:
+  void spin() const
+  {
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::microseconds(delay_us_);
+    while (std::chrono::steady_clock::now() < end) {}
+  }
+
+private:
+  long delay_us_;
+};
+
+/*
+ * a unit with a failing test and
+ * a test recording a metric
+ */
+class FailingTestUnit : public unit_test
+{
+public:
+  FailingTestUnit() : unit_test("failing", "failing test unit")
+  {
+    add_test("fail", std::bind(&FailingTestUnit::fail_test, this), "failing test");
+    add_test("metric", std::bind(&FailingTestUnit::metric_test, this), "metric test");
+  }
+
+  void fail_test()
+  {
+    UNIT_ASSERT_TRUE(true, "first assertion holds");
+    UNIT_FAIL("expected failure");
+  }
+
+  void metric_test()
+  {
+    metric("items", 42);
+    UNIT_ASSERT_TRUE(true, "test should be executed");
+  }
+
+  virtual void initialize() {}
+  virtual void finalize() {}
+};
+
+std::string read_file(const char *file)
+{
+  std::ifstream in(file);
+  std::stringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+}
+
+TestSuiteTestUnit::TestSuiteTestUnit()
+  : unit_test("suite", "test suite unit")
+{
+  add_test("baseline", std::bind(&TestSuiteTestUnit::test_baseline, this), "record and compare a benchmark baseline");
+  add_test("parallel", std::bind(&TestSuiteTestUnit::test_parallel, this), "merge the results of parallel test units");
+}
+
+TestSuiteTestUnit::~TestSuiteTestUnit()
+{}
+
+void TestSuiteTestUnit::test_baseline()
+{
+  const char *file = "suite_baseline.json";
+  std::remove(file);
+
+  UNIT_ASSERT_TRUE(run_suite({ "exec", "delay", "record", file, "tolerance", "200" }, 200), "recording the baseline must succeed");
+
+  std::ifstream in(file);
+  UNIT_ASSERT_TRUE(in.good(), "baseline file must be written");
+  json_value root = json_parser().parse(in);
+  json_value &entry = root["benchmarks"]["delay:spin"];
+  UNIT_ASSERT_TRUE(entry["median_ns"].is_type<json_number>(), "median must be recorded");
+  UNIT_ASSERT_GREATER(entry["median_ns"].value_type<json_number>()->value(), 0.0, "median must be positive");
+  UNIT_ASSERT_EQUAL(entry["tolerance"].value_type<json_number>()->value(), 200.0, "invalid tolerance");
+  in.close();
+
+  UNIT_ASSERT_TRUE(run_suite({ "exec", "delay", "baseline", file }, 200), "unchanged benchmark must pass");
+  // twenty times slower exceeds the tolerance of 200 percent
+  UNIT_ASSERT_FALSE(run_suite({ "exec", "delay", "baseline", file }, 4000), "regressed benchmark must fail");
+
+  std::remove(file);
+}
+
+void TestSuiteTestUnit::test_parallel()
+{
+  const char *sequential = "suite_sequential.json";
+  const char *parallel = "suite_parallel.json";
+
+  UNIT_ASSERT_FALSE(run_suite({ "exec", "all", "json", sequential }, 0), "sequential run must fail");
+  UNIT_ASSERT_FALSE(run_suite({ "exec", "all", "json", parallel, "-j", "2" }, 0), "parallel run must fail");
+
+  std::string expected = read_file(sequential);
+  std::string merged = read_file(parallel);
+  std::remove(sequential);
+  std::remove(parallel);
+
+  UNIT_ASSERT_TRUE(expected.find("expected failure") != std::string::npos, "failure must be reported");
+  UNIT_ASSERT_EQUAL(merged, expected, "merged results must match the sequential run");
+}
+
+bool TestSuiteTestUnit::run_suite(const std::vector<std::string> &args, long delay_us)
+{
+  std::vector<char*> argv;
+  std::string program("test_oos");
+  argv.push_back(&program[0]);
+  std::vector<std::string> arguments(args);
+  for (std::vector<std::string>::iterator i = arguments.begin(); i != arguments.end(); ++i) {
+    argv.push_back(&(*i)[0]);
+  }
+
+  test_suite suite;
+  suite.init((int)argv.size(), &argv.front());
+  suite.register_unit(new FirstTestUnit());
+  suite.register_unit(new SecondTestUnit());
+  suite.register_unit(new FailingTestUnit());
+  if (delay_us > 0) {
+    suite.register_unit(new DelayBenchmark(delay_us));
+  }
+
+  std::stringstream output;
+  std::streambuf *buf = std::cout.rdbuf(output.rdbuf());
+  bool result = false;
+  try {
+    result = suite.run();
+  } catch (...) {
+    std::cout.rdbuf(buf);
+    throw;
+  }
+  std::cout.rdbuf(buf);
+  return result;
+}
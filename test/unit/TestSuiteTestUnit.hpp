@@ -0,0 +1,29 @@
+#ifndef TEST_SUITE_TEST_UNIT_HPP
+#define TEST_SUITE_TEST_UNIT_HPP
+
+#include "unit/unit_test.hpp"
+
+#include <string>
+#include <vector>
+
+class TestSuiteTestUnit : public oos::unit_test
+{
+public:
+  TestSuiteTestUnit();
+  virtual ~TestSuiteTestUnit();
+
+  virtual void initialize() {}
+  virtual void finalize() {}
+
+  void test_baseline();
+  void test_parallel();
+
+private:
+  /*
+   * runs a test suite with the given command
+   * line, its output is discarded
+   */
+  bool run_suite(const std::vector<std::string> &args, long delay_us);
+};
+
+#endif /* TEST_SUITE_TEST_UNIT_HPP */